@@ -447,6 +447,8 @@ namespace emul
 
 			SetFlag(FLAG_I, true);
 
+			ProfileIRQ((BYTE)(nmi ? ADDR_NMI : ADDR_IRQ));
+
 			ADDRESS intVector = nmi ? m_memory.Read16(ADDR_NMI) : m_memory.Read16(ADDR_IRQ);
 			m_programCounter = intVector;
 			TICKINT();
@@ -4,6 +4,7 @@
 #include <CPU/CPU.h>
 #include <CPU/PortConnector.h>
 #include <CPU/CPUInfo.h>
+#include <CPU/OpcodeTable.h>
 #include <EdgeDetectLatch.h>
 
 #undef IN
@@ -60,7 +61,7 @@ namespace emul
 		const ADDRESS ADDR_RESET = 0xFFFC;
 		const ADDRESS ADDR_IRQ = 0xFFFE;
 
-		using OpcodeTable = std::vector<std::function<void()>>;
+		using OpcodeTable = std::vector<OpcodeHandler>;
 		OpcodeTable m_opcodes;
 		void UnknownOpcode();
 
@@ -301,7 +301,7 @@ namespace emul
 			{
 				// Mix of PortB Shift register output and tape out
 				// TODO: Allow mixing/mute
-				SOUND().PlayMono(m_via.GetSoundOut());
+				SOUND().SetOutput(g_ticks, m_via.GetSoundOut());
 			}
 
 			// Tape update
@@ -328,15 +328,14 @@ namespace emul
 			}
 
 			m_video->Tick();
-			static bool oldBlank = false;
 			bool blank = m_video->IsVSync();
-			if (blank != oldBlank)
+			if (blank != m_lastBlank)
 			{
 				LogPrintf(LOG_DEBUG, "Blank: %d", blank);
 
 				m_pia1.SetScreenRetrace(blank);
 				m_via.SetRetraceIn(blank);
-				oldBlank = blank;
+				m_lastBlank = blank;
 			}
 
 			m_via.Tick();
@@ -350,6 +349,11 @@ namespace emul
 				m_via.GetIRQ());
 		}
 
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
+		}
+
 		return true;
 	}
 
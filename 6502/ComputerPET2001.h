@@ -86,5 +86,7 @@ namespace emul
 		kbd::DeviceKeyboardPET2001* m_keyboard = nullptr;
 
 		tape::DeviceTape m_tape;
+
+		bool m_lastBlank = false;
 	};
 }
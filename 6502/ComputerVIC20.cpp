@@ -343,7 +343,7 @@ namespace emul
 			if (!m_turbo)
 			{
 				WORD sound = m_sound.GetOutput() + tape.GetSound();
-				SOUND().PlayMono(sound);
+				SOUND().SetOutput(g_ticks, sound);
 			}
 
 			// Tape update
@@ -372,6 +372,11 @@ namespace emul
 			GetCPU().SetIRQ(m_via2.GetIRQ());
 		}
 
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
+		}
+
 		return true;
 	}
 
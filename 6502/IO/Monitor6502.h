@@ -2,6 +2,7 @@
 
 #include <IO/Console.h>
 #include <CPU/Memory.h>
+#include <CPU/Breakpoints.h>
 #include <CPU/CPUInfo.h>
 #include "CPU/CPU6502.h"
 
@@ -25,9 +26,8 @@ namespace emul
 		virtual void Init(CPU* cpu, Memory& memory);
 
 		void SetCustomMemoryView(ADDRESS address) { m_customMemView = address; }
-		void SetBreakpoint(ADDRESS address) { m_breakpoint = address; m_breakpointEnabled = true; }
-		void ClearBreakpoint() { m_breakpointEnabled = false; }
-		bool IsBreakpoint() const { return m_breakpointEnabled && m_cpu->GetCurrentAddress() == m_breakpoint; }
+		// Stop at breakpoint/watchpoint, call before each instruction
+		bool IsBreakpoint() { return m_cpu->GetBreakpoints() && m_cpu->GetBreakpoints()->IsBreak(m_cpu->GetCurrentAddress()); }
 
 		void Show();
 		MonitorState Run();
@@ -48,9 +48,6 @@ namespace emul
 		};
 
 		ADDRESS m_customMemView = 0;
-		ADDRESS m_breakpoint = 0;
-		bool m_breakpointEnabled = false;
-
 		MonitorState ProcessKey();
 
 		void ToggleRunMode();
@@ -358,7 +358,7 @@ namespace emul
 		LogPrintf(LOG_ERROR, "B = %02X", m_reg.ab.B);
 		LogPrintf(LOG_ERROR, "X = %02X", m_reg.X);
 		LogPrintf(LOG_ERROR, "Flags --HINZVC");
-		LogPrintf(LOG_ERROR, "      "PRINTF_BIN_PATTERN_INT8, PRINTF_BYTE_TO_BIN_INT8(m_flags));
+		LogPrintf(LOG_ERROR, "      " PRINTF_BIN_PATTERN_INT8, PRINTF_BYTE_TO_BIN_INT8(m_flags));
 		LogPrintf(LOG_ERROR, "SP = %04X", m_reg.SP);
 		LogPrintf(LOG_ERROR, "PC = %04X", m_programCounter);
 		LogPrintf(LOG_ERROR, "");
@@ -368,7 +368,7 @@ namespace emul
 	{
 		LogPrintf(LOG_ERROR, "CPU: Unknown Opcode (0x%02X) at address 0x%04X", m_opcode, m_programCounter);
 		Dump();
-		throw std::exception("Unknown opcode");
+		throw std::runtime_error("Unknown opcode");
 	}
 
 	void CPU6800::Exec(BYTE opcode)
@@ -420,6 +420,7 @@ namespace emul
 
 		if (vector != 0xFFFF)
 		{
+			ProfileIRQ((BYTE)vector);
 			SetFlag(FLAG_I, true);   // Disable IRQ
 			m_programCounter = MemRead16(vector);
 		}
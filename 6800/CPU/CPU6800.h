@@ -4,6 +4,7 @@
 #include <CPU/CPU.h>
 #include <CPU/PortConnector.h>
 #include <CPU/CPUInfo.h>
+#include <CPU/OpcodeTable.h>
 #include <EdgeDetectLatch.h>
 
 #undef IN
@@ -64,7 +65,7 @@ namespace emul
 		static constexpr ADDRESS ADDR_NMI = 0xFFFC; // Non-maskable interrupt vector (NMI)
 		static constexpr ADDRESS ADDR_RESET = 0xFFFE; // Reset vector
 
-		using OpcodeTable = std::vector<std::function<void()>>;
+		using OpcodeTable = std::vector<OpcodeHandler>;
 		OpcodeTable m_opcodes;
 		void UnknownOpcode();
 
@@ -383,6 +383,7 @@ namespace emul
 			SetFlag(FLAG_I, true);   // Disable IRQ
 
 			m_PC = MemRead16(ADDR_NMI);
+			ProfileIRQ((BYTE)ADDR_NMI);
 			m_nmi.ResetLatch();
 		}
 		else if (m_firq && !GetFlag(FLAG_F))
@@ -396,6 +397,7 @@ namespace emul
 			SetFlag(FLAG_I, true);  // Disable IRQ
 
 			m_PC = MemRead16(ADDR_FIRQ);
+			ProfileIRQ((BYTE)ADDR_FIRQ);
 		}
 		else if (m_irq && !GetFlag(FLAG_I))
 		{
@@ -406,6 +408,7 @@ namespace emul
 			SetFlag(FLAG_I, true);   // Disable IRQ
 
 			m_PC = MemRead16(ADDR_IRQ);
+			ProfileIRQ((BYTE)ADDR_IRQ);
 		}
 	}
 
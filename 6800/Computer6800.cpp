@@ -2,7 +2,6 @@
 
 #include "Computer6800.h"
 #include <Config.h>
-#include "IO/Console.h"
 #include "CPU/CPU6800.h"
 #include <Video/VideoNull.h>
 
@@ -43,7 +42,7 @@ namespace emul
 		else
 		{
 			LogPrintf(LOG_ERROR, "CPUType not supported: [%s]", cpuid);
-			throw std::exception("CPUType not supported");
+			throw std::runtime_error("CPUType not supported");
 		}
 	}
 
@@ -63,9 +62,6 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = 0;
-		cpuTicks += GetCPU().GetInstructionTicks();
-
 		++g_ticks;
 
 		m_video->Tick();
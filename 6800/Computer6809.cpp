@@ -63,9 +63,6 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = 0;
-		cpuTicks += GetCPU().GetInstructionTicks();
-
 		++g_ticks;
 
 		m_video->Tick();
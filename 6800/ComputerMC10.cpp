@@ -116,7 +116,7 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = GetCPU().GetInstructionTicks();
+		const uint32_t cpuTicks = GetCPU().GetInstructionTicks();
 
 		for (uint32_t i = 0; i < cpuTicks; ++i)
 		{
@@ -124,7 +124,7 @@ namespace emul
 
 			if (!m_turbo)
 			{
-				SOUND().PlayMono(m_soundData * 4000);
+				SOUND().SetOutput(g_ticks, m_soundData * 4000);
 			}
 
 			m_video->Tick();
@@ -136,6 +136,11 @@ namespace emul
 			}
 		}
 
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
+		}
+
 		return true;
 	}
 }
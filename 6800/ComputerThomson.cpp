@@ -335,7 +335,7 @@ namespace emul
 
 			if (!m_turbo)
 			{
-				SOUND().PlayMono(tape.GetSound() + (m_pia->GetBuzzer() * 4000));
+				SOUND().SetOutput(g_ticks, tape.GetSound() + (m_pia->GetBuzzer() * 4000));
 			}
 
 			{
@@ -366,6 +366,11 @@ namespace emul
 
 		}
 
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
+		}
+
 		return true;
 	}
 
@@ -50,22 +50,19 @@ namespace pia
 
 	void Device6846::Tick()
 	{
-		static constexpr int PRESCALE = 8;
-		static int prescaler = PRESCALE;
-
 		// Nothing to do in preset mode
 		if (TCR.IsTimerPreset())
 		{
 			m_counter = m_counterLatch;
-			prescaler = PRESCALE;
+			m_prescaler = PRESCALE;
 			return;
 		}
 
-		if (TCR.IsDiv8Prescaler() && (--prescaler))
+		if (TCR.IsDiv8Prescaler() && (--m_prescaler))
 		{
 			return;
 		}
-		prescaler = PRESCALE;
+		m_prescaler = PRESCALE;
 
 		// Mode 0 only for now
 		if (m_counter-- == 0)
@@ -217,6 +217,10 @@ namespace pia
 		BYTE m_tempMSB = 0;
 		WORD m_counterLatch = 0;
 		WORD m_counter = 0;
+
+		static constexpr int PRESCALE = 8;
+		int m_prescaler = PRESCALE;
+
 		bool m_timerOutput = false;
 		bool m_timerIRQ = false;
 		bool m_timerIRQAcknowledged = false;
@@ -0,0 +1,40 @@
+#include "stdafx.h"
+
+// Headless batch runner
+//
+// Runs a computer created from a config file without main window,
+// overlay, monitor, console keyboard or audio output.
+//
+// Usage: hotkey6800headless [config.ini]
+//
+// Run parameters are read from the [batch] section of the config file.
+// At the end of the run, a summary line is printed on stdout.
+// See BatchRunner::Main(), this file only knows the 6800 computers.
+//
+// Built by CMake (see CMakeLists.txt), without SDL: only the
+// computers that don't need SDL headers are available.
+
+#include <Computer/BatchRunner.h>
+
+#include "Computer6800.h"
+
+#include <string>
+
+using emul::BatchRunner;
+using emul::ComputerBase;
+
+thread_local size_t emul::g_ticks = 0;
+
+ComputerBase* CreateComputer(const std::string& arch)
+{
+	if (arch == "6800")
+	{
+		return new emul::Computer6800();
+	}
+	return nullptr;
+}
+
+int main(int argc, char* args[])
+{
+	return BatchRunner::Main(argc, args, CreateComputer);
+}
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Monitor6809.h"
 #include "CPU/CPU6809.h"
+#include <CPU/CPUProfiler.h>
 
 using cpuInfo::Opcode;
 using cpuInfo::Coord;
@@ -81,8 +82,10 @@ namespace emul
 				Instruction decoded;
 				// Set breakpoint at next instruction
 				ADDRESS next = Disassemble(GetCPU()->GetCurrentAddress(), decoded);
-				m_breakpointEnabled = true;
-				m_breakpoint = next;
+				if (GetCPU()->GetBreakpoints())
+				{
+					GetCPU()->GetBreakpoints()->AddExec(next, true);
+				}
 				m_runMode = RUNMode::RUN;
 				break;
 			}
@@ -92,22 +95,23 @@ namespace emul
 				Update();
 				break;
 
+			case 64: // F6: Dump profiler data
+				if (GetCPU()->GetProfiler())
+				{
+					GetCPU()->GetProfiler()->Dump();
+				}
+				break;
+
 				// Not implemented, ignore
 			case 59: // F1
 			case 60: // F2
 			case 61: // F3
-			case 64: // F6
 			case 65: // F7
 				break;
 			case 67: // F9
-				if (IsBreakpoint())
-				{
-					m_breakpointEnabled = false;
-				}
-				else
+				if (GetCPU()->GetBreakpoints())
 				{
-					m_breakpointEnabled = true;
-					m_breakpoint = GetCPU()->GetCurrentAddress();
+					GetCPU()->GetBreakpoints()->ToggleExec(GetCPU()->GetCurrentAddress());
 				}
 				UpdateCode();
 				break;
@@ -121,6 +125,9 @@ namespace emul
 
 	MonitorState Monitor6809::Run()
 	{
+		// Monitor memory reads don't trigger watchpoints
+		Breakpoints::Suspend suspend(GetCPU()->GetBreakpoints());
+
 		Update();
 		if (m_runMode == RUNMode::STEP)
 		{
@@ -132,6 +139,8 @@ namespace emul
 
 	void Monitor6809::Show()
 	{
+		Breakpoints::Suspend suspend(GetCPU()->GetBreakpoints());
+
 		std::string ansiFile = GetCPU()->GetInfo().GetANSIFile();
 
 		if (ansiFile.size())
@@ -341,7 +350,7 @@ namespace emul
 
 		// Write address
 		pos.x = addressPos.x;
-		bool isBreakpoint = m_breakpointEnabled && (instr.address == m_breakpoint);
+		bool isBreakpoint = GetCPU()->GetBreakpoints() && GetCPU()->GetBreakpoints()->IsExec(instr.address);
 		WriteValueHex((WORD)instr.address, pos, isBreakpoint ? (4 << 4) | 15 : 8 );
 		pos.x = rawPos.x;
 		m_console.WriteAt(pos.x, pos.y, (const char*)instr.raw, instr.len);
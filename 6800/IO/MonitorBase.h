@@ -3,6 +3,7 @@
 #include <IO/Console.h>
 #include <CPU/CPU.h>
 #include <CPU/Memory.h>
+#include <CPU/Breakpoints.h>
 #include <CPU/CPUInfo.h>
 
 namespace emul
@@ -25,9 +26,8 @@ namespace emul
 		virtual void Init(CPU* cpu, Memory& memory) = 0;
 
 		void SetCustomMemoryView(ADDRESS address) { m_customMemView = address; }
-		void SetBreakpoint(ADDRESS address) { m_breakpoint = address; m_breakpointEnabled = true; }
-		void ClearBreakpoint() { m_breakpointEnabled = false; }
-		bool IsBreakpoint() const { return m_breakpointEnabled && m_cpu->GetCurrentAddress() == m_breakpoint; }
+		// Stop at breakpoint/watchpoint, call before each instruction
+		bool IsBreakpoint() { return m_cpu->GetBreakpoints() && m_cpu->GetBreakpoints()->IsBreak(m_cpu->GetCurrentAddress()); }
 
 		virtual void Show() = 0;
 		virtual MonitorState Run() = 0;
@@ -35,9 +35,6 @@ namespace emul
 		void SetStepMode() { m_runMode = RUNMode::STEP; }
 
 	protected:
-		ADDRESS m_breakpoint = 0;
-		bool m_breakpointEnabled = false;
-
 		enum class RUNMode { STEP, RUN };
 		RUNMode m_runMode = RUNMode::STEP;
 
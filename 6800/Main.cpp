@@ -2,12 +2,14 @@
 
 #include <Config.h>
 #include <FileUtil.h>
+#include <SnapshotFile.h>
 #include <UI/MainWindow.h>
 #include <UI/Overlay.h>
 #include <Sound/Sound.h>
 
 #include <CPU/Memory.h>
 #include <CPU/MemoryBlock.h>
+#include <Computer/RewindBuffer.h>
 
 #include "IO/Console.h"
 #include "IO/MonitorBase.h"
@@ -42,7 +44,7 @@ using sound::SOUND;
 using ui::MAINWND;
 using ui::Overlay;
 
-size_t emul::g_ticks = 0;
+thread_local size_t emul::g_ticks = 0;
 
 hscommon::fileUtil::File logFile;
 
@@ -186,6 +188,13 @@ void InitPC(ComputerBase* pc, Overlay& overlay, bool reset = true)
 
 	monitor->Init(pc->GetCPU(), pc->GetMemory());
 
+	emul::ADDRESS breakpoint = CONFIG().GetValueDWORD("monitor", "breakpoint", 0xFFFFFFFF);
+	if (breakpoint <= 0xFFFF)
+	{
+		fprintf(stderr, "Set Breakpoint to [0x%04X]\n", breakpoint);
+		pc->GetBreakpoints().AddExec(breakpoint);
+	}
+
 	overlay.SetPC(pc);
 
 	pc->GetVideo().AddRenderer(&overlay);
@@ -246,12 +255,26 @@ ComputerBase* RestoreNewComputerFromSnapshot()
 	// continue with the old PC.
 	bool failureIsFatal = false;
 
-	// First, load the config file so we have the proper hardware
-	fs::path config = snapshotDir;
-	config.append("config.ini");
-	if (!CONFIG().LoadConfigFile(config.string().c_str()))
+	// First, load the config so we have the proper hardware.
+	// It's stored in the snapshot file (older snapshots: config.ini)
+	emul::SnapshotFile snapshotFile;
+	fs::path snapshotPath = snapshotDir;
+	snapshotPath.append(emul::SnapshotFile::FILE_NAME);
+	if (fs::exists(snapshotPath))
+	{
+		if (!snapshotFile.Load(snapshotPath) || !snapshotFile.LoadConfig())
+		{
+			fprintf(stderr, "Unable to read config from snapshot %s, aborting\n", snapshotPath.string().c_str());
+		}
+	}
+	else
 	{
-		fprintf(stderr, "Unable to read config file %s, aborting\n", config.string().c_str());
+		fs::path config = snapshotDir;
+		config.append("config.ini");
+		if (!CONFIG().LoadConfigFile(config.string().c_str()))
+		{
+			fprintf(stderr, "Unable to read config file %s, aborting\n", config.string().c_str());
+		}
 	}
 
 	std::string arch = CONFIG().GetValueStr("core", "arch");
@@ -269,7 +292,9 @@ ComputerBase* RestoreNewComputerFromSnapshot()
 			newPC->Init(baseRAM);
 
 			newPC->SetSerializationDir(snapshotDir);
+			newPC->SetSnapshotFile(snapshotFile.IsLoaded() ? &snapshotFile : nullptr);
 			newPC->Deserialize(snapshotData);
+			newPC->SetSnapshotFile(nullptr);
 		}
 		else
 		{
@@ -326,14 +351,6 @@ int main(int argc, char* args[])
 		}
 	}
 
-	bool breakpointEnabled = false;
-	emul::ADDRESS breakpoint = CONFIG().GetValueDWORD("monitor", "breakpoint", 0xFFFFFFFF);
-	if (breakpoint <= 0xFFFF)
-	{
-		breakpointEnabled = true;
-		fprintf(stderr, "Set Breakpoint to [0x%04X]\n", breakpoint);
-	}
-
 	customMemoryView = CONFIG().GetValueWORD("monitor", "custommem", 0);
 	fprintf(stderr, "Set Monitor Custom Memory View to [0x%04X]\n", customMemoryView);
 
@@ -358,15 +375,6 @@ int main(int argc, char* args[])
 	pc->Init(baseRAM);
 	InitPC(pc, overlay);
 
-	if (breakpointEnabled)
-	{
-		monitor->SetBreakpoint(breakpoint);
-	}
-	else
-	{
-		monitor->ClearBreakpoint();
-	}
-
 	if (mode == Mode::MONITOR)
 	{
 		ShowMonitor();
@@ -425,6 +433,12 @@ int main(int argc, char* args[])
 					break;
 				}
 
+				// In-memory snapshots for rewind, between instructions
+				if (pc->GetRewind())
+				{
+					pc->GetRewind()->Update();
+				}
+
 				if (mode != Mode::MONITOR && _kbhit())
 				{
 					BYTE keyCode;
@@ -472,6 +486,12 @@ int main(int argc, char* args[])
 							overlay.Show(showOverlay);
 							break;
 						case FKEY + 2:
+							if (pc->GetRewind())
+							{
+								fprintf(stderr, "Rewind\n");
+								pc->GetRewind()->Rewind(1);
+							}
+							break;
 						case FKEY + 3:
 						case FKEY + 4:
 							break;
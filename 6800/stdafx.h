@@ -17,7 +17,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
+#ifdef _WIN32
 #include <conio.h>
+#endif
 #include <exception>
 #include <cassert>
 #include <cstdint>
@@ -37,10 +39,17 @@
 #include <BitMask.h>
 #include <CPU/CPUCommon.h>
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
 #undef LoadCursor
+#else
+// Defined globally by windows.h
+using emul::BYTE;
+using emul::WORD;
+using emul::DWORD;
+#endif
 
 #pragma warning( disable:4251 )
 #pragma warning ( disable:26429 )
@@ -66,12 +66,12 @@ namespace emul::cpu68k
 		m_opcodes[0b0111] = [=]() { MOVEQ(); };
 		m_opcodes[0b1000] = [=]() { Exec(SubOpcodeGroup::b1000, GetSubopcode6()); }; // DIVU,DIVS,SBCD,OR
 		m_opcodes[0b1001] = [=]() { Exec(SubOpcodeGroup::b1001, GetSubopcode6()); }; // SUB,SUBX,SUBA
-		m_opcodes[0b1010] = [=]() { throw CPUException(VECTOR::Line1010Emulator); };
+		m_opcodes[0b1010] = [=]() { RaiseException(VECTOR::Line1010Emulator); };
 		m_opcodes[0b1011] = [=]() { Exec(SubOpcodeGroup::b1011, GetSubopcode6()); }; // EOR,CMPM,CMP,CMPA
 		m_opcodes[0b1100] = [=]() { Exec(SubOpcodeGroup::b1100, GetSubopcode6()); }; // MULU,MULS,ABCD,EXG,AND
 		m_opcodes[0b1101] = [=]() { Exec(SubOpcodeGroup::b1101, GetSubopcode6()); }; // ADD,ADDX,ADDA
 		m_opcodes[0b1110] = [=]() { SHIFT(); }; // Shift, Rotate
-		m_opcodes[0b1111] = [=]() { throw CPUException(VECTOR::Line1111Emulator); };
+		m_opcodes[0b1111] = [=]() { RaiseException(VECTOR::Line1111Emulator); };
 
 		InitGroupB0000(m_subOpcodes[(int)SubOpcodeGroup::b0000], 64);
 		InitGroupB0100(m_subOpcodes[(int)SubOpcodeGroup::b0100], 64);
@@ -82,7 +82,47 @@ namespace emul::cpu68k
 		InitGroupB1011(m_subOpcodes[(int)SubOpcodeGroup::b1011], 64);
 		InitGroupB1100(m_subOpcodes[(int)SubOpcodeGroup::b1100], 64);
 		InitGroupB1101(m_subOpcodes[(int)SubOpcodeGroup::b1101], 64);
-		InitGroupMisc(m_subOpcodes[(int)SubOpcodeGroup::misc], 56);
+		InitGroupMisc(m_subOpcodes[(int)SubOpcodeGroup::misc], 64);
+
+		InitDecodedTable();
+	}
+
+	void CPU68000::InitDecodedTable()
+	{
+		m_decoded.resize(65536);
+
+		for (size_t i = 0; i < m_decoded.size(); ++i)
+		{
+			const WORD opcode = (WORD)i;
+			DecodedOpcode& decoded = m_decoded[i];
+			decoded.func = &Decode(opcode);
+			decoded.timing = &m_info.GetOpcodeTiming((opcode >> 12) & 15);
+		}
+	}
+
+	// Same dispatch as the m_opcodes group functions, done ahead of time
+	const CPU68000::OpcodeTable::value_type& CPU68000::Decode(WORD opcode) const
+	{
+		const WORD opGroup = (opcode >> 12) & 15;
+		const WORD sub6 = (opcode >> 6) & 63;
+		const WORD sub4 = (opcode >> 8) & 15;
+		const WORD low6 = opcode & 63;
+
+		switch (opGroup)
+		{
+		case 0b0000: return m_subOpcodes[(int)SubOpcodeGroup::b0000][sub6];
+		case 0b0100: return (sub6 == 071) ?
+			m_subOpcodes[(int)SubOpcodeGroup::misc][low6] :
+			m_subOpcodes[(int)SubOpcodeGroup::b0100][sub6];
+		case 0b0101: return m_subOpcodes[(int)SubOpcodeGroup::b0101][sub6];
+		case 0b0110: return m_subOpcodes[(int)SubOpcodeGroup::b0110][sub4];
+		case 0b1000: return m_subOpcodes[(int)SubOpcodeGroup::b1000][sub6];
+		case 0b1001: return m_subOpcodes[(int)SubOpcodeGroup::b1001][sub6];
+		case 0b1011: return m_subOpcodes[(int)SubOpcodeGroup::b1011][sub6];
+		case 0b1100: return m_subOpcodes[(int)SubOpcodeGroup::b1100][sub6];
+		case 0b1101: return m_subOpcodes[(int)SubOpcodeGroup::b1101][sub6];
+		default: return m_opcodes[opGroup];
+		}
 	}
 
 	void CPU68000::InitTable(OpcodeTable& table, size_t size)
@@ -838,7 +878,7 @@ namespace emul::cpu68k
 		table[061] = [=]() { /* nothing */ }; // NOP
 		table[063] = [=]() { RTE(); }; // RTE
 		table[065] = [=]() { RTS(); }; // RTS
-		table[066] = [=]() { if (GetFlag(FLAG_V)) throw CPUException(VECTOR::TRAPV_Instruction); }; // TRAPV
+		table[066] = [=]() { if (GetFlag(FLAG_V)) RaiseException(VECTOR::TRAPV_Instruction); }; // TRAPV
 		table[067] = [=]() { RTR(); }; // RTR
 	}
 
@@ -948,6 +988,7 @@ namespace emul::cpu68k
 
 		// Execute instruction
 		WORD op = FetchWord();
+		m_lastOpcode = op;
 		Exec(op);
 
 		return (m_state == CPUState::RUN);
@@ -1007,16 +1048,13 @@ namespace emul::cpu68k
 		throw CPUException(VECTOR::IllegalInstruction);
 	}
 
-	void CPU68000::HandleException(const CPUException& e)
+	void CPU68000::HandleException(VECTOR v, ADDRESS addr)
 	{
 		// TODO: Temp
 		bool fatal = false;
 		int exceptionGroup = 2;
 
-		VECTOR v = e.GetVector();
-		ADDRESS addr = e.GetAddress();
-
-		switch (e.GetVector())
+		switch (v)
 		{
 		case VECTOR::AddressError:
 			LogPrintf(LOG_INFO, "CPU: Exception (%d)[Address error][%08X] at PC 0x%08X", v, addr, m_programCounter);
@@ -1083,23 +1121,27 @@ namespace emul::cpu68k
 	{
 		m_opcode = opcode;
 
-		// Get group from upper 4 bits
-		WORD opGroup = (opcode >> 12) & 15;
-
-		m_currTiming = &m_info.GetOpcodeTiming(opGroup);
+		const DecodedOpcode& decoded = m_decoded[opcode];
+		m_currTiming = decoded.timing;
 
 		try
 		{
 			// Fetch the function corresponding to the opcode and run it
+			(*decoded.func)();
+
+			if (m_exceptionPending)
 			{
-				auto& opFunc = m_opcodes[opGroup];
-				opFunc();
+				m_exceptionPending = false;
+				HandleException(m_exceptionVector, m_exceptionAddr);
+			}
+			else
+			{
+				TICK();
 			}
-
-			TICK();
 		}
 		catch (CPUException e)
 		{
+			m_exceptionPending = false;
 			HandleException(e);
 		}
 		catch (std::exception e)
@@ -1129,6 +1171,8 @@ namespace emul::cpu68k
 		SetFlag(FLAG_T, false); // Clear trace flag
 		SetInterruptMask(m_interruptLevel);
 
+		ProfileIRQ((BYTE)(GetIntVectorAddress(m_interruptLevel) / 4));
+
 		ADDRESS handler = Read<DWORD>(GetIntVectorAddress(m_interruptLevel));
 		PUSHl(m_programCounter);
 		PUSHw(flags);
@@ -1446,14 +1490,20 @@ namespace emul::cpu68k
 
 	void CPU68000::MOVEwToSR(WORD src)
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 
 		SetFlags(src);
 	}
 
 	void CPU68000::MOVEwFromSR()
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 
 		m_eaMode = GetEAMode(m_opcode);
 
@@ -1469,13 +1519,19 @@ namespace emul::cpu68k
 	}
 	void CPU68000::MOVEfromUSP(DWORD& dest)
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 
 		dest = GetUSP();
 	}
 	void CPU68000::MOVEtoUSP(DWORD src)
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 
 		GetUSP() = src;
 	}
@@ -1768,7 +1824,10 @@ namespace emul::cpu68k
 
 	void CPU68000::RTE()
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 		WORD flags = POPw();
 		ADDRESS addr = POPl();
 		SetFlags(flags);
@@ -1779,7 +1838,10 @@ namespace emul::cpu68k
 
 	void CPU68000::RTR()
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 		SetCC(GetLByte(POPw()));
 		m_programCounter = POPl();
 		Aligned(m_programCounter);
@@ -2013,7 +2075,10 @@ namespace emul::cpu68k
 
 	void CPU68000::ANDIwToSR()
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 
 		WORD imm = FetchWord();
 		WORD newFlags = m_reg.flags & imm;
@@ -2073,7 +2138,10 @@ namespace emul::cpu68k
 
 	void CPU68000::ORIwToSR()
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 
 		WORD imm = FetchWord();
 		WORD newFlags = m_reg.flags | imm;
@@ -2142,7 +2210,10 @@ namespace emul::cpu68k
 
 	void CPU68000::EORIwToSR()
 	{
-		Privileged();
+		if (!Privileged())
+		{
+			return;
+		}
 
 		WORD imm = FetchWord();
 		WORD newFlags = m_reg.flags ^ imm;
@@ -2186,12 +2257,14 @@ namespace emul::cpu68k
 		if (src < 0)
 		{
 			SetFlag(FLAG_N, true);
-			throw CPUException(VECTOR::CHK_Instruction);
+			RaiseException(VECTOR::CHK_Instruction);
+			return;
 		}
 		else if (src > upperBound)
 		{
 			SetFlag(FLAG_N, false);
-			throw CPUException(VECTOR::CHK_Instruction);
+			RaiseException(VECTOR::CHK_Instruction);
+			return;
 		}
 	}
 
@@ -3024,7 +3097,8 @@ namespace emul::cpu68k
 			SetFlag(FLAG_N, false);
 			SetFlag(FLAG_Z, false);
 
-			throw CPUException(VECTOR::ZeroDivide);
+			RaiseException(VECTOR::ZeroDivide);
+			return;
 		}
 
 		DWORD quotient = dest / src;
@@ -3056,7 +3130,8 @@ namespace emul::cpu68k
 			SetFlag(FLAG_N, false);
 			SetFlag(FLAG_Z, false);
 
-			throw CPUException(VECTOR::ZeroDivide);
+			RaiseException(VECTOR::ZeroDivide);
+			return;
 		}
 
 		int32_t sdest = (int32_t)dest;
@@ -4,6 +4,7 @@
 #include <CPU/CPU.h>
 #include <CPU/PortConnector.h>
 #include <CPU/CPUInfo.h>
+#include <CPU/OpcodeTable.h>
 #include <EdgeDetectLatch.h>
 
 #undef IN
@@ -89,6 +90,7 @@ namespace emul::cpu68k
 
 		virtual const std::string GetID() const override { return m_info.GetId(); };
 		virtual size_t GetAddressBits() const override { return CPU68000_ADDRESS_BITS; };
+		virtual size_t GetOpcodeCount() const override { return 65536; }
 		virtual ADDRESS GetCurrentAddress() const override { return m_programCounter & ADDRESS_MASK; }
 
 		DWORD GetRegData(int index) const { return m_reg.DATA[index]; }
@@ -109,7 +111,7 @@ namespace emul::cpu68k
 
 		emul::cpu68k::EventHandler* m_events = nullptr;
 
-		using OpcodeTable = std::vector<std::function<void()>>;
+		using OpcodeTable = std::vector<OpcodeHandler>;
 
 		void InitTable(OpcodeTable& table, size_t size);
 
@@ -138,6 +140,20 @@ namespace emul::cpu68k
 		void InitGroupB1101(OpcodeTable& table, size_t size);
 		void InitGroupMisc(OpcodeTable& table, size_t size);
 
+		// Pre-decoded opcode map, one entry per 16 bit opcode.
+		// Resolves the group/sub group dispatch once at init time so
+		// Exec() only needs a single lookup to find the leaf handler
+		// and its timing.
+		struct DecodedOpcode
+		{
+			const OpcodeTable::value_type* func = nullptr;
+			const cpuInfo::OpcodeTiming* timing = nullptr;
+		};
+		std::vector<DecodedOpcode> m_decoded;
+
+		void InitDecodedTable();
+		const OpcodeTable::value_type& Decode(WORD opcode) const;
+
 		inline void TICK() { m_opTicks += (*m_currTiming)[(int)cpuInfo::OpcodeTimingType::BASE]; };
 		inline void TICKn(int t) { m_opTicks += t; }
 
@@ -421,13 +437,25 @@ namespace emul::cpu68k
 			return rawGetEA<SIZE>();
 		}
 
-		void HandleException(const CPUException& e);
-		void Privileged() { if (!IsSupervisorMode()) throw CPUException(VECTOR::PrivilegeViolation); }
+		void HandleException(const CPUException& e) { HandleException(e.GetVector(), e.GetAddress()); }
+		void HandleException(VECTOR v, ADDRESS addr);
+
+		// Control flow exceptions (TRAP, CHK, divide by zero, privilege violation)
+		// are latched here and handled by Exec() when the opcode function returns.
+		// Address errors and illegal EA modes are raised deep in operand decoding
+		// and still go through CPUException
+		void RaiseException(VECTOR vect, ADDRESS addr = 0) { if (!m_exceptionPending) { m_exceptionPending = true; m_exceptionVector = vect; m_exceptionAddr = addr; } }
+		bool m_exceptionPending = false;
+		VECTOR m_exceptionVector = VECTOR::ResetSSP;
+		ADDRESS m_exceptionAddr = 0;
+
+		// Raises a privilege violation when not in supervisor mode, caller returns if false
+		bool Privileged() { if (!IsSupervisorMode()) { RaiseException(VECTOR::PrivilegeViolation); return false; } return true; }
 		void Aligned(ADDRESS addr) { if (!IsWordAligned(addr)) throw CPUException(VECTOR::AddressError, addr); }
 
 		// Opcodes
 
-		void TRAP(int trap) { throw CPUException(VECTOR::TrapBase, trap); }
+		void TRAP(int trap) { RaiseException(VECTOR::TrapBase, trap); }
 
 		void LEA(DWORD& dest);
 
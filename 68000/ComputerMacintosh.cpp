@@ -138,6 +138,20 @@ namespace emul
 		}
 	}
 
+	void ComputerMacintosh::OnInputAction(const events::InputRecord& action)
+	{
+		if (((events::InputAction)action.code == events::InputAction::FLOPPY_LOAD) && (action.unit < 2))
+		{
+			if (!GetFloppy(action.unit).LoadDiskImage(action.data.c_str()))
+			{
+				LogPrintf(LOG_ERROR, "Error loading image file: %s", action.data.c_str());
+			}
+			return;
+		}
+
+		ComputerBase::OnInputAction(action);
+	}
+
 	void ComputerMacintosh::InitVIA()
 	{
 		m_via.EnableLog(CONFIG().GetLogLevel("via"));
@@ -232,16 +246,14 @@ namespace emul
 
 		// Update speed every 10 PWM values
 		constexpr int PWM_SAMPLES = 10;
-		static WORD pwmData = 0;
-		static int pwmSamples = PWM_SAMPLES;
 
-		pwmData += PWMReverseLookup[GetLByte(m_sound.GetBufferWord()) & 63];
+		m_pwmData += PWMReverseLookup[GetLByte(m_sound.GetBufferWord()) & 63];
 
-		if (--pwmSamples == 0)
+		if (++m_pwmSamples == PWM_SAMPLES)
 		{
-			pwmSamples = PWM_SAMPLES;
-			SetFloppySpeed(pwmData);
-			pwmData = 0;
+			m_pwmSamples = 0;
+			SetFloppySpeed(m_pwmData);
+			m_pwmData = 0;
 		}
 	}
 
@@ -298,7 +310,7 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = GetCPU().GetInstructionTicks();
+		const uint32_t cpuTicks = GetCPU().GetInstructionTicks();
 
 		for (uint32_t i = 0; i < cpuTicks; ++i)
 		{
@@ -307,7 +319,7 @@ namespace emul
 			if (!m_turbo)
 			{
 				WORD sound = m_sound.IsEnabled() ? GetHByte(m_sound.GetBufferWord()) * m_via.GetSoundVolume() : 0;
-				SOUND().PlayMono(sound * 2);
+				SOUND().SetOutput(g_ticks, sound * 2);
 			}
 
 			GetInputs().Tick();
@@ -329,6 +341,12 @@ namespace emul
 
 			m_mouse.Tick();
 		}
+
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
+		}
+
 		return true;
 	}
 }
@@ -46,6 +46,8 @@ namespace emul
 		void InitVIA();
 		void InitSCC();
 		void InitFloppy();
+
+		virtual void OnInputAction(const events::InputRecord& action) override;
 		void InitMouse();
 
 		void InitVideo();
@@ -104,5 +106,9 @@ namespace emul
 		mouse::mac::DeviceMouseMac m_mouse;
 
 		sound::mac::SoundMac m_sound;
+
+		// Floppy motor speed PWM, accumulated over a few samples
+		WORD m_pwmData = 0;
+		int m_pwmSamples = 0;
 	};
 }
@@ -27,11 +27,10 @@ namespace via::mac
 		// Runs at 1/10 the rate of main clk
 		virtual void Tick() override
 		{
-			static int tickCooldown = TICK_DIVIDER;
-			if (--tickCooldown == 0)
+			if (--m_tickCooldown == 0)
 			{
 				Device6522::Tick();
-				tickCooldown = TICK_DIVIDER;
+				m_tickCooldown = TICK_DIVIDER;
 			}
 		}
 
@@ -133,6 +132,8 @@ namespace via::mac
 		bool m_headSelect = false;
 		bool m_romOverlayMode = false;
 
+		int m_tickCooldown = TICK_DIVIDER;
+
 		virtual void OnWritePort(VIAPort* src);
 
 		via::mac::EventHandler* m_events = nullptr;
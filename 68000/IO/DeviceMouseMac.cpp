@@ -31,7 +31,7 @@ namespace mouse::mac
 		else if (button == 3) // TODO:temp
 		{
 			SCCChannel& ch = m_scc->GetChannelA();
-			static bool dcd = ch.GetDCD();
+			bool dcd = ch.GetDCD();
 			dcd = !dcd;
 			ch.SetDCD(dcd);
 
@@ -93,12 +93,9 @@ namespace mouse::mac
 
 	void DeviceMouseMac::Tick()
 	{
-		constexpr static int COOLDOWN = 10000;
-		static int cooldown = COOLDOWN;
-
-		if (--cooldown == 0)
+		if (--m_cooldown == 0)
 		{
-			cooldown = COOLDOWN;
+			m_cooldown = COOLDOWN;
 
 			if (!m_mouseQueue.empty())
 			{
@@ -31,6 +31,10 @@ namespace mouse::mac
 		};
 		std::deque<MouseData> m_mouseQueue;
 
+		// Ticks between mouse queue updates
+		constexpr static int COOLDOWN = 10000;
+		int m_cooldown = COOLDOWN;
+
 		void PlotLine(int x0, int y0, int x1, int y1);
 
 		via::mac::Device6522Mac* m_via = nullptr;
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Monitor68000.h"
 #include "CPU/CPU68000.h"
+#include <CPU/CPUProfiler.h>
 
 using cpuInfo::Opcode;
 using cpuInfo::Coord;
@@ -209,8 +210,10 @@ namespace emul
 				Instruction decoded;
 				// Set breakpoint at next instruction
 				ADDRESS next = Disassemble(m_cpu->GetCurrentAddress(), decoded);
-				m_breakpointEnabled = true;
-				m_breakpoint = next;
+				if (m_cpu->GetBreakpoints())
+				{
+					m_cpu->GetBreakpoints()->AddExec(next, true);
+				}
 				m_runMode = RUNMode::RUN;
 				break;
 			}
@@ -219,21 +222,22 @@ namespace emul
 				m_cpu->Reset();
 				Update();
 				break;
+			case 64: // F6: Dump profiler data
+				if (m_cpu->GetProfiler())
+				{
+					m_cpu->GetProfiler()->Dump();
+				}
+				break;
+
 				// Not implemented, ignore
 			case 59: // F1
 			case 60: // F2
-			case 64: // F6
 			case 65: // F7
 				break;
 			case 67: // F9
-				if (IsBreakpoint())
+				if (m_cpu->GetBreakpoints())
 				{
-					m_breakpointEnabled = false;
-				}
-				else
-				{
-					m_breakpointEnabled = true;
-					m_breakpoint = m_cpu->GetCurrentAddress();
+					m_cpu->GetBreakpoints()->ToggleExec(m_cpu->GetCurrentAddress());
 				}
 				UpdateCode();
 				break;
@@ -247,6 +251,9 @@ namespace emul
 
 	MonitorState Monitor68000::Run()
 	{
+		// Monitor memory reads don't trigger watchpoints
+		Breakpoints::Suspend suspend(m_cpu->GetBreakpoints());
+
 		Update();
 		if (m_runMode == RUNMode::STEP)
 		{
@@ -258,6 +265,8 @@ namespace emul
 
 	void Monitor68000::Show()
 	{
+		Breakpoints::Suspend suspend(m_cpu->GetBreakpoints());
+
 		std::string ansiFile = m_cpu->GetInfo().GetANSIFile();
 
 		if (ansiFile.size())
@@ -556,7 +565,7 @@ namespace emul
 		// Write address
 		pos.x = addressPos.x;
 
-		bool isBreakpoint = m_breakpointEnabled && (instr.address == m_breakpoint);
+		bool isBreakpoint = m_cpu->GetBreakpoints() && m_cpu->GetBreakpoints()->IsExec(instr.address);
 
 		WriteValueHex24(instr.address, pos, isBreakpoint ? (4 << 4) | 15 : 8 );
 
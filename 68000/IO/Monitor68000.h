@@ -2,6 +2,7 @@
 
 #include <IO/Console.h>
 #include <CPU/Memory.h>
+#include <CPU/Breakpoints.h>
 #include <CPU/CPUInfo.h>
 #include "CPU/CPU68000.h"
 
@@ -40,9 +41,8 @@ namespace emul::cpu68k
 		virtual ADDRESS Disassemble(ADDRESS address, Monitor68000::Instruction& decoded);
 
 		void SetCustomMemoryView(ADDRESS address) { m_customMemView = address; }
-		void SetBreakpoint(ADDRESS address) { m_breakpoint = address; m_breakpointEnabled = true; }
-		void ClearBreakpoint() { m_breakpointEnabled = false; }
-		bool IsBreakpoint() const { return m_breakpointEnabled && m_cpu->GetCurrentAddress() == m_breakpoint; }
+		// Stop at breakpoint/watchpoint, call before each instruction
+		bool IsBreakpoint() { return m_cpu->GetBreakpoints() && m_cpu->GetBreakpoints()->IsBreak(m_cpu->GetCurrentAddress()); }
 
 		void Show();
 		MonitorState Run();
@@ -100,8 +100,6 @@ namespace emul::cpu68k
 		};
 
 		ADDRESS m_customMemView = 0;
-		ADDRESS m_breakpoint = 0;
-		bool m_breakpointEnabled = false;
 
 		MonitorState ProcessKey();
 
@@ -2,12 +2,14 @@
 
 #include <Config.h>
 #include <FileUtil.h>
+#include <SnapshotFile.h>
 #include <UI/MainWindow.h>
 #include "UI/OverlayMac.h"
 #include <Sound/Sound.h>
 
 #include <CPU/Memory.h>
 #include <CPU/MemoryBlock.h>
+#include <Computer/RewindBuffer.h>
 
 #include "IO/Console.h"
 #include "IO/Monitor68000.h"
@@ -51,7 +53,7 @@ using ui::MAINWND;
 using ui::Overlay;
 using ui::OverlayMac;
 
-size_t emul::g_ticks = 0;
+thread_local size_t emul::g_ticks = 0;
 
 hscommon::fileUtil::File logFile;
 
@@ -178,6 +180,13 @@ void InitPC(ComputerBase* pc, Overlay& overlay, bool reset = true)
 
 	monitor->Init(pc->GetCPU(), pc->GetMemory());
 
+	emul::ADDRESS breakpoint = CONFIG().GetValueDWORD("monitor", "breakpoint", 0xFFFFFF);
+	if (breakpoint <= 0xFFFFFF)
+	{
+		fprintf(stderr, "Set Breakpoint to [0x%06X]\n", breakpoint);
+		pc->GetBreakpoints().AddExec(breakpoint);
+	}
+
 	overlay.SetPC(pc);
 
 	pc->GetVideo().AddRenderer(&overlay);
@@ -238,12 +247,26 @@ ComputerBase* RestoreNewComputerFromSnapshot()
 	// continue with the old PC.
 	bool failureIsFatal = false;
 
-	// First, load the config file so we have the proper hardware
-	fs::path config = snapshotDir;
-	config.append("config.ini");
-	if (!CONFIG().LoadConfigFile(config.string().c_str()))
+	// First, load the config so we have the proper hardware.
+	// It's stored in the snapshot file (older snapshots: config.ini)
+	emul::SnapshotFile snapshotFile;
+	fs::path snapshotPath = snapshotDir;
+	snapshotPath.append(emul::SnapshotFile::FILE_NAME);
+	if (fs::exists(snapshotPath))
 	{
-		fprintf(stderr, "Unable to read config file %s, aborting\n", config.string().c_str());
+		if (!snapshotFile.Load(snapshotPath) || !snapshotFile.LoadConfig())
+		{
+			fprintf(stderr, "Unable to read config from snapshot %s, aborting\n", snapshotPath.string().c_str());
+		}
+	}
+	else
+	{
+		fs::path config = snapshotDir;
+		config.append("config.ini");
+		if (!CONFIG().LoadConfigFile(config.string().c_str()))
+		{
+			fprintf(stderr, "Unable to read config file %s, aborting\n", config.string().c_str());
+		}
 	}
 
 	std::string arch = CONFIG().GetValueStr("core", "arch");
@@ -261,7 +284,9 @@ ComputerBase* RestoreNewComputerFromSnapshot()
 			newPC->Init(baseRAM);
 
 			newPC->SetSerializationDir(snapshotDir);
+			newPC->SetSnapshotFile(snapshotFile.IsLoaded() ? &snapshotFile : nullptr);
 			newPC->Deserialize(snapshotData);
+			newPC->SetSnapshotFile(nullptr);
 		}
 		else
 		{
@@ -390,14 +415,6 @@ int main(int argc, char* argv[])
 		}
 	}
 
-	bool breakpointEnabled = false;
-	emul::ADDRESS breakpoint = CONFIG().GetValueDWORD("monitor", "breakpoint", 0xFFFFFF);
-	if (breakpoint <= 0xFFFFFF)
-	{
-		breakpointEnabled = true;
-		fprintf(stderr, "Set Breakpoint to [0x%06X]\n", breakpoint);
-	}
-
 	customMemoryView = CONFIG().GetValueDWORD("monitor", "custommem", 0);
 	fprintf(stderr, "Set Monitor Custom Memory View to [0x%06X]\n", customMemoryView);
 
@@ -422,15 +439,6 @@ int main(int argc, char* argv[])
 	pc->Init(baseRAM);
 	InitPC(pc, overlay);
 
-	if (breakpointEnabled)
-	{
-		monitor->SetBreakpoint(breakpoint);
-	}
-	else
-	{
-		monitor->ClearBreakpoint();
-	}
-
 	if (mode == Mode::MONITOR)
 	{
 		ShowMonitor();
@@ -489,6 +497,12 @@ int main(int argc, char* argv[])
 					break;
 				}
 
+				// In-memory snapshots for rewind, between instructions
+				if (pc->GetRewind())
+				{
+					pc->GetRewind()->Update();
+				}
+
 				if (mode != Mode::MONITOR && _kbhit())
 				{
 					BYTE keyCode;
@@ -536,6 +550,12 @@ int main(int argc, char* argv[])
 							overlay.Show(showOverlay);
 							break;
 						case FKEY + 2:
+							if (pc->GetRewind())
+							{
+								fprintf(stderr, "Rewind\n");
+								pc->GetRewind()->Rewind(1);
+							}
+							break;
 						case FKEY + 3:
 						case FKEY + 4:
 							break;
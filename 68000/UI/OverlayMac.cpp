@@ -131,6 +131,7 @@ namespace ui
 		}
 
 		m_floppyButton[drive]->SetText(os.str().c_str());
+		SetRedraw();
 	}
 
 	bool OverlayMac::Update()
@@ -144,7 +145,13 @@ namespace ui
 		{
 			if (const auto& floppy = GetPC()->GetFloppy(i); floppy.IsConnected())
 			{
-				m_floppyButton[i]->SetImage(floppy.IsActive() ? m_floppyActive : m_floppyInactive);
+				const bool active = floppy.IsActive();
+				m_floppyButton[i]->SetImage(active ? m_floppyActive : m_floppyInactive);
+				if (active != m_floppyLED[i])
+				{
+					m_floppyLED[i] = active;
+					SetRedraw();
+				}
 			}
 		}
 
@@ -154,6 +161,7 @@ namespace ui
 			m_mouseButton->SetImage(captured ? m_mouseCaptureOn : m_mouseCaptureOff);
 			m_mouseButton->SetPushed(captured);
 			m_mouseCaptured = captured;
+			SetRedraw();
 		}
 
 		return true;
@@ -176,7 +184,7 @@ namespace ui
 
 		if (SelectFile(diskImage, { {"Floppy disk image (*.img)", "*.img"} }))
 		{
-			floppy.LoadDiskImage(diskImage.string().c_str());
+			GetPC()->GetInputs().Action(events::InputAction::FLOPPY_LOAD, drive, 0, diskImage.string().c_str());
 		}
 		UpdateFloppy(drive);
 	}
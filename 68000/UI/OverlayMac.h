@@ -26,6 +26,7 @@ namespace ui
 		void LoadFloppyDiskImage(BYTE drive);
 
 		bool m_mouseCaptured = false;
+		bool m_floppyLED[2] = { false, false }; // Last displayed activity lights
 
 		// UI Elements
 
@@ -98,23 +98,29 @@ namespace emul
 		SourceDest16 sd = GetModRegRM16(op2);
 		if (sd.source.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
 
 		if (sd.source.GetOffset() >= 0xFFFD)
 		{
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
+			return;
 		}
 
 		int16_t value = (int16_t)sd.dest.Read();
 		int16_t lowBound = (int16_t)sd.source.Read();
 		sd.source.Increment();
 		int16_t hiBound = (int16_t)sd.source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		if (value < lowBound || value > hiBound)
 		{
 			// TODO: Push CS:IP of current instruction?
-			throw CPUException(CPUExceptionType::EX_BOUND);
+			RaiseFault(CPUExceptionType::EX_BOUND);
 		}
 	}
 
@@ -132,7 +138,11 @@ namespace emul
 			for (int i = 0; i < level - 1; ++i)
 			{
 				m_reg[REG16::BP] -= 2;
-				WORD ptr = m_memory.Read16(GetAddress(SegmentOffset(SEGREG::SS, m_reg[REG16::BP])));
+				WORD ptr = ReadMem16(SegmentOffset(SEGREG::SS, m_reg[REG16::BP]));
+				if (IsFaultPending())
+				{
+					return;
+				}
 				PUSH(ptr);
 				TICKT3(); // Add overhead for each level
 			}
@@ -183,6 +193,10 @@ namespace emul
 
 		Mem8 dest = GetModRM8(op2);
 		BYTE work = dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		BYTE count = FetchByte() & 31;
 
@@ -195,6 +209,10 @@ namespace emul
 
 		Mem16 dest = GetModRM16(op2);
 		WORD work = dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		BYTE count = FetchByte() & 31;
 
@@ -223,6 +241,10 @@ namespace emul
 	void CPU80186::_IMUL16imm(SourceDest16& sd, WORD imm)
 	{
 		WORD source = sd.source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		int32_t result = (int16_t)source * (int16_t)(imm);
 		LogPrintf(LOG_DEBUG, "IMUL16imm, %d * %d = %d", (int16_t)source, (int16_t)(imm), result);
@@ -248,6 +270,10 @@ namespace emul
 			BYTE val;
 			In(m_reg[REG16::DX], val);
 			dest.Write(val);
+			if (IsFaultPending())
+			{
+				return;
+			}
 
 			IndexIncDec(m_reg[REG16::DI]);
 		}
@@ -266,6 +292,10 @@ namespace emul
 			In(m_reg[REG16::DX], l);
 			In(m_reg[REG16::DX] + 1, h);
 			dest.Write(MakeWord(h, l));
+			if (IsFaultPending())
+			{
+				return;
+			}
 
 			IndexIncDec(m_reg[REG16::DI]);
 			IndexIncDec(m_reg[REG16::DI]);
@@ -279,7 +309,11 @@ namespace emul
 
 		if (PreREP())
 		{
-			BYTE val = m_memory.Read8(GetAddress(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI])));
+			BYTE val = ReadMem8(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]));
+			if (IsFaultPending())
+			{
+				return;
+			}
 
 			Out(m_reg[REG16::DX], val);
 
@@ -294,7 +328,11 @@ namespace emul
 
 		if (PreREP())
 		{
-			WORD val = m_memory.Read16(GetAddress(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI])));
+			WORD val = ReadMem16(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]));
+			if (IsFaultPending())
+			{
+				return;
+			}
 
 			Out(m_reg[REG16::DX], emul::GetLByte(val));
 			Out(m_reg[REG16::DX] + 1, emul::GetHByte(val));
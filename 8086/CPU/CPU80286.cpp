@@ -78,7 +78,8 @@ namespace emul
 
 		CPU80186::Init();
 
-		Mem16::CheckAlignment(true);
+		m_checkAlignment = true;
+		BindOperands();
 
 		FLAG_RESERVED_ON = FLAG(FLAG_R1);
 		// Real mode: iopl & nested task bits are locked to zero (and R15 apparently)
@@ -125,35 +126,18 @@ namespace emul
 
 	ADDRESS CPU80286::GetAddress(SegmentOffset segoff, MemAccess access) const
 	{
+		const SegmentTranslationRegister* reg = GetSegmentTranslationRegister((SEGREG286)segoff.segment);
+
+		// Real mode: no limit or access rights check
 		if (!IsProtectedMode())
 		{
-			access = MemAccess::NONE;
+			return reg->base + segoff.offset;
 		}
 
-		const auto reg = GetSegmentTranslationRegister((SEGREG286)segoff.segment);
-
-		if (IsProtectedMode() && ((reg->size == 0) || (segoff.offset > reg->size)))
+		if (!reg->IsAllowed(access) || (segoff.offset > reg->size))
 		{
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION, reg->selector);
-		}
-
-		switch(access)
-		{
-		case MemAccess::READ:
-			if (!reg->access.IsReadable())
-			{
-				throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION, reg->selector);
-			}
-			break;
-		case MemAccess::WRITE:
-			if (!reg->access.IsWritable())
-			{
-				throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION, reg->selector);
-			}
-			break;
-		default:
-			// No check
-			break;
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION, reg->selector);
+			return 0;
 		}
 
 		return reg->base + segoff.offset;
@@ -163,14 +147,16 @@ namespace emul
 	{
 		LogPrintf(LOG_DEBUG, "GetInterruptDescriptor[%d]", interrupt);
 
+		InterruptDescriptor desc;
+
 		if (interrupt >= m_idt.limit)
 		{
 			// TODO
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
+			return desc;
 		}
 		ADDRESS address = m_idt.base + (interrupt * 8);
 
-		InterruptDescriptor desc;
 		desc.offset = m_memory.Read16(address);
 		desc.selector = m_memory.Read16(address + 2);
 		desc.flags = m_memory.Read8(address + 5);
@@ -178,7 +164,7 @@ namespace emul
 		if (!desc.IsGateTypeValid())
 		{
 			// TODO
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
 		}
 
 		return desc;
@@ -243,7 +229,8 @@ namespace emul
 		if (selector.GetIndex() >= m_gdt.limit)
 		{
 			// TODO
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
+			return desc;
 		}
 		ADDRESS address = m_gdt.base + (selector.GetIndex() * 8);
 
@@ -265,6 +252,7 @@ namespace emul
 		reg->base = desc.base;
 		reg->access = desc.access;
 		reg->selector = selector;
+		reg->Digest();
 	}
 
 	void CPU80286::ProtectedMode()
@@ -297,6 +285,10 @@ namespace emul
 
 		Selector source = sd.source.Read();
 		Selector dest = sd.dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		if (dest.GetRPL() < source.GetRPL())
 		{
@@ -394,23 +386,34 @@ namespace emul
 
 		if (m_iopl != 0)
 		{
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
+			return;
 		}
 
 		Selector sel = source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		SegmentDescriptor desc = LoadSegmentGlobal(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
 		LogPrintf(LOG_DEBUG, desc.ToString());
 
 		if (!sel.IsNull())
 		{
 			if (!desc.access.IsLDT())
 			{
-				throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION, sel);
+				RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION, sel);
+				return;
 			}
 			if (!desc.access.IsPresent())
 			{
-				throw CPUException(CPUExceptionType::EX_NOT_PRESENT, sel);
+				RaiseFault(CPUExceptionType::EX_NOT_PRESENT, sel);
+				return;
 			}
 		}
 
@@ -424,23 +427,34 @@ namespace emul
 
 		if (m_iopl != 0)
 		{
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
+			return;
 		}
 
 		Selector sel = source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		SegmentDescriptor desc = LoadSegmentGlobal(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
 		LogPrintf(LOG_DEBUG, desc.ToString());
 
 		if (!sel.IsNull())
 		{
 			if (!desc.access.IsTask() || desc.access.IsTaskBusy())
 			{
-				throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION, sel);
+				RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION, sel);
+				return;
 			}
 			if (!desc.access.IsPresent())
 			{
-				throw CPUException(CPUExceptionType::EX_NOT_PRESENT, sel);
+				RaiseFault(CPUExceptionType::EX_NOT_PRESENT, sel);
+				return;
 			}
 		}
 
@@ -457,34 +471,38 @@ namespace emul
 
 		Selector sel = source.Read();
 
-		// From here, no error should be thrown, result is in ZF
-		try
+		if (IsFaultPending())
 		{
-			// 1. Bound check, done in LoadSegment
-			SegmentDescriptor desc = LoadSegment(sel);
-
-			// 2. Must be code or data segment
-			if (!desc.access.IsCodeOrData())
-			{
-				return;
-			}
-
-			// 3. Segment must be readable
-			if (!desc.access.IsReadable())
-			{
-				return;
-			}
+			return;
+		}
 
-			// 4. Privilege level... TODO
+		// From here, descriptor faults are not delivered, result is in ZF
+		// 1. Bound check, done in LoadSegment
+		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			// Nothing to do, ZF is already cleared
+			ClearFault();
+			return;
+		}
 
-			// Everything checks out
-			SetFlag(FLAG_Z, true);
-			LogPrintf(LOG_DEBUG, "VERR: OK");
+		// 2. Must be code or data segment
+		if (!desc.access.IsCodeOrData())
+		{
+			return;
 		}
-		catch (CPUException)
+
+		// 3. Segment must be readable
+		if (!desc.access.IsReadable())
 		{
-			// Nothing to do, ZF is alredy cleared
+			return;
 		}
+
+		// 4. Privilege level... TODO
+
+		// Everything checks out
+		SetFlag(FLAG_Z, true);
+		LogPrintf(LOG_DEBUG, "VERR: OK");
 	}
 
 	// Verify Write
@@ -497,41 +515,46 @@ namespace emul
 
 		Selector sel = source.Read();
 
-		// From here, no error should be thrown, result is in ZF
-		try
+		if (IsFaultPending())
 		{
-			// 1. Bound check, done in LoadSegment
-			SegmentDescriptor desc = LoadSegment(sel);
-
-			// 2. Must be code or data segment
-			if (!desc.access.IsCodeOrData())
-			{
-				return;
-			}
-
-			// 3. Segment must be writable
-			if (!desc.access.IsWritable())
-			{
-				return;
-			}
+			return;
+		}
 
-			// 4. Privilege level... TODO
+		// From here, descriptor faults are not delivered, result is in ZF
+		// 1. Bound check, done in LoadSegment
+		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			// Nothing to do, ZF is already cleared
+			ClearFault();
+			return;
+		}
 
-			// Everything checks out
-			SetFlag(FLAG_Z, true);
-			LogPrintf(LOG_DEBUG, "VERW: OK");
+		// 2. Must be code or data segment
+		if (!desc.access.IsCodeOrData())
+		{
+			return;
 		}
-		catch (CPUException)
+
+		// 3. Segment must be writable
+		if (!desc.access.IsWritable())
 		{
-			// Nothing to do, ZF is alredy cleared
+			return;
 		}
+
+		// 4. Privilege level... TODO
+
+		// Everything checks out
+		SetFlag(FLAG_Z, true);
+		LogPrintf(LOG_DEBUG, "VERW: OK");
 	}
 
 	void CPU80286::SGDT(Mem16& dest)
 	{
 		if (dest.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
 
 		dest.Write(m_gdt.limit);
@@ -546,7 +569,8 @@ namespace emul
 	{
 		if (dest.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
 
 		dest.Write(m_idt.limit);
@@ -561,14 +585,23 @@ namespace emul
 	{
 		if (source.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
 
-		m_gdt.limit = source.Read();
+		const WORD limit = source.Read();
 		source.Increment();
-		SetLWord(m_gdt.base, source.Read());
+		const WORD baseL = source.Read();
 		source.Increment();
-		SetHWord(m_gdt.base, source.Read());
+		const WORD baseH = source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_gdt.limit = limit;
+		SetLWord(m_gdt.base, baseL);
+		SetHWord(m_gdt.base, baseH);
 
 		LogPrintf(LOG_DEBUG, "LGDT: %s", m_gdt.ToString());
 	}
@@ -576,14 +609,23 @@ namespace emul
 	{
 		if (source.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
 
-		m_idt.limit = source.Read();
+		const WORD limit = source.Read();
 		source.Increment();
-		SetLWord(m_idt.base, source.Read());
+		const WORD baseL = source.Read();
 		source.Increment();
-		SetHWord(m_idt.base, source.Read());
+		const WORD baseH = source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_idt.limit = limit;
+		SetLWord(m_idt.base, baseL);
+		SetHWord(m_idt.base, baseH);
 
 		LogPrintf(LOG_DEBUG, "LIDT: %s", m_gdt.ToString());
 	}
@@ -598,6 +640,10 @@ namespace emul
 	{
 		LogPrintf(LOG_DEBUG, "LMSW");
 		WORD value = source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		SetBitMask(value, MSW_RESERVED_ON, true);
 
 		bool protectedMode = IsProtectedMode();
@@ -635,30 +681,34 @@ namespace emul
 
 		Selector sel = sd.source.Read();
 
-		// From here, no error should be thrown, result is in ZF
-		try
+		if (IsFaultPending())
 		{
-			SegmentDescriptor desc = LoadSegment(sel);
-
-			// These check probably need to happen in LoadSegment
-			BYTE dpl = desc.access.GetDPL();
-			if (dpl < m_iopl || dpl < sel.GetRPL())
-			{
-				return;
-			}
-
-			WORD ret = 0;
-			SetHByte(ret, desc.access);
-			sd.dest.Write(ret);
+			return;
+		}
 
-			// Everything checks out
-			SetFlag(FLAG_Z, true);
-			LogPrintf(LOG_DEBUG, "LAR: OK");
+		// From here, descriptor faults are not delivered, result is in ZF
+		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			// Nothing to do, ZF is already cleared
+			ClearFault();
+			return;
 		}
-		catch (CPUException)
+
+		// These check probably need to happen in LoadSegment
+		BYTE dpl = desc.access.GetDPL();
+		if (dpl < m_iopl || dpl < sel.GetRPL())
 		{
-			// Nothing to do, ZF is alredy cleared
+			return;
 		}
+
+		WORD ret = 0;
+		SetHByte(ret, desc.access);
+		sd.dest.Write(ret);
+
+		// Everything checks out
+		SetFlag(FLAG_Z, true);
+		LogPrintf(LOG_DEBUG, "LAR: OK");
 	}
 	void CPU80286::LSL(SourceDest16 sd)
 	{
@@ -675,34 +725,38 @@ namespace emul
 
 		Selector sel = sd.source.Read();
 
-		// From here, no error should be thrown, result is in ZF
-		try
+		if (IsFaultPending())
 		{
-			SegmentDescriptor desc = LoadSegment(sel);
-
-			// These check probably need to happen in LoadSegment
-			BYTE dpl = desc.access.GetDPL();
-			if (dpl < m_iopl || dpl < sel.GetRPL())
-			{
-				return;
-			}
-
-			if (desc.access.IsConforming())
-			{
-				return;
-			}
+			return;
+		}
 
-			WORD ret = desc.limit;
-			sd.dest.Write(ret);
+		// From here, descriptor faults are not delivered, result is in ZF
+		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			// Nothing to do, ZF is already cleared
+			ClearFault();
+			return;
+		}
 
-			// Everything checks out
-			SetFlag(FLAG_Z, true);
-			LogPrintf(LOG_DEBUG, "LSL: OK");
+		// These check probably need to happen in LoadSegment
+		BYTE dpl = desc.access.GetDPL();
+		if (dpl < m_iopl || dpl < sel.GetRPL())
+		{
+			return;
 		}
-		catch (CPUException)
+
+		if (desc.access.IsConforming())
 		{
-			// Nothing to do, ZF is alredy cleared
+			return;
 		}
+
+		WORD ret = desc.limit;
+		sd.dest.Write(ret);
+
+		// Everything checks out
+		SetFlag(FLAG_Z, true);
+		LogPrintf(LOG_DEBUG, "LSL: OK");
 	}
 
 	void CPU80286::LoadTranslationDescriptor(SEGREG286 dest, Selector selector, ADDRESS base)
@@ -715,6 +769,7 @@ namespace emul
 		emul::SetHWord(reg->base, baseH);
 		reg->access = m_memory.Read8(base + 3);
 		reg->size = m_memory.Read16(base + 4);
+		reg->Digest();
 	}
 
 	void CPU80286::LOADALL()
@@ -785,12 +840,14 @@ namespace emul
 
 		if (modRegRm.source.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
 
 		if (modRegRm.source.GetOffset() == 0xFFFD)
 		{
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
+			return;
 		}
 
 		if (IsProtectedMode())
@@ -798,13 +855,22 @@ namespace emul
 			CPU::TICK(15); // TODO: Dynamic timings
 		}
 
-		// Target register -> offset
-		modRegRm.dest.Write(modRegRm.source.Read());
-
-		// Read segment
+		const WORD offset = modRegRm.source.Read();
 		modRegRm.source.Increment();
 		Selector sel = modRegRm.source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
 		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		// Target register -> offset
+		modRegRm.dest.Write(offset);
 
 		UpdateTranslationRegister((SEGREG286)dest, sel, desc);
 	}
@@ -815,26 +881,40 @@ namespace emul
 		Selector sel = FetchWord();
 		LogPrintf(LOG_DEBUG, "CALLfar %02X|%02X", sel, offset);
 
+		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
+
 		PUSH(REG16::CS);
 		PUSH(REG16::IP);
 
 		m_reg[REG16::IP] = offset;
-
-		SegmentDescriptor desc = LoadSegment(sel);
 		UpdateTranslationRegister(SEGREG286::CS, sel, desc);
 	}
 
 	void CPU80286::CALLInter(Mem16 destPtr)
 	{
-		PUSH(REG16::CS);
-		PUSH(REG16::IP);
-
-		m_reg[REG16::IP] = destPtr.Read();
+		const WORD offset = destPtr.Read();
 		destPtr.Increment();
 		Selector sel = destPtr.Read();
-		LogPrintf(LOG_DEBUG, "CALLInter newCS=%04X, newIP=%04X", sel, m_reg[REG16::IP]);
+		if (IsFaultPending())
+		{
+			return;
+		}
+		LogPrintf(LOG_DEBUG, "CALLInter newCS=%04X, newIP=%04X", sel, offset);
 
 		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		PUSH(REG16::CS);
+		PUSH(REG16::IP);
+
+		m_reg[REG16::IP] = offset;
 		UpdateTranslationRegister(SEGREG286::CS, sel, desc);
 	}
 
@@ -844,9 +924,13 @@ namespace emul
 		Selector sel = FetchWord();
 		LogPrintf(LOG_DEBUG, "JMPfar %02X|%02X", sel, offset);
 
-		m_reg[REG16::IP] = offset;
-
 		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_reg[REG16::IP] = offset;
 		UpdateTranslationRegister(SEGREG286::CS, sel, desc);
 	}
 
@@ -854,15 +938,26 @@ namespace emul
 	{
 		if (destPtr.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
-		m_reg[REG16::IP] = destPtr.Read();
+		const WORD offset = destPtr.Read();
 		destPtr.Increment();
 
 		Selector sel = destPtr.Read();
-		LogPrintf(LOG_DEBUG, "JMPInter newCS=%04X, newIP=%04X", sel, m_reg[REG16::IP]);
+		if (IsFaultPending())
+		{
+			return;
+		}
+		LogPrintf(LOG_DEBUG, "JMPInter newCS=%04X, newIP=%04X", sel, offset);
 
 		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_reg[REG16::IP] = offset;
 		UpdateTranslationRegister(SEGREG286::CS, sel, desc);
 	}
 
@@ -870,11 +965,21 @@ namespace emul
 	{
 		LogPrintf(LOG_DEBUG, "RETFar [%s][%d]", pop ? "Pop" : "NoPop", value);
 
-		POP(REG16::IP);
+		const WORD offset = POP();
 		Selector sel = POP();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		m_reg[REG16::SP] += value;
 
 		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_reg[REG16::IP] = offset;
 		UpdateTranslationRegister(SEGREG286::CS, sel, desc);
 	}
 
@@ -896,7 +1001,15 @@ namespace emul
 		if (IsProtectedMode())
 		{
 			InterruptDescriptor intDesc = GetInterruptDescriptor(interrupt);
+			if (IsFaultPending())
+			{
+				return;
+			}
 			SegmentDescriptor segDesc = LoadSegment(intDesc.selector);
+			if (IsFaultPending())
+			{
+				return;
+			}
 			UpdateTranslationRegister(SEGREG286::CS, intDesc.selector, segDesc);
 
 			m_reg[REG16::IP] = intDesc.offset;
@@ -906,6 +1019,10 @@ namespace emul
 			ADDRESS interruptAddress = interrupt * 4;
 			Selector sel = m_memory.Read16(interruptAddress + 2);
 			SegmentDescriptor desc = LoadSegment(sel);
+			if (IsFaultPending())
+			{
+				return;
+			}
 			UpdateTranslationRegister(SEGREG286::CS, sel, desc);
 
 			m_reg[REG16::IP] = m_memory.Read16(interruptAddress);
@@ -915,11 +1032,22 @@ namespace emul
 	void CPU80286::IRET()
 	{
 		LogPrintf(LOG_DEBUG, "IRET");
-		POP(REG16::IP);
+		const WORD offset = POP();
 		Selector sel = POP();
-		POPF();
+		const WORD flags = POP();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_reg[REG16::IP] = offset;
+		SetFlags(flags);
 		UpdateTranslationRegister(SEGREG286::CS, sel, desc);
 	}
 
@@ -951,7 +1079,16 @@ namespace emul
 		}
 
 		Selector sel = sd.source.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
 		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		SEGREG segreg = (SEGREG)sd.dest.GetRegister();
 		switch (segreg)
@@ -995,7 +1132,16 @@ namespace emul
 		}
 
 		Selector sel = POP();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
 		SegmentDescriptor desc = LoadSegment(sel);
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		switch (segreg)
 		{
@@ -1035,6 +1181,7 @@ namespace emul
 		access = (BYTE)from["access"];
 		base = from["base"];
 		size = from["size"];
+		Digest();
 	}
 
 	void CPU80286::Serialize(json& to)
@@ -96,6 +96,9 @@ namespace emul
 		const char* ToString() const;
 	};
 
+	// Segment descriptor cache, lives in the register block (see REG16).
+	// Access rights and limit are digested into one bit per MemAccess type
+	// when the descriptor is loaded, GetAddress only tests that bit
 	struct SegmentTranslationRegister
 	{
 		Selector selector;
@@ -103,11 +106,30 @@ namespace emul
 		DWORD base = 0;
 		WORD size = 0;
 
+		// Bit n set: MemAccess n allowed. Zero limit is treated as an invalid segment
+		BYTE allowed = 0;
+
+		// Call when access or size changes
+		void Digest()
+		{
+			allowed = 0;
+			if (size != 0)
+			{
+				SetBit(allowed, (int)MemAccess::NONE, true);
+				SetBit(allowed, (int)MemAccess::READ, access.IsReadable());
+				SetBit(allowed, (int)MemAccess::WRITE, access.IsWritable());
+			}
+		}
+		bool IsAllowed(MemAccess a) const { return GetBit(allowed, (int)a); }
+
 		// Don't derive from Serializable so we remain a POD
 		void Serialize(json& to);
 		void Deserialize(const json& from);
 	};
 
+	// Must fit in the space between segment registers
+	static_assert(sizeof(SegmentTranslationRegister) <= 8 * sizeof(WORD));
+
 	struct InterruptDescriptor
 	{
 		WORD offset = 0;
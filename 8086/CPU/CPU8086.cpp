@@ -30,23 +30,55 @@ namespace emul
 	DWORD rawXor16(WORD& dest, const WORD src, bool) { dest ^= src; return dest; }
 	DWORD rawTest16(WORD& dest, const WORD src, bool) { return dest & src; }
 
-	CPU8086* Mem8::m_cpu = nullptr;
-	Memory* Mem8::m_memory = nullptr;
-	Registers* Mem8::m_registers = nullptr;
+	thread_local CPU8086* Mem8::m_cpu = nullptr;
+	thread_local Memory* Mem8::m_memory = nullptr;
+	thread_local Registers* Mem8::m_registers = nullptr;
 
-	Memory* Mem16::m_memory = nullptr;
-	Registers* Mem16::m_registers = nullptr;
-	bool Mem16::m_checkAlignment = false;
+	thread_local CPU8086* Mem16::m_cpu = nullptr;
+	thread_local Memory* Mem16::m_memory = nullptr;
+	thread_local Registers* Mem16::m_registers = nullptr;
+	thread_local bool Mem16::m_checkAlignment = false;
 
 	BYTE GetOP2(BYTE op2) { return (op2 >> 3) & 7; }
 
 	BYTE Mem8::Read() const
 	{
-		return (int)m_reg8 ? m_registers->Read8(m_reg8) : m_memory->Read8(m_cpu->GetAddress(m_segOff, MemAccess::READ));
+		if ((int)m_reg8)
+		{
+			return m_registers->Read8(m_reg8);
+		}
+
+		const ADDRESS address = m_cpu->GetAddress(m_segOff, MemAccess::READ);
+		return m_cpu->IsFaultPending() ? 0xFF : m_memory->Read8(address);
 	}
 	void Mem8::Write(BYTE value)
 	{
-		(int)m_reg8 ? m_registers->Write8(m_reg8, value) : m_memory->Write8(m_cpu->GetAddress(m_segOff, MemAccess::WRITE), value);
+		// Nothing is written after a fault
+		if (m_cpu->IsFaultPending())
+		{
+			return;
+		}
+
+		if ((int)m_reg8)
+		{
+			m_registers->Write8(m_reg8, value);
+			return;
+		}
+
+		const ADDRESS address = m_cpu->GetAddress(m_segOff, MemAccess::WRITE);
+		if (!m_cpu->IsFaultPending())
+		{
+			m_memory->Write8(address, value);
+		}
+	}
+	void Mem8::RaiseFault(CPUExceptionType type)
+	{
+		m_cpu->RaiseFault(type);
+	}
+
+	void Mem16::RaiseFault(CPUExceptionType type)
+	{
+		m_cpu->RaiseFault(type);
 	}
 
 	CPU8086::CPU8086(Memory& memory) : CPU8086("8086", memory)
@@ -58,8 +90,7 @@ namespace emul
 		m_info(cpuid),
 		Logger(cpuid)
 	{
-		Mem8::Init(this, &memory, &m_reg);
-		Mem16::Init(&memory, &m_reg);
+		BindOperands();
 
 		try
 		{
@@ -505,9 +536,9 @@ namespace emul
 		// MOV
 		// ----------
 		// MOV AL, MEM8
-		m_opcodes[0xA0] = [=]() { MOV8(REG8::AL, m_memory.Read8(GetAddress(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, FetchWord())))); };
+		m_opcodes[0xA0] = [=]() { MOV8(REG8::AL, ReadMem8(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, FetchWord()))); };
 		// MOV AX, MEM16
-		m_opcodes[0xA1] = [=]() { MOV16(REG16::AX, m_memory.Read16(GetAddress(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, FetchWord())))); };
+		m_opcodes[0xA1] = [=]() { MOV16(REG16::AX, ReadMem16(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, FetchWord()))); };
 
 		// MOV
 		// ----------
@@ -621,11 +652,11 @@ namespace emul
 		m_opcodes[0xCB] = [=]() { RETFar(); };
 
 		// INT3
-		m_opcodes[0xCC] = [=]() { throw CPUException(CPUExceptionType::EX_BREAKPOINT); };
+		m_opcodes[0xCC] = [=]() { RaiseFault(CPUExceptionType::EX_BREAKPOINT); };
 		// INT IMM8
 		m_opcodes[0xCD] = [=]() { INT(FetchByte()); };
 		// INTO
-		m_opcodes[0xCE] = [=]() { if (GetFlag(FLAG_O)) { TICKT3(); throw CPUException(CPUExceptionType::EX_OVERFLOW); } };
+		m_opcodes[0xCE] = [=]() { if (GetFlag(FLAG_O)) { TICKT3(); RaiseFault(CPUExceptionType::EX_OVERFLOW); } };
 		// IRET
 		m_opcodes[0xCF] = [=]() { IRET(); };
 
@@ -752,8 +783,19 @@ namespace emul
 		m_opcodes[0xFF] = [=]() { MultiFunc(FetchByte()); };
 	}
 
+	void CPU8086::BindOperands()
+	{
+		Mem8::Init(this, &m_memory, &m_reg);
+		Mem16::Init(this, &m_memory, &m_reg, m_checkAlignment);
+	}
+
 	bool CPU8086::Step()
 	{
+		if (!Mem8::IsBound(this))
+		{
+			BindOperands();
+		}
+
 		bool ret = true;
 		if (m_state != CPUState::HALT)
 		{
@@ -761,7 +803,10 @@ namespace emul
 			// TODO: Other prefixes
 			if (ret && inSegOverride)
 			{
+				// CPU::Step() resets the tick count, keep the prefix ticks
+				const uint32_t prefixTicks = m_opTicks;
 				ret = CPU::Step();
+				m_opTicks += prefixTicks;
 			}
 		}
 
@@ -775,9 +820,16 @@ namespace emul
 		{
 			assert(!inSegOverride);
 			TICKMISC(MiscTiming::IRQ);
+			ProfileIRQ((BYTE)m_irqPending);
 			INT(m_irqPending);
 			m_irqPending = -1;
 			m_state = CPUState::RUN;
+
+			// Fault while dispatching the interrupt (protected mode)
+			if (IsFaultPending())
+			{
+				DeliverFault();
+			}
 		}
 
 		return ret;
@@ -794,14 +846,15 @@ namespace emul
 
 		m_currTiming = &m_info.GetOpcodeTiming(opcode);
 
-		try
+		// Fetch the function corresponding to the opcode and run it
 		{
-			// Fetch the function corresponding to the opcode and run it
-			{
-				auto& opFunc = m_opcodes[opcode];
-				opFunc();
-			}
+			auto& opFunc = m_opcodes[opcode];
+			opFunc();
+		}
 
+		// Faulting instructions are not completed
+		if (!IsFaultPending())
+		{
 			TICK();
 
 			// Disable override after next instruction
@@ -815,12 +868,29 @@ namespace emul
 			{
 				LogPrintf(LOG_INFO, "TRAP AT CS=%04X, IP=%04X", m_reg[REG16::CS], m_reg[REG16::IP]);
 				TICKMISC(MiscTiming::TRAP);
-				throw CPUException(CPUExceptionType::EX_STEP);
+				RaiseFault(CPUExceptionType::EX_STEP);
 			}
 		}
-		catch (CPUException e)
+
+		if (IsFaultPending())
+		{
+			DeliverFault();
+		}
+	}
+
+	void CPU8086::DeliverFault()
+	{
+		const CPUException fault = m_fault;
+		ClearFault();
+
+		CPUExceptionHandler(fault);
+
+		if (IsFaultPending())
 		{
-			CPUExceptionHandler(e);
+			EnableLog(LOG_ERROR);
+			LogPrintf(LOG_ERROR, "Fault [%d] while handling fault [%d] at 0x%04X! Stopping CPU.", m_fault.GetType(), fault.GetType(), GetCurrentAddress());
+			ClearFault();
+			m_state = CPUState::STOP;
 		}
 	}
 
@@ -1276,12 +1346,19 @@ namespace emul
 
 	void CPU8086::CALLInter(Mem16 destPtr)
 	{
+		const WORD offset = destPtr.Read();
+		destPtr.Increment();
+		const WORD segment = destPtr.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
 		PUSH(REG16::CS);
 		PUSH(REG16::IP);
 
-		m_reg[REG16::IP] = destPtr.Read();
-		destPtr.Increment();
-		m_reg[REG16::CS] = destPtr.Read();
+		m_reg[REG16::IP] = offset;
+		m_reg[REG16::CS] = segment;
 		LogPrintf(LOG_DEBUG, "CALLInter newCS=%04X, newIP=%04X", m_reg[REG16::CS], m_reg[REG16::IP]);
 	}
 
@@ -1315,18 +1392,26 @@ namespace emul
 	{
 		if (destPtr.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
-		m_reg[REG16::IP] = destPtr.Read();
+		const WORD offset = destPtr.Read();
 		destPtr.Increment();
-		m_reg[REG16::CS] = destPtr.Read();
+		const WORD segment = destPtr.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_reg[REG16::IP] = offset;
+		m_reg[REG16::CS] = segment;
 		LogPrintf(LOG_DEBUG, "JMPInter newCS=%04X, newIP=%04X", m_reg[REG16::CS], m_reg[REG16::IP]);
 	}
 
 	void CPU8086::InvalidOpcode()
 	{
 		LogPrintf(LOG_ERROR, "TRAP: Invalid opcode [%02x] @ %08x", m_opcode, GetCurrentAddress());
-		throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+		RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
 	}
 
 	void CPU8086::NotImplemented()
@@ -1361,8 +1446,16 @@ namespace emul
 	{
 		LogPrintf(LOG_DEBUG, "INC8");
 		BYTE before = b.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		BYTE after = before + 1;
 		b.Write(after);
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		SetFlag(FLAG_O, (!GetMSB(before) && GetMSB(after)));
 		AdjustSign(after);
@@ -1377,8 +1470,16 @@ namespace emul
 	{
 		LogPrintf(LOG_DEBUG, "DEC8");
 		BYTE before = b.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		BYTE after = before - 1;
 		b.Write(after);
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		SetFlag(FLAG_O, (GetMSB(before) && !GetMSB(after)));
 		AdjustSign(after);
@@ -1550,6 +1651,10 @@ namespace emul
 
 		Mem8 dest = GetModRM8(op2);
 		BYTE work = dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		work = _SHIFTROT8(work, op2, 1);
 		dest.Write(work);
 	}
@@ -1561,6 +1666,10 @@ namespace emul
 		BYTE count = m_reg[REG8::CL] & mask;
 		Mem8 dest = GetModRM8(op2);
 		BYTE work = dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		work = _SHIFTROT8(work, op2, count);
 		dest.Write(work);
 	}
@@ -1640,6 +1749,10 @@ namespace emul
 
 		Mem16 dest = GetModRM16(op2);
 		WORD work = dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		work = _SHIFTROT16(work, op2, 1);
 		dest.Write(work);
 	}
@@ -1651,6 +1764,10 @@ namespace emul
 		BYTE count = m_reg[REG8::CL] & mask;
 		Mem16 dest = GetModRM16(op2);
 		WORD work = dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		work = _SHIFTROT16(work, op2, count);
 		dest.Write(work);
 	}
@@ -1660,17 +1777,25 @@ namespace emul
 		// Aliases
 		const BYTE source = sd.source.Read();
 		BYTE dest = sd.dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		// AC Calculation
 		const BYTE source4 = source & 0x0F;
 		BYTE dest4 = dest & 0x0F;
 		WORD after4 = func(dest4, source4, GetFlag(FLAG_C));
-		SetFlag(FLAG_A, after4 > 0x0F);
 
 		BYTE before = dest;
 		WORD after = func(dest, source, GetFlag(FLAG_C));
 		BYTE afterB = (BYTE)after;
 		sd.dest.Write(dest);
+		if (IsFaultPending())
+		{
+			return;
+		}
+		SetFlag(FLAG_A, after4 > 0x0F);
 		SetFlag(FLAG_C, after > 0xFF);
 
 		// TODO: improve this
@@ -1702,17 +1827,25 @@ namespace emul
 		// Aliases
 		const WORD source = sd.source.Read();
 		WORD dest = sd.dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		// AC Calculations
 		const WORD source4 = source & 0x0F;
 		WORD dest4 = dest & 0x0F;
 		WORD after4 = func(dest4, source4, GetFlag(FLAG_C));
-		SetFlag(FLAG_A, after4 > 0x0F);
 
 		WORD before = dest;
 		DWORD after = func(dest, source, GetFlag(FLAG_C));
 		WORD afterW = (WORD)after;
 		sd.dest.Write(dest);
+		if (IsFaultPending())
+		{
+			return;
+		}
+		SetFlag(FLAG_A, after4 > 0x0F);
 		SetFlag(FLAG_C, after > 65535);
 
 		// TODO: improve this
@@ -1798,6 +1931,10 @@ namespace emul
 		LogPrintf(LOG_DEBUG, "RETNear [%s][%d]", pop?"Pop":"NoPop", value);
 
 		POP(REG16::IP);
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		m_reg[REG16::SP] += value;
 	}
@@ -1806,8 +1943,15 @@ namespace emul
 	{
 		LogPrintf(LOG_DEBUG, "RETFar [%s][%d]", pop ? "Pop" : "NoPop", value);
 
-		POP(REG16::IP);
-		POP(REG16::CS);
+		const WORD offset = POP();
+		const WORD segment = POP();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_reg[REG16::IP] = offset;
+		m_reg[REG16::CS] = segment;
 		m_reg[REG16::SP] += value;
 	}
 
@@ -1876,6 +2020,10 @@ namespace emul
 
 		Mem8 modrm = GetModRM8(op2);
 		BYTE val = modrm.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		m_currTiming = &m_info.GetSubOpcodeTiming(Opcode::MULTI::GRP3, GetOP2(op2));
 
@@ -1942,13 +2090,15 @@ namespace emul
 			LogPrintf(LOG_DEBUG, "DIV8");
 			if (val == 0)
 			{
-				throw CPUException(CPUExceptionType::EX_DIVIDE);
+				RaiseFault(CPUExceptionType::EX_DIVIDE);
+				return;
 			}
 			WORD dividend = m_reg[REG16::AX];
 			WORD quotient = dividend / val;
 			if (quotient > 0xFF)
 			{
-				throw CPUException(CPUExceptionType::EX_DIVIDE);
+				RaiseFault(CPUExceptionType::EX_DIVIDE);
+				return;
 			}
 			BYTE remainder = dividend % val;
 			LogPrintf(LOG_DEBUG, "DIV8 %04X / %02X = %02X r %02X", dividend, val, quotient, remainder);
@@ -1961,13 +2111,15 @@ namespace emul
 			LogPrintf(LOG_DEBUG, "IDIV8");
 			if (val == 0)
 			{
-				throw CPUException(CPUExceptionType::EX_DIVIDE);
+				RaiseFault(CPUExceptionType::EX_DIVIDE);
+				return;
 			}
 			int16_t dividend = (int16_t)m_reg[REG16::AX];
 			int16_t quotient = dividend / int8_t(val);
 			if (quotient > 127 || quotient < -127)
 			{
-				throw CPUException(CPUExceptionType::EX_DIVIDE);
+				RaiseFault(CPUExceptionType::EX_DIVIDE);
+				return;
 			}
 			int8_t remainder = dividend % int8_t(val);
 			LogPrintf(LOG_DEBUG, "IDIV8 %04X / %02X = %02X r %02X", dividend, val, quotient, remainder);
@@ -1985,6 +2137,10 @@ namespace emul
 
 		Mem16 modrm = GetModRM16(op2);
 		WORD val = modrm.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		m_currTiming = &m_info.GetSubOpcodeTiming(Opcode::MULTI::GRP3, GetOP2(op2));
 		TICKT3(); // Add 16-bit operation overhead
@@ -2054,13 +2210,15 @@ namespace emul
 			LogPrintf(LOG_DEBUG, "DIV16");
 			if (val == 0)
 			{
-				throw CPUException(CPUExceptionType::EX_DIVIDE);
+				RaiseFault(CPUExceptionType::EX_DIVIDE);
+				return;
 			}
 			DWORD dividend = MakeDword(m_reg[REG16::DX], m_reg[REG16::AX]);
 			DWORD quotient = dividend / val;
 			if (quotient > 0xFFFF)
 			{
-				throw CPUException(CPUExceptionType::EX_DIVIDE);
+				RaiseFault(CPUExceptionType::EX_DIVIDE);
+				return;
 			}
 			WORD remainder = dividend % val;
 			LogPrintf(LOG_DEBUG, "DIV16 %08X / %04X = %04X r %04X", dividend, val, quotient, remainder);
@@ -2073,13 +2231,15 @@ namespace emul
 			LogPrintf(LOG_DEBUG, "IDIV16");
 			if (val == 0)
 			{
-				throw CPUException(CPUExceptionType::EX_DIVIDE);
+				RaiseFault(CPUExceptionType::EX_DIVIDE);
+				return;
 			}
 			int32_t dividend = (int32_t)MakeDword(m_reg[REG16::DX], m_reg[REG16::AX]);
 			int32_t quotient = dividend / int16_t(val);
 			if (quotient > 32767 || quotient < -32767)
 			{
-				throw CPUException(CPUExceptionType::EX_DIVIDE);
+				RaiseFault(CPUExceptionType::EX_DIVIDE);
+				return;
 			}
 			int16_t remainder = dividend % int16_t(val);
 			LogPrintf(LOG_DEBUG, "IDIV16 %08X / %04X = %04X r %04X", dividend, val, quotient, remainder);
@@ -2129,7 +2289,12 @@ namespace emul
 
 	void CPU8086::PUSH(Mem16 m)
 	{
-		PUSH(m.Read());
+		const WORD value = m.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
+		PUSH(value);
 	}
 
 	void CPU8086::PUSH(WORD w)
@@ -2137,8 +2302,8 @@ namespace emul
 		SegmentOffset h(SEGREG::SS, --m_reg[REG16::SP]);
 		SegmentOffset l(SEGREG::SS, --m_reg[REG16::SP]);
 
-		m_memory.Write8(GetAddress(h), GetHByte(w));
-		m_memory.Write8(GetAddress(l), GetLByte(w));
+		WriteMem8(h, GetHByte(w));
+		WriteMem8(l, GetLByte(w));
 	}
 
 	void CPU8086::POP(Mem16 dest)
@@ -2151,7 +2316,7 @@ namespace emul
 		SegmentOffset l(SEGREG::SS, m_reg[REG16::SP]++);
 		SegmentOffset h(SEGREG::SS, m_reg[REG16::SP]++);
 
-		return MakeWord(m_memory.Read8(GetAddress(h)), m_memory.Read8(GetAddress(l)));
+		return MakeWord(ReadMem8(h), ReadMem8(l));
 	}
 
 	void CPU8086::PUSHF()
@@ -2162,6 +2327,10 @@ namespace emul
 	void CPU8086::POPF()
 	{
 		WORD flags = POP();
+		if (IsFaultPending())
+		{
+			return;
+		}
 		SetFlags(flags);
 	}
 
@@ -2171,7 +2340,14 @@ namespace emul
 
 		if (PreREP())
 		{
-			m_reg[REG8::AL] = m_memory.Read8(GetAddress(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI])));
+			RepBurstLODS(1);
+			const BYTE value = ReadMem8(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]));
+			if (IsFaultPending())
+			{
+				return;
+			}
+
+			m_reg[REG8::AL] = value;
 			IndexIncDec(m_reg[REG16::SI]);
 		}
 		PostREP(false);
@@ -2183,11 +2359,18 @@ namespace emul
 
 		if (PreREP())
 		{
+			RepBurstLODS(2);
+
 			SourceDest16 sd;
 			sd.dest = REG16::AX;
 			sd.source = SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]);
 			sd.dest.Write(sd.source.Read());
 
+			if (IsFaultPending())
+			{
+				return;
+			}
+
 			IndexIncDec(m_reg[REG16::SI]);
 			IndexIncDec(m_reg[REG16::SI]);
 		}
@@ -2200,7 +2383,14 @@ namespace emul
 
 		if (PreREP())
 		{
-			m_memory.Write8(GetAddress(SegmentOffset(SEGREG::ES, m_reg[REG16::DI])), m_reg[REG8::AL]);
+			RepBurstSTOS(1);
+			WriteMem8(SegmentOffset(SEGREG::ES, m_reg[REG16::DI]), m_reg[REG8::AL]);
+
+			if (IsFaultPending())
+			{
+				return;
+			}
+
 			IndexIncDec(m_reg[REG16::DI]);
 		}
 		PostREP(false);
@@ -2211,11 +2401,18 @@ namespace emul
 
 		if (PreREP())
 		{
+			RepBurstSTOS(2);
+
 			SourceDest16 sd;
 			sd.dest = SegmentOffset(SEGREG::ES, m_reg[REG16::DI]);
 			sd.source = REG16::AX;
 			sd.dest.Write(sd.source.Read());
 
+			if (IsFaultPending())
+			{
+				return;
+			}
+
 			IndexIncDec(m_reg[REG16::DI]);
 			IndexIncDec(m_reg[REG16::DI]);
 		}
@@ -2228,12 +2425,19 @@ namespace emul
 
 		if (PreREP())
 		{
+			RepBurstSCAS(1);
+
 			SourceDest8 sd;
 
 			sd.source = SegmentOffset(SEGREG::ES, m_reg[REG16::DI]);
 			sd.dest = REG8::AL;
 			Arithmetic8(sd, rawCmp8);
 
+			if (IsFaultPending())
+			{
+				return;
+			}
+
 			IndexIncDec(m_reg[REG16::DI]);
 		}
 		PostREP(true);
@@ -2244,12 +2448,19 @@ namespace emul
 
 		if (PreREP())
 		{
+			RepBurstSCAS(2);
+
 			SourceDest16 sd;
 
 			sd.source = SegmentOffset(SEGREG::ES, m_reg[REG16::DI]);
 			sd.dest = REG16::AX;
 			Arithmetic16(sd, rawCmp16);
 
+			if (IsFaultPending())
+			{
+				return;
+			}
+
 			IndexIncDec(m_reg[REG16::DI]);
 			IndexIncDec(m_reg[REG16::DI]);
 		}
@@ -2262,8 +2473,14 @@ namespace emul
 
 		if (PreREP())
 		{
-			BYTE val = m_memory.Read8(GetAddress(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI])));
-			m_memory.Write8(GetAddress(SegmentOffset(SEGREG::ES, m_reg[REG16::DI])), val);
+			RepBurstMOVS(1);
+			BYTE val = ReadMem8(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]));
+			WriteMem8(SegmentOffset(SEGREG::ES, m_reg[REG16::DI]), val);
+
+			if (IsFaultPending())
+			{
+				return;
+			}
 
 			IndexIncDec(m_reg[REG16::SI]);
 			IndexIncDec(m_reg[REG16::DI]);
@@ -2276,12 +2493,19 @@ namespace emul
 
 		if (PreREP())
 		{
+			RepBurstMOVS(2);
+
 			SourceDest16 sd;
 			sd.source = SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]);
 			sd.dest = SegmentOffset(SEGREG::ES, m_reg[REG16::DI]);
 
 			sd.dest.Write(sd.source.Read());
 
+			if (IsFaultPending())
+			{
+				return;
+			}
+
 			IndexIncDec(m_reg[REG16::SI]);
 			IndexIncDec(m_reg[REG16::SI]);
 
@@ -2297,12 +2521,19 @@ namespace emul
 
 		if (PreREP())
 		{
+			RepBurstCMPS(1);
+
 			SourceDest8 sd;
 			sd.dest = SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]);
 			sd.source = SegmentOffset(SEGREG::ES, m_reg[REG16::DI]);
 
 			Arithmetic8(sd, rawCmp8);
 
+			if (IsFaultPending())
+			{
+				return;
+			}
+
 			IndexIncDec(m_reg[REG16::SI]);
 
 			IndexIncDec(m_reg[REG16::DI]);
@@ -2315,12 +2546,19 @@ namespace emul
 
 		if (PreREP())
 		{
+			RepBurstCMPS(2);
+
 			SourceDest16 sd;
 			sd.dest = SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]);
 			sd.source = SegmentOffset(SEGREG::ES, m_reg[REG16::DI]);
 
 			Arithmetic16(sd, rawCmp16);
 
+			if (IsFaultPending())
+			{
+				return;
+			}
+
 			IndexIncDec(m_reg[REG16::SI]);
 			IndexIncDec(m_reg[REG16::SI]);
 
@@ -2359,7 +2597,8 @@ namespace emul
 	}
 	void CPU8086::PostREP(bool checkZ)
 	{
-		if (!inRep)
+		// Faulting iteration is not completed
+		if (!inRep || IsFaultPending())
 		{
 			return;
 		}
@@ -2378,6 +2617,303 @@ namespace emul
 		}
 	}
 
+	size_t CPU8086::GetRepIterationTicks() const
+	{
+		// Each iteration goes through the REP prefix (IP is rewound to it),
+		// the prefixes that follow it (segment override) and the string instruction
+		size_t ticks = (*m_currTiming)[(int)m_regMem];
+		for (WORD ip = m_reg[REG16::_REP_IP]; ip != (WORD)(m_reg[REG16::IP] - 1); ++ip)
+		{
+			const BYTE prefix = m_memory.Read8(S2A(m_reg[REG16::CS], ip));
+			ticks += m_info.GetOpcodeTiming(prefix)[(int)m_regMem];
+		}
+		return ticks;
+	}
+
+	WORD CPU8086::GetRepBurstCount()
+	{
+		// Keep single stepping and pending interrupts on the regular path
+		if (!m_repBurst || !inRep || (m_reg[REG16::CX] < 2) || GetFlag(FLAG_T) || (m_irqPending != -1))
+		{
+			return 0;
+		}
+
+		const size_t ticks = GetRepIterationTicks();
+		const size_t maxCount = ticks ? std::max(REP_BURST_TICKS / ticks, (size_t)1) : REP_BURST_TICKS;
+
+		// Last iteration is done by the caller
+		return (WORD)std::min((size_t)m_reg[REG16::CX] - 1, maxCount);
+	}
+
+	// Reduces count so that 'count' elements of 'size' bytes starting at segoff
+	// (going up or down depending on FLAG_D) don't wrap around the segment
+	// and stay in the same memory slot.
+	// lowest: physical address of the lowest byte of the range
+	bool CPU8086::GetStringRange(SegmentOffset segoff, WORD& count, BYTE size, MemAccess access, ADDRESS& lowest)
+	{
+		const DWORD offset = segoff.offset;
+		const DWORD gran = m_memory.GetBlockGranularity();
+		const bool down = GetFlag(FLAG_D);
+
+		if (offset > 0x10000 - size)
+		{
+			return false;
+		}
+
+		// Faults are left to the regular path
+		const ADDRESS start = GetAddress(segoff, access);
+		if (IsFaultPending())
+		{
+			ClearFault();
+			return false;
+		}
+
+		// First element crosses a slot boundary
+		if ((start % gran) + size > gran)
+		{
+			return false;
+		}
+
+		// Segment wraparound and slot boundary
+		DWORD maxCount = down ?
+			std::min(offset, start % gran) / size + 1 :
+			std::min(0x10000 - offset, gran - (start % gran)) / size;
+		count = (WORD)std::min((DWORD)count, maxCount);
+		if (!count)
+		{
+			return false;
+		}
+
+		const DWORD len = (DWORD)count * size;
+		const WORD lowOffset = (WORD)(down ? (offset + size - len) : offset);
+
+		// Limit checks are monotonic: checking both ends covers the whole range
+		lowest = GetAddress(SegmentOffset(segoff.segment, lowOffset), access);
+		const ADDRESS highest = GetAddress(SegmentOffset(segoff.segment, (WORD)(lowOffset + len - 1)), access);
+		if (IsFaultPending())
+		{
+			ClearFault();
+			return false;
+		}
+		return (highest - lowest == len - 1);
+	}
+
+	void CPU8086::EndRepBurst(WORD count, BYTE size, bool incSI, bool incDI)
+	{
+		const WORD delta = (WORD)(count * size);
+		if (incSI)
+		{
+			m_reg[REG16::SI] += GetFlag(FLAG_D) ? -delta : delta;
+		}
+		if (incDI)
+		{
+			m_reg[REG16::DI] += GetFlag(FLAG_D) ? -delta : delta;
+		}
+		m_reg[REG16::CX] -= count;
+
+		m_opTicks += count * GetRepIterationTicks();
+
+		LogPrintf(LOG_DEBUG, "RepBurst, count=%d, cx=%04X", count, m_reg[REG16::CX]);
+	}
+
+	void CPU8086::RepBurstMOVS(BYTE size)
+	{
+		WORD count = GetRepBurstCount();
+		if (!count)
+		{
+			return;
+		}
+
+		const SegmentOffset src(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]);
+		const SegmentOffset dst(SEGREG::ES, m_reg[REG16::DI]);
+
+		ADDRESS srcAddr, dstAddr;
+		if (!GetStringRange(src, count, size, MemAccess::READ, srcAddr) ||
+			!GetStringRange(dst, count, size, MemAccess::WRITE, dstAddr))
+		{
+			return;
+		}
+		// count could have been reduced by the destination range
+		if (!GetStringRange(src, count, size, MemAccess::READ, srcAddr))
+		{
+			return;
+		}
+
+		const DWORD len = (DWORD)count * size;
+		const BYTE* srcPtr = m_memory.GetDirectReadPtr(srcAddr, len);
+		BYTE* dstPtr = m_memory.GetDirectWritePtr(dstAddr, len);
+		if (!srcPtr || !dstPtr)
+		{
+			return;
+		}
+
+		if ((dstPtr >= srcPtr + len) || (srcPtr >= dstPtr + len))
+		{
+			memcpy(dstPtr, srcPtr, len);
+		}
+		else
+		{
+			// Overlapping, element by element in iteration order
+			const bool down = GetFlag(FLAG_D);
+			for (DWORD i = 0; i < count; ++i)
+			{
+				const DWORD pos = (down ? (count - 1 - i) : i) * size;
+				BYTE element[2];
+				memcpy(element, srcPtr + pos, size);
+				memcpy(dstPtr + pos, element, size);
+			}
+		}
+
+		EndRepBurst(count, size, true, true);
+	}
+
+	void CPU8086::RepBurstSTOS(BYTE size)
+	{
+		WORD count = GetRepBurstCount();
+		if (!count)
+		{
+			return;
+		}
+
+		ADDRESS dstAddr;
+		if (!GetStringRange(SegmentOffset(SEGREG::ES, m_reg[REG16::DI]), count, size, MemAccess::WRITE, dstAddr))
+		{
+			return;
+		}
+
+		const DWORD len = (DWORD)count * size;
+		BYTE* dstPtr = m_memory.GetDirectWritePtr(dstAddr, len);
+		if (!dstPtr)
+		{
+			return;
+		}
+
+		const BYTE l = m_reg[REG8::AL];
+		const BYTE h = m_reg[REG8::AH];
+		if ((size == 1) || (l == h))
+		{
+			memset(dstPtr, l, len);
+		}
+		else
+		{
+			for (DWORD i = 0; i < len; i += 2)
+			{
+				dstPtr[i] = l;
+				dstPtr[i + 1] = h;
+			}
+		}
+
+		EndRepBurst(count, size, false, true);
+	}
+
+	void CPU8086::RepBurstLODS(BYTE size)
+	{
+		WORD count = GetRepBurstCount();
+		if (!count)
+		{
+			return;
+		}
+
+		// Only the last element ends up in the accumulator (regular path),
+		// we only need to make sure the skipped reads have no side effects
+		ADDRESS srcAddr;
+		if (!GetStringRange(SegmentOffset(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]), count, size, MemAccess::READ, srcAddr) ||
+			!m_memory.GetDirectReadPtr(srcAddr, (DWORD)count * size))
+		{
+			return;
+		}
+
+		EndRepBurst(count, size, true, false);
+	}
+
+	void CPU8086::RepBurstSCAS(BYTE size)
+	{
+		WORD count = GetRepBurstCount();
+		if (!count)
+		{
+			return;
+		}
+
+		ADDRESS srcAddr;
+		if (!GetStringRange(SegmentOffset(SEGREG::ES, m_reg[REG16::DI]), count, size, MemAccess::READ, srcAddr))
+		{
+			return;
+		}
+
+		const BYTE* srcPtr = m_memory.GetDirectReadPtr(srcAddr, (DWORD)count * size);
+		if (!srcPtr)
+		{
+			return;
+		}
+
+		// Skip the elements that don't end the loop, the element
+		// that ends it (and sets the flags) goes through the regular path
+		const bool down = GetFlag(FLAG_D);
+		const BYTE l = m_reg[REG8::AL];
+		const BYTE h = m_reg[REG8::AH];
+		WORD done = 0;
+		for (; done < count; ++done)
+		{
+			const BYTE* element = srcPtr + (down ? (count - 1 - done) : done) * size;
+			const bool equal = (element[0] == l) && ((size == 1) || (element[1] == h));
+			if (equal != repZ)
+			{
+				break;
+			}
+		}
+
+		if (done)
+		{
+			EndRepBurst(done, size, false, true);
+		}
+	}
+
+	void CPU8086::RepBurstCMPS(BYTE size)
+	{
+		WORD count = GetRepBurstCount();
+		if (!count)
+		{
+			return;
+		}
+
+		const SegmentOffset src1(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::SI]);
+		const SegmentOffset src2(SEGREG::ES, m_reg[REG16::DI]);
+
+		ADDRESS addr1, addr2;
+		if (!GetStringRange(src1, count, size, MemAccess::READ, addr1) ||
+			!GetStringRange(src2, count, size, MemAccess::READ, addr2) ||
+			!GetStringRange(src1, count, size, MemAccess::READ, addr1))
+		{
+			return;
+		}
+
+		const DWORD len = (DWORD)count * size;
+		const BYTE* ptr1 = m_memory.GetDirectReadPtr(addr1, len);
+		const BYTE* ptr2 = m_memory.GetDirectReadPtr(addr2, len);
+		if (!ptr1 || !ptr2)
+		{
+			return;
+		}
+
+		// Same as SCAS, the element that ends the loop goes through the regular path
+		const bool down = GetFlag(FLAG_D);
+		WORD done = 0;
+		for (; done < count; ++done)
+		{
+			const DWORD pos = (down ? (count - 1 - done) : done) * size;
+			const bool equal = memcmp(ptr1 + pos, ptr2 + pos, size) == 0;
+			if (equal != repZ)
+			{
+				break;
+			}
+		}
+
+		if (done)
+		{
+			EndRepBurst(done, size, true, true);
+		}
+	}
+
 	void CPU8086::SEGOVERRIDE(SEGREG val)
 	{
 		LogPrintf(LOG_DEBUG, "Segment Override, val=%04X", val);
@@ -2487,9 +3023,17 @@ namespace emul
 	void CPU8086::IRET()
 	{
 		LogPrintf(LOG_DEBUG, "IRET");
-		POP(REG16::IP);
-		POP(REG16::CS);
-		POPF();
+		const WORD offset = POP();
+		const WORD segment = POP();
+		const WORD flags = POP();
+		if (IsFaultPending())
+		{
+			return;
+		}
+
+		m_reg[REG16::IP] = offset;
+		m_reg[REG16::CS] = segment;
+		SetFlags(flags);
 	}
 
 	void CPU8086::MultiFunc(BYTE op2)
@@ -2498,6 +3042,10 @@ namespace emul
 
 		Mem16 dest = GetModRM16(op2);
 		WORD val = dest.Read();
+		if (IsFaultPending())
+		{
+			return;
+		}
 
 		m_currTiming = &m_info.GetSubOpcodeTiming(Opcode::MULTI::GRP5, GetOP2(op2));
 
@@ -2526,20 +3074,29 @@ namespace emul
 
 		if (regMem.source.IsRegister())
 		{
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		}
 
 		if (regMem.source.GetOffset() == 0xFFFD)
 		{
-			throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+			RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
+			return;
+		}
+
+		const WORD offset = regMem.source.Read();
+		regMem.source.Increment();
+		const WORD segment = regMem.source.Read();
+		if (IsFaultPending())
+		{
+			return;
 		}
 
 		// Target register -> offset
-		regMem.dest.Write(regMem.source.Read());
+		regMem.dest.Write(offset);
 
-		// Read segment
-		regMem.source.Increment();
-		m_reg[(REG16)dest] = regMem.source.Read();
+		// Segment
+		m_reg[(REG16)dest] = segment;
 	}
 
 	void CPU8086::XLAT()
@@ -2548,7 +3105,12 @@ namespace emul
 
 		SegmentOffset so(inSegOverride ? segOverride : SEGREG::DS, m_reg[REG16::BX] + m_reg[REG8::AL]);
 
-		m_reg[REG8::AL] = m_memory.Read8(GetAddress(so));
+		const BYTE value = ReadMem8(so);
+		if (IsFaultPending())
+		{
+			return;
+		}
+		m_reg[REG8::AL] = value;
 	}
 
 	void CPU8086::AAA()
@@ -2602,7 +3164,8 @@ namespace emul
 		LogPrintf(LOG_DEBUG, "AAM base %d", base);
 		if (base == 0)
 		{
-			throw CPUException(CPUExceptionType::EX_DIVIDE);
+			RaiseFault(CPUExceptionType::EX_DIVIDE);
+			return;
 		}
 
 		m_reg[REG8::AH] = m_reg[REG8::AL] / base;
@@ -2689,7 +3252,8 @@ namespace emul
 		{
 		case 0xC0: // REG
 			// Register is not a valid source
-			throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
+			return;
 		case 0x00: // NO DISP (or DIRECT)
 			if ((modregrm & 7) == 6) // Direct
 			{
@@ -3,6 +3,7 @@
 #include <Serializable.h>
 #include <CPU/CPU.h>
 #include <CPU/CPUInfo.h>
+#include <CPU/OpcodeTable.h>
 #include <CPU/PortConnector.h>
 #include "CPUException.h"
 #include <tuple>
@@ -121,6 +122,7 @@ namespace emul
 		void Write(BYTE value);
 
 		static void Init(CPU8086* cpu, Memory* m, Registers* r) { m_cpu = cpu; m_memory = m; m_registers = r; }
+		static bool IsBound(const CPU8086* cpu) { return m_cpu == cpu; }
 
 		bool IsRegister() const
 		{
@@ -134,22 +136,22 @@ namespace emul
 
 		WORD GetOffset() const
 		{
-			if (!IsRegister())
-			{
-				return m_segOff.offset;
-			}
-			else
+			if (IsRegister())
 			{
 				// We shouldn't get there. This means that the operation needs a
 				// memory operand instead of a register, so this is an invalid opcode
-				throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+				RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
 			}
+			return m_segOff.offset;
 		}
 
 	protected:
-		static CPU8086* m_cpu;
-		static Memory* m_memory;
-		static Registers* m_registers;
+		static void RaiseFault(CPUExceptionType type);
+
+		// Bound to the CPU currently executing on this thread (see CPU8086::BindOperands)
+		static thread_local CPU8086* m_cpu;
+		static thread_local Memory* m_memory;
+		static thread_local Registers* m_registers;
 
 		SegmentOffset m_segOff;
 		REG8 m_reg8 = REG8::INVALID;
@@ -169,7 +171,7 @@ namespace emul
 		{
 			if (m_checkAlignment && (segoff.offset == 0xFFFF))
 			{
-				throw CPUException(CPUExceptionType::EX_GENERAL_PROTECTION);
+				RaiseFault(CPUExceptionType::EX_GENERAL_PROTECTION);
 			}
 		}
 		Mem16(REG16 r16) : m_reg16(r16), l((REG8)((int)r16 * 2)), h((REG8)((int)r16 * 2 + 1)) {}
@@ -193,20 +195,22 @@ namespace emul
 			{
 				// We shouldn't get there. This means that the operation needs a
 				// memory operand instead of a register, so this is an invalid opcode
-				throw CPUException(CPUExceptionType::EX_UNDEFINED_OPCODE);
+				RaiseFault(CPUExceptionType::EX_UNDEFINED_OPCODE);
 			}
 		}
 
 		WORD Read() const { return MakeWord(h.Read(), l.Read()); }
 		void Write(WORD value) { l.Write(GetLByte(value)); h.Write(GetHByte(value)); }
 
-		static void Init(Memory* m, Registers* r) { m_memory = m; m_registers = r; m_checkAlignment; }
-		static void CheckAlignment(bool check) { m_checkAlignment = check; }
+		static void Init(CPU8086* cpu, Memory* m, Registers* r, bool checkAlignment) { m_cpu = cpu; m_memory = m; m_registers = r; m_checkAlignment = checkAlignment; }
 
 	protected:
-		static Memory* m_memory;
-		static Registers* m_registers;
-		static bool m_checkAlignment;
+		static void RaiseFault(CPUExceptionType type);
+
+		static thread_local CPU8086* m_cpu;
+		static thread_local Memory* m_memory;
+		static thread_local Registers* m_registers;
+		static thread_local bool m_checkAlignment;
 
 		REG16 m_reg16 = REG16::INVALID;
 		Mem8 h;
@@ -248,6 +252,19 @@ namespace emul
 		virtual void Reset(WORD segment, WORD offset);
 
 		void Interrupt(BYTE irq) { m_irqPending = irq; }
+
+		// Faults (divide error, trap, protection, ...) are latched here while the
+		// instruction runs, and delivered by Exec() at the instruction boundary.
+		// Only the first one is kept. The code that raises a fault returns right
+		// away, its callers keep going with memory and operand writes suppressed.
+		void RaiseFault(CPUExceptionType type, int errorCode = 0) const
+		{
+			if (!IsFaultPending())
+			{
+				m_fault = CPUException(type, errorCode);
+			}
+		}
+		bool IsFaultPending() const { return m_fault.GetType() != CPUExceptionType::EX_NONE; }
 		bool CanInterrupt()
 		{
 			if (m_opcode == 0x17)
@@ -308,6 +325,11 @@ namespace emul
 	protected:
 		CPU8086(const char* cpuid, Memory& memory);
 
+		// Point the Mem8/Mem16 operand accessors to this CPU for the current thread.
+		// Done on each Step() if another CPU instance ran on this thread in between.
+		void BindOperands();
+		bool m_checkAlignment = false;
+
 		// Fetch the timing for the reg (base) or mem variant.
 		// If not applicable, this has no impact since timing[base] == timing[mem]
 		// (This happens when the timing values are loaded: if no mem timing, we copy the base timing)
@@ -316,7 +338,7 @@ namespace emul
 		inline void TICKT3() { CPU::TICK((*m_currTiming)[(int)cpuInfo::OpcodeTimingType::T3]); }
 		inline void TICKT4() { CPU::TICK((*m_currTiming)[(int)cpuInfo::OpcodeTimingType::T4]); }
 
-		std::vector<std::function<void()>> m_opcodes;
+		std::vector<OpcodeHandler> m_opcodes;
 
 		cpuInfo::CPUInfo m_info;
 		const cpuInfo::OpcodeTiming* m_currTiming = nullptr;
@@ -349,6 +371,12 @@ namespace emul
 
 		void IndexIncDec(WORD& idx) { GetFlag(FLAG_D) ? --idx : ++idx; }
 
+		// Direct memory access through segment translation (no access rights check).
+		// Memory is not accessed once a fault is pending
+		BYTE ReadMem8(SegmentOffset segoff) { const ADDRESS address = GetAddress(segoff); return IsFaultPending() ? 0xFF : m_memory.Read8(address); }
+		WORD ReadMem16(SegmentOffset segoff) { const ADDRESS address = GetAddress(segoff); return IsFaultPending() ? 0xFFFF : m_memory.Read16(address); }
+		void WriteMem8(SegmentOffset segoff, BYTE value) { const ADDRESS address = GetAddress(segoff); if (!IsFaultPending()) m_memory.Write8(address, value); }
+
 		virtual BYTE FetchByte() override;
 		virtual WORD FetchWord() override;
 
@@ -368,6 +396,11 @@ namespace emul
 		// Exceptions
 		virtual void CPUExceptionHandler(CPUException e);
 
+		// Pending fault, set from const helpers (GetAddress) as well
+		mutable CPUException m_fault;
+		void ClearFault() { m_fault = CPUException(); }
+		void DeliverFault();
+
 		// Opcodes
 		void NotImplemented();
 		virtual void InvalidOpcode();
@@ -480,6 +513,28 @@ namespace emul
 		bool PreREP();
 		void PostREP(bool checkZ);
 
+		// REP fast path
+		//
+		// When both operands resolve to plain RAM/ROM slots (see Memory::GetDirectReadPtr),
+		// runs up to CX-1 iterations directly on host memory and charges their cycles
+		// in one go. The last iteration always goes through the regular path (PreREP/PostREP, flags).
+		// Bursts are capped to REP_BURST_TICKS so interrupts are not delayed by much.
+		static constexpr size_t REP_BURST_TICKS = 1024;
+
+		// Cleared by the tests to compare with the per-iteration path
+		bool m_repBurst = true;
+
+		size_t GetRepIterationTicks() const;
+		WORD GetRepBurstCount();
+		bool GetStringRange(SegmentOffset segoff, WORD& count, BYTE size, MemAccess access, ADDRESS& lowest);
+		void EndRepBurst(WORD count, BYTE size, bool incSI, bool incDI);
+
+		void RepBurstMOVS(BYTE size);
+		void RepBurstSTOS(BYTE size);
+		void RepBurstLODS(BYTE size);
+		void RepBurstSCAS(BYTE size);
+		void RepBurstCMPS(BYTE size);
+
 		void SEGOVERRIDE(SEGREG);
 
 		virtual void INT(BYTE interrupt);
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <exception>
-
 namespace emul
 {
 
@@ -25,17 +23,21 @@ namespace emul
 		EX_NONE = 0xFF
 	};
 
-	class CPUException : public std::runtime_error
+	// CPU fault/trap, latched by the CPU while an instruction executes
+	// and delivered at the instruction boundary (see CPU8086::RaiseFault).
+	// Plain value, not thrown.
+	class CPUException
 	{
 	public:
+		CPUException() {}
 		CPUException(CPUExceptionType type, int errorCode = 0) :
-			std::runtime_error("CPU Exception"),
 			m_type(type),
 			m_errorCode(errorCode)
 		{
 		}
 
 		CPUExceptionType GetType() const { return m_type; }
+		int GetErrorCode() const { return m_errorCode; }
 
 	protected:
 		CPUExceptionType m_type = CPUExceptionType::EX_NONE;
@@ -71,6 +71,9 @@ namespace emul
 			m_cpu->Reset();
 			m_memory.Clear();
 
+			m_floppyDMABurstWait = 0;
+			m_hddDMABurstWait = 0;
+
 			// TODO: Reset all components
 			m_video->Reset();
 		}
@@ -233,6 +236,57 @@ namespace emul
 		m_pit->EnableLog(CONFIG().GetLogLevel("pit"));
 		m_pit->Init();
 	}
+	void Computer::InitPITEvents()
+	{
+		m_pit->SetLazyMode(true);
+
+		m_timer0Out = m_pit->GetCounter(0).GetOutput();
+		m_timer0Event = m_scheduler.Schedule(g_ticks + 1, [this]() { OnTimer0Edge(); });
+
+		m_pit->SetCounterChangeCallback([this](BYTE counter)
+		{
+			if (counter == 0)
+			{
+				m_scheduler.Reschedule(m_timer0Event, g_ticks + 1);
+			}
+		});
+	}
+
+	void Computer::OnTimer0Edge()
+	{
+		pit::Counter& timer0 = m_pit->GetCounter(0);
+
+		bool out = timer0.GetOutput();
+
+		// Requests are ignored while the PIC is not initialized. Follow the
+		// output on every tick until it's ready, so edge detection picks up
+		// from the current level like with the per-tick IRQ0 update
+		if (!m_pic->IsReady())
+		{
+			m_timer0Out = out;
+			m_scheduler.Reschedule(m_timer0Event, g_ticks + 1);
+			return;
+		}
+
+		if (out != m_timer0Out)
+		{
+			m_timer0Out = out;
+			if (out)
+			{
+				// The PIC only latches low->high transitions, make sure it sees
+				// the low level in case it was initialized during the low phase
+				m_pic->InterruptRequest(0, false);
+			}
+			m_pic->InterruptRequest(0, out);
+		}
+
+		size_t nextEdge = timer0.GetNextOutputEdge();
+		if (nextEdge != pit::Counter::NO_EDGE)
+		{
+			m_scheduler.Reschedule(m_timer0Event, nextEdge);
+		}
+	}
+
 	void Computer::InitPIC(pic::Device8259* pic)
 	{
 		assert(pic);
@@ -341,6 +395,7 @@ namespace emul
 
 		m_floppy->EnableLog(CONFIG().GetLogLevel("floppy"));
 		m_floppy->Init();
+		m_floppyDMABurst = CONFIG().GetValueBool("floppy", "dmaburst");
 
 		std::string floppy = CONFIG().GetValueStr("floppy", "floppy.1");
 		if (floppy.size())
@@ -354,6 +409,32 @@ namespace emul
 			m_floppy->LoadDiskImage(1, floppy.c_str());
 		}
 	}
+
+	void Computer::OnInputAction(const events::InputRecord& action)
+	{
+		switch ((events::InputAction)action.code)
+		{
+		case events::InputAction::FLOPPY_LOAD:
+			if (m_floppy && (action.unit < 2))
+			{
+				m_floppy->LoadDiskImage(action.unit, action.data.c_str());
+				return;
+			}
+			break;
+		case events::InputAction::FLOPPY_EJECT:
+			if (m_floppy && (action.unit < 2))
+			{
+				m_floppy->ClearDiskImage(action.unit);
+				return;
+			}
+			break;
+		default:
+			break;
+		}
+
+		ComputerBase::OnInputAction(action);
+	}
+
 	void Computer::InitHardDrive(hdd::DeviceHardDrive* hdd, BYTE irq, BYTE dma)
 	{
 		assert(hdd);
@@ -363,13 +444,15 @@ namespace emul
 
 		m_hardDrive->EnableLog(CONFIG().GetLogLevel("hdd"));
 		m_hardDrive->Init();
+		m_hardDrive->SetCopyOnWrite(CONFIG().GetValueBool("hdd", "cow"));
+		m_hddDMABurst = CONFIG().GetValueBool("hdd", "dmaburst");
 
 		for (int i = 0; i < 2; i++)
 		{
 			const HardDriveImageInfo& img = GetHardDriveImageInfo(i + 1);
 			if (img.set)
 			{
-				m_hardDrive->LoadDiskImage(i, img.type, img.file.c_str());
+				m_hardDrive->LoadDiskImage(i, img.type, img.file.c_str(), img.delta.c_str());
 			}
 		}
 
@@ -411,11 +494,46 @@ namespace emul
 			{
 				LogPrintf(LOG_ERROR, "GetHDDImageConfig: Error parsing hdd image file for key [hdd][%s]", key);
 			}
+
+			strcat(key, ".delta");
+			info.delta = CONFIG().GetValueStr("hdd", key);
 		}
 
 		return info;
 	}
 
+	// Moves what's left of the controller's sector buffer in one DMA block transfer.
+	// Returns the number of bytes transferred, 0 if the channel or
+	// controller state requires a byte per byte transfer
+	template<class CONTROLLER>
+	static size_t DMASectorBurst(dma::DMAChannel& channel, CONTROLLER& controller)
+	{
+		BYTE buffer[512];
+		size_t size = 0;
+		switch (channel.GetOperation())
+		{
+		case dma::OPERATION::READ: // Memory -> controller
+			size = channel.GetBurstSize(controller.GetDMAWriteBurstSize());
+			if (size)
+			{
+				channel.DMABurst(buffer, size);
+				controller.WriteDataBurst(buffer, size);
+			}
+			break;
+		case dma::OPERATION::WRITE: // Controller -> memory
+			size = channel.GetBurstSize(controller.GetDMAReadBurstSize());
+			if (size)
+			{
+				controller.ReadDataBurst(buffer, size);
+				channel.DMABurst(buffer, size);
+			}
+			break;
+		default:
+			break;
+		}
+		return size;
+	}
+
 	void Computer::TickHardDrive()
 	{
 		if (!m_hardDrive)
@@ -431,6 +549,13 @@ namespace emul
 			return;
 		}
 
+		// Bus time of the last sector burst
+		if (m_hddDMABurstWait)
+		{
+			--m_hddDMABurstWait;
+			return;
+		}
+
 		if (m_hardDrive->IsDMAPending())
 		{
 			m_dma1->DMARequest(m_hddDMA, true);
@@ -440,27 +565,37 @@ namespace emul
 		{
 			m_dma1->DMARequest(m_hddDMA, false);
 
-			// Do it manually
-			m_hardDrive->DMAAcknowledge();
-
 			dma::DMAChannel& channel = m_dma1->GetChannel(m_hddDMA);
-			dma::OPERATION op = channel.GetOperation();
-			BYTE value;
-			switch (op)
+
+			size_t burst = m_hddDMABurst ? DMASectorBurst(channel, *m_hardDrive) : 0;
+			if (burst)
+			{
+				// Bus is held for the whole burst, one byte per tick
+				m_hddDMABurstWait = burst - 1;
+			}
+			else
 			{
-			case dma::OPERATION::READ:
-				channel.DMAOperation(value);
-				m_hardDrive->WriteDataFIFO(value);
-				break;
-			case dma::OPERATION::WRITE:
-				value = m_hardDrive->ReadDataFIFO();
-				channel.DMAOperation(value);
-				break;
-			case dma::OPERATION::VERIFY:
-				channel.DMAOperation(value);
-				break;
-			default:
-				throw std::exception("DMAOperation: Operation not supported");
+				// Do it manually
+				m_hardDrive->DMAAcknowledge();
+
+				dma::OPERATION op = channel.GetOperation();
+				BYTE value;
+				switch (op)
+				{
+				case dma::OPERATION::READ:
+					channel.DMAOperation(value);
+					m_hardDrive->WriteDataFIFO(value);
+					break;
+				case dma::OPERATION::WRITE:
+					value = m_hardDrive->ReadDataFIFO();
+					channel.DMAOperation(value);
+					break;
+				case dma::OPERATION::VERIFY:
+					channel.DMAOperation(value);
+					break;
+				default:
+					throw std::exception("DMAOperation: Operation not supported");
+				}
 			}
 
 			if (m_dma1->GetTerminalCount(m_hddDMA))
@@ -484,6 +619,13 @@ namespace emul
 			return;
 		}
 
+		// Bus time of the last sector burst
+		if (m_floppyDMABurstWait)
+		{
+			--m_floppyDMABurstWait;
+			return;
+		}
+
 		// TODO: duplication with HDD
 		if (m_floppy->IsDMAPending())
 		{
@@ -494,27 +636,37 @@ namespace emul
 		{
 			m_dma1->DMARequest(m_floppyDMA, false);
 
-			// Do it manually
-			m_floppy->DMAAcknowledge();
-
 			dma::DMAChannel& channel = m_dma1->GetChannel(m_floppyDMA);
-			dma::OPERATION op = channel.GetOperation();
-			BYTE value;
-			switch (op)
+
+			size_t burst = m_floppyDMABurst ? DMASectorBurst(channel, *m_floppy) : 0;
+			if (burst)
 			{
-			case dma::OPERATION::READ:
-				channel.DMAOperation(value);
-				m_floppy->WriteDataFIFO(value);
-				break;
-			case dma::OPERATION::WRITE:
-				value = m_floppy->ReadDataFIFO();
-				channel.DMAOperation(value);
-				break;
-			case dma::OPERATION::VERIFY:
-				channel.DMAOperation(value);
-				break;
-			default:
-				throw std::exception("DMAOperation: Operation not supported");
+				// Bus is held for the whole burst, one byte per tick
+				m_floppyDMABurstWait = burst - 1;
+			}
+			else
+			{
+				// Do it manually
+				m_floppy->DMAAcknowledge();
+
+				dma::OPERATION op = channel.GetOperation();
+				BYTE value;
+				switch (op)
+				{
+				case dma::OPERATION::READ:
+					channel.DMAOperation(value);
+					m_floppy->WriteDataFIFO(value);
+					break;
+				case dma::OPERATION::WRITE:
+					value = m_floppy->ReadDataFIFO();
+					channel.DMAOperation(value);
+					break;
+				case dma::OPERATION::VERIFY:
+					channel.DMAOperation(value);
+					break;
+				default:
+					throw std::exception("DMAOperation: Operation not supported");
+				}
 			}
 
 			if (m_dma1->GetTerminalCount(m_floppyDMA))
@@ -549,6 +701,9 @@ namespace emul
 		{
 			m_mouse->Serialize(to["mouse"]);
 		}
+
+		to["floppyDMABurstWait"] = m_floppyDMABurstWait;
+		to["hddDMABurstWait"] = m_hddDMABurstWait;
 	}
 
 	void Computer::Deserialize(const json& from)
@@ -557,6 +712,13 @@ namespace emul
 
 		m_pit->Deserialize(from["pit"]);
 		m_pic->Deserialize(from["pic"]);
+
+		// Edge detection restarts from the restored timer 0 output
+		if (m_timer0Event != Scheduler::INVALID_EVENT)
+		{
+			m_timer0Out = m_pit->GetCounter(0).GetOutput();
+			m_scheduler.Reschedule(m_timer0Event, g_ticks + 1);
+		}
 		m_cpuSpeed.Deserialize(from["speed"]);
 
 		if ((from.contains("floppy") && !m_floppy) ||
@@ -595,5 +757,9 @@ namespace emul
 		{
 			m_mouse->Deserialize(from["mouse"]);
 		}
+
+		// Not in older snapshots
+		m_floppyDMABurstWait = from.contains("floppyDMABurstWait") ? (size_t)from["floppyDMABurstWait"] : 0;
+		m_hddDMABurstWait = from.contains("hddDMABurstWait") ? (size_t)from["hddDMABurstWait"] : 0;
 	}
 }
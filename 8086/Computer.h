@@ -67,14 +67,13 @@ namespace emul
 
 		virtual std::string_view GetModel() const override
 		{
-			static std::string model;
 			// Use video mode as model only if non-trivial (e.g skip pcjr)
 			const auto& videoModes = GetVideoModes();
 			if (videoModes.size() > 1)
 			{
-				model = GetVideo().GetDisplayName();
+				m_model = GetVideo().GetDisplayName();
 			}
-			return model;
+			return m_model;
 		}
 
 		virtual void Init(WORD baseRAM) = 0;
@@ -129,12 +128,21 @@ namespace emul
 			bool set = false;
 			BYTE type = 0;
 			std::string file;
+			std::string delta; // Copy-on-write delta file
 		};
 		HardDriveImageInfo GetHardDriveImageInfo(int id);
 
 		virtual void TickFloppy();
 		virtual void TickHardDrive();
 
+		virtual void OnInputAction(const events::InputRecord& action) override;
+
+		// Lazy PIT: counter 0 output edges are delivered to IRQ0 by the scheduler
+		void InitPITEvents();
+		void OnTimer0Edge();
+		Scheduler::EventID m_timer0Event = Scheduler::INVALID_EVENT;
+		bool m_timer0Out = false;
+
 		MemoryBlock m_hddROM;
 
 		pit::Device8254* m_pit = nullptr;
@@ -155,8 +163,20 @@ namespace emul
 		BYTE m_hddIRQ = 0;
 		BYTE m_hddDMA = 0;
 
+		// DMA sector bursts: remaining ticks of bus time for the last burst
+		bool m_floppyDMABurst = false;
+		size_t m_floppyDMABurstWait = 0;
+		bool m_hddDMABurst = false;
+		size_t m_hddDMABurstWait = 0;
+
+		// Step(): CPU ticks not yet converted to base clock ticks, and base
+		// clock tick count for the devices clocked at a multiple of it
+		uint32_t m_cpuTicks = 0;
+		int64_t m_syncTicks = 0;
+
 	private:
 		VideoModes m_videoModes;
+		mutable std::string m_model;
 
 		CPUSpeed m_cpuSpeed;
 		CPUSpeeds m_cpuSpeeds;
@@ -111,6 +111,12 @@ namespace emul
 		GetInputs().InitJoystick(m_joystick);
 		GetInputs().InitMouse(m_mouse);
 
+		InitPITEvents();
+
+		// Devices that only need attention at fixed intervals
+		m_scheduler.SchedulePeriodic(GetInputs().GetPollInterval(), [this]() { GetInputs().Poll(); });
+		m_scheduler.SchedulePeriodic(m_keyboard.SCAN_INTERVAL, [this]() { m_keyboard.Scan(); });
+
 		std::string soundModule = CONFIG().GetValueStr("sound", "soundcard");
 		if (soundModule == "cms" || soundModule == "gb")
 		{
@@ -229,9 +235,6 @@ namespace emul
 
 	bool ComputerAT::Step()
 	{
-		static auto lastTick = std::chrono::high_resolution_clock::now();
-		static int64_t syncTicks = 0;
-
 		if (m_pic->InterruptPending() && GetCPU()->CanInterrupt())
 		{
 			m_pic->InterruptAcknowledge();
@@ -244,23 +247,23 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = 0;
-		cpuTicks += GetCPU()->GetInstructionTicks();
+		m_cpuTicks += GetCPU()->GetInstructionTicks();
 
 		ppi::Device8042AT* ppi = (ppi::Device8042AT*)m_ppi;
 
-		for (uint32_t i = 0; i < cpuTicks / GetCPUSpeedRatio(); ++i)
+		for (uint32_t i = 0; i < m_cpuTicks / GetCPUSpeedRatio(); ++i)
 		{
 			++g_ticks;
 
-			GetInputs().Tick();
-			if (GetInputs().IsQuit())
+			if (m_scheduler.IsDue(g_ticks))
 			{
-				return false;
+				m_scheduler.Run(g_ticks);
+				if (GetInputs().IsQuit())
+				{
+					return false;
+				}
 			}
 
-			m_keyboard.Tick();
-
 			if (m_joystick)
 			{
 				m_joystick->Tick();
@@ -273,11 +276,8 @@ namespace emul
 			ppi->Tick();
 			m_pic->InterruptRequest(1, ppi->IsInterruptPending());
 
-			m_pit->Tick();
 			ppi->SetTimer2Output(timer2.GetOutput());
 
-			m_pic->InterruptRequest(0, m_pit->GetCounter(0).GetOutput());
-
 			if (isSoundGameBlaster)
 			{
 				// TODO: Ugly
@@ -300,7 +300,7 @@ namespace emul
 				if (!m_turbo) m_pcSpeaker.Tick();
 			}
 
-			if (syncTicks & 1)
+			if (m_syncTicks & 1)
 			{
 				m_video->Tick();
 			}
@@ -311,15 +311,20 @@ namespace emul
 
 			m_mouse->Tick();
 			// UART clock is 1.5x base clock
-			if (syncTicks & 1)
+			if (m_syncTicks & 1)
 			{
 				m_mouse->Tick();
 			}
 			m_pic->InterruptRequest(m_mouse->GetIRQ(), m_mouse->IsInterrupt());
 
-			++syncTicks;
+			++m_syncTicks;
+		}
+		m_cpuTicks %= GetCPUSpeedRatio();
+
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
 		}
-		cpuTicks %= GetCPUSpeedRatio();
 
 		return true;
 	}
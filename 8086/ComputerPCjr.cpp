@@ -164,11 +164,6 @@ namespace emul
 
 	bool ComputerPCjr::Step()
 	{
-		static auto lastTick = std::chrono::high_resolution_clock::now();
-		static int64_t syncTicks = 0;
-
-		static bool timer0Out = false;
-
 		if (m_keyboard.NMIPending())
 		{
 			GetCPU()->Interrupt(2);
@@ -185,13 +180,12 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = 0;
-		cpuTicks += GetCPU()->GetInstructionTicks();
+		m_cpuTicks += GetCPU()->GetInstructionTicks();
 
 		ppi::Device8255PCjr* ppi = (ppi::Device8255PCjr*)m_ppi;
 		video::VideoPCjr* video = (video::VideoPCjr*)m_video;
 
-		for (uint32_t i = 0; i < cpuTicks / GetCPUSpeedRatio(); ++i)
+		for (uint32_t i = 0; i < m_cpuTicks / GetCPUSpeedRatio(); ++i)
 		{
 			++g_ticks;
 
@@ -222,13 +216,13 @@ namespace emul
 
 			bool out = m_pit->GetCounter(0).GetOutput();
 			m_pic->InterruptRequest(0, out);
-			if (out != timer0Out)
+			if (out != m_lastTimer0Out)
 			{
 				if (out && m_keyboard.GetTimer1Source() == kbd::CLK1::TIMER0_OUT)
 				{
 					m_pit->GetCounter(1).Tick();
 				}
-				timer0Out = out;
+				m_lastTimer0Out = out;
 			}
 
 			// SN76489 clock is 3x base clock
@@ -239,7 +233,7 @@ namespace emul
 
 			TickFloppy();
 
-			if ((syncTicks & 1))
+			if ((m_syncTicks & 1))
 			{
 				video->Tick();
 				m_pic->InterruptRequest(IRQ_VSYNC, (video->IsVSync()));
@@ -249,15 +243,20 @@ namespace emul
 
 			m_uart.Tick();
 			// UART clock is 1.5x base clock
-			if (syncTicks & 1)
+			if (m_syncTicks & 1)
 			{
 				m_uart.Tick();
 			}
 			m_pic->InterruptRequest(m_uart.GetIRQ(), m_uart.IsInterrupt());
 
-			++syncTicks;
+			++m_syncTicks;
+		}
+		m_cpuTicks %= GetCPUSpeedRatio();
+
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
 		}
-		cpuTicks %= GetCPUSpeedRatio();
 
 		return true;
 	}
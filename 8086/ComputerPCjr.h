@@ -46,5 +46,8 @@ namespace emul
 		sn76489::DeviceSN76489 m_soundModule;
 
 		post::DevicePOSTCard m_post;
+
+		// Timer 0 output on the previous tick, counter 1 can be clocked by its rising edge
+		bool m_lastTimer0Out = false;
 	};
 }
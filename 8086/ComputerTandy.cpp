@@ -166,11 +166,6 @@ namespace emul
 
 	bool ComputerTandy::Step()
 	{
-		static auto lastTick = std::chrono::high_resolution_clock::now();
-		static int64_t syncTicks = 0;
-
-		static bool timer0Out = false;
-
 		if (m_pic->InterruptPending() && GetCPU()->CanInterrupt())
 		{
 			m_pic->InterruptAcknowledge();
@@ -182,13 +177,12 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = 0;
-		cpuTicks += GetCPU()->GetInstructionTicks();
+		m_cpuTicks += GetCPU()->GetInstructionTicks();
 
 		ppi::Device8255Tandy* ppi = (ppi::Device8255Tandy*)m_ppi;
 		video::VideoTandy* video = (video::VideoTandy*)m_video;
 
-		for (uint32_t i = 0; i < cpuTicks / GetCPUSpeedRatio(); ++i)
+		for (uint32_t i = 0; i < m_cpuTicks / GetCPUSpeedRatio(); ++i)
 		{
 			++g_ticks;
 
@@ -225,7 +219,7 @@ namespace emul
 			TickHardDrive();
 
 			// Skip one in four video ticks to sync up with pit timing
-			if (syncTicks & 1)
+			if (m_syncTicks & 1)
 			{
 				video->Tick();
 				m_pic->InterruptRequest(IRQ_VSYNC, (video->IsVSync()));
@@ -233,9 +227,14 @@ namespace emul
 			video->Tick();
 			m_pic->InterruptRequest(IRQ_VSYNC, (video->IsVSync()));
 
-			++syncTicks;
+			++m_syncTicks;
+		}
+		m_cpuTicks %= GetCPUSpeedRatio();
+
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
 		}
-		cpuTicks %= GetCPUSpeedRatio();
 
 		return true;
 	}
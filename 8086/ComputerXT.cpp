@@ -36,6 +36,8 @@ namespace emul
 	static const BYTE IRQ_HDD = 5;
 	static const BYTE DMA_HDD = 3;
 
+	static const size_t DMA0_REFRESH_INTERVAL = 16;
+
 	ComputerXT::ComputerXT() :
 		Logger("XT"),
 		m_baseRAM("RAM", emul::MemoryType::RAM),
@@ -91,6 +93,14 @@ namespace emul
 		GetInputs().InitJoystick(m_joystick);
 		GetInputs().InitMouse(m_mouse);
 
+		InitPITEvents();
+
+		// Devices that only need attention at fixed intervals
+		m_scheduler.SchedulePeriodic(GetInputs().GetPollInterval(), [this]() { GetInputs().Poll(); });
+		m_scheduler.SchedulePeriodic(m_keyboard.SCAN_INTERVAL, [this]() { m_keyboard.Scan(); });
+		// Fake DMA Channel 0 memory refresh to shut up POST
+		m_scheduler.SchedulePeriodic(DMA0_REFRESH_INTERVAL, [this]() { m_dma1->GetChannel(0).Tick(); });
+
 		std::string soundModule = CONFIG().GetValueStr("sound", "soundcard");
 		if (soundModule == "pcjr" || soundModule == "tandy")
 		{
@@ -169,9 +179,6 @@ namespace emul
 
 	bool ComputerXT::Step()
 	{
-		static auto lastTick = std::chrono::high_resolution_clock::now();
-		static int64_t syncTicks = 0;
-
 		if (m_pic->InterruptPending() && GetCPU()->CanInterrupt())
 		{
 			m_pic->InterruptAcknowledge();
@@ -187,23 +194,23 @@ namespace emul
 			}
 		}
 
-		static uint32_t cpuTicks = 0;
-		cpuTicks += GetCPU()->GetInstructionTicks();
+		m_cpuTicks += GetCPU()->GetInstructionTicks();
 
 		ppi::Device8255XT* ppi = (ppi::Device8255XT*)m_ppi;
 
-		for (uint32_t i = 0; i < cpuTicks / GetCPUSpeedRatio(); ++i)
+		for (uint32_t i = 0; i < m_cpuTicks / GetCPUSpeedRatio(); ++i)
 		{
 			++g_ticks;
 
-			GetInputs().Tick();
-			if (GetInputs().IsQuit())
+			if (m_scheduler.IsDue(g_ticks))
 			{
-				return false;
+				m_scheduler.Run(g_ticks);
+				if (GetInputs().IsQuit())
+				{
+					return false;
+				}
 			}
 
-			m_keyboard.Tick();
-
 			if (m_joystick)
 			{
 				m_joystick->Tick();
@@ -212,11 +219,8 @@ namespace emul
 			pit::Counter& timer2 = m_pit->GetCounter(2);
 			timer2.SetGate(ppi->GetTimer2Gate());
 
-			m_pit->Tick();
 			ppi->SetTimer2Output(timer2.GetOutput());
 
-			m_pic->InterruptRequest(0, m_pit->GetCounter(0).GetOutput());
-
 			if (isSoundPCjr)
 			{
 				// SN76489 clock is 3x base clock
@@ -245,17 +249,7 @@ namespace emul
 				if (!m_turbo) m_pcSpeaker.Tick();
 			}
 
-			// Fake DMA Channel 0 memory refresh to shut up POST
-			{
-				static size_t dma0Div = 0;
-				if (dma0Div++ == 15)
-				{
-					dma0Div = 0;
-					m_dma1->GetChannel(0).Tick();
-				}
-			}
-
-			if (syncTicks & 1)
+			if (m_syncTicks & 1)
 			{
 				m_video->Tick();
 			}
@@ -266,15 +260,20 @@ namespace emul
 
 			m_mouse->Tick();
 			// UART clock is 1.5x base clock
-			if (syncTicks & 1)
+			if (m_syncTicks & 1)
 			{
 				m_mouse->Tick();
 			}
 			m_pic->InterruptRequest(m_mouse->GetIRQ(), m_mouse->IsInterrupt());
 
-			++syncTicks;
+			++m_syncTicks;
+		}
+		m_cpuTicks %= GetCPUSpeedRatio();
+
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
 		}
-		cpuTicks %= GetCPUSpeedRatio();
 
 		return true;
 	}
@@ -304,9 +304,8 @@ namespace ppi
 
 	void Device8042AT::SetRefresh(bool refreshBit)
 	{
-		// Toggle at the 0->1 transition
-		static bool lastRefresh = false;
-		if (!lastRefresh && refreshBit)
+		// Advance while timer 1 output is high
+		if (refreshBit)
 		{
 			++m_portB.refresh;
 			m_portB.refresh &= 7;
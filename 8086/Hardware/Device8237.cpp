@@ -68,19 +68,24 @@ namespace dma
 
 		if (m_count == 0xFFFF)
 		{
-			LogPrintf(LOG_DEBUG, "Channel %d, Count done", m_id);
+			CountDone();
+		}
+	}
 
-			// TODO: Terminalcount & correct states
-			if (m_autoInit)
-			{
-				m_count = m_baseCount;
-				m_address = m_baseAddress;
-			}
-			else
-			{
-				m_terminalCount = true;
-				m_parent->SetTerminalCount(m_id);
-			}
+	void DMAChannel::CountDone()
+	{
+		LogPrintf(LOG_DEBUG, "Channel %d, Count done", m_id);
+
+		// TODO: Terminalcount & correct states
+		if (m_autoInit)
+		{
+			m_count = m_baseCount;
+			m_address = m_baseAddress;
+		}
+		else
+		{
+			m_terminalCount = true;
+			m_parent->SetTerminalCount(m_id);
 		}
 	}
 
@@ -206,6 +211,85 @@ namespace dma
 		Tick();
 	}
 
+	size_t DMAChannel::GetBurstSize(size_t size)
+	{
+		// Only plain 8 bit, incrementing transfers
+		if (m_parent->IsDisabled() || m_terminalCount || m_addressShift || m_decrement ||
+			((m_operation != OPERATION::READ) && (m_operation != OPERATION::WRITE)))
+		{
+			return 0;
+		}
+
+		// Stop at terminal count and at the end of the 64K page
+		// (the address wraps around, the page register doesn't change)
+		size = std::min(size, (size_t)m_count + 1);
+		return std::min(size, (size_t)0x10000 - m_address);
+	}
+
+	void DMAChannel::DMABurst(BYTE* buffer, size_t size)
+	{
+		if (!size || (GetBurstSize(size) != size))
+		{
+			throw std::exception("DMABurst: Invalid burst size");
+		}
+
+		emul::ADDRESS addr = (m_page << 16) + m_address;
+		LogPrintf(LOG_DEBUG, "DMA Burst %s, size=%zu @ Address %04x",
+			(m_operation == OPERATION::READ) ? "Read" : "Write", size, addr);
+
+		// One memory block at a time, direct copy when possible
+		const DWORD granularity = m_memory.GetBlockGranularity();
+		BYTE* curr = buffer;
+		size_t left = size;
+		while (left)
+		{
+			const DWORD chunk = (DWORD)std::min(left, (size_t)(granularity - (addr % granularity)));
+
+			if (m_operation == OPERATION::READ)
+			{
+				const BYTE* src = m_memory.GetDirectReadPtr(addr, chunk);
+				if (src)
+				{
+					memcpy(curr, src, chunk);
+				}
+				else
+				{
+					for (DWORD i = 0; i < chunk; ++i)
+					{
+						curr[i] = m_memory.Read8(addr + i);
+					}
+				}
+			}
+			else
+			{
+				BYTE* dest = m_memory.GetDirectWritePtr(addr, chunk);
+				if (dest)
+				{
+					memcpy(dest, curr, chunk);
+				}
+				else
+				{
+					for (DWORD i = 0; i < chunk; ++i)
+					{
+						m_memory.Write8(addr + i, curr[i]);
+					}
+				}
+			}
+
+			addr += chunk;
+			curr += chunk;
+			left -= chunk;
+		}
+
+		const bool done = (size == (size_t)m_count + 1);
+		m_count -= (WORD)size;
+		m_address += (WORD)size;
+		if (done)
+		{
+			CountDone();
+		}
+	}
+
 	Device8237::Device8237(const char* id, WORD baseAddress, emul::Memory& memory) :
 		Logger(id),
 		m_channels {
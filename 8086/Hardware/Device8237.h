@@ -47,7 +47,16 @@ namespace dma
 		OPERATION GetOperation() { return m_operation; }
 		void DMAOperation(BYTE& value);
 
+		// Block transfer, equivalent to [size] DMAOperation() calls.
+		// GetBurstSize returns how many of [size] bytes can be transferred at once
+		// (0: not supported in the current channel state, use DMAOperation)
+		size_t GetBurstSize(size_t size);
+		// READ: memory -> buffer, WRITE: buffer -> memory
+		void DMABurst(BYTE* buffer, size_t size);
+
 	private:
+		void CountDone();
+
 		Device8237* m_parent;
 		emul::Memory& m_memory;
 		BYTE m_id;
@@ -16,10 +16,10 @@ namespace uart
 	Device8250::Device8250(WORD baseAddress, BYTE irq, size_t clockSpeedHz) : 
 		Logger("UART8250"), 
 		m_baseAddress(baseAddress),
-		m_irq(irq)
+		m_irq(irq),
+		m_clockSpeed(clockSpeedHz)
 	{
 		Reset();
-		s_clockSpeed = clockSpeedHz;
 	}
 
 	void Device8250::Reset()
@@ -614,7 +614,7 @@ namespace uart
 	}
 	void Device8250::Serialize(json& to)
 	{
-		to["clockSpeed"] = s_clockSpeed;
+		to["clockSpeed"] = m_clockSpeed;
 
 		to["baseAddress"] = m_baseAddress;
 		to["irq"] = m_irq;
@@ -694,7 +694,7 @@ namespace uart
 	void Device8250::Deserialize(const json& from)
 	{
 		size_t clockSpeed = from["clockSpeed"];
-		if (clockSpeed != s_clockSpeed)
+		if (clockSpeed != m_clockSpeed)
 		{
 			throw emul::SerializableException("Device8250: Incompatible clockSpeed", SerializationError::COMPAT);
 		}
@@ -9,8 +9,6 @@ using emul::BYTE;
 
 namespace uart
 {
-	static size_t s_clockSpeed = 1000000;
-
 	enum class StopBits
 	{
 		ONE = '1',
@@ -60,7 +58,7 @@ namespace uart
 		void SetDCD(bool set);
 		void SetRI(bool set);
 
-		WORD GetBaudRate() const { return m_divisorLatch ? (WORD)(s_clockSpeed / ((size_t)m_divisorLatch * 16)) : 0; }
+		WORD GetBaudRate() const { return m_divisorLatch ? (WORD)(m_clockSpeed / ((size_t)m_divisorLatch * 16)) : 0; }
 
 		BYTE GetDataLength() const { return m_dataConfig.dataLength; }
 		Parity GetParity() const { return m_dataConfig.parity; }
@@ -82,6 +80,7 @@ namespace uart
 
 		const WORD m_baseAddress;
 		const BYTE m_irq = 0;
+		const size_t m_clockSpeed;
 
 		BYTE Read0();
 		void Write0(BYTE value);
@@ -26,9 +26,160 @@ namespace pit
 		Connect(m_parent->GetBaseAdress() + m_id, static_cast<PortConnector::INFunction>(&Counter::ReadData));
 		Connect(m_parent->GetBaseAdress() + m_id, static_cast<PortConnector::OUTFunction>(&Counter::WriteData));
 
+		m_syncTicks = emul::g_ticks;
 		SetGate(true);
 	}
 
+	void Counter::SetGate(bool gate)
+	{
+		if (gate == m_gate)
+		{
+			return;
+		}
+
+		// The gate is sampled at the start of the current tick
+		if (emul::g_ticks)
+		{
+			SyncTo(emul::g_ticks - 1);
+		}
+		m_gate = gate;
+		m_parent->FireCounterChange(m_id);
+	}
+
+	void Counter::SyncTo(size_t ticks)
+	{
+		if (!m_parent->IsLazyMode() || (ticks <= m_syncTicks))
+		{
+			return;
+		}
+
+		size_t elapsed = ticks - m_syncTicks;
+		m_syncTicks = ticks;
+		Advance(elapsed);
+	}
+
+	// Equivalent to calling Tick() 'ticks' times, but only the
+	// ticks where something other than a decrement happens
+	// (reload, output change, terminal count) go through Tick()
+	void Counter::Advance(size_t ticks)
+	{
+		while (ticks)
+		{
+			if (m_newValue)
+			{
+				Tick();
+				--ticks;
+			}
+			else if (!m_gate)
+			{
+				// Paused, only the first tick has side effects
+				Tick();
+				return;
+			}
+			else if (!m_lastGate)
+			{
+				// First tick after gate 0->1 (Mode 2 & 3 reload)
+				Tick();
+				--ticks;
+			}
+			else if (!m_run)
+			{
+				return;
+			}
+			else
+			{
+				size_t skip = std::min(ticks, GetTicksToNextEvent() - 1);
+				Decrement(skip);
+				ticks -= skip;
+
+				if (ticks)
+				{
+					Tick();
+					--ticks;
+				}
+			}
+		}
+	}
+
+	// Number of decrements needed to go from 'from' to 'to'
+	static size_t TicksToReach(WORD from, WORD to)
+	{
+		return (size_t)(WORD)(from - to - 1) + 1;
+	}
+
+	// Ticks until the next tick that needs to go through Tick(), for a
+	// running counter with gate high since the last tick and no pending value
+	size_t Counter::GetTicksToNextEvent() const
+	{
+		switch (m_mode)
+		{
+		case CounterMode::Mode0:
+			return TicksToReach(m_value, 0);
+		case CounterMode::Mode2:
+		case CounterMode::Mode4:
+			return std::min(TicksToReach(m_value, 1), TicksToReach(m_value, 0));
+		case CounterMode::Mode3:
+			// Odd values are decremented by 1 first
+			return (m_value & 1) ? 1 : (m_value ? (m_value / 2) : 32768);
+		default:
+			return NO_EDGE;
+		}
+	}
+
+	void Counter::Decrement(size_t ticks)
+	{
+		switch (m_mode)
+		{
+		case CounterMode::Mode0:
+		case CounterMode::Mode2:
+		case CounterMode::Mode4:
+			m_value -= (WORD)ticks;
+			break;
+		case CounterMode::Mode3:
+			m_value -= (WORD)(ticks * 2);
+			break;
+		default:
+			break;
+		}
+	}
+
+	size_t Counter::GetNextOutputEdge()
+	{
+		assert(m_parent->IsLazyMode());
+		Sync();
+
+		if (m_newValue)
+		{
+			// Reload (and possible output change) on next tick
+			return m_syncTicks + 1;
+		}
+		else if (!m_gate || !m_run)
+		{
+			return NO_EDGE;
+		}
+		else if (!m_lastGate)
+		{
+			// Gate 0->1, next tick goes through Tick()
+			return m_syncTicks + 1;
+		}
+
+		switch (m_mode)
+		{
+		case CounterMode::Mode0:
+		case CounterMode::Mode2:
+		case CounterMode::Mode4:
+			return m_syncTicks + GetTicksToNextEvent();
+		case CounterMode::Mode3:
+			if (m_value & 1)
+			{
+				return m_syncTicks + 1 + ((m_value - 1) / 2);
+			}
+			return m_syncTicks + GetTicksToNextEvent();
+		default:
+			return NO_EDGE;
+		}
+	}
+
 	void Counter::Tick()
 	{
 		if (m_newValue)
@@ -44,7 +195,7 @@ namespace pit
 				m_out = false;
 				m_value = m_n;
 				size_t ticks = (size_t)GetMaxValue() + 1;
-				m_periodMicro = (float)ticks * 1000000 / (float)s_clockSpeed;
+				m_periodMicro = (float)ticks * 1000000 / (float)m_parent->GetClockSpeed();
 				LogPrintf(LOG_INFO, "[%zu] Mode0: Starting Count, interval = %0.2fus", emul::g_ticks, m_periodMicro);
 				// Start counting on next tick
 				return;
@@ -56,15 +207,15 @@ namespace pit
 					m_value = m_n;
 				}
 				size_t ticks = GetMaxValue();
-				m_periodMicro = (float)ticks * 1000000 / (float)s_clockSpeed;
+				m_periodMicro = (float)ticks * 1000000 / (float)m_parent->GetClockSpeed();
 				LogPrintf(LOG_INFO, "[%zu] Mode2: Starting Count, period = %0.2fus", emul::g_ticks, m_periodMicro);
 				break;
 			}
 			case CounterMode::Mode3:
 			{
 				size_t ticks = GetMaxValue();
-				m_periodMicro = (float)ticks * 1000000 / (float)s_clockSpeed;
-				float freq = (float)s_clockSpeed / (float)ticks;
+				m_periodMicro = (float)ticks * 1000000 / (float)m_parent->GetClockSpeed();
+				float freq = (float)m_parent->GetClockSpeed() / (float)ticks;
 				LogPrintf(LOG_INFO, "Mode3: Frequency = %0.2fHz", freq);
 				break;
 			}
@@ -73,7 +224,7 @@ namespace pit
 				m_out = true;
 				m_value = m_n;
 				size_t ticks = (size_t)GetMaxValue() + 1;
-				m_periodMicro = (float)ticks * 1000000 / (float)s_clockSpeed;
+				m_periodMicro = (float)ticks * 1000000 / (float)m_parent->GetClockSpeed();
 				LogPrintf(LOG_INFO, "[%zu] Mode0: Starting Count, interval = %0.2fus", emul::g_ticks, m_periodMicro);
 				// Start counting on next tick
 				break;
@@ -172,6 +323,8 @@ namespace pit
 
 	BYTE Counter::ReadData()
 	{
+		Sync();
+
 		BYTE ret;
 		WORD value = (m_latched) ? m_latchedValue : m_value;
 
@@ -208,6 +361,8 @@ namespace pit
 
 	void Counter::WriteData(BYTE value)
 	{
+		Sync();
+
 		LogPrintf(LOG_DEBUG, "WriteData, value=%02Xh", value);
 		switch (m_rwMode)
 		{
@@ -240,6 +395,8 @@ namespace pit
 		default:
 			throw std::exception("Set:RWMode: Not implemented");
 		}
+
+		m_parent->FireCounterChange(m_id);
 	}
 
 	void Counter::LatchValue()
@@ -312,6 +469,8 @@ namespace pit
 		default:
 			throw std::exception("SetMode: Not implemented");
 		}
+
+		m_parent->FireCounterChange(m_id);
 	}
 
 	void Counter::SetBCD(bool bcd)
@@ -326,6 +485,8 @@ namespace pit
 
 	void Counter::Serialize(json& to)
 	{
+		Sync();
+
 		to["rwMode"] = m_rwMode;
 		to["mode"] = m_mode;
 		to["bcd"] = m_bcd;
@@ -363,6 +524,9 @@ namespace pit
 		m_latchedValue = from["latchedValue"];
 
 		m_periodMicro = from["periodMicro"];
+
+		m_syncTicks = emul::g_ticks;
+		m_parent->FireCounterChange(m_id);
 	}
 
 	// ------------------------------------------
@@ -376,10 +540,10 @@ namespace pit
 			{this, 1, "pit.t1"},
 			{this, 2, "pit.t2"}
 		},
-		m_baseAddress(baseAddress)
+		m_baseAddress(baseAddress),
+		m_clockSpeed(clockSpeedHz)
 	{
 		Reset();
-		s_clockSpeed = clockSpeedHz;
 	}
 
 	void Device8254::EnableLog(SEVERITY minSev)
@@ -416,6 +580,7 @@ namespace pit
 		}
 
 		Counter& counter = m_counters[counterSel];
+		counter.Sync();
 
 		switch (value & (CTRL_RW1 | CTRL_RW0))
 		{
@@ -462,8 +627,20 @@ namespace pit
 		counter.SetBCD(value & CTRL_BCD);
 	}
 
+	void Device8254::SetLazyMode(bool lazy)
+	{
+		LogPrintf(LOG_INFO, "SetLazyMode: %d", lazy);
+
+		m_lazy = lazy;
+		for (Counter& counter : m_counters)
+		{
+			counter.m_syncTicks = emul::g_ticks;
+		}
+	}
+
 	void Device8254::Tick()
 	{
+		assert(!m_lazy);
 		m_counters[0].Tick();
 		m_counters[1].Tick();
 		m_counters[2].Tick();
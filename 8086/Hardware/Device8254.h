@@ -2,6 +2,7 @@
 
 #include <Serializable.h>
 #include <CPU/PortConnector.h>
+#include <functional>
 
 using emul::PortConnector;
 using emul::WORD;
@@ -9,8 +10,6 @@ using emul::BYTE;
 
 namespace pit
 {
-	static size_t s_clockSpeed = 1000000;
-
 	enum class RWMode { RW_LSB, RW_MSB, RW_LSBMSB };
 	enum class CounterMode { Mode0, Mode1, Mode2, Mode3, Mode4, Mode5 };
 
@@ -31,11 +30,18 @@ namespace pit
 
 		void Tick();
 
+		// Lazy mode: bring counter up to date with emul::g_ticks
+		void Sync() { SyncTo(emul::g_ticks); }
+
+		// Lazy mode: next tick where the output can change, NO_EDGE if output is static
+		size_t GetNextOutputEdge();
+		static constexpr size_t NO_EDGE = (size_t)-1;
+
 		float GetPeriodMicro() const { return m_periodMicro; };
 
-		bool GetOutput() const { return m_out; }
+		bool GetOutput() { Sync(); return m_out; }
 		bool GetGate() const { return m_gate; }
-		void SetGate(bool gate) { m_gate = gate; }
+		void SetGate(bool gate);
 
 		void LatchValue();
 
@@ -58,6 +64,15 @@ namespace pit
 			return m_n ? m_n : (m_rwMode == RWMode::RW_LSB ? 256 : 65536);
 		}
 
+		void SyncTo(size_t ticks);
+		void Advance(size_t ticks);
+		size_t GetTicksToNextEvent() const;
+		void Decrement(size_t ticks);
+
+		size_t m_syncTicks = 0;
+
+		friend class Device8254;
+
 		RWMode m_rwMode = RWMode::RW_LSB;
 		CounterMode m_mode = CounterMode::Mode0;
 		bool m_bcd = false;
@@ -95,9 +110,21 @@ namespace pit
 
 		void Tick();
 
+		// Lazy mode: counters are not ticked, they catch up with
+		// emul::g_ticks when accessed (ports, GetOutput(), etc.)
+		void SetLazyMode(bool lazy);
+		bool IsLazyMode() const { return m_lazy; }
+
+		// Called when a counter is reprogrammed (mode, count, gate) so that
+		// the counter's next output edge can be re-evaluated
+		using CounterChangeFunc = std::function<void(BYTE counter)>;
+		void SetCounterChangeCallback(CounterChangeFunc func) { m_onCounterChange = func; }
+		void FireCounterChange(BYTE counter) { if (m_onCounterChange) m_onCounterChange(counter); }
+
 		Counter& GetCounter(size_t counter);
 
 		WORD GetBaseAdress() const { return m_baseAddress; }
+		size_t GetClockSpeed() const { return m_clockSpeed; }
 
 		virtual void Serialize(json& to);
 		virtual void Deserialize(const json& from);
@@ -115,9 +142,13 @@ namespace pit
 		};
 
 		const WORD m_baseAddress;
+		const size_t m_clockSpeed;
 
 		void WriteControl(BYTE value);
 
 		Counter m_counters[3];
+
+		bool m_lazy = false;
+		CounterChangeFunc m_onCounterChange;
 	};
 }
@@ -70,6 +70,8 @@ namespace ppi
 
 		BYTE m_portAData = 0;
 		BYTE m_portBData = 0;
+		// PORTB_OUT() logs all bits on the first write, then the changed ones
+		bool m_firstPortBSet = true;
 		BYTE m_portCData = 0;
 
 		BYTE m_controlWord = DEFAULT_CONTROLWORD;
@@ -56,11 +56,10 @@ namespace ppi
 
 		// First time we're call display all bit states, otherwise show changed only
 		BYTE diff = m_portBData ^ value;
-		static bool firstSet = true;
-		if (firstSet)
+		if (m_firstPortBSet)
 		{
 			diff = 0xFF;
-			firstSet = false;
+			m_firstPortBSet = false;
 		}
 
 		if (diff & 0x80) LogPrintf(LOG_INFO, "PB7: KSR+IRQ1 %s", value & 0x80 ? "Clear" : "Normal");
@@ -23,6 +23,9 @@ namespace pic
 
 		void InterruptRequest(BYTE interrupt, bool value = true);
 
+		// Initialization done, InterruptRequest() is ignored until then
+		bool IsReady() const { return m_state == STATE::READY; }
+
 		void AttachSecondaryDevice(BYTE irq, Device8259* secondary);
 
 		void Init();
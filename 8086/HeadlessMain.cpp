@@ -0,0 +1,71 @@
+#include "stdafx.h"
+
+// Headless batch runner
+//
+// Runs a computer created from a config file without main window,
+// overlay, monitor, console keyboard or audio output.
+//
+// Usage: hotkey86headless [config.ini]
+//
+// Run parameters are read from the [batch] section of the config file.
+// At the end of the run, a summary line is printed on stdout.
+// See BatchRunner::Main(), this file only knows the 8086 computers.
+
+#include <Config.h>
+#include <Computer/BatchRunner.h>
+
+#include "ComputerXT.h"
+#include "ComputerPCjr.h"
+#include "ComputerTandy.h"
+#include "ComputerAT.h"
+
+#include <string>
+
+using cfg::CONFIG;
+using emul::BatchRunner;
+using emul::ComputerBase;
+using emul::Computer;
+
+thread_local size_t emul::g_ticks = 0;
+
+ComputerBase* CreateComputer(const std::string& arch)
+{
+	if (arch == "xt")
+	{
+		return new emul::ComputerXT();
+	}
+	else if (arch == "at")
+	{
+		return new emul::ComputerAT();
+	}
+	else if (arch == "pcjr")
+	{
+		return new emul::ComputerPCjr();
+	}
+	else if (arch == "tandy")
+	{
+		return new emul::ComputerTandy();
+	}
+	return nullptr;
+}
+
+void SetCPUSpeed(ComputerBase& base)
+{
+	Computer& pc = static_cast<Computer&>(base);
+
+	Computer::CPUSpeeds speedList = pc.GetCPUSpeeds();
+	bool turbo = CONFIG().GetValueBool("core", "turbo");
+
+	Computer::CPUSpeeds::const_iterator currSpeed = speedList.begin();
+	if (turbo)
+	{
+		currSpeed = --speedList.end();
+	}
+
+	pc.SetCPUSpeed(*currSpeed);
+}
+
+int main(int argc, char* args[])
+{
+	return BatchRunner::Main(argc, args, CreateComputer, SetCPUSpeed);
+}
@@ -96,14 +96,12 @@ namespace joy
 
 	void DeviceJoystick::Tick()
 	{
-		static int cooldown = 8;
-
-		if (--cooldown)
+		if (--m_cooldown)
 		{
 			return;
 		}
 
-		cooldown = 8;
+		m_cooldown = TICK_DIVIDER;
 		if (m_joysticks[0].connected)
 		{
 			DecrementCount(m_joysticks[0].axisCounter[0]);
@@ -44,6 +44,10 @@ namespace joy
 
 		static void DecrementCount(uint8_t& count) { if (count) --count; }
 
+		// Axis counters run at 1/8 of the tick rate
+		static constexpr int TICK_DIVIDER = 8;
+		int m_cooldown = TICK_DIVIDER;
+
 		uint8_t Trim(const uint8_t id, const uint8_t value);
 
 		struct JoystickState
@@ -107,17 +107,17 @@ namespace kbd
 
 	void DeviceKeyboardAT::Tick()
 	{
-		static int cooldown = 0;
-		static bool keySent = false;
-
-		if (cooldown)
+		if (--m_cooldown)
 		{
-			--cooldown;
 			return;
 		}
 
-		cooldown = 10000;
+		m_cooldown = SCAN_INTERVAL;
+		Scan();
+	}
 
+	void DeviceKeyboardAT::Scan()
+	{
 		if (GetPPI()->IsKeyboardCommandPending())
 		{
 			PrepareCommand();
@@ -130,9 +130,9 @@ namespace kbd
 			ExecCommand();
 		}
 
-		if (keySent)
+		if (m_keySent)
 		{
-			keySent = false;
+			m_keySent = false;
 		}
 		else if (m_keyBufRead != m_keyBufWrite)
 		{
@@ -142,8 +142,7 @@ namespace kbd
 				m_lastByte = (BYTE)currKey;
 			}
 			m_ppi->SetCurrentKeyCode(currKey);
-			keySent = true;
+			m_keySent = true;
 		}
-
 	}
 }
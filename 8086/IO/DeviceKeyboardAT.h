@@ -50,6 +50,12 @@ namespace kbd
 
 		virtual void Tick() override;
 
+		// Keyboard scan, Tick() calls this every SCAN_INTERVAL ticks.
+		// Can also be driven directly by the scheduler.
+		void Scan();
+		// One scan tick followed by 10000 idle ticks
+		static constexpr size_t SCAN_INTERVAL = 10001;
+
 		ppi::Device8042AT* GetPPI() { return (ppi::Device8042AT*)m_ppi; }
 
 	protected:
@@ -58,6 +64,9 @@ namespace kbd
 
 		BYTE m_lastByte = 0;
 
+		size_t m_cooldown = 1;
+		bool m_keySent = false;
+
 		void Reply(KBDReply reply);
 
 		void PrepareCommand();
@@ -52,10 +52,9 @@ namespace kbd
 
 	bool DeviceKeyboardPCjr::NMIPending()
 	{
-		static bool lastNMI = false;
 		bool nmi = m_nmiLatch && m_portA0.enableNMI;
-		bool ret = (nmi && !lastNMI); // Trigger only on low-to-high transitions
-		lastNMI = nmi;
+		bool ret = (nmi && !m_lastNMI); // Trigger only on low-to-high transitions
+		m_lastNMI = nmi;
 		return ret;
 	}
 
@@ -117,15 +116,14 @@ namespace kbd
 	{
 		ppi::Device8255PCjr* ppi = (ppi::Device8255PCjr*)m_ppi;
 
-		static WORD wait = 0;
-		if (wait)
+		if (m_bitWait)
 		{
-			--wait;
+			--m_bitWait;
 		}
 		else if (IsSendingKey())
 		{
 			SendBit();
-			wait = 263; // 220 microseconds
+			m_bitWait = 263; // 220 microseconds
 		}
 		else if (m_keyBufRead != m_keyBufWrite)
 		{
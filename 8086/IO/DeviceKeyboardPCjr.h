@@ -34,6 +34,10 @@ namespace kbd
 		WORD m_baseAddress;
 
 		bool m_nmiLatch = false;
+		bool m_lastNMI = false;
+
+		// Ticks until the next serial bit is sent
+		WORD m_bitWait = 0;
 
 		struct PortA0
 		{
@@ -19,23 +19,20 @@ namespace kbd
 
 	void DeviceKeyboardTandy::Tick()
 	{
-		static int cooldown = 0;
-		static int lastBusy = false;
-
 		ppi::Device8255Tandy* ppi = (ppi::Device8255Tandy*)(m_ppi);
 		bool busy = ppi->IsKeyboardBusy();
 
 		// Busy 1->0, clear IRQ1
-		if (lastBusy && !busy)
+		if (m_lastBusy && !busy)
 		{
 			LogPrintf(LOG_DEBUG, "Clear interrupt");
 			m_pic->InterruptRequest(1, false);
 		}
-		lastBusy = busy;
+		m_lastBusy = busy;
 
-		if (cooldown)
+		if (m_cooldown)
 		{
-			--cooldown;
+			--m_cooldown;
 			return;
 		}
 
@@ -45,7 +42,7 @@ namespace kbd
 			LogPrintf(LOG_DEBUG, "Interrupt, key=%02Xh", currChar);
 			m_ppi->SetCurrentKeyCode(currChar);
 			m_pic->InterruptRequest(1);
-			cooldown = 10000;
+			m_cooldown = 10000;
 		}
 	}
 }
@@ -21,6 +21,9 @@ namespace kbd
 		virtual void Tick() override;
 
 	protected:
+		bool m_lastBusy = false;
 
+		// Ticks before the next key can be sent
+		int m_cooldown = 0;
 	};
 }
@@ -18,28 +18,27 @@ namespace kbd
 
 	void DeviceKeyboardXT::Tick()
 	{
-		static int cooldown = 0;
-		static bool keySent = false;
-
-		if (cooldown)
+		if (--m_cooldown)
 		{
-			--cooldown;
 			return;
 		}
 
-		cooldown = 10000;
+		m_cooldown = SCAN_INTERVAL;
+		Scan();
+	}
 
-		if (keySent)
+	void DeviceKeyboardXT::Scan()
+	{
+		if (m_keySent)
 		{
-			keySent = false;
+			m_keySent = false;
 			m_pic->InterruptRequest(1, false);
 		}
 		else if (m_keyBufRead != m_keyBufWrite)
 		{
 			m_ppi->SetCurrentKeyCode(m_keyBuf[m_keyBufRead++]);
 			m_pic->InterruptRequest(1);
-			keySent = true;
+			m_keySent = true;
 		}
-
 	}
 }
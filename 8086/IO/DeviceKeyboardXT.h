@@ -20,7 +20,14 @@ namespace kbd
 
 		virtual void Tick() override;
 
-	protected:
+		// Keyboard scan, Tick() calls this every SCAN_INTERVAL ticks.
+		// Can also be driven directly by the scheduler.
+		void Scan();
+		// One scan tick followed by 10000 idle ticks
+		static constexpr size_t SCAN_INTERVAL = 10001;
 
+	protected:
+		size_t m_cooldown = 1;
+		bool m_keySent = false;
 	};
 }
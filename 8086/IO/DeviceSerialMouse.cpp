@@ -6,9 +6,6 @@ using emul::SerializationError;
 
 namespace mouse
 {
-	bool DeviceSerialMouse::MouseState::left = false;
-	bool DeviceSerialMouse::MouseState::right = false;
-
 	bool DeviceSerialMouse::MouseDataPacket::Merge(MouseState mergeWith)
 	{
 		if (!IsLocked())
@@ -22,13 +19,13 @@ namespace mouse
 		return false;
 	}
 
-	BYTE DeviceSerialMouse::MouseDataPacket::GetNextByte()
+	BYTE DeviceSerialMouse::MouseDataPacket::GetNextByte(bool left, bool right)
 	{
 		switch (sentBytes++)
 		{
 		case 0: return
-			(state.right << 4) |
-			(state.left << 5) |
+			(right << 4) |
+			(left << 5) |
 			((state.dy & 0b11000000) >> 4) |
 			((state.dx & 0b11000000) >> 6) |
 			(1 << 6);
@@ -84,10 +81,10 @@ namespace mouse
 		switch (button)
 		{
 		case 0:
-			MouseState::left = clicked;
+			m_left = clicked;
 			break;
 		case 1:
-			MouseState::right = clicked;
+			m_right = clicked;
 			break;
 		default:
 			LogPrintf(LOG_ERROR, "Invalid button id");
@@ -128,7 +125,7 @@ namespace mouse
 		{
 			MouseDataPacket& packet = m_queue.front();
 
-			BYTE value = packet.GetNextByte();
+			BYTE value = packet.GetNextByte(m_left, m_right);
 			LogPrintf(LOG_DEBUG, "Send mouse data: [%02x]", value);
 			InputData(value);
 			if (!packet.HasNextByte())
@@ -155,8 +152,8 @@ namespace mouse
 		to["cooldown"] = m_cooldown;
 		to["lastRTS"] = m_lastRTS;
 
-		to["mouseState.left"] = MouseState::left;
-		to["mouseState.right"] = MouseState::right;
+		to["mouseState.left"] = m_left;
+		to["mouseState.right"] = m_right;
 
 		json queue = json::array();
 		for (auto& item : m_queue)
@@ -187,8 +184,8 @@ namespace mouse
 		m_cooldown = from["cooldown"];
 		m_lastRTS = from["lastRTS"];
 
-		MouseState::left = from["mouseState.left"];
-		MouseState::right = from["mouseState.right"];
+		m_left = from["mouseState.left"];
+		m_right = from["mouseState.right"];
 
 		const json& queue = from["queue"];
 		for (int i = 0; i < queue.size(); ++i)
@@ -33,13 +33,15 @@ namespace mouse
 			MouseState() {}
 			MouseState(int8_t dx, int8_t dy) : dx(dx), dy(dy) {}
 
-			static bool left;
-			static bool right;
 			int8_t dx = 0;
 			int8_t dy = 0;
 		};
 		void SendMouseState(MouseState state);
 
+		// Button state, sent with each packet
+		bool m_left = false;
+		bool m_right = false;
+
 		class MouseDataPacket : emul::Serializable
 		{
 		public:
@@ -49,7 +51,7 @@ namespace mouse
 			bool HasNextByte() const { return sentBytes < 3; }
 
 			bool Merge(MouseState state);
-			BYTE GetNextByte();
+			BYTE GetNextByte(bool left, bool right);
 
 			// emul::Serializable
 			virtual void Serialize(json& to) override;
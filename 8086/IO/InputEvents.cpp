@@ -394,6 +394,12 @@ namespace events
 		SDL_SetRelativeMouseMode(m_mouseCaptured ? SDL_TRUE : SDL_FALSE);
 	}
 
+	void InputEvents::RestartRecorder()
+	{
+		m_recorder.Restart();
+		m_cooldown = m_pollInterval;
+	}
+
 	void InputEvents::Tick()
 	{
 		if (--m_cooldown)
@@ -402,6 +408,16 @@ namespace events
 		}
 
 		m_cooldown = m_pollInterval;
+		Poll();
+	}
+
+	void InputEvents::Poll()
+	{
+		if (m_recorder.IsReplaying())
+		{
+			Replay();
+			return;
+		}
 
 		SDL_Event e;
 		while (!m_quit && SDL_PollEvent(&e))
@@ -426,7 +442,7 @@ namespace events
 			switch (e.type)
 			{
 			case SDL_QUIT:
-				m_quit = true;
+				InputQuit();
 				break;
 			case SDL_KEYDOWN:
 			case SDL_KEYUP:
@@ -465,9 +481,80 @@ namespace events
 			}
 		}
 	}
+
+	void InputEvents::Replay()
+	{
+		InputRecord record;
+		while (!m_quit && m_recorder.GetNext(record))
+		{
+			switch (record.type)
+			{
+			case InputRecordType::KEY:
+			{
+				SDL_KeyboardEvent evt = {};
+				evt.state = record.value ? SDL_PRESSED : SDL_RELEASED;
+				evt.repeat = record.repeat;
+				evt.keysym.scancode = (SDL_Scancode)record.code;
+				InputKey(evt);
+				break;
+			}
+			case InputRecordType::CONTROLLER_BUTTON:
+				InputControllerButton((uint8_t)record.code, record.value ? SDL_PRESSED : SDL_RELEASED);
+				break;
+			case InputRecordType::CONTROLLER_AXIS:
+				InputControllerAxis((uint8_t)record.code, (int16_t)record.value);
+				break;
+			case InputRecordType::MOUSE_BUTTON:
+				InputMouseButton((uint8_t)record.code, record.value ? SDL_PRESSED : SDL_RELEASED);
+				break;
+			case InputRecordType::MOUSE_MOTION:
+				InputMouseMotion(record.dx, record.dy);
+				break;
+			case InputRecordType::ACTION:
+				if (m_actionHandler)
+				{
+					m_actionHandler(record);
+				}
+				break;
+			case InputRecordType::QUIT:
+				InputQuit();
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	void InputEvents::Action(InputAction action, BYTE unit, int32_t value, const char* data)
+	{
+		// Actions come from the recording during a replay
+		if (m_recorder.IsReplaying())
+		{
+			LogPrintf(LOG_WARNING, "Action [%d] ignored during replay", (int)action);
+			return;
+		}
+
+		LogPrintf(LOG_INFO, "Action: [%d] unit: %d, value: %d, data: [%s]", (int)action, unit, value, data);
+
+		InputRecord record(InputRecordType::ACTION, (WORD)action, value);
+		record.unit = unit;
+		record.data = data;
+		m_recorder.Record(record);
+
+		if (m_actionHandler)
+		{
+			m_actionHandler(record);
+		}
+	}
+
 	void InputEvents::InputKey(SDL_KeyboardEvent& evt)
 	{
-		if (evt.state == SDL_PRESSED && evt.keysym.scancode == SDL_SCANCODE_SCROLLLOCK)
+		InputRecord record(InputRecordType::KEY, evt.keysym.scancode, evt.state == SDL_PRESSED);
+		record.repeat = evt.repeat;
+		m_recorder.Record(record);
+
+		// Mouse capture is a host side toggle, not replayed
+		if (!m_recorder.IsReplaying() && evt.state == SDL_PRESSED && evt.keysym.scancode == SDL_SCANCODE_SCROLLLOCK)
 		{
 			ToggleMouseCapture();
 		}
@@ -506,6 +593,8 @@ namespace events
 
 	void InputEvents::InputControllerButton(uint8_t button, uint8_t state)
 	{
+		m_recorder.Record(InputRecord(InputRecordType::CONTROLLER_BUTTON, button, state == SDL_PRESSED));
+
 		LogPrintf(LOG_DEBUG, "InputControllerButton: button[%d]=[%s]", button, (state == SDL_PRESSED) ? "PRESSED" : "RELEASED");
 		if (m_joystick)
 		{
@@ -515,6 +604,8 @@ namespace events
 	}
 	void InputEvents::InputControllerAxis(uint8_t axis, int16_t value)
 	{
+		m_recorder.Record(InputRecord(InputRecordType::CONTROLLER_AXIS, axis, value));
+
 		LogPrintf(LOG_DEBUG, "InputControllerAxis: axis[%d]=[%d]", axis, value);
 		if (m_joystick)
 		{
@@ -527,6 +618,8 @@ namespace events
 
 	void InputEvents::InputMouseButton(uint8_t button, uint8_t state)
 	{
+		m_recorder.Record(InputRecord(InputRecordType::MOUSE_BUTTON, button, state == SDL_PRESSED));
+
 		LogPrintf(LOG_DEBUG, "InputControllerAxis: button[%d] state[%d]", button, state);
 		BYTE mappedButton = 0;
 		switch (button)
@@ -542,6 +635,11 @@ namespace events
 	}
 	void InputEvents::InputMouseMotion(int32_t dx, int32_t dy)
 	{
+		InputRecord record(InputRecordType::MOUSE_MOTION);
+		record.dx = dx;
+		record.dy = dy;
+		m_recorder.Record(record);
+
 		LogPrintf(LOG_DEBUG, "InputControllerAxis: dx[%d] dy[%d]", dx, dy);
 
 		dx /= 2;
@@ -550,4 +648,10 @@ namespace events
 		m_mouse->Move(std::clamp(dx, -254, 255), std::clamp(dy, -254, 255));
 	}
 
+	void InputEvents::InputQuit()
+	{
+		m_recorder.Record(InputRecord(InputRecordType::QUIT));
+		m_quit = true;
+	}
+
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <SDL.h>
+#include <IO/InputRecorder.h>
 
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -88,9 +90,25 @@ namespace events
 		bool IsMouseCaptured() const { return m_mouseCaptured; }
 
 		void Tick();
+		// Process pending SDL events, Tick() calls this every m_pollInterval ticks
+		void Poll();
+		size_t GetPollInterval() const { return m_pollInterval; }
 
 		bool IsQuit() { return m_quit; }
 
+		// Record/replay of all the input events below
+		InputRecorder& GetRecorder() { return m_recorder; }
+		// New time base for record/replay (snapshot restored, etc.),
+		// also restarts the poll interval so polls happen at the same ticks
+		void RestartRecorder();
+
+		// External stimuli that are not SDL events (media changes from the UI, etc.).
+		// They go through the handler so they can be recorded and replayed
+		// Ignored during a replay, where they come from the recording
+		using ActionHandler = std::function<void(const InputRecord& action)>;
+		void SetActionHandler(ActionHandler handler) { m_actionHandler = handler; }
+		void Action(InputAction action, BYTE unit = 0, int32_t value = 0, const char* data = "");
+
 	protected:
 		const size_t m_clockSpeedHz;
 		const size_t m_pollInterval;
@@ -101,8 +119,14 @@ namespace events
 		void InputControllerAxis(uint8_t axis, int16_t value);
 		void InputMouseButton(uint8_t button, uint8_t state);
 		void InputMouseMotion(int32_t dx, int32_t dy);
+		void InputQuit();
 		bool m_quit = false;
 
+		// Feeds the recorded events that are due, without SDL
+		void Replay();
+		InputRecorder m_recorder;
+		ActionHandler m_actionHandler;
+
 		kbd::DeviceKeyboard* m_keyboard = nullptr;
 		KeyMap* m_keyMap = nullptr;
 
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
 #include "Monitor.h"
+#include <CPU/CPUProfiler.h>
 
 using cpuInfo::Opcode;
 using cpuInfo::Coord;
@@ -62,13 +63,26 @@ namespace emul
 				Update();
 				break;
 
+			case 64: // F6: Dump profiler data
+				if (m_cpu->GetProfiler())
+				{
+					m_cpu->GetProfiler()->Dump();
+				}
+				break;
+
 				// Not implemented, ignore
 			case 59: // F1
 			case 60: // F2
 			case 61: // F3
-			case 64: // F6
 			case 65: // F7
+				break;
 			case 67: // F9
+				if (m_cpu->GetBreakpoints())
+				{
+					m_cpu->GetBreakpoints()->ToggleExec(m_cpu->GetCurrentAddress());
+				}
+				UpdateCode();
+				break;
 			case 68: // F10
 			default:
 				break;
@@ -79,6 +93,9 @@ namespace emul
 
 	MonitorState Monitor::Run()
 	{
+		// Monitor memory reads don't trigger watchpoints
+		Breakpoints::Suspend suspend(m_cpu->GetBreakpoints());
+
 		Update();
 		if (m_runMode == RUNMode::STEP)
 		{
@@ -90,6 +107,8 @@ namespace emul
 
 	void Monitor::Show()
 	{
+		Breakpoints::Suspend suspend(m_cpu->GetBreakpoints());
+
 		std::string ansiFile = m_cpu->GetInfo().GetANSIFile();
 
 		if (ansiFile.size())
@@ -330,10 +349,13 @@ namespace emul
 		Coord pos;
 		pos.y = baseY + y;
 
+		const WORD segment = m_cpu->GetRegValue(instr.address.segment);
+		bool isBreakpoint = m_cpu->GetBreakpoints() && m_cpu->GetBreakpoints()->IsExec(S2A(segment, instr.address.offset));
+
 		pos.x = segmentPos.x;
-		WriteValueHex(m_cpu->GetRegValue(instr.address.segment), pos);
+		WriteValueHex(segment, pos, isBreakpoint ? (4 << 4) | 15 : 15);
 		pos.x = offsetPos.x;
-		WriteValueHex(instr.address.offset, pos);
+		WriteValueHex(instr.address.offset, pos, isBreakpoint ? (4 << 4) | 15 : 15);
 		pos.x = rawPos.x;
 		m_console.WriteAt(pos.x, pos.y, (const char*)instr.raw, instr.len);
 		for (int i = 0; i < rawPos.w - instr.len; ++i)
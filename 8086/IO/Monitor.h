@@ -2,6 +2,7 @@
 
 #include <IO/Console.h>
 #include <CPU/Memory.h>
+#include <CPU/Breakpoints.h>
 #include <CPU/CPUInfo.h>
 #include "../CPU/CPU8086.h"
 
@@ -22,6 +23,8 @@ namespace emul
 		void Init(CPU8086* cpu, Memory& memory);
 
 		void SetCustomMemoryView(RawSegmentOffset segoff) { m_customMemView = segoff; }
+		// Stop at breakpoint/watchpoint, call before each instruction
+		bool IsBreakpoint() { return m_cpu->GetBreakpoints() && m_cpu->GetBreakpoints()->IsBreak(m_cpu->GetCurrentAddress()); }
 
 		void Show();
 		MonitorState Run();
@@ -2,12 +2,14 @@
 
 #include <Config.h>
 #include <FileUtil.h>
+#include <SnapshotFile.h>
 #include <UI/MainWindow.h>
 #include "UI/OverlayXT.h"
 #include <Sound/Sound.h>
 
 #include <CPU/Memory.h>
 #include <CPU/MemoryBlock.h>
+#include <Computer/RewindBuffer.h>
 
 #include "IO/Console.h"
 #include "IO/Monitor.h"
@@ -46,7 +48,7 @@ using ui::MAINWND;
 using ui::Overlay;
 using ui::OverlayXT;
 
-size_t emul::g_ticks = 0;
+thread_local size_t emul::g_ticks = 0;
 
 hscommon::fileUtil::File logFile;
 
@@ -84,6 +86,16 @@ void LogCallback(const char* str)
 	}
 }
 
+// Async mode: called on the logger thread, log file only (backlog is not thread safe)
+void AsyncLogCallback(const char* str)
+{
+	if (logFile)
+	{
+		fprintf(logFile, "%s", str);
+		fflush(logFile);
+	}
+}
+
 bool consoleInit = false;
 void ShowMonitor()
 {
@@ -175,6 +187,23 @@ void InitPC(Computer* pc, Overlay& overlay, bool reset = true)
 
 	SetCPUSpeed(pc);
 
+	monitor.Init(pc->GetCPU(), pc->GetMemory());
+
+	std::string breakpointStr = CONFIG().GetValueStr("monitor", "breakpoint");
+	if (breakpointStr.size())
+	{
+		emul::RawSegmentOffset breakpoint;
+		if (breakpoint.FromString(breakpointStr.c_str()))
+		{
+			fprintf(stderr, "Set Breakpoint to [%s]\n", breakpoint.ToString());
+			pc->GetBreakpoints().AddExec(emul::S2A(breakpoint.segment, breakpoint.offset));
+		}
+		else
+		{
+			fprintf(stderr, "Unable to decode SEGMENT:OFFSET value [%s]\n", breakpointStr.c_str());
+		}
+	}
+
 	overlay.SetPC(pc);
 
 	pc->GetVideo().AddRenderer(&overlay);
@@ -215,13 +244,11 @@ void NewComputerCallback(fs::path dir, json& j)
 // To deserialize a pc from json data, you need to have it created
 // and initialized.
 //
-// However as soon as you create a new Computer object,
-// you reset some internal static things to point to the new computer object.
-//
-// Same things happens with port connections, which are global and reset
-// when you initialize the new Computer.
+// Port connections are per Computer object (see PortConnector::Context),
+// but the new Computer becomes the current port context for devices
+// created afterwards, and both machines share the same g_ticks clock.
 //
-// This means that as soon as you call CreateComputer(), you can *not* use the
+// This means that as soon as you call CreateComputer(), you should not use the
 // old Computer object anymore for anything.
 //
 // This also means that if the deseriaization fails with the new Computer, you can
@@ -235,12 +262,26 @@ Computer* RestoreNewComputerFromSnapshot()
 	// continue with the old PC.
 	bool failureIsFatal = false;
 
-	// First, load the config file so we have the proper hardware
-	fs::path config = snapshotDir;
-	config.append("config.ini");
-	if (!CONFIG().LoadConfigFile(config.string().c_str()))
+	// First, load the config so we have the proper hardware.
+	// It's stored in the snapshot file (older snapshots: config.ini)
+	emul::SnapshotFile snapshotFile;
+	fs::path snapshotPath = snapshotDir;
+	snapshotPath.append(emul::SnapshotFile::FILE_NAME);
+	if (fs::exists(snapshotPath))
 	{
-		fprintf(stderr, "Unable to read config file %s, aborting\n", config.string().c_str());
+		if (!snapshotFile.Load(snapshotPath) || !snapshotFile.LoadConfig())
+		{
+			fprintf(stderr, "Unable to read config from snapshot %s, aborting\n", snapshotPath.string().c_str());
+		}
+	}
+	else
+	{
+		fs::path config = snapshotDir;
+		config.append("config.ini");
+		if (!CONFIG().LoadConfigFile(config.string().c_str()))
+		{
+			fprintf(stderr, "Unable to read config file %s, aborting\n", config.string().c_str());
+		}
 	}
 
 	std::string arch = CONFIG().GetValueStr("core", "arch");
@@ -258,7 +299,9 @@ Computer* RestoreNewComputerFromSnapshot()
 			newPC->Init(baseRAM);
 
 			newPC->SetSerializationDir(snapshotDir);
+			newPC->SetSnapshotFile(snapshotFile.IsLoaded() ? &snapshotFile : nullptr);
 			newPC->Deserialize(snapshotData);
+			newPC->SetSnapshotFile(nullptr);
 		}
 		else
 		{
@@ -281,6 +324,7 @@ Computer* RestoreNewComputerFromSnapshot()
 		// TODO: Before restoring a snapshot, we should save state.
 		// If restore fails, re-create the original pc and restore the saved snapshot
 		fprintf(stderr, "Unrecoverable error while restoring snapshot\n");
+		Logger::EnableAsync(false);
 		exit(3);
 	}
 
@@ -312,21 +356,11 @@ int main(int argc, char* args[])
 		{
 			fprintf(stderr, "Error opening log file\n");
 		}
-	}
-
-	bool breakpointEnabled = false;
-	emul::RawSegmentOffset breakpoint;
-	std::string breakpointStr = CONFIG().GetValueStr("monitor", "breakpoint");
-	if (breakpointStr.size())
-	{
-		if (breakpoint.FromString(breakpointStr.c_str()))
+		else if (CONFIG().GetValueBool("debug", "logfile.async"))
 		{
-			breakpointEnabled = true;
-			fprintf(stderr, "Set Breakpoint to [%s]\n", breakpoint.ToString());
-		}
-		else
-		{
-			fprintf(stderr, "Unable to decode SEGMENT:OFFSET value [%s]\n", breakpointStr.c_str());
+			Logger::RegisterLogCallback(AsyncLogCallback);
+			Logger::SetTimestampFunc([]() { return emul::g_ticks; });
+			Logger::EnableAsync();
 		}
 	}
 
@@ -354,6 +388,7 @@ int main(int argc, char* args[])
 
 		fprintf(stderr, "Press any key to continue\n");
 		_getch();
+		Logger::EnableAsync(false);
 		return 0;}
 #endif
 
@@ -370,6 +405,7 @@ int main(int argc, char* args[])
 	if (!pc)
 	{
 		fprintf(stderr, "Unknown architecture: [core].arch=[%s]", arch.c_str());
+		Logger::EnableAsync(false);
 		return 2;
 	}
 
@@ -385,8 +421,6 @@ int main(int argc, char* args[])
 	pc->Reset(0xF000, 0);
 #endif
 
-	monitor.Init(pc->GetCPU(), pc->GetMemory());
-
 	if (mode == Mode::MONITOR)
 	{
 		monitor.Show();
@@ -402,9 +436,7 @@ int main(int argc, char* args[])
 
 		while (run)
 		{
-			if (breakpointEnabled &&
-				(pc->GetCPU()->GetRegValue(REG16::CS) == breakpoint.segment) &&
-				(pc->GetCPU()->GetRegValue(REG16::IP) == breakpoint.offset))
+			if (monitor.IsBreakpoint())
 			{
 				ShowMonitor();
 				mode = Mode::MONITOR;
@@ -447,6 +479,12 @@ int main(int argc, char* args[])
 					break;
 				}
 
+				// In-memory snapshots for rewind, between instructions
+				if (pc->GetRewind())
+				{
+					pc->GetRewind()->Update();
+				}
+
 				if (mode != Mode::MONITOR && _kbhit())
 				{
 					BYTE keyCode;
@@ -494,6 +532,12 @@ int main(int argc, char* args[])
 							overlay.Show(showOverlay);
 							break;
 						case FKEY + 2:
+							if (pc->GetRewind())
+							{
+								fprintf(stderr, "Rewind\n");
+								pc->GetRewind()->Rewind(1);
+							}
+							break;
 						case FKEY + 3:
 						case FKEY + 4:
 							break;
@@ -611,6 +655,9 @@ int main(int argc, char* args[])
 		delete pc;
 		pc = nullptr;
 
+		// Flush pending log records
+		Logger::EnableAsync(false);
+
 		SOUND().Cleanup();
 
 		fprintf(stderr, "Shutdown SDL Subsystems\n");
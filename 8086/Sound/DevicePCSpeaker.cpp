@@ -27,10 +27,7 @@ namespace beeper
 
 	void DevicePCSpeaker::Tick(WORD mixWithL, WORD mixWithR)
 	{
-		static int sample = 0;
-		static int32_t avg = 0;
-
 		WORD speakerData = (m_ppi->IsSoundON() && m_8254->GetCounter(2).GetOutput()) ? 1024 : 0;
-		SOUND().PlayStereo(speakerData + mixWithL, speakerData + mixWithR);
+		SOUND().SetOutput(emul::g_ticks, speakerData + mixWithL, speakerData + mixWithR);
 	}
 }
@@ -42,14 +42,12 @@ namespace dss
 
 	void DeviceSoundSource::Tick()
 	{
-		static size_t cooldown = m_tickDivider;
-
-		if (--cooldown)
+		if (--m_cooldown)
 		{
 			return;
 		}
 
-		cooldown = m_tickDivider;
+		m_cooldown = m_tickDivider;
 		m_output = Pop();
 	}
 
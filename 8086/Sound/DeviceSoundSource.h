@@ -34,6 +34,7 @@ namespace dss
 
 	protected:
 		const size_t m_tickDivider;
+		size_t m_cooldown = m_tickDivider;
 		const WORD m_baseAddress;
 
 		bool m_select = false;
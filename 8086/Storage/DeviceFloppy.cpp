@@ -269,6 +269,40 @@ namespace fdc
 		}
 	}
 
+	void DeviceFloppy::ReadDataBurst(BYTE* dest, size_t size)
+	{
+		LogPrintf(Logger::LOG_DEBUG, "ReadDataBurst, size=%zu", size);
+		if ((m_state != STATE::DMA_WAIT) || (size > m_fifo.size()))
+		{
+			LogPrintf(Logger::LOG_ERROR, "ReadDataBurst() Unexpected State: %d", m_state);
+			throw std::exception("Unexpected state");
+		}
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			dest[i] = Pop();
+		}
+		DMAAcknowledge();
+		ReadSector();
+	}
+
+	void DeviceFloppy::WriteDataBurst(const BYTE* src, size_t size)
+	{
+		LogPrintf(Logger::LOG_DEBUG, "WriteDataBurst, size=%zu", size);
+		if ((m_state != STATE::DMA_WAIT) || (m_fifo.size() + size > 512))
+		{
+			LogPrintf(Logger::LOG_ERROR, "WriteDataBurst() Unexpected State: %d", m_state);
+			throw std::exception("Unexpected state");
+		}
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			Push(src[i]);
+		}
+		DMAAcknowledge();
+		WriteSector();
+	}
+
 	void DeviceFloppy::Tick()
 	{
 		switch (m_state)
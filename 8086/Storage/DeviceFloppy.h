@@ -77,6 +77,13 @@ namespace fdc
 		void DMAAcknowledge();
 		void DMATerminalCount();
 
+		// DMA sector burst, equivalent to [size] ReadDataFIFO/WriteDataFIFO calls
+		// while waiting for DMA. Burst size = bytes left in the current sector (0: no burst)
+		size_t GetDMAReadBurstSize() const { return (m_state == STATE::DMA_WAIT) ? m_fifo.size() : 0; }
+		size_t GetDMAWriteBurstSize() const { return (m_state == STATE::DMA_WAIT) ? 512 - m_fifo.size() : 0; }
+		void ReadDataBurst(BYTE* dest, size_t size);
+		void WriteDataBurst(const BYTE* src, size_t size);
+
 		// emul::Serializable
 		virtual void Serialize(json& to);
 		virtual void Deserialize(const json& from);
@@ -1,8 +1,11 @@
 #include "stdafx.h"
 
 #include "DeviceHardDrive.h"
+#include <SnapshotFile.h>
 
 using emul::GetBit;
+using emul::SnapshotFile;
+using hscommon::fileUtil::File;
 
 namespace hdd
 {
@@ -29,7 +32,7 @@ namespace hdd
 		m_state = STATE::CMD_WAIT;
 	}
 
-	bool DeviceHardDrive::LoadDiskImage(BYTE drive, BYTE type, const char* path)
+	bool DeviceHardDrive::LoadDiskImage(BYTE drive, BYTE type, const char* path, const char* deltaPath)
 	{
 		if (drive > 1)
 		{
@@ -59,19 +62,26 @@ namespace hdd
 			return false;
 		}
 
-		hscommon::fileUtil::File f(path, "r+b");
-		if (!f)
+		HardDisk& image = m_images[drive];
+		image.Clear();
+
+		bool opened = m_copyOnWrite ?
+			image.data.OpenOverlay(path, size, deltaPath ? deltaPath : "") :
+			image.data.Open(path, size);
+
+		if (!opened)
 		{
-			LogPrintf(LOG_ERROR, "LoadDiskImage: error opening binary file");
+			LogPrintf(LOG_ERROR, "LoadDiskImage: error opening image file");
 			return false;
 		}
 
-		HardDisk& image = m_images[drive];
-		image.Clear();
 		image.type = type;
 		image.path = path;
+		if (m_copyOnWrite && deltaPath)
+		{
+			image.deltaPath = deltaPath;
+		}
 		image.loaded = true;
-		image.data.Attach(f);
 		image.geometry = geometry;
 
 		return true;
@@ -179,6 +189,40 @@ namespace hdd
 		}
 	}
 
+	void DeviceHardDrive::ReadDataBurst(BYTE* dest, size_t size)
+	{
+		LogPrintf(Logger::LOG_DEBUG, "ReadDataBurst, size=%zu", size);
+		if ((m_state != STATE::DMA_WAIT) || (size > m_fifo.size()))
+		{
+			LogPrintf(Logger::LOG_ERROR, "ReadDataBurst() Unexpected State: %d", m_state);
+			throw std::exception("Unexpected state");
+		}
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			dest[i] = Pop();
+		}
+		DMAAcknowledge();
+		ReadSector();
+	}
+
+	void DeviceHardDrive::WriteDataBurst(const BYTE* src, size_t size)
+	{
+		LogPrintf(Logger::LOG_DEBUG, "WriteDataBurst, size=%zu", size);
+		if ((m_state != STATE::DMA_WAIT) || (m_fifo.size() + size > 512))
+		{
+			LogPrintf(Logger::LOG_ERROR, "WriteDataBurst() Unexpected State: %d", m_state);
+			throw std::exception("Unexpected state");
+		}
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			Push(src[i]);
+		}
+		DMAAcknowledge();
+		WriteSector();
+	}
+
 	void DeviceHardDrive::WriteControllerReset(BYTE)
 	{
 		LogPrintf(Logger::LOG_DEBUG, "WriteControllerReset");
@@ -708,8 +752,7 @@ namespace hdd
 
 			const HardDisk& disk = m_images[m_currDrive];
 			uint32_t offset = disk.geometry.CHS2A(m_currCylinder, m_currHead, m_currSector);
-			fseek(disk.data, offset, SEEK_SET);
-			fread(m_sectorBuffer, 512, 1, disk.data);
+			disk.data.ReadSector(offset, m_sectorBuffer);
 			for (size_t b = 0; b < 512; ++b)
 			{
 				Push(m_sectorBuffer[b]);
@@ -742,10 +785,9 @@ namespace hdd
 			// Actual write to disk image
 			if (m_currcommandID != WRITE_DATA_BUFFER)
 			{
-				const HardDisk& disk = m_images[m_currDrive];
+				HardDisk& disk = m_images[m_currDrive];
 				uint32_t offset = disk.geometry.CHS2A(m_currCylinder, m_currHead, m_currSector);
-				fseek(disk.data, offset, SEEK_SET);
-				fwrite(m_sectorBuffer, 512, 1, disk.data);
+				disk.data.WriteSector(offset, m_sectorBuffer);
 			}
 
 			if (!m_commandBlock.blockCount || m_currcommandID == WRITE_DATA_BUFFER)
@@ -823,16 +865,19 @@ namespace hdd
 		{
 			to["type"] = type;
 			to["path"] = path;
+			to["deltaPath"] = deltaPath;
 		}
 
 		virtual void Deserialize(const json& from)
 		{
 			type = from["type"];
 			path = from["path"];
+			deltaPath = from.contains("deltaPath") ? from["deltaPath"].get<std::string>() : "";
 		}
 
 		BYTE type = 0;
 		std::string path;
+		std::string deltaPath;
 	};
 
 	void DeviceHardDrive::Serialize(json& to)
@@ -846,8 +891,15 @@ namespace hdd
 			{
 				info.type = m_images[i].type;
 				info.path = m_images[i].path.string();
+				info.deltaPath = m_images[i].deltaPath.string();
 
 				info.Serialize(imageJson);
+
+				// Copy-on-write: only the written sectors are saved, base image is referenced
+				if (m_images[i].data.IsOverlay() && GetSerializeDiskData())
+				{
+					SerializeDelta(i, imageJson);
+				}
 			}
 			images.push_back(imageJson);
 		}
@@ -868,7 +920,83 @@ namespace hdd
 				LoadImageInfo info;
 				info.Deserialize(images[i]);
 
-				LoadDiskImage(i, info.type, info.path.c_str());
+				// Without disk data, keep the image as is if it's the same one
+				const HardDisk& current = m_images[i];
+				if (!GetSerializeDiskData() && current.loaded && (current.type == info.type) &&
+					(current.path == info.path) && (current.deltaPath == info.deltaPath))
+				{
+					continue;
+				}
+
+				LoadDiskImage(i, info.type, info.path.c_str(), info.deltaPath.c_str());
+
+				if (images[i].contains("deltaChunk") || images[i].contains("deltaFile"))
+				{
+					DeserializeDelta(i, images[i]);
+				}
+			}
+		}
+	}
+
+	void DeviceHardDrive::SerializeDelta(BYTE drive, json& to)
+	{
+		std::vector<BYTE> delta;
+		m_images[drive].data.GetDelta(delta);
+
+		const std::string name = "hdd" + std::to_string(drive);
+		if (GetSnapshotFile())
+		{
+			GetSnapshotFile()->AddChunk(SnapshotFile::ChunkType::DISK, name, delta.data(), delta.size());
+			to["deltaChunk"] = name;
+		}
+		else
+		{
+			std::string fileName = name + ".delta.bin";
+			std::filesystem::path path = GetSerializationDir();
+			path.append(fileName);
+
+			File f(path.string().c_str(), "wb");
+			if (!f || (fwrite(delta.data(), delta.size(), 1, f) != 1))
+			{
+				throw emul::SerializableException("DeviceHardDrive: Error writing delta file");
+			}
+			to["deltaFile"] = fileName;
+		}
+	}
+
+	void DeviceHardDrive::DeserializeDelta(BYTE drive, const json& from)
+	{
+		HardDisk& disk = m_images[drive];
+		if (!disk.data.IsOverlay())
+		{
+			LogPrintf(LOG_WARNING, "Deserialize: Copy-on-write disabled, ignoring disk changes in snapshot");
+			return;
+		}
+
+		if (from.contains("deltaChunk"))
+		{
+			if (!GetSnapshotFile())
+			{
+				throw emul::SerializableException("DeviceHardDrive: No snapshot file");
+			}
+
+			size_t size;
+			const BYTE* data = GetSnapshotFile()->FindChunk(SnapshotFile::ChunkType::DISK, from["deltaChunk"].get<std::string>(), size);
+			if (!data || !disk.data.SetDelta(data, size))
+			{
+				throw emul::SerializableException("DeviceHardDrive: Error loading disk changes");
+			}
+		}
+		else
+		{
+			std::filesystem::path path = GetSerializationDir();
+			path.append(from["deltaFile"].get<std::string>());
+
+			std::vector<BYTE> delta(std::filesystem::file_size(path));
+			File f(path.string().c_str(), "rb");
+			if (!f || (fread(delta.data(), delta.size(), 1, f) != 1) || !disk.data.SetDelta(delta.data(), delta.size()))
+			{
+				throw emul::SerializableException("DeviceHardDrive: Error loading delta file");
 			}
 		}
 	}
@@ -2,7 +2,7 @@
 
 #include <CPU/PortConnector.h>
 #include <Serializable.h>
-#include <FileUtil.h>
+#include "HardDiskImage.h"
 #include <vector>
 #include <deque>
 
@@ -38,6 +38,7 @@ namespace hdd
 		{
 			type = 0;
 			path.clear();
+			deltaPath.clear();
 			loaded = false;
 
 			data.Close();
@@ -45,9 +46,10 @@ namespace hdd
 
 		BYTE type;
 		std::filesystem::path path;
+		std::filesystem::path deltaPath; // Copy-on-write only, empty = temporary
 		bool loaded = false;
 		Geometry geometry;
-		hscommon::fileUtil::File data;
+		HardDiskImage data;
 	};
 
 	class DeviceHardDrive : public PortConnector, public emul::Serializable
@@ -72,7 +74,12 @@ namespace hdd
 
 		bool IsActive(BYTE drive) { return m_commandBusy && (m_currDrive == drive); }
 
-		bool LoadDiskImage(BYTE drive, BYTE type, const char* path);
+		// Copy-on-write: images are opened read-only, writes go to a delta file
+		void SetCopyOnWrite(bool cow) { m_copyOnWrite = cow; }
+		bool IsCopyOnWrite() const { return m_copyOnWrite; }
+
+		// deltaPath: copy-on-write delta file, nullptr or empty = temporary
+		bool LoadDiskImage(BYTE drive, BYTE type, const char* path, const char* deltaPath = nullptr);
 
 		const HardDisk& GetImageInfo(BYTE drive) { assert(drive < 2); return m_images[drive]; }
 
@@ -95,11 +102,21 @@ namespace hdd
 		void DMAAcknowledge();
 		void DMATerminalCount();
 
+		// DMA sector burst, equivalent to [size] ReadDataFIFO/WriteDataFIFO calls
+		// while waiting for DMA. Burst size = bytes left in the current sector (0: no burst)
+		size_t GetDMAReadBurstSize() const { return (m_state == STATE::DMA_WAIT) ? m_fifo.size() : 0; }
+		size_t GetDMAWriteBurstSize() const { return (m_state == STATE::DMA_WAIT) ? 512 - m_fifo.size() : 0; }
+		void ReadDataBurst(BYTE* dest, size_t size);
+		void WriteDataBurst(const BYTE* src, size_t size);
+
 		// emul::Serializable
 		virtual void Serialize(json& to);
 		virtual void Deserialize(const json& from);
 
 	protected:
+		void SerializeDelta(BYTE drive, json& to);
+		void DeserializeDelta(BYTE drive, const json& from);
+
 		const WORD m_baseAddress;
 		size_t m_clockSpeed;
 		size_t m_currOpWait = 0;
@@ -362,6 +379,7 @@ namespace hdd
 		};
 
 		HardDisk m_images[2];
+		bool m_copyOnWrite = false;
 
 		BYTE m_sectorBuffer[512];
 	};
@@ -0,0 +1,309 @@
+#include "stdafx.h"
+
+#include "HardDiskImage.h"
+#include <winioctl.h>
+
+namespace hdd
+{
+	static const char DELTA_MAGIC[8] = { 'H', 'K', 'D', 'E', 'L', 'T', 'A', 0x1A };
+	static const uint32_t DELTA_VERSION = 1;
+
+	HardDiskImage::HardDiskImage() : Logger("hddImage")
+	{
+	}
+
+	HardDiskImage::~HardDiskImage()
+	{
+		Close();
+	}
+
+	bool HardDiskImage::MapFile(MappedFile& file, void* fileHandle, bool write)
+	{
+		file.fileHandle = fileHandle;
+
+		HANDLE mapping = CreateFileMappingA((HANDLE)fileHandle, NULL, write ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+		if (!mapping)
+		{
+			LogPrintf(LOG_ERROR, "MapFile: error mapping file");
+			UnmapFile(file);
+			return false;
+		}
+		file.mapHandle = mapping;
+
+		file.view = (BYTE*)MapViewOfFile(mapping, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+		if (!file.view)
+		{
+			LogPrintf(LOG_ERROR, "MapFile: error mapping file view");
+			UnmapFile(file);
+			return false;
+		}
+		return true;
+	}
+
+	void HardDiskImage::UnmapFile(MappedFile& file)
+	{
+		if (file.view)
+		{
+			UnmapViewOfFile(file.view);
+			file.view = nullptr;
+		}
+		if (file.mapHandle)
+		{
+			CloseHandle((HANDLE)file.mapHandle);
+			file.mapHandle = nullptr;
+		}
+		if (file.fileHandle)
+		{
+			CloseHandle((HANDLE)file.fileHandle);
+			file.fileHandle = nullptr;
+		}
+	}
+
+	bool HardDiskImage::Open(const std::filesystem::path& path, uint32_t size)
+	{
+		Close();
+
+		LogPrintf(LOG_INFO, "Open: [%s], size=%d", path.string().c_str(), size);
+
+		HANDLE file = CreateFileA(path.string().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			LogPrintf(LOG_ERROR, "Open: error opening image file");
+			return false;
+		}
+
+		if (!MapFile(m_imageFile, file, true))
+		{
+			return false;
+		}
+
+		m_size = size;
+		m_image = m_imageFile.view;
+		return true;
+	}
+
+	bool HardDiskImage::OpenOverlay(const std::filesystem::path& path, uint32_t size, const std::filesystem::path& deltaPath)
+	{
+		Close();
+
+		LogPrintf(LOG_INFO, "OpenOverlay: [%s], size=%d, delta=[%s]", path.string().c_str(), size,
+			deltaPath.empty() ? "(temp)" : deltaPath.string().c_str());
+
+		// Read-only, can be shared with other instances
+		HANDLE file = CreateFileA(path.string().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			LogPrintf(LOG_ERROR, "OpenOverlay: error opening image file");
+			return false;
+		}
+
+		if (!MapFile(m_imageFile, file, false))
+		{
+			return false;
+		}
+
+		m_size = size;
+		m_image = m_imageFile.view;
+
+		if (!OpenDelta(deltaPath))
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	bool HardDiskImage::OpenDelta(const std::filesystem::path& deltaPath)
+	{
+		std::string path = deltaPath.string();
+		DWORD flags = FILE_ATTRIBUTE_NORMAL;
+
+		if (path.empty())
+		{
+			char tempDir[MAX_PATH];
+			char tempFile[MAX_PATH];
+			if (!GetTempPathA(MAX_PATH, tempDir) || !GetTempFileNameA(tempDir, "hdd", 0, tempFile))
+			{
+				LogPrintf(LOG_ERROR, "OpenDelta: error creating temporary file name");
+				return false;
+			}
+			path = tempFile;
+			flags = FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE;
+		}
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_ALWAYS, flags, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			LogPrintf(LOG_ERROR, "OpenDelta: error opening delta file [%s]", path.c_str());
+			return false;
+		}
+
+		LARGE_INTEGER currSize;
+		if (!GetFileSizeEx(file, &currSize))
+		{
+			LogPrintf(LOG_ERROR, "OpenDelta: error reading delta file size");
+			CloseHandle(file);
+			return false;
+		}
+		const bool newFile = (currSize.QuadPart == 0);
+
+		// Only written sectors take disk space (NTFS), not fatal if unsupported
+		DWORD bytes;
+		if (!DeviceIoControl(file, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &bytes, NULL))
+		{
+			LogPrintf(LOG_WARNING, "OpenDelta: unable to make delta file sparse");
+		}
+
+		LARGE_INTEGER deltaSize;
+		deltaSize.QuadPart = sizeof(DeltaHeader) + GetBitmapSize() + m_size;
+
+		if (newFile)
+		{
+			if (!SetFilePointerEx(file, deltaSize, NULL, FILE_BEGIN) || !SetEndOfFile(file))
+			{
+				LogPrintf(LOG_ERROR, "OpenDelta: error setting delta file size");
+				CloseHandle(file);
+				return false;
+			}
+		}
+		else if (currSize.QuadPart != deltaSize.QuadPart)
+		{
+			LogPrintf(LOG_ERROR, "OpenDelta: delta file size doesn't match image");
+			CloseHandle(file);
+			return false;
+		}
+
+		if (!MapFile(m_deltaFile, file, true))
+		{
+			return false;
+		}
+
+		DeltaHeader* header = (DeltaHeader*)m_deltaFile.view;
+		if (newFile)
+		{
+			memcpy(header->magic, DELTA_MAGIC, sizeof(DELTA_MAGIC));
+			header->version = DELTA_VERSION;
+			header->sectorSize = SECTOR_SIZE;
+			header->imageSize = m_size;
+		}
+		else if (memcmp(header->magic, DELTA_MAGIC, sizeof(DELTA_MAGIC)) ||
+			(header->version != DELTA_VERSION) ||
+			(header->sectorSize != SECTOR_SIZE) ||
+			(header->imageSize != m_size))
+		{
+			LogPrintf(LOG_ERROR, "OpenDelta: invalid delta file");
+			UnmapFile(m_deltaFile);
+			return false;
+		}
+
+		m_bitmap = m_deltaFile.view + sizeof(DeltaHeader);
+		m_delta = m_bitmap + GetBitmapSize();
+		return true;
+	}
+
+	void HardDiskImage::Close()
+	{
+		UnmapFile(m_deltaFile);
+		m_bitmap = nullptr;
+		m_delta = nullptr;
+
+		UnmapFile(m_imageFile);
+		m_image = nullptr;
+		m_size = 0;
+	}
+
+	bool HardDiskImage::ReadSector(uint32_t offset, BYTE* dest) const
+	{
+		if (!m_image || (offset > m_size - SECTOR_SIZE))
+		{
+			LogPrintf(LOG_ERROR, "ReadSector: invalid offset %d", offset);
+			memset(dest, 0, SECTOR_SIZE);
+			return false;
+		}
+
+		const BYTE* source = (m_delta && IsInDelta(offset / SECTOR_SIZE)) ? m_delta : m_image;
+		memcpy(dest, source + offset, SECTOR_SIZE);
+		return true;
+	}
+
+	bool HardDiskImage::WriteSector(uint32_t offset, const BYTE* src)
+	{
+		if (!m_image || (offset > m_size - SECTOR_SIZE))
+		{
+			LogPrintf(LOG_ERROR, "WriteSector: invalid offset %d", offset);
+			return false;
+		}
+
+		if (m_delta)
+		{
+			const size_t sector = offset / SECTOR_SIZE;
+			memcpy(m_delta + offset, src, SECTOR_SIZE);
+			m_bitmap[sector / 8] |= (1 << (sector % 8));
+		}
+		else
+		{
+			memcpy(m_imageFile.view + offset, src, SECTOR_SIZE);
+		}
+		return true;
+	}
+
+	void HardDiskImage::GetDelta(std::vector<BYTE>& delta) const
+	{
+		delta.clear();
+		if (!m_delta)
+		{
+			return;
+		}
+
+		const size_t bitmapSize = GetBitmapSize();
+		delta.assign(m_bitmap, m_bitmap + bitmapSize);
+
+		for (size_t sector = 0; sector < GetSectorCount(); ++sector)
+		{
+			if (IsInDelta(sector))
+			{
+				const BYTE* data = m_delta + (sector * SECTOR_SIZE);
+				delta.insert(delta.end(), data, data + SECTOR_SIZE);
+			}
+		}
+	}
+
+	bool HardDiskImage::SetDelta(const BYTE* delta, size_t size)
+	{
+		if (!m_delta)
+		{
+			LogPrintf(LOG_ERROR, "SetDelta: no delta file");
+			return false;
+		}
+
+		const size_t bitmapSize = GetBitmapSize();
+		if (size < bitmapSize)
+		{
+			LogPrintf(LOG_ERROR, "SetDelta: invalid size");
+			return false;
+		}
+
+		const BYTE* bitmap = delta;
+		const BYTE* data = delta + bitmapSize;
+		const BYTE* end = delta + size;
+
+		memset(m_bitmap, 0, bitmapSize);
+		for (size_t sector = 0; sector < GetSectorCount(); ++sector)
+		{
+			if (bitmap[sector / 8] & (1 << (sector % 8)))
+			{
+				if (end - data < (ptrdiff_t)SECTOR_SIZE)
+				{
+					LogPrintf(LOG_ERROR, "SetDelta: truncated data");
+					return false;
+				}
+				memcpy(m_delta + (sector * SECTOR_SIZE), data, SECTOR_SIZE);
+				m_bitmap[sector / 8] |= (1 << (sector % 8));
+				data += SECTOR_SIZE;
+			}
+		}
+
+		LogPrintf(LOG_INFO, "SetDelta: %zu sectors", (data - (delta + bitmapSize)) / SECTOR_SIZE);
+		return true;
+	}
+}
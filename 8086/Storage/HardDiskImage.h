@@ -0,0 +1,95 @@
+#pragma once
+
+#include <CPU/CPUCommon.h>
+#include <filesystem>
+#include <vector>
+
+using emul::BYTE;
+
+namespace hdd
+{
+	// Memory mapped hard disk image
+	//
+	// Without overlay, the image is mapped read/write and
+	// sector writes go directly to the image file.
+	//
+	// With a copy-on-write overlay, the image is mapped read-only
+	// (and can be shared in the page cache by multiple instances),
+	// written sectors go to a sparse delta file instead:
+	//
+	//   DeltaHeader
+	//   Sector bitmap (1 = sector is in delta), padded to SECTOR_SIZE
+	//   Sector data, same offset as in the image
+	//
+	// The delta file is either persistent or a temporary file
+	// deleted when the image is closed.
+	class HardDiskImage : public Logger
+	{
+	public:
+		static constexpr size_t SECTOR_SIZE = 512;
+
+		HardDiskImage();
+		~HardDiskImage();
+
+		HardDiskImage(const HardDiskImage&) = delete;
+		HardDiskImage& operator=(const HardDiskImage&) = delete;
+		HardDiskImage(HardDiskImage&&) = delete;
+		HardDiskImage& operator=(HardDiskImage&&) = delete;
+
+		// Opens the image read/write
+		bool Open(const std::filesystem::path& path, uint32_t size);
+		// Opens the image read-only, with a copy-on-write delta file.
+		// Empty delta path: temporary delta file
+		bool OpenOverlay(const std::filesystem::path& path, uint32_t size, const std::filesystem::path& deltaPath);
+		void Close();
+
+		bool IsOpen() const { return m_image != nullptr; }
+		bool IsOverlay() const { return m_delta != nullptr; }
+
+		// offset: byte offset in image, multiple of SECTOR_SIZE
+		bool ReadSector(uint32_t offset, BYTE* dest) const;
+		bool WriteSector(uint32_t offset, const BYTE* src);
+
+		// Written sectors (overlay only), for snapshots:
+		// sector bitmap followed by the data of the sectors in the delta
+		void GetDelta(std::vector<BYTE>& delta) const;
+		bool SetDelta(const BYTE* delta, size_t size);
+
+	protected:
+		struct DeltaHeader
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t sectorSize;
+			uint64_t imageSize;
+			BYTE reserved[SECTOR_SIZE - 24];
+		};
+		static_assert(sizeof(DeltaHeader) == SECTOR_SIZE);
+
+		struct MappedFile
+		{
+			void* fileHandle = nullptr;
+			void* mapHandle = nullptr;
+			BYTE* view = nullptr;
+		};
+		// Takes ownership of the file handle
+		bool MapFile(MappedFile& file, void* fileHandle, bool write);
+		void UnmapFile(MappedFile& file);
+
+		bool OpenDelta(const std::filesystem::path& deltaPath);
+
+		size_t GetSectorCount() const { return m_size / SECTOR_SIZE; }
+		size_t GetBitmapSize() const { return (((GetSectorCount() + 7) / 8) + SECTOR_SIZE - 1) & ~(SECTOR_SIZE - 1); }
+
+		bool IsInDelta(size_t sector) const { return m_bitmap[sector / 8] & (1 << (sector % 8)); }
+
+		uint32_t m_size = 0;
+
+		MappedFile m_imageFile;
+		const BYTE* m_image = nullptr;
+
+		MappedFile m_deltaFile;
+		BYTE* m_bitmap = nullptr;
+		BYTE* m_delta = nullptr;
+	};
+}
@@ -283,6 +283,7 @@ namespace ui
 		emul::CPUSpeed speed = GetPC()->GetCPUSpeed();
 		sprintf(speedStr, "%.2fMHz", speed.GetSpeed() / 1000000.0f);
 		m_speedButton->SetText(speedStr);
+		SetRedraw();
 	}
 
 	void OverlayXT::UpdateFloppy(BYTE drive)
@@ -305,6 +306,7 @@ namespace ui
 		}
 
 		m_floppyButton[drive]->SetText(os.str().c_str());
+		SetRedraw();
 	}
 
 	void OverlayXT::UpdateHardDisk(BYTE drive)
@@ -328,6 +330,7 @@ namespace ui
 		}
 
 		m_hddButton[drive]->SetText(os.str().c_str());
+		SetRedraw();
 	}
 
 	void OverlayXT::UpdateTrim()
@@ -344,6 +347,7 @@ namespace ui
 			os << m_trim.y;
 			m_trimY->SetText(os.str().c_str());
 		}
+		SetRedraw();
 	}
 
 	void OverlayXT::SetTrim()
@@ -363,7 +367,13 @@ namespace ui
 		{
 			for (int i = 0; i < 2; ++i)
 			{
-				m_floppyButton[i]->SetImage(GetPC()->GetFloppy()->IsActive(i) ? m_floppyActive : m_floppyInactive);
+				const bool active = GetPC()->GetFloppy()->IsActive(i);
+				m_floppyButton[i]->SetImage(active ? m_floppyActive : m_floppyInactive);
+				if (active != m_floppyLED[i])
+				{
+					m_floppyLED[i] = active;
+					SetRedraw();
+				}
 			}
 		}
 
@@ -372,7 +382,13 @@ namespace ui
 			for (int i = 0; i < 2; ++i)
 			{
 				m_hardDriveLEDs[i].Update(GetPC()->GetHardDrive()->IsActive(i));
-				m_hddButton[i]->SetImage(m_hardDriveLEDs[i].GetStatus() ? m_hddActive : m_hddInactive);
+				const bool active = m_hardDriveLEDs[i].GetStatus();
+				m_hddButton[i]->SetImage(active ? m_hddActive : m_hddInactive);
+				if (active != m_hddLED[i])
+				{
+					m_hddLED[i] = active;
+					SetRedraw();
+				}
 			}
 		}
 
@@ -382,6 +398,7 @@ namespace ui
 			m_mouseButton->SetImage(captured ? m_mouseCaptureOn : m_mouseCaptureOff);
 			m_mouseButton->SetPushed(captured);
 			m_mouseCaptured = captured;
+			SetRedraw();
 		}
 
 		return true;
@@ -398,11 +415,11 @@ namespace ui
 
 		if (eject)
 		{
-			GetPC()->GetFloppy()->ClearDiskImage(drive);
+			GetPC()->GetInputs().Action(events::InputAction::FLOPPY_EJECT, drive);
 		}
 		else if (SelectFile(diskImage, { {"Floppy disk image (*.img)", "*.img"} }))
 		{
-			GetPC()->GetFloppy()->LoadDiskImage(drive, diskImage.string().c_str());
+			GetPC()->GetInputs().Action(events::InputAction::FLOPPY_LOAD, drive, 0, diskImage.string().c_str());
 		}
 		UpdateFloppy(drive);
 	}
@@ -54,6 +54,10 @@ namespace ui
 
 		HardDriveLED m_hardDriveLEDs[2];
 
+		// Last displayed activity lights
+		bool m_floppyLED[2] = { false, false };
+		bool m_hddLED[2] = { false, false };
+
 		bool m_mouseCaptured = false;
 
 		// UI Elements
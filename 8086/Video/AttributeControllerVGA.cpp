@@ -24,6 +24,7 @@ namespace attr_vga
 		m_data.Reset();
 		m_currMode = RegisterMode::ADDRESS;
 		m_currRegister = AttrControllerAddress::ATTR_INVALID;
+		++m_version;
 		DisconnectPorts();
 	}
 
@@ -171,6 +172,7 @@ namespace attr_vga
 				LogPrintf(LOG_ERROR, "WriteData, Invalid Address %d", m_currRegister);
 			}
 
+			++m_version;
 			m_currMode = RegisterMode::ADDRESS;
 		}
 	}
@@ -217,5 +219,7 @@ namespace attr_vga
 		m_data.videoStatusMux = from["videoStatusMux"];
 		m_data.hPelPanning = from["hPelPanning"];
 		m_data.colorSelect = from["colorSelect"];
+
+		++m_version;
 	}
 }
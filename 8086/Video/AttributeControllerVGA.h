@@ -74,6 +74,10 @@ namespace attr_vga
 		}
 		BYTE GetLastDot() const { return m_lastDot; }
 
+		// Incremented on every register write, so renderers
+		// can cache the palette mapping
+		uint32_t GetVersion() const { return m_version; }
+
 		// emul::Serializable
 		virtual void Serialize(json& to);
 		virtual void Deserialize(const json& from);
@@ -82,6 +86,7 @@ namespace attr_vga
 		const WORD m_baseAddress;
 
 		mutable BYTE m_lastDot = 0;
+		uint32_t m_version = 0;
 
 		uint32_t GetRGB32Color(BYTE value);
 
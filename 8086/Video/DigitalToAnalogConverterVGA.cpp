@@ -138,6 +138,7 @@ namespace dac_vga
 		LogPrintf(LOG_INFO, "WritePaletteData, palette[%d][%d] = %d", index, rgb, value);
 
 		SetARGB(m_data.palette[index], rgb + 1, value);
+		++m_version;
 
 		++m_writeAddress;
 		if ((m_writeAddress & 3) == 3)
@@ -168,5 +169,6 @@ namespace dac_vga
 
 		m_data.pelMask = from["pelMask"];
 		m_data.palette = from["palette"];
+		++m_version;
 	}
 }
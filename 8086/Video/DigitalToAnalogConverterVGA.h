@@ -35,6 +35,10 @@ namespace dac_vga
 
 		uint32_t GetColor(BYTE index) const { return m_data.palette[index]; }
 
+		// Incremented on every palette write, so renderers
+		// can cache the palette mapping
+		uint32_t GetVersion() const { return m_version; }
+
 		const DACData& GetData() const { return m_data; }
 
 		// emul::Serializable
@@ -49,6 +53,8 @@ namespace dac_vga
 		WORD m_readAddress = 0;
 		WORD m_writeAddress = 0;
 
+		uint32_t m_version = 0;
+
 		// Pel mask
 		BYTE ReadPelMask();
 		void WritePelMask(BYTE value);
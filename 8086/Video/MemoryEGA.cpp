@@ -6,12 +6,17 @@
 #include <Config.h>
 
 using emul::ADDRESS;
+using emul::DWORD;
 using emul::GetBit;
 using emul::SetBit;
 using cfg::CONFIG;
 
 using graph_ega::ALUFunction;
 
+using memory_planes::GetPlane;
+using memory_planes::Broadcast;
+using memory_planes::ExpandPlaneMask;
+
 namespace memory_ega
 {
 	std::string PathAppendIndex(const char* inPath, int index)
@@ -34,12 +39,7 @@ namespace memory_ega
 		m_ramSize(ramsize),
 		m_planeSize((DWORD)ramsize / 4),
 		m_planeAddressMask(m_planeSize - 1),
-		m_planes{
-			MemoryBlock("BP0", (DWORD)ramsize / 4),
-			MemoryBlock("BP1", (DWORD)ramsize / 4),
-			MemoryBlock("BP2", (DWORD)ramsize / 4),
-			MemoryBlock("BP3", (DWORD)ramsize / 4)
-		}
+		m_planes(m_planeSize, 0)
 	{
 		m_size = (DWORD)ramsize;
 		SelectCharMaps(0, 0);
@@ -49,10 +49,7 @@ namespace memory_ega
 
 	void MemoryEGA::Clear(BYTE filler)
 	{
-		for (int i = 0; i < 4; ++i)
-		{
-			m_planes[i].Clear();
-		}
+		std::fill(m_planes.begin(), m_planes.end(), 0);
 	}
 
 	void MemoryEGA::SelectCharMaps(BYTE selectA, BYTE selectB)
@@ -75,8 +72,8 @@ namespace memory_ega
 			break;
 		}
 
-		const BYTE* newA = m_planes[2].getPtr() + ((size_t)selectA * 16384);
-		const BYTE* newB = m_planes[2].getPtr() + ((size_t)selectB * 16384);
+		const DWORD* newA = m_planes.data() + ((size_t)selectA * 16384);
+		const DWORD* newB = m_planes.data() + ((size_t)selectB * 16384);
 
 		if (m_charMapA != newA || m_charMapB != newB)
 		{
@@ -86,26 +83,75 @@ namespace memory_ega
 		}
 	}
 
+	void MemoryEGA::ExportPlane(int plane, MemoryBlock& dest) const
+	{
+		BYTE* out = dest.getPtr();
+		for (DWORD i = 0; i < m_planeSize; ++i)
+		{
+			out[i] = GetPlane(m_planes[i], plane);
+		}
+	}
+
+	void MemoryEGA::ImportPlane(int plane, const MemoryBlock& src)
+	{
+		const BYTE* in = src.getPtr();
+		const int shift = plane * 8;
+		const DWORD mask = ~(0xFFu << shift);
+		for (DWORD i = 0; i < m_planeSize; ++i)
+		{
+			m_planes[i] = (m_planes[i] & mask) | ((DWORD)in[i] << shift);
+		}
+	}
+
 	bool MemoryEGA::LoadFromFile(const char* file, WORD offset)
 	{
+		MemoryBlock block("BP", m_planeSize);
 		for (int i = 0; i < 4; ++i)
 		{
 			std::string planeFile = PathAppendIndex(file, i);
 
-			if (!m_planes[i].LoadFromFile(planeFile.c_str()))
+			ExportPlane(i, block);
+			if (!block.LoadFromFile(planeFile.c_str()))
 			{
 				return false;
 			}
+			ImportPlane(i, block);
 		}
 		return true;
 	}
 
 	bool MemoryEGA::Dump(emul::ADDRESS, emul::DWORD, const char* outFile) const
 	{
+		MemoryBlock block("BP", m_planeSize);
 		for (int i = 0; i < 4; ++i)
 		{
 			std::string planeFile = PathAppendIndex(outFile, i);
-			m_planes[i].Dump(0, 0, planeFile.c_str());
+			ExportPlane(i, block);
+			block.Dump(0, 0, planeFile.c_str());
+		}
+		return true;
+	}
+
+	void MemoryEGA::SaveToSnapshot(emul::SnapshotFile& to, const std::string& name) const
+	{
+		MemoryBlock block("BP", m_planeSize);
+		for (int i = 0; i < 4; ++i)
+		{
+			ExportPlane(i, block);
+			block.SaveToSnapshot(to, name + "_" + std::to_string(i));
+		}
+	}
+
+	bool MemoryEGA::LoadFromSnapshot(const emul::SnapshotFile& from, const std::string& name)
+	{
+		MemoryBlock block("BP", m_planeSize);
+		for (int i = 0; i < 4; ++i)
+		{
+			if (!block.LoadFromSnapshot(from, name + "_" + std::to_string(i)))
+			{
+				return false;
+			}
+			ImportPlane(i, block);
 		}
 		return true;
 	}
@@ -131,32 +177,25 @@ namespace memory_ega
 
 		offset &= m_planeAddressMask;
 
-		for (int i = 0; i < 4; ++i)
-		{
-			m_dataLatches[i] = m_planes[i].read(offset);
-		}
+		m_dataLatches = m_planes[offset];
 
 		if (m_graphData->readModeCompare)
 		{
 			LogPrintf(LOG_TRACE, "Read[compare][%04x]", offset);
-			BYTE compare = 0xFF;
-			for (int i = 0; i < 4; ++i)
-			{
-				// Skip the don't care planes
-				if (GetBit(m_graphData->colorDontCare, i))
-				{
-					BYTE value = m_dataLatches[i];
-					BYTE compareWith = GetBit(m_graphData->colorCompare, i) ? 0xFF : 0;
-					BYTE match = ~(value ^ compareWith);
-					compare &= match;
-				}
-			}
-			return compare;
+			// Matching bits set in each plane, don't care planes match everything
+			DWORD match =
+				~(m_dataLatches ^ ExpandPlaneMask(m_graphData->colorCompare)) |
+				~ExpandPlaneMask(m_graphData->colorDontCare);
+
+			// AND the four planes together
+			match &= (match >> 16);
+			match &= (match >> 8);
+			return (BYTE)match;
 		}
 		else
 		{
 			LogPrintf(LOG_TRACE, "Read[%04x]", offset);
-			return m_dataLatches[selectedPlane];
+			return GetPlane(m_dataLatches, selectedPlane);
 		}
 	}
 
@@ -187,57 +226,44 @@ namespace memory_ega
 
 		offset &= m_planeAddressMask;
 
+		const DWORD latches = m_dataLatches;
+		DWORD toWrite;
 		if (m_graphData->writeMode == 1)
 		{
-			for (int i = 0; i < 4; ++i)
-			{
-				if (GetBit(planeMask, i))
-				{
-					m_planes[i].write(offset, m_dataLatches[i]);
-				}
-			}
+			toWrite = latches;
 		}
 		else // Modes 0 & 2
 		{
-			for (int i = 0; i < 4; ++i)
+			if (m_graphData->writeMode == 2)
 			{
-				if (GetBit(planeMask, i))
-				{
-					BYTE toWrite;
-					if (m_graphData->writeMode == 2)
-					{
-						toWrite = GetBit(data, i) ? 0xFF : 0;
-					}
-					else // Mode 0
-					{
-						// Set/Reset
-						if (GetBit(m_graphData->enableSetReset, i))
-						{
-							toWrite = GetBit(m_graphData->setReset, i) ? 0xFF : 0;
-						}
-						else
-						{
-							// Rotate
-							toWrite = RotateRight(data, m_graphData->rotateCount);
-						}
-					}
-
-					// ALU
-					switch (m_graphData->aluFunction)
-					{
-					case ALUFunction::AND: toWrite &= m_dataLatches[i]; break;
-					case ALUFunction::OR:  toWrite |= m_dataLatches[i]; break;
-					case ALUFunction::XOR: toWrite ^= m_dataLatches[i]; break;
-					}
-
-					// Bit Mask
-					const BYTE& latched = m_dataLatches[i];
-					BYTE masked = latched ^ ((toWrite ^ latched) & m_graphData->bitMask);
-
-					m_planes[i].write(offset, masked);
-				}
+				toWrite = ExpandPlaneMask(data);
 			}
+			else // Mode 0
+			{
+				// Set/Reset on enabled planes, rotated data on the others
+				const DWORD enableSetReset = ExpandPlaneMask(m_graphData->enableSetReset);
+				toWrite =
+					(ExpandPlaneMask(m_graphData->setReset) & enableSetReset) |
+					(Broadcast(RotateRight(data, m_graphData->rotateCount)) & ~enableSetReset);
+			}
+
+			// ALU
+			switch (m_graphData->aluFunction)
+			{
+			case ALUFunction::AND: toWrite &= latches; break;
+			case ALUFunction::OR:  toWrite |= latches; break;
+			case ALUFunction::XOR: toWrite ^= latches; break;
+			}
+
+			// Bit Mask
+			toWrite = latches ^ ((toWrite ^ latches) & Broadcast(m_graphData->bitMask));
 		}
+
+		// Map Mask
+		const DWORD planeMask32 = ExpandPlaneMask(planeMask);
+		DWORD& dest = m_planes[offset];
+		dest = (dest & ~planeMask32) | (toWrite & planeMask32);
+		MarkDirty(offset * sizeof(DWORD));
 	}
 
 	void MemoryEGA::Serialize(json& to)
@@ -248,7 +274,12 @@ namespace memory_ega
 		// Char maps are initialized by parent
 
 		to["enable"] = m_enable;
-		to["dataLatches"] = m_dataLatches;
+		std::array<BYTE, 4> dataLatches;
+		for (int i = 0; i < 4; ++i)
+		{
+			dataLatches[i] = GetPlane(m_dataLatches, i);
+		}
+		to["dataLatches"] = dataLatches;
 	}
 
 	void MemoryEGA::Deserialize(const json& from)
@@ -259,6 +290,11 @@ namespace memory_ega
 		}
 
 		m_enable = from["enable"];
-		m_dataLatches = from["dataLatches"];
+		std::array<BYTE, 4> dataLatches = from["dataLatches"];
+		m_dataLatches = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			m_dataLatches |= (DWORD)dataLatches[i] << (i * 8);
+		}
 	}
 }
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CPU/CPUCommon.h>
+#include <array>
+
+using emul::BYTE;
+using emul::DWORD;
+
+// EGA/VGA plane memory is stored interleaved, one DWORD per
+// offset with plane n in byte n, so that latches, write modes
+// and masks operate on the four planes at once
+namespace memory_planes
+{
+	// Byte of plane n
+	inline BYTE GetPlane(DWORD planes, int plane) { return (BYTE)(planes >> (plane * 8)); }
+
+	// Same byte in all planes
+	inline DWORD Broadcast(BYTE value) { return value * 0x01010101u; }
+
+	// Bit n of a 4 bit plane mask -> 0xFF in plane n
+	inline DWORD ExpandPlaneMask(BYTE mask)
+	{
+		const DWORD bits =
+			(mask & 1) |
+			((mask & 2) << 7) |
+			((mask & 4) << 14) |
+			((mask & 8) << 21);
+		return bits * 0xFF;
+	}
+
+	// Spreads the 8 bits of a plane byte to one bit per nibble,
+	// leftmost pixel (bit 7) in the lowest nibble
+	constexpr std::array<DWORD, 256> MakeSpreadTable()
+	{
+		std::array<DWORD, 256> table{};
+		for (int value = 0; value < 256; ++value)
+		{
+			DWORD spread = 0;
+			for (int bit = 0; bit < 8; ++bit)
+			{
+				if (value & (0x80 >> bit))
+				{
+					spread |= 1u << (bit * 4);
+				}
+			}
+			table[value] = spread;
+		}
+		return table;
+	}
+	inline constexpr std::array<DWORD, 256> SpreadTable = MakeSpreadTable();
+
+	// Bit transpose of the four planes into 8 packed 4 bit
+	// color indices, pixel n (left to right) in nibble n
+	inline DWORD PlanarToChunky(DWORD planes)
+	{
+		return
+			(SpreadTable[(BYTE)(planes >> 0)] << 0) |
+			(SpreadTable[(BYTE)(planes >> 8)] << 1) |
+			(SpreadTable[(BYTE)(planes >> 16)] << 2) |
+			(SpreadTable[(BYTE)(planes >> 24)] << 3);
+	}
+}
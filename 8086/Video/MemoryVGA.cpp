@@ -6,12 +6,17 @@
 #include <Config.h>
 
 using emul::ADDRESS;
+using emul::DWORD;
 using emul::GetBit;
 using emul::SetBit;
 using cfg::CONFIG;
 
 using graph_vga::ALUFunction;
 
+using memory_planes::GetPlane;
+using memory_planes::Broadcast;
+using memory_planes::ExpandPlaneMask;
+
 namespace memory_vga
 {
 	std::string PathAppendIndex(const char* inPath, int index)
@@ -34,12 +39,7 @@ namespace memory_vga
 		m_ramSize(RAMSIZE::VGA_256K),
 		m_planeSize((DWORD)m_ramSize / 4),
 		m_planeAddressMask(m_planeSize - 1),
-		m_planes{
-			MemoryBlock("BP0", (DWORD)m_ramSize / 4),
-			MemoryBlock("BP1", (DWORD)m_ramSize / 4),
-			MemoryBlock("BP2", (DWORD)m_ramSize / 4),
-			MemoryBlock("BP3", (DWORD)m_ramSize / 4)
-		}
+		m_planes(m_planeSize, 0)
 	{
 		m_size = (DWORD)m_ramSize;
 		SelectCharMaps(0, 0);
@@ -49,10 +49,7 @@ namespace memory_vga
 
 	void MemoryVGA::Clear(BYTE filler)
 	{
-		for (int i = 0; i < 4; ++i)
-		{
-			m_planes[i].Clear();
-		}
+		std::fill(m_planes.begin(), m_planes.end(), 0);
 	}
 
 	void MemoryVGA::SelectCharMaps(BYTE selectA, BYTE selectB)
@@ -60,8 +57,8 @@ namespace memory_vga
 		selectA &= 3;
 		selectB &= 3;
 
-		const BYTE* newA = m_planes[2].getPtr() + ((size_t)selectA * 16384);
-		const BYTE* newB = m_planes[2].getPtr() + ((size_t)selectB * 16384);
+		const DWORD* newA = m_planes.data() + ((size_t)selectA * 16384);
+		const DWORD* newB = m_planes.data() + ((size_t)selectB * 16384);
 
 		if (m_charMapA != newA || m_charMapB != newB)
 		{
@@ -71,26 +68,75 @@ namespace memory_vga
 		}
 	}
 
+	void MemoryVGA::ExportPlane(int plane, MemoryBlock& dest) const
+	{
+		BYTE* out = dest.getPtr();
+		for (DWORD i = 0; i < m_planeSize; ++i)
+		{
+			out[i] = GetPlane(m_planes[i], plane);
+		}
+	}
+
+	void MemoryVGA::ImportPlane(int plane, const MemoryBlock& src)
+	{
+		const BYTE* in = src.getPtr();
+		const int shift = plane * 8;
+		const DWORD mask = ~(0xFFu << shift);
+		for (DWORD i = 0; i < m_planeSize; ++i)
+		{
+			m_planes[i] = (m_planes[i] & mask) | ((DWORD)in[i] << shift);
+		}
+	}
+
 	bool MemoryVGA::LoadFromFile(const char* file, WORD offset)
 	{
+		MemoryBlock block("BP", m_planeSize);
 		for (int i = 0; i < 4; ++i)
 		{
 			std::string planeFile = PathAppendIndex(file, i);
 
-			if (!m_planes[i].LoadFromFile(planeFile.c_str()))
+			ExportPlane(i, block);
+			if (!block.LoadFromFile(planeFile.c_str()))
 			{
 				return false;
 			}
+			ImportPlane(i, block);
 		}
 		return true;
 	}
 
 	bool MemoryVGA::Dump(emul::ADDRESS, emul::DWORD, const char* outFile) const
 	{
+		MemoryBlock block("BP", m_planeSize);
 		for (int i = 0; i < 4; ++i)
 		{
 			std::string planeFile = PathAppendIndex(outFile, i);
-			m_planes[i].Dump(0, 0, planeFile.c_str());
+			ExportPlane(i, block);
+			block.Dump(0, 0, planeFile.c_str());
+		}
+		return true;
+	}
+
+	void MemoryVGA::SaveToSnapshot(emul::SnapshotFile& to, const std::string& name) const
+	{
+		MemoryBlock block("BP", m_planeSize);
+		for (int i = 0; i < 4; ++i)
+		{
+			ExportPlane(i, block);
+			block.SaveToSnapshot(to, name + "_" + std::to_string(i));
+		}
+	}
+
+	bool MemoryVGA::LoadFromSnapshot(const emul::SnapshotFile& from, const std::string& name)
+	{
+		MemoryBlock block("BP", m_planeSize);
+		for (int i = 0; i < 4; ++i)
+		{
+			if (!block.LoadFromSnapshot(from, name + "_" + std::to_string(i)))
+			{
+				return false;
+			}
+			ImportPlane(i, block);
 		}
 		return true;
 	}
@@ -121,32 +167,25 @@ namespace memory_vga
 
 		offset &= m_planeAddressMask;
 
-		for (int i = 0; i < 4; ++i)
-		{
-			m_dataLatches[i] = m_planes[i].read(offset);
-		}
+		m_dataLatches = m_planes[offset];
 
 		if (m_graphData->readModeCompare)
 		{
 			LogPrintf(LOG_TRACE, "Read[compare][%04x]", offset);
-			BYTE compare = 0xFF;
-			for (int i = 0; i < 4; ++i)
-			{
-				// Skip the don't care planes
-				if (GetBit(m_graphData->colorDontCare, i))
-				{
-					BYTE value = m_dataLatches[i];
-					BYTE compareWith = GetBit(m_graphData->colorCompare, i) ? 0xFF : 0;
-					BYTE match = ~(value ^ compareWith);
-					compare &= match;
-				}
-			}
-			return compare;
+			// Matching bits set in each plane, don't care planes match everything
+			DWORD match =
+				~(m_dataLatches ^ ExpandPlaneMask(m_graphData->colorCompare)) |
+				~ExpandPlaneMask(m_graphData->colorDontCare);
+
+			// AND the four planes together
+			match &= (match >> 16);
+			match &= (match >> 8);
+			return (BYTE)match;
 		}
 		else
 		{
 			LogPrintf(LOG_TRACE, "Read[%04x]", offset);
-			return m_dataLatches[selectedPlane];
+			return GetPlane(m_dataLatches, selectedPlane);
 		}
 	}
 
@@ -183,15 +222,11 @@ namespace memory_vga
 
 		offset &= m_planeAddressMask;
 
+		const DWORD latches = m_dataLatches;
+		DWORD toWrite;
 		if (m_graphData->writeMode == 1)
 		{
-			for (int i = 0; i < 4; ++i)
-			{
-				if (GetBit(planeMask, i))
-				{
-					m_planes[i].write(offset, m_dataLatches[i]);
-				}
-			}
+			toWrite = latches;
 		}
 		else // Modes 0,2,3
 		{
@@ -201,45 +236,40 @@ namespace memory_vga
 				mask &= RotateRight(data, m_graphData->rotateCount);
 			}
 
-			for (int i = 0; i < 4; ++i)
+			if (m_graphData->writeMode == 2)
+			{
+				toWrite = ExpandPlaneMask(data);
+			}
+			else if (m_graphData->writeMode == 3)
+			{
+				toWrite = ExpandPlaneMask(m_graphData->setReset);
+			}
+			else // Mode 0
+			{
+				// Set/Reset on enabled planes, rotated data on the others
+				const DWORD enableSetReset = ExpandPlaneMask(m_graphData->enableSetReset);
+				toWrite =
+					(ExpandPlaneMask(m_graphData->setReset) & enableSetReset) |
+					(Broadcast(RotateRight(data, m_graphData->rotateCount)) & ~enableSetReset);
+			}
+
+			// ALU
+			switch (m_graphData->aluFunction)
 			{
-				if (GetBit(planeMask, i))
-				{
-					BYTE toWrite;
-					if (m_graphData->writeMode == 2)
-					{
-						toWrite = GetBit(data, i) ? 0xFF : 0;
-					}
-					else // Mode 0, 3
-					{
-						// Set/Reset
-						if ((m_graphData->writeMode == 3) || GetBit(m_graphData->enableSetReset, i))
-						{
-							toWrite = GetBit(m_graphData->setReset, i) ? 0xFF : 0;
-						}
-						else
-						{
-							// Rotate
-							toWrite = RotateRight(data, m_graphData->rotateCount);
-						}
-					}
-
-					// ALU
-					switch (m_graphData->aluFunction)
-					{
-					case ALUFunction::AND: toWrite &= m_dataLatches[i]; break;
-					case ALUFunction::OR:  toWrite |= m_dataLatches[i]; break;
-					case ALUFunction::XOR: toWrite ^= m_dataLatches[i]; break;
-					}
-
-					// Bit Mask
-					const BYTE& latched = m_dataLatches[i];
-					BYTE masked = latched ^ ((toWrite ^ latched) & mask);
-
-					m_planes[i].write(offset, masked);
-				}
+			case ALUFunction::AND: toWrite &= latches; break;
+			case ALUFunction::OR:  toWrite |= latches; break;
+			case ALUFunction::XOR: toWrite ^= latches; break;
 			}
+
+			// Bit Mask
+			toWrite = latches ^ ((toWrite ^ latches) & Broadcast(mask));
 		}
+
+		// Map Mask
+		const DWORD planeMask32 = ExpandPlaneMask(planeMask);
+		DWORD& dest = m_planes[offset];
+		dest = (dest & ~planeMask32) | (toWrite & planeMask32);
+		MarkDirty(offset * sizeof(DWORD));
 	}
 
 	void MemoryVGA::Serialize(json& to)
@@ -250,7 +280,12 @@ namespace memory_vga
 		// Char maps are initialized by parent
 
 		to["enable"] = m_enable;
-		to["dataLatches"] = m_dataLatches;
+		std::array<BYTE, 4> dataLatches;
+		for (int i = 0; i < 4; ++i)
+		{
+			dataLatches[i] = GetPlane(m_dataLatches, i);
+		}
+		to["dataLatches"] = dataLatches;
 	}
 
 	void MemoryVGA::Deserialize(const json& from)
@@ -261,6 +296,11 @@ namespace memory_vga
 		}
 
 		m_enable = from["enable"];
-		m_dataLatches = from["dataLatches"];
+		std::array<BYTE, 4> dataLatches = from["dataLatches"];
+		m_dataLatches = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			m_dataLatches |= (DWORD)dataLatches[i] << (i * 8);
+		}
 	}
 }
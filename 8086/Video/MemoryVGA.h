@@ -1,8 +1,10 @@
 #pragma once
 #include <CPU/MemoryBlock.h>
 #include <Serializable.h>
+#include "MemoryPlanes.h"
 
 #include <array>
+#include <vector>
 
 namespace graph_vga
 {
@@ -35,17 +37,27 @@ namespace memory_vga
 		virtual void write(emul::ADDRESS offset, BYTE data) override;
 
 		// Direct access to ram for video card drawing
-		BYTE readRaw(BYTE plane, emul::ADDRESS offset) { return m_planes[plane].read(offset); }
+		BYTE readRaw(BYTE plane, emul::ADDRESS offset) const { return memory_planes::GetPlane(m_planes[offset], plane); }
+		// All four planes, see MemoryPlanes.h
+		emul::DWORD readRaw32(emul::ADDRESS offset) const { return m_planes[offset]; }
 
 		// Character Maps
 		void SelectCharMaps(BYTE selectA, BYTE selectB);
 
-		const BYTE* GetCharMapB() const { return m_charMapA; }
-		const BYTE* GetCharMapA() const { return m_charMapB; }
+		// Character maps are in plane 2
+		BYTE GetCharMapB(size_t offset) const { return memory_planes::GetPlane(m_charMapA[offset], 2); }
+		BYTE GetCharMapA(size_t offset) const { return memory_planes::GetPlane(m_charMapB[offset], 2); }
 
 		virtual bool LoadFromFile(const char* file, WORD offset = 0) override;
 		virtual bool Dump(emul::ADDRESS offset, emul::DWORD len, const char* outFile) const override;
 
+		// Plane data, interleaved. Pages are flagged dirty in write()
+		virtual BYTE* GetRawData() override { return (BYTE*)m_planes.data(); }
+		virtual emul::DWORD GetRawSize() const override { return m_planeSize * sizeof(emul::DWORD); }
+
+		virtual void SaveToSnapshot(emul::SnapshotFile& to, const std::string& name) const override;
+		virtual bool LoadFromSnapshot(const emul::SnapshotFile& from, const std::string& name) override;
+
 		// emul::Serializable
 		virtual void Serialize(json& to) override;
 		virtual void Deserialize(const json& from) override;
@@ -60,10 +72,15 @@ namespace memory_vga
 		const emul::DWORD m_planeSize;
 		const emul::ADDRESS m_planeAddressMask;
 
-		MemoryBlock m_planes[4];
-		mutable std::array<BYTE, 4> m_dataLatches = { 0, 0, 0, 0 };
+		// Plane data, interleaved
+		std::vector<emul::DWORD> m_planes;
+		mutable emul::DWORD m_dataLatches = 0;
+
+		// Plane <-> flat block, for files and snapshots
+		void ExportPlane(int plane, MemoryBlock& dest) const;
+		void ImportPlane(int plane, const MemoryBlock& src);
 
-		const BYTE* m_charMapA = nullptr;
-		const BYTE* m_charMapB = nullptr;
+		const emul::DWORD* m_charMapA = nullptr;
+		const emul::DWORD* m_charMapB = nullptr;
 	};
 }
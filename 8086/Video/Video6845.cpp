@@ -13,14 +13,17 @@ namespace video
 	Video6845::Video6845(WORD baseAddress, BYTE charWidth) :
 		Logger("Video6845"),
 		m_baseAddress(baseAddress),
-		m_crtc(baseAddress, charWidth)
+		m_crtc(baseAddress, charWidth),
+		m_textAttr(256)
 	{
 		Reset();
 	}
 
 	void Video6845::Reset()
 	{
+		m_div2 = false;
 		m_crtc.Reset();
+		InvalidateText();
 	}
 
 	void Video6845::EnableLog(SEVERITY minSev)
@@ -93,6 +96,94 @@ namespace video
 			((config.cursor == CRTCConfig::CURSOR_BLINK32 && m_crtc.IsBlink32()) || m_crtc.IsBlink16());
 	}
 
+	void Video6845::DrawTextChar16(const BYTE* charROM, BYTE ch, BYTE attr, bool blink, WORD lastGlyphRow)
+	{
+		const struct CRTCData& data = m_crtc.GetData();
+
+		if (!m_textLine.valid ||
+			(m_textLine.vPos != data.vPos) ||
+			(m_textLine.frame != data.frame) ||
+			(m_textLine.crtcWrites != m_crtc.GetWriteCount()) ||
+			(m_textLine.palette != GetMonitorPalette()) ||
+			(m_textLine.blink != blink))
+		{
+			LatchTextLine(charROM, blink, lastGlyphRow);
+		}
+
+		BYTE glyph = m_textLine.glyphRow[(size_t)ch * 8];
+		if (m_textLine.cursorRow && IsCursor())
+		{
+			glyph = 0xFF;
+		}
+		else if (blink && GetBit(attr, 7) && !m_textLine.blinkVisible)
+		{
+			glyph = 0;
+		}
+
+		const TextAttr& pixels = GetTextAttr(attr);
+		DrawPixels(pixels.pixels[glyph >> 4], 4);
+		DrawPixels(pixels.pixels[glyph & 0x0F], 4);
+	}
+
+	void Video6845::LatchTextLine(const BYTE* charROM, bool blink, WORD lastGlyphRow)
+	{
+		const struct CRTCConfig& config = m_crtc.GetConfig();
+		const struct CRTCData& data = m_crtc.GetData();
+
+		// Attribute pixels depend on the colors and the meaning of bit 7
+		bool colorsChanged = (blink != m_textLine.blink);
+		for (BYTE i = 0; i < 16; ++i)
+		{
+			const uint32_t color = GetColor(i);
+			if (color != m_textLine.colors[i])
+			{
+				m_textLine.colors[i] = color;
+				colorsChanged = true;
+			}
+		}
+		if (colorsChanged)
+		{
+			std::fill(std::begin(m_textAttrValid), std::end(m_textAttrValid), false);
+		}
+
+		m_textLine.valid = true;
+		m_textLine.vPos = data.vPos;
+		m_textLine.frame = data.frame;
+		m_textLine.crtcWrites = m_crtc.GetWriteCount();
+		m_textLine.palette = GetMonitorPalette();
+		m_textLine.blink = blink;
+
+		m_textLine.glyphRow = charROM + std::min(data.rowAddress, lastGlyphRow);
+		m_textLine.cursorRow = (data.rowAddress >= config.cursorStart) && (data.rowAddress <= config.cursorEnd);
+		m_textLine.blinkVisible = m_crtc.IsBlink16();
+	}
+
+	const Video6845::TextAttr& Video6845::GetTextAttr(BYTE attr)
+	{
+		TextAttr& entry = m_textAttr[attr];
+		if (!m_textAttrValid[attr])
+		{
+			BYTE bg = attr >> 4;
+			if (m_textLine.blink) // Hi bit: intense bg vs blink fg
+			{
+				SetBit(bg, 3, false);
+			}
+
+			const uint32_t fgColor = m_textLine.colors[attr & 0x0F];
+			const uint32_t bgColor = m_textLine.colors[bg];
+
+			for (BYTE nibble = 0; nibble < 16; ++nibble)
+			{
+				for (BYTE x = 0; x < 4; ++x)
+				{
+					entry.pixels[nibble][x] = (nibble & (0x08 >> x)) ? fgColor : bgColor;
+				}
+			}
+			m_textAttrValid[attr] = true;
+		}
+		return entry;
+	}
+
 	void Video6845::Draw320x200x4()
 	{
 		const struct CRTCData& data = GetCRTC().GetData();
@@ -135,16 +226,7 @@ namespace video
 
 			for (int w = 0; w < 2; ++w)
 			{
-				BYTE ch = m_memory->Read8(base++);
-
-				DrawPixel((ch & 0b10000000) ? fg : bg);
-				DrawPixel((ch & 0b01000000) ? fg : bg);
-				DrawPixel((ch & 0b00100000) ? fg : bg);
-				DrawPixel((ch & 0b00010000) ? fg : bg);
-				DrawPixel((ch & 0b00001000) ? fg : bg);
-				DrawPixel((ch & 0b00000100) ? fg : bg);
-				DrawPixel((ch & 0b00000010) ? fg : bg);
-				DrawPixel((ch & 0b00000001) ? fg : bg);
+				DrawGlyphRow(m_memory->Read8(base++), fg, bg);
 			}
 		}
 		else
@@ -210,5 +292,6 @@ namespace video
 	{
 		Video::Deserialize(from);
 		m_crtc.Deserialize(from["crtc"]);
+		InvalidateText();
 	}
 }
@@ -51,6 +51,28 @@ namespace video
 		crtc_6845::CRTController& GetCRTC() { return m_crtc; }
 		const crtc_6845::CRTController& GetCRTC() const { return m_crtc; }
 
+		// Clock divider for adapters that run the crtc at half speed in some modes
+		bool m_div2 = false;
+
+		// 8 pixels of a character row, msb first, colors already resolved
+		void DrawGlyphRow(BYTE glyph, uint32_t fg, uint32_t bg)
+		{
+			for (int x = 0; x < 8; ++x)
+			{
+				DrawPixel((glyph & (0x80 >> x)) ? fg : bg);
+			}
+		}
+
+		// One character of a 16 color text mode (CGA, PCjr, Tandy).
+		// charROM points to the 8x8 font, 8 bytes per character.
+		// blink: attribute bit 7 is fg blink instead of bg intensity.
+		// Glyph rows past lastGlyphRow repeat the last row
+		void DrawTextChar16(const BYTE* charROM, BYTE ch, BYTE attr, bool blink, WORD lastGlyphRow = 31);
+
+		// Drops the text scanline latch and attribute colors,
+		// call when a register that affects text colors is written
+		void InvalidateText() { m_textLine.valid = false; }
+
 		// Common drawing functions
 		void Draw320x200x4();
 		void Draw640x200x2();
@@ -59,5 +81,36 @@ namespace video
 
 	private:
 		crtc_6845::CRTController m_crtc;
+
+		// Text state that is constant for a scanline, latched on its
+		// first character. A crtc or adapter register write drops the
+		// latch, so a mid-line change is seen from the next character on
+		struct TextLine
+		{
+			bool valid = false;
+			WORD vPos = 0;
+			size_t frame = 0;
+			size_t crtcWrites = 0;
+			const uint32_t* palette = nullptr;
+			bool blink = false;
+
+			const BYTE* glyphRow = nullptr; // Font row for character 0
+			bool cursorRow = false;
+			bool blinkVisible = false;
+			uint32_t colors[16] = {};
+		} m_textLine;
+
+		void LatchTextLine(const BYTE* charROM, bool blink, WORD lastGlyphRow);
+
+		// Pixels for each attribute and glyph nibble (4 pixels, msb first),
+		// built on first use and dropped when the latched colors change
+		struct TextAttr
+		{
+			uint32_t pixels[16][4];
+		};
+		std::vector<TextAttr> m_textAttr;
+		bool m_textAttrValid[256] = {};
+
+		const TextAttr& GetTextAttr(BYTE attr);
 	};
 }
@@ -95,6 +95,7 @@ namespace video
 	void VideoCGA::WriteModeControlRegister(BYTE value)
 	{
 		LogPrintf(Logger::LOG_DEBUG, "WriteModeControlRegister, value=%02Xh", value);
+		InvalidateText();
 
 		m_mode.text80Columns = GetBit(value, 0);
 		m_mode.graphics = GetBit(value, 1);
@@ -117,6 +118,7 @@ namespace video
 	void VideoCGA::WriteColorSelectRegister(BYTE value)
 	{
 		LogPrintf(Logger::LOG_DEBUG, "WriteColorSelectRegister, value=%02Xh", value);
+		InvalidateText();
 
 		m_color.color = (value & 15);
 		m_color.palIntense = value & 16;
@@ -133,9 +135,8 @@ namespace video
 		// Halve the clock for all modes except 80 cols
 		if (!m_mode.text80Columns)
 		{ 
-			static bool div2 = false;
-			div2 = !div2;
-			if (div2)
+			m_div2 = !m_div2;
+			if (m_div2)
 			{
 				return;
 			}
@@ -161,38 +162,14 @@ namespace video
 
 	void VideoCGA::DrawTextMode()
 	{
-		const struct CRTCData& data = GetCRTC().GetData();
-		const struct CRTCConfig& config = GetCRTC().GetConfig();
-
 		if (GetCRTC().IsDisplayArea() && IsEnabled())
 		{
 			ADDRESS base = GetAddress();
 
-			bool isCursorChar = IsCursor();
 			BYTE ch = m_memory->Read8(base);
 			BYTE attr = m_memory->Read8(base + 1);
 
-			BYTE bg = attr >> 4;
-			BYTE fg = attr & 0x0F;
-			bool charBlink = false;
-
-			// Background
-			if (m_mode.blink) // Hi bit: intense bg vs blink fg
-			{
-				charBlink = GetBit(bg, 3);
-				SetBit(bg, 3, false);
-			}
-
-			// Draw character
-			BYTE currChar = m_charROM.read(m_charROMStart + ((size_t)ch * 8) + data.rowAddress);
-			bool draw = !charBlink || (charBlink && GetCRTC().IsBlink16());
-
-			bool cursorLine = isCursorChar && (data.rowAddress >= config.cursorStart) && (data.rowAddress <= config.cursorEnd);
-			for (int x = 0; x < 8; ++x)
-			{
-				bool set = draw && GetBit(currChar, 7 - x);
-				DrawPixel(GetColor((set || cursorLine) ? fg : bg));
-			}
+			DrawTextChar16(m_charROM.getPtr() + m_charROMStart, ch, attr, m_mode.blink);
 		}
 		else
 		{
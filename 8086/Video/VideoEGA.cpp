@@ -16,6 +16,10 @@ using crtc_ega::CRTCData;
 using memory_ega::RAMSIZE;
 using memory_ega::MemoryEGA;
 
+using memory_planes::GetPlane;
+using memory_planes::ExpandPlaneMask;
+using memory_planes::PlanarToChunky;
+
 using graph_ega::GraphControllerData;
 using graph_ega::ALUFunction;
 
@@ -174,12 +178,11 @@ namespace video
 
 		if (m_misc.clockSel == MISCRegister::ClockSelect::CLK_16)
 		{
-			static uint32_t tick16 = 0;
 			// Add two ticks every 15 ticks to approximate 16 mhz clock
 			// Gives 16.227MHz instead of 16.257Mhz (0.2% off)
-			if (++tick16 == 15)
+			if (++m_clockTicks == 15)
 			{
-				tick16 = 0;
+				m_clockTicks = 0;
 				InternalTick();
 				InternalTick();
 			}
@@ -192,9 +195,8 @@ namespace video
 	{
 		if (m_sequencer.GetData().clockingMode.halfDotClock)
 		{
-			static bool div2 = false;
-			div2 = !div2;
-			if (div2)
+			m_halfDotClockSkip = !m_halfDotClockSkip;
+			if (m_halfDotClockSkip)
 			{
 				return;
 			}
@@ -398,7 +400,7 @@ namespace video
 			}
 
 			// Draw character
-			BYTE currChar = m_egaRAM.GetCharMapA()[((size_t)ch * 0x20) + crtcData.rowAddress];
+			BYTE currChar = m_egaRAM.GetCharMapA(((size_t)ch * 0x20) + crtcData.rowAddress);
 			bool draw = !charBlink || (charBlink && m_crtc.IsBlink16());
 
 			// TODO: This is not the correct behavior
@@ -463,7 +465,7 @@ namespace video
 			uint32_t bgRGB = GetColor(bg);
 
 			// Draw character
-			BYTE currChar = m_egaRAM.GetCharMapA()[((size_t)ch * 0x20) + crtcData.rowAddress];
+			BYTE currChar = m_egaRAM.GetCharMapA(((size_t)ch * 0x20) + crtcData.rowAddress);
 			bool draw = !charBlink || (charBlink && m_crtc.IsBlink16());
 
 			bool underline = draw && (charUnderline & (crtcData.rowAddress == crtcConfig.underlineLocation));
@@ -516,10 +518,11 @@ namespace video
 		if (IsDisplayArea() && IsEnabled() && (crtcData.hPos < crtcData.hTotalDisp))
 		{
 			ADDRESS base = GetAddress();
+			const DWORD planes = m_egaRAM.readRaw32(base) & ExpandPlaneMask(attrData.colorPlaneEnable);
 			BYTE pixData[4];
 			for (int i = 0; i < 4; ++i)
 			{
-				pixData[i] = GetBit(attrData.colorPlaneEnable, i) ? m_egaRAM.readRaw(i, base) : 0;
+				pixData[i] = GetPlane(planes, i);
 			}
 
 			for (int i = 0; i < 2; ++i)
@@ -544,7 +547,7 @@ namespace video
 	void VideoEGA::DrawGraphMode()
 	{
 		const struct CRTCData& crtcData = m_crtc.GetData();
-		const struct AttrControllerData attrData = m_attrController.GetData();
+		const struct AttrControllerData& attrData = m_attrController.GetData();
 
 		BYTE pelPanning = m_syncPelPanning ? m_newPelPanning : attrData.hPelPanning;
 
@@ -552,37 +555,32 @@ namespace video
 		if (IsDisplayArea() && IsEnabled())
 		{
 			ADDRESS base = GetAddress();
-			BYTE pixData[4];
-			for (int i = 0; i < 4; ++i)
+			const DWORD planes = m_egaRAM.readRaw32(base) & ExpandPlaneMask(attrData.colorPlaneEnable);
+
+			// 8 color indices, leftmost pixel in low nibble
+			DWORD pixels = PlanarToChunky(planes);
+
+			// For graphics mode blink, flip ATR3 every 16 frames
+			if (attrData.blink && m_crtc.IsBlink16())
 			{
-				pixData[i] = GetBit(attrData.colorPlaneEnable, i) ?  m_egaRAM.readRaw(i, base) : 0;
+				pixels ^= 0x88888888;
 			}
 
-			int startBit = 7;
-			int endBit = 0;
+			int count = 8;
 			if (crtcData.hPos == 0)
 			{
-				startBit -= pelPanning;
+				pixels >>= ((pelPanning & 7) * 4);
+				count -= pelPanning;
 			}
 			else if (crtcData.hPos == crtcData.hTotalDisp)
 			{
-				endBit = 8 - pelPanning;
+				count = pelPanning;
 			}
+			count = std::min(count, 8);
 
-			for (int i = startBit; i >= endBit; --i)
+			for (int i = 0; i < count; ++i, pixels >>= 4)
 			{
-				BYTE color =
-					(GetBit(pixData[0], i) << 0) |
-					(GetBit(pixData[1], i) << 1) |
-					(GetBit(pixData[2], i) << 2) |
-					(GetBit(pixData[3], i) << 3);
-
-				// For graphics mode blink, flip ATR3 every 16 frames
-				if (attrData.blink && m_crtc.IsBlink16())
-				{
-					color ^= 0b1000;
-				}
-				DrawPixel(GetColor(color));
+				DrawPixel(attrData.palette[pixels & 15]);
 			}
 		}
 		else
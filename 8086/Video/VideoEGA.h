@@ -68,6 +68,9 @@ namespace video
 		BYTE m_newPelPanning = 0;
 
 		void InternalTick();
+		// Dot clock approximation (CLK_16) and half dot clock dividers
+		uint32_t m_clockTicks = 0;
+		bool m_halfDotClockSkip = false;
 
 		bool IsCursor() const;
 
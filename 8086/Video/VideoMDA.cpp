@@ -140,21 +140,20 @@ namespace video
 			bool underline = draw && (charUnderline & (data.rowAddress == config.maxScanlineAddress));
 
 			bool cursorLine = isCursorChar && (data.rowAddress >= config.cursorStart) && (data.rowAddress <= config.cursorEnd);
-			bool lastDot = false;
-			for (int x = 0; x < 9; ++x)
+			if (cursorLine || underline)
 			{
-				if (x < 8)
-				{
-					lastDot = draw && GetBit(currChar, 7 - x);
-				}
-				// Characters C0h - DFh: 9th pixel == 8th pixel, otherwise blank
-				else if ((ch < 0xC0) || (ch > 0xDF))
-				{
-					lastDot = 0;
-				}
-
-				DrawPixel((lastDot || cursorLine || underline) ? fgRGB : bgRGB);
+				currChar = 0xFF;
 			}
+			else if (!draw)
+			{
+				currChar = 0;
+			}
+
+			DrawGlyphRow(currChar, fgRGB, bgRGB);
+
+			// Characters C0h - DFh: 9th pixel == 8th pixel, otherwise blank
+			bool lastDot = (cursorLine || underline) || (GetBit(currChar, 0) && (ch >= 0xC0) && (ch <= 0xDF));
+			DrawPixel(lastDot ? fgRGB : bgRGB);
 		}
 		else
 		{
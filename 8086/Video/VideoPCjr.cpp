@@ -130,6 +130,7 @@ namespace video
 		else // Set Register value
 		{
 			LogPrintf(Logger::LOG_DEBUG, "WriteGateArrayRegister, data=%02Xh", value);
+			InvalidateText();
 			if (m_mode.currRegister & GA_PALETTE)
 			{
 				// TODO: When loading the palette, the video is 'disabled' and the color viewed on the screen
@@ -268,9 +269,8 @@ namespace video
 	{
 		if (!m_mode.hiBandwidth)
 		{
-			static bool div2 = false;
-			div2 = !div2;
-			if (div2)
+			m_div2 = !m_div2;
+			if (m_div2)
 			{
 				return;
 			}
@@ -281,38 +281,14 @@ namespace video
 
 	void VideoPCjr::DrawTextMode()
 	{
-		const struct CRTCData& data = GetCRTC().GetData();
-		const struct CRTCConfig& config = GetCRTC().GetConfig();
-
 		if (IsDisplayArea() && IsEnabled())
 		{
 			ADDRESS base = GetAddress();
 
-			bool isCursorChar = IsCursor();
 			BYTE ch = m_memory->Read8(base);
 			BYTE attr = m_memory->Read8(base + 1);
 
-			BYTE bg = attr >> 4;
-			BYTE fg = attr & 0x0F;
-			bool charBlink = false;
-
-			// Background
-			if (m_mode.blink) // Hi bit: intense bg vs blink fg
-			{
-				charBlink = GetBit(bg, 3);
-				SetBit(bg, 3, false);
-			}
-
-			// Draw character
-			BYTE currChar = m_charROM.read(m_charROMStart + ((size_t)ch * 8) + data.rowAddress);
-			bool draw = !charBlink || (charBlink && GetCRTC().IsBlink16());
-
-			bool cursorLine = isCursorChar && (data.rowAddress >= config.cursorStart) && (data.rowAddress <= config.cursorEnd);
-			for (int x = 0; x < 8; ++x)
-			{
-				bool set = draw && GetBit(currChar, 7 - x);
-				DrawPixel(GetColor((set || cursorLine) ? fg : bg));
-			}
+			DrawTextChar16(m_charROM.getPtr() + m_charROMStart, ch, attr, m_mode.blink);
 		}
 		else
 		{
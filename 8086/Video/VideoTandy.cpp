@@ -75,6 +75,7 @@ namespace video
 	void VideoTandy::WriteModeControlRegister(BYTE value)
 	{
 		LogPrintf(Logger::LOG_DEBUG, "WriteModeControlRegister, value=%02Xh", value);
+		InvalidateText();
 
 		m_mode.hiDotClock = GetBit(value, 0);
 		m_mode.graphics = GetBit(value, 1);
@@ -97,6 +98,7 @@ namespace video
 	void VideoTandy::WriteColorSelectRegister(BYTE value)
 	{
 		LogPrintf(Logger::LOG_DEBUG, "WriteColorSelectRegister, value=%02Xh", value);
+		InvalidateText();
 
 		m_color.color = (value & 15);
 		m_color.palIntense = GetBit(value, 4);
@@ -175,6 +177,7 @@ namespace video
 	void VideoTandy::WriteVideoArrayData(BYTE value)
 	{
 		LogPrintf(Logger::LOG_DEBUG, "WriteVideoArrayData, data=%02Xh", value);
+		InvalidateText();
 		if (m_videoArrayRegisterAddress & GA_PALETTE)
 		{
 			// TODO: When loading the palette, the video is 'disabled' and the color viewed on the screen
@@ -274,9 +277,8 @@ namespace video
 	{
 		if (!m_mode.hiDotClock)
 		{
-			static bool div2 = false;
-			div2 = !div2;
-			if (div2)
+			m_div2 = !m_div2;
+			if (m_div2)
 			{
 				return;
 			}
@@ -301,48 +303,20 @@ namespace video
 
 	void VideoTandy::DrawTextMode()
 	{
-		const struct CRTCData& data = GetCRTC().GetData();
-		const struct CRTCConfig& config = GetCRTC().GetConfig();
-
 		if (IsDisplayArea() && IsEnabled())
 		{
 			ADDRESS base = GetAddress();
 
-			bool isCursorChar = IsCursor();
 			BYTE ch = m_memory->Read8(base);
 			BYTE attr = m_memory->Read8(base + 1);
 
-			BYTE bg = attr >> 4;
-			BYTE fg = attr & 0x0F;
-			bool charBlink = false;
-
-			// Background
-			if (m_mode.blink) // Hi bit: intense bg vs blink fg
-			{
-				charBlink = GetBit(bg, 3);
-				SetBit(bg, 3, false);
-			}
-
-			// Draw character
 			// 225 lines char mode: Extend line 8 to 9 for some characters, need info (assuming B0-DF)
-			WORD rowAddress = data.rowAddress;
-			if (rowAddress > 7)
+			if ((GetCRTC().GetData().rowAddress > 7) && ((ch < 0xB0) || (ch >= 0xE0)))
 			{
-				rowAddress = 7;
-				if ((ch < 0xB0) || (ch >= 0xE0))
-				{
-					ch = 0;
-				}
+				ch = 0;
 			}
-			BYTE currChar = m_charROM.read(m_charROMStart + ((size_t)ch * 8) + rowAddress);
-			bool draw = !charBlink || (charBlink && GetCRTC().IsBlink16());
 
-			bool cursorLine = isCursorChar && (data.rowAddress >= config.cursorStart) && (data.rowAddress <= config.cursorEnd);
-			for (int x = 0; x < 8; ++x)
-			{
-				bool set = draw && GetBit(currChar, 7 - x);
-				DrawPixel(GetColor((set || cursorLine) ? fg : bg));
-			}
+			DrawTextChar16(m_charROM.getPtr() + m_charROMStart, ch, attr, m_mode.blink, 7);
 		}
 		else
 		{
@@ -16,6 +16,10 @@ using crtc_vga::CRTCData;
 using memory_vga::RAMSIZE;
 using memory_vga::MemoryVGA;
 
+using memory_planes::GetPlane;
+using memory_planes::ExpandPlaneMask;
+using memory_planes::PlanarToChunky;
+
 using graph_vga::GraphControllerData;
 using graph_vga::ALUFunction;
 
@@ -237,10 +241,9 @@ namespace video
 			// Double ticks, skip one out of four
 			// Gives 25.056MHz (0.5% off)
 			// TODO: Improve this
-			static uint32_t tick4 = 0;
-			if (++tick4 == 4)
+			if (++m_clockTicks == 4)
 			{
-				tick4 = 0;
+				m_clockTicks = 0;
 			}
 			else
 			{
@@ -263,9 +266,8 @@ namespace video
 	{
 		if (m_sequencer.GetData().clockingMode.halfDotClock)
 		{
-			static bool div2 = false;
-			div2 = !div2;
-			if (div2)
+			m_halfDotClockSkip = !m_halfDotClockSkip;
+			if (m_halfDotClockSkip)
 			{
 				return;
 			}
@@ -530,7 +532,7 @@ namespace video
 			}
 
 			// Draw character
-			BYTE currChar = m_vgaRAM.GetCharMapA()[((size_t)ch * 0x20) + crtcData.rowAddress];
+			BYTE currChar = m_vgaRAM.GetCharMapA(((size_t)ch * 0x20) + crtcData.rowAddress);
 			bool draw = !charBlink || (charBlink && m_crtc.IsBlink16());
 
 			// TODO: This is not the correct behavior
@@ -607,7 +609,7 @@ namespace video
 			uint32_t bgRGB = GetColor(bg);
 
 			// Draw character
-			BYTE currChar = m_vgaRAM.GetCharMapA()[((size_t)ch * 0x20) + crtcData.rowAddress];
+			BYTE currChar = m_vgaRAM.GetCharMapA(((size_t)ch * 0x20) + crtcData.rowAddress);
 			bool draw = !charBlink || (charBlink && m_crtc.IsBlink16());
 
 			bool underline = draw && (charUnderline & (crtcData.rowAddress == crtcConfig.underlineLocation));
@@ -660,10 +662,11 @@ namespace video
 		if (IsDisplayArea() && IsEnabled() && (crtcData.hPos < crtcData.hTotalDisp))
 		{
 			ADDRESS base = GetAddress();
+			const DWORD planes = m_vgaRAM.readRaw32(base) & ExpandPlaneMask(attrData.colorPlaneEnable);
 			BYTE pixData[4];
 			for (int i = 0; i < 4; ++i)
 			{
-				pixData[i] = GetBit(attrData.colorPlaneEnable, i) ? m_vgaRAM.readRaw(i, base) : 0;
+				pixData[i] = GetPlane(planes, i);
 			}
 
 			for (int i = 0; i < 2; ++i)
@@ -685,47 +688,65 @@ namespace video
 		}
 	}
 
+	void VideoVGA::UpdateIndexedColors()
+	{
+		if (m_attrController.GetVersion() == m_attrVersion && m_dac.GetVersion() == m_dacVersion)
+		{
+			return;
+		}
+
+		for (BYTE i = 0; i < 16; ++i)
+		{
+			m_indexedColors[i] = GetIndexedColor(i);
+		}
+		m_attrVersion = m_attrController.GetVersion();
+		m_dacVersion = m_dac.GetVersion();
+	}
+
 	void VideoVGA::DrawGraphMode()
 	{
 		const struct CRTCData& crtcData = m_crtc.GetData();
-		const struct AttrControllerData attrData = m_attrController.GetData();
+		const struct AttrControllerData& attrData = m_attrController.GetData();
 
 		// Called every 8 horizontal pixels
 		if (IsEnabled() && IsDisplayArea() && !m_crtc.IsVBlank())
 		{
+			UpdateIndexedColors();
+
 			ADDRESS base = GetAddress();
-			BYTE pixData[4];
-			for (int i = 0; i < 4; ++i)
+			const DWORD planes = m_vgaRAM.readRaw32(base) & ExpandPlaneMask(attrData.colorPlaneEnable);
+
+			// 8 color indices, leftmost pixel in low nibble
+			DWORD pixels = PlanarToChunky(planes);
+
+			if (crtcData.hPos == crtcData.hTotalDisp)
 			{
-				pixData[i] = GetBit(attrData.colorPlaneEnable, i) ?  m_vgaRAM.readRaw(i, base) : 0;
+				// Only the leftmost pixels (panning) are visible
+				pixels &= (DWORD)((1ull << (m_framePelPanning * 4)) - 1);
+			}
 
-				if (crtcData.hPos == crtcData.hTotalDisp)
-				{
-					pixData[i] &= (0xFF << (8 - m_framePelPanning));
-				}
+			// For graphics mode blink, flip ATR3 every 16 frames
+			if (attrData.blink && m_crtc.IsBlink16())
+			{
+				pixels ^= 0x88888888;
 			}
 
-			int startBit = 7;
+			int count = 8;
 			if (crtcData.hPos == 0)
 			{
-				startBit -= m_framePelPanning;
+				pixels >>= ((m_framePelPanning & 7) * 4);
+				count -= m_framePelPanning;
 			}
 
-			for (int i = startBit; i >= 0; --i)
+			BYTE color = 0;
+			for (int i = 0; i < count; ++i, pixels >>= 4)
 			{
-				BYTE color =
-					(GetBit(pixData[0], i) << 0) |
-					(GetBit(pixData[1], i) << 1) |
-					(GetBit(pixData[2], i) << 2) |
-					(GetBit(pixData[3], i) << 3);
-
-				// For graphics mode blink, flip ATR3 every 16 frames
-				if (attrData.blink && m_crtc.IsBlink16())
-				{
-					color ^= 0b1000;
-				}
-				DrawPixel(GetColor(color));
+				color = pixels & 15;
+				DrawPixel(m_indexedColors[color]);
 			}
+
+			// Keep the attribute controller's last dot (status register) in sync
+			m_attrController.GetColor(color);
 		}
 		else
 		{
@@ -740,7 +761,7 @@ namespace video
 		// Called every 4 horizontal pixel
 		if (IsEnabled() && IsDisplayArea() && !m_crtc.IsBlank())
 		{
-			ADDRESS base = GetAddress();
+			const DWORD planes = m_vgaRAM.readRaw32(GetAddress());
 
 			bool blankRight = false;
 			int startBit = 3;
@@ -757,7 +778,7 @@ namespace video
 
 			for (int i = startBit; i >= endBit; --i)
 			{
-				DrawPixel(GetColor(m_vgaRAM.readRaw(3 - i, base)));
+				DrawPixel(GetColor(GetPlane(planes, 3 - i)));
 			}
 			if (blankRight)
 			{
@@ -68,6 +68,9 @@ namespace video
 		BYTE AdjustPelPanning(BYTE pelPan) const;
 
 		void InternalTick();
+		// Dot clock approximation (CLK_25) and half dot clock dividers
+		uint32_t m_clockTicks = 0;
+		bool m_halfDotClockSkip = false;
 
 		bool IsCursor() const;
 
@@ -128,6 +131,13 @@ namespace video
 		uint32_t GetIndexedColor(BYTE index) const { return m_dac.GetColor(m_attrController.GetColor(index)); }
 		uint32_t GetColor256(BYTE index) const { return m_dac.GetColor(index); }
 
+		// GetIndexedColor for the 16 color indices, rebuilt
+		// when the attribute controller or DAC is written to
+		std::array<uint32_t, 16> m_indexedColors = {};
+		uint32_t m_attrVersion = UINT32_MAX;
+		uint32_t m_dacVersion = UINT32_MAX;
+		void UpdateIndexedColors();
+
 		void DrawTextMode();
 		void DrawTextModeMDA();
 		void DrawGraphMode();
@@ -6,10 +6,16 @@
 using namespace std::filesystem;
 
 #define TEST_CPU 1
+#define TEST_PIT 1
+#define TEST_REP 1
 
 const path workingDirectory = "../";
 
 int testCPU();
+int testPIT();
+int testREP();
+
+thread_local size_t emul::g_ticks = 0;
 
 void LogCallback(const char* str)
 {
@@ -22,9 +28,21 @@ int main(int argc, char* argv[])
 
 	Logger::RegisterLogCallback(LogCallback);
 
+	// Each test returns its number of failures
+	int fail = 0;
+
 #if TEST_CPU
-	testCPU();
+	fail += testCPU();
+#endif
+
+#if TEST_PIT
+	fail += testPIT();
+#endif
+
+#if TEST_REP
+	fail += testREP();
 #endif
 
-	return 0;
+	fprintf(stdout, "%d test failure(s)\n", fail);
+	return fail ? 1 : 0;
 }
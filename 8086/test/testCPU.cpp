@@ -1,9 +1,14 @@
 #include "stdafx.h"
 
 #include "../CPU/CPU8086.h"
+#include "../CPU/CPU80286.h"
 #include <functional>
+#include <chrono>
 
 using emul::CPU8086;
+using emul::CPU80286;
+using emul::SEGREG286;
+using emul::Selector;
 using emul::REG16;
 using emul::GetLByte;
 using emul::GetLWord;
@@ -11,6 +16,9 @@ using namespace std::filesystem;
 using emul::PortConnector;
 using emul::PortConnectorMode;
 
+// Set to 1 to time fault delivery (FaultBenchmark), not a test
+#define BENCH_FAULT 0
+
 // JSONTester class runs the processor tests from https://github.com/TomHarte/ProcessorTests/tree/main/8088/v1
 // 
 // Set path to json test cases here:
@@ -27,6 +35,16 @@ public:
 	CPU8086Test(emul::Memory& mem) : CPU8086(mem), Logger("CPU8086Test") {}
 
 	friend class JSONTester;
+	friend class FaultBenchmark;
+	friend class PrefixTimingTester;
+};
+
+class CPU80286Test : public CPU80286
+{
+public:
+	CPU80286Test(emul::Memory& mem) : CPU80286(mem), Logger("CPU80286Test") {}
+
+	friend class ProtectedModeFaultTester;
 };
 
 class TesterBase : public Logger
@@ -35,7 +53,7 @@ public:
 	TesterBase(const char* id) : Logger(id), m_memory(1024)
 	{
 		EnableLog(Logger::LOG_INFO);
-		PortConnector::Init(PortConnectorMode::WORD);
+		PortConnector::GetCurrentContext().Init(PortConnectorMode::WORD);
 		m_memory.Init(emul::CPU8086_ADDRESS_BITS);
 		NewCPU();
 		LogPrintf(LOG_INFO, "Start");
@@ -44,6 +62,9 @@ public:
 	virtual ~TesterBase() {};
 	virtual void test() = 0;
 
+	// Number of failed test cases
+	int GetFailCount() const { return m_fail; }
+
 	void NewCPU()
 	{
 		delete m_cpu;
@@ -80,6 +101,7 @@ public:
 protected:
 	emul::Memory m_memory;
 	CPU8086Test* m_cpu = nullptr;
+	int m_fail = 0;
 };
 
 class JSONTester : public TesterBase
@@ -178,12 +200,14 @@ public:
 		else
 		{
 			LogPrintf(LOG_ERROR, "Error loading test case file: [%s]", m_currPath.string().c_str());
+			++m_fail;
 			return;
 		}
 
 		if (!testCases.is_array())
 		{
 			LogPrintf(LOG_ERROR, "Expected array");
+			++m_fail;
 			return;
 		}
 
@@ -227,6 +251,7 @@ public:
 		LogPrintf(LOG_INFO, separator);
 		LogPrintf(LOG_INFO, "Total tests: %d", tests);
 		LogPrintf(LOG_INFO, "Fail: %d", fail);
+		m_fail += fail;
 	}
 
 	virtual void test() override
@@ -326,7 +351,7 @@ public:
 	{
 		if (!exists(testCaseFilesPath))
 		{			
-			LogPrintf(LOG_ERROR, "test case(s) not found: %s\n", testCaseFilesPath.string().c_str());
+			LogPrintf(LOG_WARNING, "test case(s) not found, skipping: %s\n", testCaseFilesPath.string().c_str());
 			return false;
 		}
 
@@ -342,9 +367,281 @@ public:
 	emul::WORD m_flagMask = 0xFFFF;
 };
 
+// FaultBenchmark times small loops that fault on every iteration
+// (divide error, single step trap) against the same loops without faults.
+// All interrupt vectors point to an IRET.
+class FaultBenchmark : public TesterBase
+{
+public:
+	FaultBenchmark() : TesterBase("BENCH_FAULT"), m_ram("RAM", 1 * 1024 * 1024)
+	{
+	}
+
+	virtual void test() override
+	{
+		m_memory.Allocate(&m_ram, 0);
+
+		// IRET at 0050:0000
+		m_memory.Write8(IRET_ADDRESS, 0xCF);
+		for (int i = 0; i < 256; ++i)
+		{
+			m_memory.Write16(i * 4, 0);
+			m_memory.Write16(i * 4 + 2, IRET_ADDRESS >> 4);
+		}
+
+		// DIV BL; JMP $-4
+		const std::vector<BYTE> div = { 0xF6, 0xF3, 0xEB, 0xFC };
+		// NOP; JMP $-3
+		const std::vector<BYTE> nop = { 0x90, 0xEB, 0xFD };
+
+		bench("DIV", div, 1, false);
+		bench("DIV #DE", div, 0, false);
+		bench("NOP", nop, 0, false);
+		bench("NOP TF", nop, 0, true);
+	}
+
+protected:
+	void bench(const char* name, const std::vector<BYTE>& code, BYTE bl, bool trap)
+	{
+		for (size_t i = 0; i < code.size(); ++i)
+		{
+			m_memory.Write8(CODE_ADDRESS + (emul::ADDRESS)i, code[i]);
+		}
+
+		m_cpu->m_reg.Get16(REG16::AX) = 0x1234;
+		m_cpu->m_reg.Get16(REG16::BX) = bl;
+		m_cpu->m_reg.Get16(REG16::CS) = CODE_ADDRESS >> 4;
+		m_cpu->m_reg.Get16(REG16::IP) = 0;
+		m_cpu->m_reg.Get16(REG16::SS) = 0x8000;
+		m_cpu->m_reg.Get16(REG16::SP) = 0xFFFE;
+		m_cpu->SetFlags(trap ? CPU8086Test::FLAG_T : 0);
+		m_cpu->inSegOverride = false;
+		m_cpu->inRep = false;
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < STEPS; ++i)
+		{
+			m_cpu->Step();
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		LogPrintf(LOG_INFO, "%-10s %8.1f ns/step", name, ns / STEPS);
+	}
+
+	static constexpr int STEPS = 1000000;
+	static constexpr emul::ADDRESS IRET_ADDRESS = 0x500;
+	static constexpr emul::ADDRESS CODE_ADDRESS = 0x1000;
+
+	emul::MemoryBlock m_ram;
+};
+
+// PrefixTimingTester checks that a segment override prefix is charged
+// on top of the instruction it applies to (2 clocks on the 8086).
+// Prefix and instruction run in the same Step()
+class PrefixTimingTester : public TesterBase
+{
+public:
+	PrefixTimingTester() : TesterBase("TEST_PREFIX"), m_ram("RAM", 1 * 1024 * 1024)
+	{
+	}
+
+	virtual void test() override
+	{
+		m_memory.Allocate(&m_ram, 0);
+
+		m_memory.Write16(DS_ADDRESS + 0x10, 0x1234);
+		m_memory.Write16(ES_ADDRESS + 0x10, 0x5678);
+
+		// MOV AX,[BX]
+		const emul::DWORD ticks = run({ 0x8B, 0x07 });
+		bool ok = ExpectEqual((WORD)0x1234, m_cpu->m_reg.Get16(REG16::AX), "MOV AX,[BX]");
+
+		// ES: MOV AX,[BX]
+		const emul::DWORD ticksES = run({ 0x26, 0x8B, 0x07 });
+		ok &= ExpectEqual((WORD)0x5678, m_cpu->m_reg.Get16(REG16::AX), "ES: MOV AX,[BX]");
+		ok &= ExpectEqual((emul::DWORD)(ticks + SEG_OVERRIDE_TICKS), ticksES, "ES: MOV AX,[BX] ticks");
+
+		LogPrintf(ok ? LOG_INFO : LOG_ERROR, "Segment override ticks %s", ok ? "OK" : "FAIL");
+		m_fail += !ok;
+	}
+
+protected:
+	emul::DWORD run(const std::vector<BYTE>& code)
+	{
+		for (size_t i = 0; i < code.size(); ++i)
+		{
+			m_memory.Write8(CODE_ADDRESS + (emul::ADDRESS)i, code[i]);
+		}
+
+		m_cpu->m_reg.Get16(REG16::AX) = 0;
+		m_cpu->m_reg.Get16(REG16::BX) = 0x10;
+		m_cpu->m_reg.Get16(REG16::CS) = CODE_ADDRESS >> 4;
+		m_cpu->m_reg.Get16(REG16::DS) = DS_ADDRESS >> 4;
+		m_cpu->m_reg.Get16(REG16::ES) = ES_ADDRESS >> 4;
+		m_cpu->m_reg.Get16(REG16::IP) = 0;
+		m_cpu->SetFlags(0);
+		m_cpu->inSegOverride = false;
+		m_cpu->inRep = false;
+
+		m_cpu->Step();
+		return m_cpu->GetInstructionTicks();
+	}
+
+	static constexpr emul::DWORD SEG_OVERRIDE_TICKS = 2;
+
+	static constexpr emul::ADDRESS CODE_ADDRESS = 0x1000;
+	static constexpr emul::ADDRESS DS_ADDRESS = 0x2000;
+	static constexpr emul::ADDRESS ES_ADDRESS = 0x3000;
+
+	emul::MemoryBlock m_ram;
+};
+
+// ProtectedModeFaultTester runs 286 protected mode instructions with a memory
+// operand past the data segment limit. The #GP has to go through the IDT and
+// leave the destination registers, segments and stack untouched
+class ProtectedModeFaultTester : public TesterBase
+{
+public:
+	ProtectedModeFaultTester() : TesterBase("TEST_PM_FAULT"), m_ram("RAM", 1 * 1024 * 1024)
+	{
+	}
+
+	~ProtectedModeFaultTester()
+	{
+		delete m_cpu286;
+	}
+
+	virtual void test() override
+	{
+		m_memory.Allocate(&m_ram, 0);
+
+		m_cpu286 = new CPU80286Test(m_memory);
+		m_cpu286->Init();
+
+		// GDT: null, code, data (past DATA_LIMIT faults), stack
+		SetDescriptor(SEL_CODE, CODE_ADDRESS, 0xFFFF, 0x9A);
+		SetDescriptor(SEL_DATA, DATA_ADDRESS, DATA_LIMIT, 0x92);
+		SetDescriptor(SEL_STACK, STACK_ADDRESS, 0xFFFF, 0x92);
+
+		// IDT: #GP interrupt gate to the handler
+		const emul::ADDRESS gate = IDT_ADDRESS + ((emul::ADDRESS)emul::CPUExceptionType::EX_GENERAL_PROTECTION * 8);
+		m_memory.Write16(gate, HANDLER_OFFSET);
+		m_memory.Write16(gate + 2, SEL_CODE);
+		m_memory.Write8(gate + 5, 0x86);
+
+		m_cpu286->m_gdt.base = GDT_ADDRESS;
+		m_cpu286->m_gdt.limit = 0xFF;
+		m_cpu286->m_idt.base = IDT_ADDRESS;
+		m_cpu286->m_idt.limit = 0xFF;
+		m_cpu286->m_msw = (CPU80286Test::MSW)(m_cpu286->m_msw | CPU80286Test::MSW_PE);
+
+		// Memory operands at DS:1000
+		m_fail += !run("LODSB", { 0xAC });
+		m_fail += !run("XLAT", { 0xD7 });
+		m_fail += !run("LES BX", { 0xC4, 0x1E, 0x00, 0x10 });
+		m_fail += !run("MOV DS", { 0x8E, 0x1E, 0x00, 0x10 });
+		m_fail += !run("JMP FAR", { 0xFF, 0x2E, 0x00, 0x10 });
+		m_fail += !run("CALL FAR", { 0xFF, 0x1E, 0x00, 0x10 });
+
+		LogPrintf(m_fail ? LOG_ERROR : LOG_INFO, "%d failure(s)", m_fail);
+	}
+
+protected:
+	void SetDescriptor(Selector sel, emul::ADDRESS base, WORD limit, BYTE access)
+	{
+		const emul::ADDRESS address = GDT_ADDRESS + (sel.GetIndex() * 8);
+		m_memory.Write16(address, limit);
+		m_memory.Write16(address + 2, GetLWord(base));
+		m_memory.Write8(address + 4, GetLByte(emul::GetHWord(base)));
+		m_memory.Write8(address + 5, access);
+	}
+
+	void SetSegment(SEGREG286 segreg, Selector sel)
+	{
+		m_cpu286->UpdateTranslationRegister(segreg, sel, m_cpu286->LoadSegment(sel));
+	}
+
+	bool run(const char* name, const std::vector<BYTE>& code)
+	{
+		for (size_t i = 0; i < code.size(); ++i)
+		{
+			m_memory.Write8(CODE_ADDRESS + (emul::ADDRESS)i, code[i]);
+		}
+
+		auto& reg = m_cpu286->m_reg;
+
+		SetSegment(SEGREG286::CS, SEL_CODE);
+		SetSegment(SEGREG286::DS, SEL_DATA);
+		SetSegment(SEGREG286::ES, SEL_DATA);
+		SetSegment(SEGREG286::SS, SEL_STACK);
+		reg[REG16::IP] = 0;
+		reg[REG16::SP] = STACK_TOP;
+		reg[REG16::AX] = 0x1200;
+		reg[REG16::BX] = 0x1000;
+		reg[REG16::SI] = 0x1000;
+		m_cpu286->SetFlags(0);
+		m_cpu286->inSegOverride = false;
+		m_cpu286->inRep = false;
+
+		bool ok = m_cpu286->Step();
+
+		// Delivered to the #GP handler, only the interrupt frame is pushed
+		ok &= ExpectEqual((WORD)SEL_CODE, reg[REG16::CS], "cs");
+		ok &= ExpectEqual(HANDLER_OFFSET, reg[REG16::IP], "ip");
+		ok &= ExpectEqual((WORD)(STACK_TOP - 6), reg[REG16::SP], "sp");
+
+		// Faulting instruction has no effect
+		ok &= ExpectEqual((WORD)0x1200, reg[REG16::AX], "ax");
+		ok &= ExpectEqual((WORD)0x1000, reg[REG16::BX], "bx");
+		ok &= ExpectEqual((WORD)0x1000, reg[REG16::SI], "si");
+		ok &= ExpectEqual((WORD)SEL_DATA, reg[REG16::DS], "ds");
+		ok &= ExpectEqual((WORD)SEL_DATA, reg[REG16::ES], "es");
+
+		LogPrintf(ok ? LOG_INFO : LOG_ERROR, "%-10s %s", name, ok ? "OK" : "FAIL");
+		return ok;
+	}
+
+	static constexpr emul::ADDRESS GDT_ADDRESS = 0x10000;
+	static constexpr emul::ADDRESS IDT_ADDRESS = 0x11000;
+	static constexpr emul::ADDRESS CODE_ADDRESS = 0x20000;
+	static constexpr emul::ADDRESS DATA_ADDRESS = 0x30000;
+	static constexpr emul::ADDRESS STACK_ADDRESS = 0x40000;
+
+	static constexpr WORD SEL_CODE = 0x08;
+	static constexpr WORD SEL_DATA = 0x10;
+	static constexpr WORD SEL_STACK = 0x18;
+
+	static constexpr WORD DATA_LIMIT = 0xFF;
+	static constexpr WORD STACK_TOP = 0x100;
+	static constexpr WORD HANDLER_OFFSET = 0x100;
+
+	CPU80286Test* m_cpu286 = nullptr;
+	emul::MemoryBlock m_ram;
+};
 
 int testCPU()
 {
+	int fail = 0;
+
+#if BENCH_FAULT
+	{
+		FaultBenchmark bench;
+		bench.test();
+	}
+#endif
+
+	{
+		PrefixTimingTester tester;
+		tester.test();
+		fail += tester.GetFailCount();
+	}
+
+	{
+		ProtectedModeFaultTester tester;
+		tester.test();
+		fail += tester.GetFailCount();
+	}
 
 	//{
 	//	EAModeTester tester;
@@ -352,20 +649,15 @@ int testCPU()
 	//}
 
 	{
+		// Test case files are not part of the repository, skip when not found
 		JSONTester tester;
-		if (!tester.setup())
-		{
-			return 1;
-		}
-				
-		if (!tester.readTestcaseFiles())
+		if (tester.setup() && tester.readTestcaseFiles())
 		{
-			return 2;
+			tester.readSummaryFile();
+			tester.test();
+			fail += tester.GetFailCount();
 		}
-
-		tester.readSummaryFile();
-		tester.test();
 	}
 
-	return 0;
+	return fail;
 }
@@ -0,0 +1,175 @@
+#include "stdafx.h"
+
+#include "../Hardware/Device8254.h"
+#include <random>
+
+using emul::PortConnector;
+using emul::PortConnectorMode;
+
+static constexpr const char* separator = "------------------------------------------";
+
+// PITLazyTester runs two PITs side by side, one ticked every cycle and one
+// in lazy mode, with random counter programming and timer 2 gate toggles.
+// Outputs are compared on every tick, counter values (latched reads) and
+// serialized states at random points.
+class PITLazyTester : public Logger
+{
+public:
+	PITLazyTester() : Logger("TEST_PIT")
+	{
+		EnableLog(Logger::LOG_INFO);
+
+		// Each PIT gets its own ports
+		m_tickContext.Init(PortConnectorMode::WORD);
+		m_lazyContext.Init(PortConnectorMode::WORD);
+
+		PortConnector::SetCurrentContext(&m_tickContext);
+		m_tick = new pit::Device8254(BASE_ADDRESS, CLOCK);
+		m_tick->Init();
+
+		PortConnector::SetCurrentContext(&m_lazyContext);
+		m_lazy = new pit::Device8254(BASE_ADDRESS, CLOCK);
+		m_lazy->Init();
+		m_lazy->SetLazyMode(true);
+
+		PortConnector::SetCurrentContext(nullptr);
+	}
+
+	~PITLazyTester()
+	{
+		delete m_tick;
+		delete m_lazy;
+	}
+
+	PITLazyTester(const PITLazyTester&) = delete;
+	PITLazyTester& operator=(const PITLazyTester&) = delete;
+	PITLazyTester(PITLazyTester&&) = delete;
+	PITLazyTester& operator=(PITLazyTester&&) = delete;
+
+	bool test(unsigned int seed)
+	{
+		LogPrintf(LOG_INFO, separator);
+		LogPrintf(LOG_INFO, "Seed %d", seed);
+
+		const bool ok = run(seed);
+		LogPrintf(ok ? LOG_INFO : LOG_ERROR, ok ? "OK" : "FAIL");
+		return ok;
+	}
+
+protected:
+	bool run(unsigned int seed)
+	{
+		std::mt19937 rng(seed);
+
+		for (size_t i = 0; i < TICKS; ++i)
+		{
+			++emul::g_ticks;
+
+			// Timer 2 gate (PC speaker), set before the PIT tick like ComputerXT/AT
+			if ((rng() % GATE_RATE) == 0)
+			{
+				const bool gate = !m_tick->GetCounter(2).GetGate();
+				m_tick->GetCounter(2).SetGate(gate);
+				m_lazy->GetCounter(2).SetGate(gate);
+			}
+
+			m_tick->Tick();
+
+			for (BYTE c = 0; c < 3; ++c)
+			{
+				if (m_tick->GetCounter(c).GetOutput() != m_lazy->GetCounter(c).GetOutput())
+				{
+					LogPrintf(LOG_ERROR, "[%zu] Counter %d: Output mismatch", emul::g_ticks, c);
+					return false;
+				}
+			}
+
+			// CPU accesses, between ticks
+			const unsigned int op = rng() % OP_RATE;
+			if (op == 0)
+			{
+				Program((BYTE)(rng() % 3), rng);
+			}
+			else if (op == 1)
+			{
+				const BYTE c = (BYTE)(rng() % 3);
+				Out(BASE_ADDRESS + 3, (BYTE)(c << 6)); // Latch
+				for (int j = 0; j < 2; ++j)
+				{
+					const BYTE expect = In(m_tick, c);
+					const BYTE actual = In(m_lazy, c);
+					if (expect != actual)
+					{
+						LogPrintf(LOG_ERROR, "[%zu] Counter %d: Read %02X, expected %02X", emul::g_ticks, c, actual, expect);
+						return false;
+					}
+				}
+			}
+			else if (op == 2)
+			{
+				json expect, actual;
+				m_tick->Serialize(expect);
+				m_lazy->Serialize(actual);
+				if (expect != actual)
+				{
+					LogPrintf(LOG_ERROR, "[%zu] State mismatch", emul::g_ticks);
+					LogPrintf(LOG_ERROR, "  expected: %s", expect.dump().c_str());
+					LogPrintf(LOG_ERROR, "  actual  : %s", actual.dump().c_str());
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// Random mode (0, 2, 3, 4) and short count, LSB/MSB
+	void Program(BYTE counter, std::mt19937& rng)
+	{
+		static const BYTE modes[] = { 0, 2, 3, 4 };
+		const BYTE mode = modes[rng() % 4];
+		const WORD n = (WORD)(2 + (rng() % 200));
+
+		Out(BASE_ADDRESS + 3, (BYTE)((counter << 6) | 0x30 | (mode << 1)));
+		Out(BASE_ADDRESS + counter, emul::GetLByte(n));
+		Out(BASE_ADDRESS + counter, emul::GetHByte(n));
+	}
+
+	void Out(WORD port, BYTE value)
+	{
+		m_tick->Out(port, value);
+		m_lazy->Out(port, value);
+	}
+
+	BYTE In(pit::Device8254* pit, BYTE counter)
+	{
+		BYTE value = 0xFF;
+		pit->In(BASE_ADDRESS + counter, value);
+		return value;
+	}
+
+	static constexpr WORD BASE_ADDRESS = 0x40;
+	static constexpr size_t CLOCK = 1193182;
+	static constexpr size_t TICKS = 500000;
+	static constexpr unsigned int GATE_RATE = 97;
+	static constexpr unsigned int OP_RATE = 50;
+
+	PortConnector::Context m_tickContext;
+	PortConnector::Context m_lazyContext;
+
+	pit::Device8254* m_tick = nullptr;
+	pit::Device8254* m_lazy = nullptr;
+};
+
+int testPIT()
+{
+	int fail = 0;
+	for (unsigned int seed = 1; seed <= 10; ++seed)
+	{
+		PITLazyTester tester;
+		if (!tester.test(seed))
+		{
+			++fail;
+		}
+	}
+	return fail;
+}
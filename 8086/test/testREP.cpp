@@ -0,0 +1,356 @@
+#include "stdafx.h"
+
+#include "../CPU/CPU8086.h"
+#include <random>
+
+using emul::CPU8086;
+using emul::REG8;
+using emul::REG16;
+using emul::ADDRESS;
+using emul::DWORD;
+using emul::PortConnector;
+using emul::PortConnectorMode;
+
+static constexpr const char* separator = "------------------------------------------";
+
+class CPU8086RepTest : public CPU8086
+{
+public:
+	CPU8086RepTest(emul::Memory& mem, bool burst) : CPU8086(mem), Logger("CPU8086RepTest")
+	{
+		m_repBurst = burst;
+	}
+
+	friend class RepBurstTester;
+};
+
+// RepBurstTester runs two 8086 side by side, one with the REP burst fast
+// path and one without, each with its own memory. Random REP string
+// instructions (prefix, segment override, direction, ranges) are run to
+// completion on both, then registers, flags, memory and ticks are compared.
+//
+// Ranges are picked to hit the cases the burst path has to clip or skip:
+// overlapping MOVS, segment offset wraparound, 1MB wraparound (reads only),
+// memory slot boundaries, REPE/REPNE early exit, a pending IRQ and the trap
+// flag. Memory is mostly zeroes so SCAS/CMPS runs end at random points.
+class RepBurstTester : public Logger
+{
+public:
+	RepBurstTester() : Logger("TEST_REP"),
+		m_burstMemory(SLOT_SIZE),
+		m_refMemory(SLOT_SIZE),
+		m_burstRAM("RAM", RAM_SIZE),
+		m_refRAM("RAM", RAM_SIZE)
+	{
+		EnableLog(Logger::LOG_INFO);
+		PortConnector::GetCurrentContext().Init(PortConnectorMode::WORD);
+
+		m_burstMemory.Init(emul::CPU8086_ADDRESS_BITS);
+		m_burstMemory.Allocate(&m_burstRAM, 0);
+		m_refMemory.Init(emul::CPU8086_ADDRESS_BITS);
+		m_refMemory.Allocate(&m_refRAM, 0);
+
+		m_burst = new CPU8086RepTest(m_burstMemory, true);
+		m_burst->Init();
+		m_burst->EnableLog(LOG_WARNING);
+		m_ref = new CPU8086RepTest(m_refMemory, false);
+		m_ref->Init();
+		m_ref->EnableLog(LOG_WARNING);
+	}
+
+	~RepBurstTester()
+	{
+		delete m_burst;
+		delete m_ref;
+	}
+
+	RepBurstTester(const RepBurstTester&) = delete;
+	RepBurstTester& operator=(const RepBurstTester&) = delete;
+	RepBurstTester(RepBurstTester&&) = delete;
+	RepBurstTester& operator=(RepBurstTester&&) = delete;
+
+	bool test(unsigned int seed)
+	{
+		LogPrintf(LOG_INFO, separator);
+		LogPrintf(LOG_INFO, "Seed %d", seed);
+
+		const bool ok = run(seed);
+		LogPrintf(ok ? LOG_INFO : LOG_ERROR, ok ? "OK" : "FAIL");
+		return ok;
+	}
+
+protected:
+	struct Case
+	{
+		BYTE rep = 0xF3;
+		BYTE segOverride = 0; // 0: none
+		BYTE opcode = 0xA4;
+
+		WORD ds = 0, es = 0, si = 0, di = 0, cx = 0;
+		WORD ax = 0;
+		bool down = false;
+		bool trap = false;
+		bool irq = false;
+	};
+
+	bool run(unsigned int seed)
+	{
+		std::mt19937 rng(seed);
+
+		FillRAM(rng);
+
+		for (size_t i = 0; i < CASES; ++i)
+		{
+			const Case c = NewCase(rng);
+
+			Load(*m_burst, c);
+			Load(*m_ref, c);
+
+			const size_t burstTicks = Exec(*m_burst);
+			const size_t refTicks = Exec(*m_ref);
+
+			if (!Compare(i, c, burstTicks, refTicks))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Mostly zeroes, so REPE/REPNE SCAS/CMPS stop after a few elements or a few hundreds
+	void FillRAM(std::mt19937& rng)
+	{
+		const unsigned int ones = 1 + (rng() % 20);
+		BYTE* ram = m_burstRAM.getPtr();
+		for (DWORD i = 0; i < RAM_SIZE; ++i)
+		{
+			ram[i] = ((rng() % 100) < ones) ? 1 : 0;
+		}
+
+		// IRET for the IRQ and single step vectors, away from the string ranges
+		ram[HANDLER_ADDRESS] = 0xCF;
+		for (BYTE vect : { (BYTE)1, IRQ })
+		{
+			ram[vect * 4 + 0] = 0;
+			ram[vect * 4 + 1] = 0;
+			ram[vect * 4 + 2] = (BYTE)(HANDLER_ADDRESS >> 4);
+			ram[vect * 4 + 3] = 0;
+		}
+
+		memcpy(m_refRAM.getPtr(), ram, RAM_SIZE);
+	}
+
+	Case NewCase(std::mt19937& rng)
+	{
+		static const BYTE opcodes[] = { 0xA4, 0xA5, 0xA6, 0xA7, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF };
+		static const BYTE overrides[] = { 0x26, 0x2E, 0x36, 0x3E };
+
+		Case c;
+		c.opcode = opcodes[rng() % std::size(opcodes)];
+		c.rep = (rng() % 2) ? 0xF3 : 0xF2;
+		c.down = (rng() % 2);
+		c.trap = (rng() % 16) == 0;
+		c.irq = !c.trap && (rng() % 16) == 0;
+
+		// No override with a pending IRQ, Step() expects the override to be
+		// done when the IRQ is taken
+		if (!c.irq && (rng() % 3) == 0)
+		{
+			c.segOverride = overrides[rng() % std::size(overrides)];
+		}
+
+		c.ax = (rng() % 2) ? 0x0000 : ((rng() % 2) ? 0x0101 : (WORD)rng());
+		c.cx = RandomCount(rng);
+
+		// Destination (ES) stays clear of the code, vectors and stack in the first 64K
+		c.es = (WORD)(0x1000 + (rng() % 0xE000));
+		c.di = RandomOffset(rng);
+
+		switch (rng() % 4)
+		{
+		case 0: // Overlapping, same segment
+			c.ds = c.es;
+			c.si = (WORD)(c.di + (int)(rng() % 9) - 4);
+			if (c.segOverride == 0x2E || c.segOverride == 0x36)
+			{
+				c.segOverride = 0x3E;
+			}
+			break;
+		case 1: // Source wraps around 1MB
+			c.ds = (WORD)(0xF000 + (rng() % 0x1000));
+			c.si = RandomOffset(rng);
+			break;
+		default:
+			c.ds = (WORD)(rng() % 0x10000);
+			c.si = RandomOffset(rng);
+			break;
+		}
+
+		return c;
+	}
+
+	// Short, around the burst size, or long enough to cross a few slots
+	WORD RandomCount(std::mt19937& rng)
+	{
+		switch (rng() % 4)
+		{
+		case 0: return (WORD)(rng() % 4);
+		case 1: return (WORD)(rng() % 100);
+		case 2: return (WORD)(rng() % 1000);
+		default: return (WORD)(rng() % 5000);
+		}
+	}
+
+	// Near the segment ends (wraparound), near a slot boundary, or anywhere
+	WORD RandomOffset(std::mt19937& rng)
+	{
+		const int delta = (int)(rng() % 64) - 32;
+		switch (rng() % 4)
+		{
+		case 0: return (WORD)(0x10000 + delta);
+		case 1: return (WORD)(((rng() % 64) * SLOT_SIZE) + delta);
+		default: return (WORD)rng();
+		}
+	}
+
+	void Load(CPU8086RepTest& cpu, const Case& c)
+	{
+		std::vector<BYTE> code = { c.rep };
+		if (c.segOverride)
+		{
+			code.push_back(c.segOverride);
+		}
+		code.push_back(c.opcode);
+		m_codeSize = (WORD)code.size();
+
+		for (size_t i = 0; i < code.size(); ++i)
+		{
+			cpu.m_memory.Write8(CODE_ADDRESS + (ADDRESS)i, code[i]);
+		}
+
+		cpu.m_reg[REG16::AX] = c.ax;
+		cpu.m_reg[REG16::CX] = c.cx;
+		cpu.m_reg[REG16::SI] = c.si;
+		cpu.m_reg[REG16::DI] = c.di;
+		cpu.m_reg[REG16::DS] = c.ds;
+		cpu.m_reg[REG16::ES] = c.es;
+		cpu.m_reg[REG16::CS] = CODE_ADDRESS >> 4;
+		cpu.m_reg[REG16::IP] = 0;
+		cpu.m_reg[REG16::SS] = 0;
+		cpu.m_reg[REG16::SP] = STACK_TOP;
+
+		cpu.SetFlags(
+			(c.down ? CPU8086::FLAG_D : 0) |
+			(c.trap ? CPU8086::FLAG_T : 0) |
+			CPU8086::FLAG_I);
+		cpu.inSegOverride = false;
+		cpu.inRep = false;
+
+		if (c.irq)
+		{
+			cpu.Interrupt(IRQ);
+		}
+	}
+
+	// Runs until the string instruction is done, returns the total ticks
+	size_t Exec(CPU8086RepTest& cpu)
+	{
+		size_t ticks = 0;
+		for (size_t i = 0; i < MAX_STEPS; ++i)
+		{
+			cpu.Step();
+			ticks += cpu.GetInstructionTicks();
+
+			if (!cpu.inRep &&
+				(cpu.m_reg[REG16::CS] == (CODE_ADDRESS >> 4)) &&
+				(cpu.m_reg[REG16::IP] == m_codeSize))
+			{
+				break;
+			}
+		}
+		return ticks;
+	}
+
+	bool Compare(size_t index, const Case& c, size_t burstTicks, size_t refTicks)
+	{
+		static const struct { REG16 reg; const char* name; } regs[] = {
+			{ REG16::AX, "ax" }, { REG16::BX, "bx" }, { REG16::CX, "cx" }, { REG16::DX, "dx" },
+			{ REG16::SI, "si" }, { REG16::DI, "di" }, { REG16::BP, "bp" }, { REG16::SP, "sp" },
+			{ REG16::CS, "cs" }, { REG16::DS, "ds" }, { REG16::ES, "es" }, { REG16::SS, "ss" },
+			{ REG16::IP, "ip" }, { REG16::FLAGS, "flags" }
+		};
+
+		bool ok = true;
+		for (const auto& r : regs)
+		{
+			const WORD expect = m_ref->m_reg[r.reg];
+			const WORD actual = m_burst->m_reg[r.reg];
+			if (expect != actual)
+			{
+				LogPrintf(LOG_ERROR, "[%zu] %s: %04X, expected %04X", index, r.name, actual, expect);
+				ok = false;
+			}
+		}
+
+		if (burstTicks != refTicks)
+		{
+			LogPrintf(LOG_ERROR, "[%zu] ticks: %zu, expected %zu", index, burstTicks, refTicks);
+			ok = false;
+		}
+
+		if (memcmp(m_burstRAM.getPtr(), m_refRAM.getPtr(), RAM_SIZE) != 0)
+		{
+			for (DWORD i = 0; i < RAM_SIZE; ++i)
+			{
+				if (m_burstRAM.getPtr()[i] != m_refRAM.getPtr()[i])
+				{
+					LogPrintf(LOG_ERROR, "[%zu] RAM[%05X]: %02X, expected %02X", index, i, m_burstRAM.getPtr()[i], m_refRAM.getPtr()[i]);
+					break;
+				}
+			}
+			ok = false;
+		}
+
+		if (!ok)
+		{
+			LogPrintf(LOG_ERROR, "[%zu] ... while testing %02X %02X %02X, cx=%04X, %04X:%04X -> %04X:%04X, ax=%04X, df=%d tf=%d irq=%d",
+				index, c.rep, c.segOverride, c.opcode, c.cx, c.ds, c.si, c.es, c.di, c.ax, c.down, c.trap, c.irq);
+		}
+		return ok;
+	}
+
+	static constexpr WORD SLOT_SIZE = 1024;
+	static constexpr DWORD RAM_SIZE = 1024 * 1024;
+
+	static constexpr ADDRESS CODE_ADDRESS = 0x0400;
+	static constexpr ADDRESS HANDLER_ADDRESS = 0x0500;
+	static constexpr WORD STACK_TOP = 0x1000;
+	static constexpr BYTE IRQ = 8;
+
+	static constexpr size_t CASES = 2000;
+	static constexpr size_t MAX_STEPS = 100000;
+
+	emul::Memory m_burstMemory;
+	emul::Memory m_refMemory;
+	emul::MemoryBlock m_burstRAM;
+	emul::MemoryBlock m_refRAM;
+
+	CPU8086RepTest* m_burst = nullptr;
+	CPU8086RepTest* m_ref = nullptr;
+
+	WORD m_codeSize = 0;
+};
+
+int testREP()
+{
+	int fail = 0;
+	for (unsigned int seed = 1; seed <= 10; ++seed)
+	{
+		RepBurstTester tester;
+		if (!tester.test(seed))
+		{
+			++fail;
+		}
+	}
+	return fail;
+}
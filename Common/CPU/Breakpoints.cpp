@@ -0,0 +1,328 @@
+#include "stdafx.h"
+
+#include <CPU/Breakpoints.h>
+
+namespace emul
+{
+	static const char* GetTypeStr(BreakpointType type)
+	{
+		switch (type)
+		{
+		case BreakpointType::EXEC: return "exec";
+		case BreakpointType::READ: return "read";
+		case BreakpointType::WRITE: return "write";
+		case BreakpointType::PORT_IN: return "in";
+		case BreakpointType::PORT_OUT: return "out";
+		default: return "invalid BreakpointType";
+		}
+	}
+
+	static bool IsPort(BreakpointType type)
+	{
+		return (type == BreakpointType::PORT_IN) || (type == BreakpointType::PORT_OUT);
+	}
+
+	Breakpoints::Breakpoints() : Logger("breakpoints")
+	{
+	}
+
+	Breakpoints::~Breakpoints()
+	{
+		if (m_memory)
+		{
+			m_memory->ClearWatch();
+			m_memory->SetWatcher(nullptr);
+		}
+	}
+
+	void Breakpoints::Init(Memory* memory)
+	{
+		assert(memory);
+		m_memory = memory;
+		m_memory->SetWatcher(this);
+
+		m_portWatch.assign(65536, 0);
+
+		Clear();
+	}
+
+	int Breakpoints::Add(const Breakpoint& breakpoint)
+	{
+		if (breakpoint.end < breakpoint.address)
+		{
+			LogPrintf(LOG_ERROR, "Add: Invalid range [%X-%X]", breakpoint.address, breakpoint.end);
+			return 0;
+		}
+		if (IsPort(breakpoint.type) && (breakpoint.end > 0xFFFF))
+		{
+			LogPrintf(LOG_ERROR, "Add: Invalid port [%X]", breakpoint.end);
+			return 0;
+		}
+
+		m_breakpoints.push_back(breakpoint);
+		Breakpoint& added = m_breakpoints.back();
+		added.id = m_nextID++;
+		added.hits = 0;
+
+		LogPrintf(LOG_INFO, "Add: id=%d, %s [%X-%X], value=%d, hitCount=%d%s", added.id,
+			GetTypeStr(added.type),
+			added.address, added.end,
+			added.value,
+			added.hitCount,
+			added.temporary ? " (temporary)" : "");
+
+		UpdateWatch();
+		return added.id;
+	}
+
+	int Breakpoints::AddExec(ADDRESS address, bool temporary)
+	{
+		Breakpoint breakpoint;
+		breakpoint.type = BreakpointType::EXEC;
+		breakpoint.address = address;
+		breakpoint.end = address;
+		breakpoint.temporary = temporary;
+		return Add(breakpoint);
+	}
+
+	bool Breakpoints::Remove(int id)
+	{
+		for (auto it = m_breakpoints.begin(); it != m_breakpoints.end(); ++it)
+		{
+			if (it->id == id)
+			{
+				LogPrintf(LOG_INFO, "Remove: id=%d", id);
+				m_breakpoints.erase(it);
+				UpdateWatch();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Breakpoints::Clear()
+	{
+		m_breakpoints.clear();
+		m_pending = false;
+		m_stopped = false;
+		UpdateWatch();
+	}
+
+	bool Breakpoints::Enable(int id, bool enable)
+	{
+		for (Breakpoint& breakpoint : m_breakpoints)
+		{
+			if (breakpoint.id == id)
+			{
+				breakpoint.enabled = enable;
+				UpdateWatch();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Breakpoints::ToggleExec(ADDRESS address)
+	{
+		for (const Breakpoint& breakpoint : m_breakpoints)
+		{
+			if ((breakpoint.type == BreakpointType::EXEC) &&
+				!breakpoint.temporary &&
+				(breakpoint.address == address) &&
+				(breakpoint.end == address))
+			{
+				Remove(breakpoint.id);
+				return;
+			}
+		}
+		AddExec(address);
+	}
+
+	bool Breakpoints::IsExec(ADDRESS address) const
+	{
+		for (const Breakpoint& breakpoint : m_breakpoints)
+		{
+			if ((breakpoint.type == BreakpointType::EXEC) &&
+				breakpoint.enabled &&
+				(address >= breakpoint.address) &&
+				(address <= breakpoint.end))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool Breakpoints::AddFromString(BreakpointType type, const char* str)
+	{
+		bool ok = true;
+		while (*str)
+		{
+			if ((*str == ' ') || (*str == ','))
+			{
+				++str;
+				continue;
+			}
+
+			Breakpoint breakpoint;
+			breakpoint.type = type;
+
+			char* end;
+			breakpoint.address = strtoul(str, &end, 0);
+			breakpoint.end = breakpoint.address;
+			if (end == str)
+			{
+				LogPrintf(LOG_ERROR, "AddFromString: Invalid address [%s]", str);
+				return false;
+			}
+			str = end;
+
+			while (*str && (*str != ' ') && (*str != ','))
+			{
+				const char separator = *str++;
+				const DWORD value = strtoul(str, &end, 0);
+				if (end == str)
+				{
+					LogPrintf(LOG_ERROR, "AddFromString: Invalid value after '%c' [%s]", separator, str);
+					return false;
+				}
+				str = end;
+
+				switch (separator)
+				{
+				case '-': breakpoint.end = value; break;
+				case '=': breakpoint.value = (BYTE)value; break;
+				case '#': breakpoint.hitCount = value; break;
+				default:
+					LogPrintf(LOG_ERROR, "AddFromString: Invalid separator '%c'", separator);
+					return false;
+				}
+			}
+
+			ok &= (Add(breakpoint) != 0);
+		}
+		return ok;
+	}
+
+	bool Breakpoints::CheckBreak(ADDRESS address)
+	{
+		if (m_pending)
+		{
+			m_pending = false;
+			m_stopped = true;
+			m_stopAddress = address;
+			return true;
+		}
+
+		if (m_stopped && (address == m_stopAddress))
+		{
+			return false;
+		}
+
+		for (Breakpoint& breakpoint : m_breakpoints)
+		{
+			if ((breakpoint.type == BreakpointType::EXEC) &&
+				(address >= breakpoint.address) &&
+				(address <= breakpoint.end) &&
+				Hit(breakpoint, -1))
+			{
+				Stop(breakpoint, address);
+
+				m_stopped = true;
+				m_stopAddress = address;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Breakpoints::OnAccess(BreakpointType type, ADDRESS address, BYTE value)
+	{
+		if (m_suspended || m_pending)
+		{
+			return;
+		}
+
+		for (Breakpoint& breakpoint : m_breakpoints)
+		{
+			if ((breakpoint.type == type) &&
+				(address >= breakpoint.address) &&
+				(address <= breakpoint.end) &&
+				Hit(breakpoint, value))
+			{
+				LogPrintf(LOG_INFO, "Watchpoint id=%d: %s [%X], value=%02X", breakpoint.id, GetTypeStr(type), address, value);
+				Stop(breakpoint, address);
+				m_pending = true;
+				return;
+			}
+		}
+	}
+
+	bool Breakpoints::Hit(Breakpoint& breakpoint, int value)
+	{
+		if (!breakpoint.enabled ||
+			((breakpoint.value != -1) && (value != breakpoint.value)) ||
+			(breakpoint.condition && !breakpoint.condition()))
+		{
+			return false;
+		}
+
+		++breakpoint.hits;
+		return breakpoint.hits >= breakpoint.hitCount;
+	}
+
+	void Breakpoints::Stop(const Breakpoint& breakpoint, ADDRESS address)
+	{
+		LogPrintf(LOG_INFO, "Stop: id=%d, %s [%X], hits=%d", breakpoint.id, GetTypeStr(breakpoint.type), address, breakpoint.hits);
+
+		if (breakpoint.temporary)
+		{
+			Remove(breakpoint.id);
+		}
+	}
+
+	void Breakpoints::UpdateWatch()
+	{
+		if (!m_memory)
+		{
+			return;
+		}
+
+		m_memory->ClearWatch();
+		std::fill(m_portWatch.begin(), m_portWatch.end(), 0);
+
+		const ADDRESS slotMask = ~(ADDRESS)(m_memory->GetBlockGranularity() - 1);
+
+		for (const Breakpoint& breakpoint : m_breakpoints)
+		{
+			if (!breakpoint.enabled)
+			{
+				continue;
+			}
+
+			switch (breakpoint.type)
+			{
+			case BreakpointType::PORT_IN:
+			case BreakpointType::PORT_OUT:
+				for (size_t port = breakpoint.address; port <= breakpoint.end; ++port)
+				{
+					m_portWatch[port] |= (breakpoint.type == BreakpointType::PORT_IN) ? WATCH_READ : WATCH_WRITE;
+				}
+				break;
+			default:
+			{
+				const BYTE flag =
+					(breakpoint.type == BreakpointType::EXEC) ? WATCH_EXEC :
+					(breakpoint.type == BreakpointType::READ) ? WATCH_READ : WATCH_WRITE;
+
+				const ADDRESS end = std::min(breakpoint.end, m_memory->GetAddressMask());
+				for (uint64_t address = breakpoint.address & slotMask; address <= end; address += m_memory->GetBlockGranularity())
+				{
+					m_memory->SetWatch((ADDRESS)address, m_memory->GetWatch((ADDRESS)address) | flag);
+				}
+				break;
+			}
+			}
+		}
+	}
+}
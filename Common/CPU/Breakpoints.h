@@ -0,0 +1,146 @@
+#pragma once
+
+#include <CPU/Memory.h>
+#include <functional>
+#include <vector>
+
+namespace emul
+{
+	enum class BreakpointType { EXEC, READ, WRITE, PORT_IN, PORT_OUT };
+
+	struct Breakpoint
+	{
+		int id = 0;
+		BreakpointType type = BreakpointType::EXEC;
+
+		// Address range (memory address or port), inclusive
+		ADDRESS address = 0;
+		ADDRESS end = 0;
+
+		// Data value to match (READ/WRITE/PORT_*), -1 = any value
+		int value = -1;
+
+		// Break on this hit and the following ones, 0 = every hit
+		uint32_t hitCount = 0;
+		uint32_t hits = 0;
+
+		// Optional, evaluated on each access that matches
+		std::function<bool()> condition;
+
+		bool enabled = true;
+		bool temporary = false; // Removed when it stops execution
+	};
+
+	// Breakpoint and watchpoint engine, shared by the monitors.
+	//
+	// Each memory slot has watch flags (MemorySlot::watch), each port has
+	// an in/out flag, so in the common case (nothing watched nearby) a
+	// check is a single bit test. Breakpoint lists are only searched
+	// on flagged slots/ports.
+	//
+	// Exec breakpoints are checked by the main loop before each instruction
+	// (IsBreak). Data and port watchpoints are reported by Memory and
+	// PortConnector as they happen and stop execution at the next check.
+	// Slots watched for read/write lose their direct host pointers, so
+	// the fast access paths of Memory are not affected.
+	class Breakpoints : public Logger, public MemoryWatcher
+	{
+	public:
+		Breakpoints();
+		virtual ~Breakpoints();
+
+		Breakpoints(const Breakpoints&) = delete;
+		Breakpoints& operator=(const Breakpoints&) = delete;
+		Breakpoints(Breakpoints&&) = delete;
+		Breakpoints& operator=(Breakpoints&&) = delete;
+
+		void Init(Memory* memory);
+
+		// Returns the breakpoint id
+		int Add(const Breakpoint& breakpoint);
+		int AddExec(ADDRESS address, bool temporary = false);
+		bool Remove(int id);
+		void Clear();
+		bool Enable(int id, bool enable = true);
+
+		// Adds or removes a (non temporary) exec breakpoint at address
+		void ToggleExec(ADDRESS address);
+		bool IsExec(ADDRESS address) const;
+
+		// List of breakpoints separated by spaces or commas:
+		//   address[-end][=value][#hitCount]
+		// Numbers are decimal, 0xhex or 0octal
+		bool AddFromString(BreakpointType type, const char* str);
+
+		const std::vector<Breakpoint>& GetList() const { return m_breakpoints; }
+
+		// Called before each instruction, true if execution should stop:
+		// exec breakpoint at address or watchpoint hit since the last call
+		bool IsBreak(ADDRESS address)
+		{
+			if (!m_pending && !(m_memory->GetWatch(address) & WATCH_EXEC))
+			{
+				return false;
+			}
+			return CheckBreak(address);
+		}
+
+		// Called after each instruction
+		void OnStep() { m_stopped = false; }
+
+		void OnPortIn(WORD port, BYTE value) { if (m_portWatch[port] & WATCH_READ) OnAccess(BreakpointType::PORT_IN, port, value); }
+		void OnPortOut(WORD port, BYTE value) { if (m_portWatch[port] & WATCH_WRITE) OnAccess(BreakpointType::PORT_OUT, port, value); }
+
+		// MemoryWatcher
+		virtual void OnMemoryRead(ADDRESS address, BYTE value) override { OnAccess(BreakpointType::READ, address, value); }
+		virtual void OnMemoryWrite(ADDRESS address, BYTE value) override { OnAccess(BreakpointType::WRITE, address, value); }
+
+		// Accesses made while suspended are ignored (monitor display, etc.)
+		class Suspend
+		{
+		public:
+			Suspend(Breakpoints* breakpoints) : m_breakpoints(breakpoints)
+			{
+				if (m_breakpoints) ++m_breakpoints->m_suspended;
+			}
+			~Suspend()
+			{
+				if (m_breakpoints) --m_breakpoints->m_suspended;
+			}
+
+			Suspend(const Suspend&) = delete;
+			Suspend& operator=(const Suspend&) = delete;
+			Suspend(Suspend&&) = delete;
+			Suspend& operator=(Suspend&&) = delete;
+
+		protected:
+			Breakpoints* m_breakpoints;
+		};
+
+	protected:
+		bool CheckBreak(ADDRESS address);
+		void OnAccess(BreakpointType type, ADDRESS address, BYTE value);
+
+		// Updates hit count, true if the breakpoint stops execution
+		bool Hit(Breakpoint& breakpoint, int value);
+		void Stop(const Breakpoint& breakpoint, ADDRESS address);
+
+		// Recomputes memory slot and port flags
+		void UpdateWatch();
+
+		Memory* m_memory = nullptr;
+		std::vector<BYTE> m_portWatch; // WATCH_READ: in, WATCH_WRITE: out
+
+		std::vector<Breakpoint> m_breakpoints;
+		int m_nextID = 1;
+
+		// Watchpoint hit, stop at next IsBreak()
+		bool m_pending = false;
+
+		// Stopped at m_stopAddress, no new hit there until the next step
+		bool m_stopped = false;
+		ADDRESS m_stopAddress = 0;
+
+		int m_suspended = 0;
+	};
+}
@@ -35,7 +35,9 @@ namespace emul
 			m_state = CPUState::RUN;
 
 			// Execute instruction
-			Exec(FetchByte());
+			const BYTE opcode = FetchByte();
+			m_lastOpcode = opcode;
+			Exec(opcode);
 		}
 		catch (std::exception e)
 		{
@@ -1,10 +1,12 @@
 #pragma once
 #include <CPU/Memory.h>
+#include <CPU/CPUProfiler.h>
 #include <Serializable.h>
 
 namespace emul
 {
 	class CPU;
+	class Breakpoints;
 	typedef void(*CPUCallbackFunc)(CPU* cpu, ADDRESS addr);
 
 	struct WatchItem
@@ -34,6 +36,18 @@ namespace emul
 		virtual void Halt() { m_state = CPUState::HALT; }
 
 		uint32_t GetInstructionTicks() const { return m_opTicks; }
+		WORD GetLastOpcode() const { return m_lastOpcode; }
+
+		// Size of the opcode space, for profiling
+		virtual size_t GetOpcodeCount() const { return 256; }
+
+		// Not owned, nullptr when profiling is disabled
+		void SetProfiler(CPUProfiler* profiler) { m_profiler = profiler; }
+		CPUProfiler* GetProfiler() const { return m_profiler; }
+
+		// Not owned, used by the monitors
+		void SetBreakpoints(Breakpoints* breakpoints) { m_breakpoints = breakpoints; }
+		Breakpoints* GetBreakpoints() const { return m_breakpoints; }
 
 		CPUState GetState() const { return m_state; }
 
@@ -50,6 +64,12 @@ namespace emul
 
 		uint32_t m_opTicks = 0;
 		ADDRESS m_lastAddress = 0;
+		WORD m_lastOpcode = 0;
 		inline void TICK(uint32_t count) { m_opTicks += count; }
+
+		// Call when an interrupt is serviced, see CPUProfiler for the id
+		void ProfileIRQ(BYTE id) { if (m_profiler) m_profiler->OnIRQ(id); }
+		CPUProfiler* m_profiler = nullptr;
+		Breakpoints* m_breakpoints = nullptr;
 	};
 }
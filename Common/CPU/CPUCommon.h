@@ -3,8 +3,10 @@
 #ifdef _DEBUG
 // This code is supposed to be unreachable, so assert
 # define NODEFAULT   assert(0); throw("Unreachable code");
-#else
+#elif defined(_MSC_VER)
 # define NODEFAULT   __assume(0)
+#else
+# define NODEFAULT   __builtin_unreachable()
 #endif
 
 #define PRINTF_BIN_PATTERN_INT4 "%c%c%c%c"
@@ -39,7 +41,8 @@ using hscommon::bitUtil::BitMask;
 
 namespace emul
 {
-	extern size_t g_ticks;
+	// Per thread so that machines running on separate threads keep their own clock
+	extern thread_local size_t g_ticks;
 
 	typedef uint8_t BYTE;
 	typedef uint16_t WORD;
@@ -34,7 +34,7 @@ namespace cpuInfo
 		else
 		{
 			LogPrintf(LOG_ERROR, "Config File not found: [%s]", m_configFile.c_str());
-			throw std::exception("Config File not found");
+			throw std::runtime_error("Config File not found");
 		}
 
 		json& cpuData = m_config["cpu"];
@@ -66,7 +66,7 @@ namespace cpuInfo
 	{
 		if (!cpuData.contains("opcodes"))
 		{
-			throw std::exception("missing [opcodes] array");
+			throw std::runtime_error("missing [opcodes] array");
 		}
 
 		// Check for optional size
@@ -77,7 +77,7 @@ namespace cpuInfo
 			if (opcodeCount == 0 || opcodeCount > MAX_OPCODE)
 			{
 				LogPrintf(LOG_ERROR, "Invalid opcode.size: %d", opcodeCount);
-				throw std::exception("invalid opcode.size");
+				throw std::runtime_error("invalid opcode.size");
 			}
 		}
 		LogPrintf(LOG_INFO, "Opcode table, size [%d]", opcodeCount);
@@ -99,7 +99,7 @@ namespace cpuInfo
 		if (groupCount > (int)Opcode::MULTI::_COUNT)
 		{
 			LogPrintf(LOG_ERROR, "Subopcode group count > %d", (int)Opcode::MULTI::_COUNT);
-			throw std::exception("invalid opcode.grp count");
+			throw std::runtime_error("invalid opcode.grp count");
 		}
 
 		for (int i = 0; i < groupCount; ++i)
@@ -115,7 +115,7 @@ namespace cpuInfo
 		if (!cpuData.contains(groupName))
 		{
 			LogPrintf(LOG_ERROR, "Subopcode table [%s] not found", groupName);
-			throw std::exception("opcode.grp# list missing");
+			throw std::runtime_error("opcode.grp# list missing");
 		}
 
 		// Check for optional size, otherwise use MAX_OPCODE
@@ -135,7 +135,7 @@ namespace cpuInfo
 			else if (subOpcodeCount > MAX_OPCODE + 1)
 			{
 				LogPrintf(LOG_ERROR, "Subopcode table [%s] invalid size: %d", groupName, subOpcodeCount);
-				throw std::exception("invalid grp size");
+				throw std::runtime_error("invalid grp size");
 			}
 		}
 
@@ -175,7 +175,7 @@ namespace cpuInfo
 			if (miscCount > (int)MiscTiming::_COUNT)
 			{
 				LogPrintf(LOG_ERROR, "MISC timing list too large: [%d>%d]", miscCount, (int)MiscTiming::_COUNT);
-				throw std::exception("misc timing list too large");
+				throw std::runtime_error("misc timing list too large");
 			}
 			for (size_t i = 0; i < miscCount; ++i)
 			{
@@ -235,7 +235,7 @@ namespace cpuInfo
 			if (opcodeIndex < 0 || opcodeIndex > (opcodeTable.size() - 1))
 			{
 				LogPrintf(LOG_ERROR, "AddOpcodes: invalid index [%d]", opcodeIndex);
-				throw std::exception("AddOpcodes: invalid index");
+				throw std::runtime_error("AddOpcodes: invalid index");
 			}
 
 			if (curr.is_number_integer()) // new index (integer)
@@ -295,7 +295,7 @@ namespace cpuInfo
 			}
 			else
 			{
-				throw std::exception("AddOpcodes: Invalid value");
+				throw std::runtime_error("AddOpcodes: Invalid value");
 			}
 		}
 	}
@@ -330,7 +330,7 @@ namespace cpuInfo
 		OpcodeTiming timing = m_defaultOpcodeTiming;
 		if (!timingArray.is_array() || timingArray.size() < 1 || timingArray.size() > (int)OpcodeTimingType::_COUNT)
 		{
-			throw std::exception("invalid timing array");
+			throw std::runtime_error("invalid timing array");
 		}
 
 		for (size_t i = 0; i < timingArray.size(); ++i)
@@ -504,7 +504,7 @@ namespace cpuInfo
 		else
 		{
 			LogPrintf(LOG_ERROR, "GetANSIFile: File not found [%s]", ansiFileName.c_str());
-			throw std::exception("file not found");
+			throw std::runtime_error("file not found");
 		}
 	}
 
@@ -0,0 +1,184 @@
+#include "stdafx.h"
+
+#include <CPU/CPUProfiler.h>
+#include <Serializable.h>
+#include <fstream>
+#include <iomanip>
+
+namespace emul
+{
+	CPUProfiler::CPUProfiler() : Logger("profiler")
+	{
+	}
+
+	void CPUProfiler::Init(const char* cpuID, size_t opcodeCount, size_t addressBits, WORD blockGranularity)
+	{
+		assert(opcodeCount && opcodeCount <= 65536 && !(opcodeCount & (opcodeCount - 1)));
+		assert(blockGranularity && !(blockGranularity & (blockGranularity - 1)));
+		assert(addressBits <= 32);
+
+		m_cpuID = cpuID;
+
+		m_opcodes.resize(opcodeCount);
+		m_opcodeMask = (WORD)(opcodeCount - 1);
+
+		m_slotShift = 0;
+		while ((1u << m_slotShift) < blockGranularity)
+		{
+			++m_slotShift;
+		}
+		const size_t slotCount = std::max((size_t)1, (size_t)((1ull << addressBits) >> m_slotShift));
+		m_slots.resize(slotCount);
+		m_slotMask = (ADDRESS)(slotCount - 1);
+
+		m_irqs.resize(256);
+		m_portIn.resize(65536);
+		m_portOut.resize(65536);
+
+		LogPrintf(LOG_INFO, "Init: cpu=[%s], opcodes=%zu, slots=%zu (%d bytes)", cpuID, opcodeCount, slotCount, blockGranularity);
+
+		Clear();
+	}
+
+	void CPUProfiler::Clear()
+	{
+		std::fill(m_opcodes.begin(), m_opcodes.end(), Counter());
+		std::fill(m_slots.begin(), m_slots.end(), Counter());
+		std::fill(m_irqs.begin(), m_irqs.end(), 0);
+		std::fill(m_portIn.begin(), m_portIn.end(), 0);
+		std::fill(m_portOut.begin(), m_portOut.end(), 0);
+	}
+
+	bool CPUProfiler::Dump() const
+	{
+		const char* path = m_dumpFile.c_str();
+
+		if (!IsEnabled())
+		{
+			LogPrintf(LOG_WARNING, "Dump: profiler not enabled");
+			return false;
+		}
+
+		if (!path[0])
+		{
+			LogPrintf(LOG_ERROR, "Dump: Empty path");
+			return false;
+		}
+
+		std::ofstream os(path);
+		if (!os)
+		{
+			LogPrintf(LOG_ERROR, "Dump: Error opening output file [%s]", path);
+			return false;
+		}
+
+		LogPrintf(LOG_INFO, "Dump: [%s]", path);
+
+		const std::string ext = std::filesystem::path(path).extension().string();
+		return (ext == ".json") ? DumpJSON(os) : DumpCSV(os);
+	}
+
+	// One row per non-zero counter:
+	// type,id (hex),count,ticks
+	bool CPUProfiler::DumpCSV(std::ostream& os) const
+	{
+		os << "type,id,count,ticks" << std::endl;
+		os << std::hex << std::uppercase;
+
+		for (size_t i = 0; i < m_opcodes.size(); ++i)
+		{
+			const Counter& op = m_opcodes[i];
+			if (op.count)
+			{
+				os << "opcode," << i << "," << std::dec << op.count << "," << op.ticks << std::hex << std::endl;
+			}
+		}
+
+		for (size_t i = 0; i < m_slots.size(); ++i)
+		{
+			const Counter& slot = m_slots[i];
+			if (slot.count)
+			{
+				os << "address," << (i << m_slotShift) << "," << std::dec << slot.count << "," << slot.ticks << std::hex << std::endl;
+			}
+		}
+
+		for (size_t i = 0; i < m_irqs.size(); ++i)
+		{
+			if (m_irqs[i])
+			{
+				os << "irq," << i << "," << std::dec << m_irqs[i] << "," << std::hex << std::endl;
+			}
+		}
+
+		for (size_t i = 0; i < m_portIn.size(); ++i)
+		{
+			if (m_portIn[i])
+			{
+				os << "in," << i << "," << std::dec << m_portIn[i] << "," << std::hex << std::endl;
+			}
+		}
+
+		for (size_t i = 0; i < m_portOut.size(); ++i)
+		{
+			if (m_portOut[i])
+			{
+				os << "out," << i << "," << std::dec << m_portOut[i] << "," << std::hex << std::endl;
+			}
+		}
+
+		return (bool)os;
+	}
+
+	bool CPUProfiler::DumpJSON(std::ostream& os) const
+	{
+		json j;
+		j["cpu"] = m_cpuID;
+		j["slotSize"] = 1 << m_slotShift;
+
+		uint64_t totalCount = 0;
+		uint64_t totalTicks = 0;
+		json& opcodes = j["opcodes"] = json::array();
+		for (size_t i = 0; i < m_opcodes.size(); ++i)
+		{
+			const Counter& op = m_opcodes[i];
+			if (op.count)
+			{
+				opcodes.push_back({ { "opcode", i }, { "count", op.count }, { "ticks", op.ticks } });
+				totalCount += op.count;
+				totalTicks += op.ticks;
+			}
+		}
+		j["instructions"] = totalCount;
+		j["ticks"] = totalTicks;
+
+		json& slots = j["addresses"] = json::array();
+		for (size_t i = 0; i < m_slots.size(); ++i)
+		{
+			const Counter& slot = m_slots[i];
+			if (slot.count)
+			{
+				slots.push_back({ { "address", i << m_slotShift }, { "count", slot.count }, { "ticks", slot.ticks } });
+			}
+		}
+
+		auto counters = [](const std::vector<uint64_t>& values, const char* key)
+		{
+			json list = json::array();
+			for (size_t i = 0; i < values.size(); ++i)
+			{
+				if (values[i])
+				{
+					list.push_back({ { key, i }, { "count", values[i] } });
+				}
+			}
+			return list;
+		};
+		j["irqs"] = counters(m_irqs, "irq");
+		j["portIn"] = counters(m_portIn, "port");
+		j["portOut"] = counters(m_portOut, "port");
+
+		os << std::setw(4) << j;
+		return (bool)os;
+	}
+}
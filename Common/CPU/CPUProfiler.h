@@ -0,0 +1,79 @@
+#pragma once
+
+#include <CPU/CPUCommon.h>
+#include <iosfwd>
+#include <vector>
+
+namespace emul
+{
+	// Instruction level profiler, enabled with [debug] profile=1
+	//
+	// Counters are flat arrays allocated once in Init(), the hooks
+	// are inline increments. When profiling is disabled nothing
+	// is allocated and callers only test a null pointer.
+	//
+	// Collected:
+	//   - Per opcode: execution count, total ticks (CPU::GetInstructionTicks)
+	//   - Per memory slot (block granularity): instructions executed from
+	//     that slot and their ticks
+	//   - Per interrupt: count. Id is the vector number (x86, 68000)
+	//     or the low byte of the vector/restart address (8 bit CPUs)
+	//   - Per I/O port: IN and OUT count
+	class CPUProfiler : public Logger
+	{
+	public:
+		CPUProfiler();
+
+		CPUProfiler(const CPUProfiler&) = delete;
+		CPUProfiler& operator=(const CPUProfiler&) = delete;
+		CPUProfiler(CPUProfiler&&) = delete;
+		CPUProfiler& operator=(CPUProfiler&&) = delete;
+
+		void Init(const char* cpuID, size_t opcodeCount, size_t addressBits, WORD blockGranularity);
+		void Clear();
+
+		bool IsEnabled() const { return !m_opcodes.empty(); }
+
+		void OnInstruction(WORD opcode, ADDRESS address, uint32_t ticks)
+		{
+			Counter& op = m_opcodes[opcode & m_opcodeMask];
+			++op.count;
+			op.ticks += ticks;
+
+			Counter& slot = m_slots[(address >> m_slotShift) & m_slotMask];
+			++slot.count;
+			slot.ticks += ticks;
+		}
+		void OnIRQ(BYTE id) { ++m_irqs[id]; }
+		void OnPortIn(WORD port) { ++m_portIn[port]; }
+		void OnPortOut(WORD port) { ++m_portOut[port]; }
+
+		// .json extension: json, otherwise csv
+		void SetDumpFile(const char* path) { m_dumpFile = path; }
+		bool Dump() const;
+
+	protected:
+		bool DumpCSV(std::ostream& os) const;
+		bool DumpJSON(std::ostream& os) const;
+
+		struct Counter
+		{
+			uint64_t count = 0;
+			uint64_t ticks = 0;
+		};
+
+		std::string m_cpuID;
+		std::string m_dumpFile;
+
+		std::vector<Counter> m_opcodes;
+		WORD m_opcodeMask = 0;
+
+		std::vector<Counter> m_slots;
+		BYTE m_slotShift = 0;
+		ADDRESS m_slotMask = 0;
+
+		std::vector<uint64_t> m_irqs;
+		std::vector<uint64_t> m_portIn;
+		std::vector<uint64_t> m_portOut;
+	};
+}
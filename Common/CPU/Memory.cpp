@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
 #include <CPU/Memory.h>
+#include <typeinfo>
 
 namespace fs = std::filesystem;
 
@@ -19,8 +20,16 @@ namespace emul
 		}
 	}
 
+	// Blocks with dirty tracking: RAM with raw storage
+	static MemoryBlock* GetTrackable(MemoryBlockBase* block)
+	{
+		return (block->GetType() == MemoryType::RAM) ? dynamic_cast<MemoryBlock*>(block) : nullptr;
+	}
+
 
-	Memory::Memory(WORD blockGranularity) : Logger("MEM"), m_blockGranularity(blockGranularity)
+	Memory::Memory(WORD blockGranularity) : Logger("MEM"),
+		m_blockGranularity(blockGranularity),
+		m_slotOffsetMask(blockGranularity - 1)
 	{
 		assert(IsPowerOf2(blockGranularity));
 		assert(blockGranularity >= 8);
@@ -37,7 +46,7 @@ namespace emul
 		m_addressBits = addressBits;
 		m_addressMask = (ADDRESS)GetMaxAddress(addressBits);
 
-		LogPrintf(LOG_INFO, "Setting up [%d] bit memory address space mask=["PRINTF_BIN_PATTERN_INT32"]",
+		LogPrintf(LOG_INFO, "Setting up [%d] bit memory address space mask=[" PRINTF_BIN_PATTERN_INT32 "]",
 			addressBits,
 			PRINTF_BYTE_TO_BIN_INT32(m_addressMask));
 
@@ -96,6 +105,15 @@ namespace emul
 		size_t minSlot = base / m_blockGranularity;
 		LogPrintf(LOG_DEBUG, "Using %d slots, first slot = %02Xh", nbSlots, minSlot);
 
+		if (m_dirtyTracking)
+		{
+			MemoryBlock* trackable = GetTrackable(block);
+			if (trackable && !trackable->IsDirtyTracking())
+			{
+				trackable->EnableDirtyTracking(true);
+			}
+		}
+
 		base -= sourceOffset;
 
 		for (size_t i = 0; i < nbSlots; ++i)
@@ -139,8 +157,10 @@ namespace emul
 				slot.baseW = base;
 				break;
 			default:
-				throw std::exception("invalid mode");
+				throw std::runtime_error("invalid mode");
 			}
+
+			UpdateDirectAccess(minSlot + i);
 		}
 
 		m_blocks.insert(block);
@@ -193,6 +213,8 @@ namespace emul
 				slot.blockW = slot.blockR;
 				slot.baseW = slot.baseR;
 			}
+
+			UpdateDirectAccess(minSlot + i);
 		}
 
 		return true;
@@ -217,6 +239,8 @@ namespace emul
 				slot.blockW = nullptr;
 				slot.baseW = 0;
 			}
+
+			UpdateDirectAccess(i);
 		}
 
 		m_blocks.erase(block);
@@ -230,8 +254,19 @@ namespace emul
 			if (block->GetType() == MemoryType::RAM)
 			{
 				block->Clear(filler);
+
+				MemoryBlock* trackable = GetTrackable(block);
+				if (trackable)
+				{
+					trackable->SetDirty(0, trackable->GetRawSize());
+				}
 			}
 		}
+
+		if (m_dirtyTracking)
+		{
+			UpdateDirectAccess();
+		}
 	}
 
 	bool Memory::MapWindow(ADDRESS source, ADDRESS window, DWORD len, AllocateMode mode)
@@ -302,15 +337,161 @@ namespace emul
 				// Nothing to do
 				break;
 			default:
-				throw std::exception("invalid mode");
+				throw std::runtime_error("invalid mode");
 			}
 
+			// Watch flags belong to the address, not the mapped block
+			slot.watch = m_memory[windowBaseSlot + i].watch;
 			m_memory[windowBaseSlot + i] = slot;
+			UpdateDirectAccess(windowBaseSlot + i);
 		}
 
 		return true;
 	}
 
+	// Only exact MemoryBlock instances qualify: subclasses (video memory,
+	// cartridges, register files, ...) override read/write and must stay
+	// on the virtual path
+	static BYTE* GetDirectPtr(MemoryBlockBase* block, ADDRESS offset, bool write)
+	{
+		if (!block || (typeid(*block) != typeid(MemoryBlock)))
+		{
+			return nullptr;
+		}
+
+		// Writes to ROM are ignored by MemoryBlock::write, keep them there
+		if (write && (block->GetType() != MemoryType::RAM))
+		{
+			return nullptr;
+		}
+
+		return static_cast<MemoryBlock*>(block)->getPtr() + offset;
+	}
+
+	// Same restriction as direct pointers, other blocks flag
+	// their pages themselves and always use the slow path
+	static bool IsCleanPage(MemoryBlockBase* block, ADDRESS offset)
+	{
+		if (!block || (typeid(*block) != typeid(MemoryBlock)))
+		{
+			return false;
+		}
+
+		const MemoryBlock* memBlock = static_cast<MemoryBlock*>(block);
+		return memBlock->IsDirtyTracking() && !memBlock->IsDirty(offset / MemoryBlockBase::GetBlockGranularity());
+	}
+
+	void Memory::UpdateDirectAccess(size_t slotIndex)
+	{
+		MemorySlot& slot = m_memory[slotIndex];
+		const ADDRESS slotBase = (ADDRESS)(slotIndex * m_blockGranularity);
+
+		slot.clean = m_dirtyTracking && IsCleanPage(slot.blockW, slotBase - slot.baseW);
+
+		slot.directR = (slot.watch & WATCH_READ) ? nullptr : GetDirectPtr(slot.blockR, slotBase - slot.baseR, false);
+		slot.directW = ((slot.watch & WATCH_WRITE) || slot.clean) ? nullptr : GetDirectPtr(slot.blockW, slotBase - slot.baseW, true);
+	}
+
+	void Memory::UpdateDirectAccess()
+	{
+		for (size_t i = 0; i < m_memory.size(); ++i)
+		{
+			UpdateDirectAccess(i);
+		}
+	}
+
+	void Memory::OnWriteClean(ADDRESS address)
+	{
+		const size_t slotIndex = address / m_blockGranularity;
+		MemorySlot& slot = m_memory[slotIndex];
+		const ADDRESS slotBase = (ADDRESS)(slotIndex * m_blockGranularity);
+
+		static_cast<MemoryBlock*>(slot.blockW)->SetDirty(slotBase - slot.baseW, m_blockGranularity);
+		UpdateDirectAccess(slotIndex);
+	}
+
+	void Memory::EnableDirtyTracking(bool enable)
+	{
+		LogPrintf(LOG_INFO, "%s dirty page tracking", enable ? "Enable" : "Disable");
+
+		m_dirtyTracking = enable;
+		for (auto block : m_blocks)
+		{
+			MemoryBlock* trackable = GetTrackable(block);
+			if (trackable)
+			{
+				trackable->EnableDirtyTracking(enable);
+			}
+		}
+		UpdateDirectAccess();
+	}
+
+	void Memory::ClearDirty()
+	{
+		for (MemoryBlock* block : GetTrackedBlocks())
+		{
+			block->ClearDirty();
+		}
+		UpdateDirectAccess();
+	}
+
+	std::vector<MemoryBlock*> Memory::GetTrackedBlocks() const
+	{
+		std::vector<MemoryBlock*> tracked;
+		for (auto block : m_blocks)
+		{
+			MemoryBlock* trackable = GetTrackable(block);
+			if (trackable && trackable->IsDirtyTracking())
+			{
+				tracked.push_back(trackable);
+			}
+		}
+		return tracked;
+	}
+
+	void Memory::SetWatch(ADDRESS address, BYTE flags)
+	{
+		const size_t slotIndex = (address & m_addressMask) / m_blockGranularity;
+		m_memory[slotIndex].watch = flags;
+		UpdateDirectAccess(slotIndex);
+	}
+
+	void Memory::ClearWatch()
+	{
+		for (size_t i = 0; i < m_memory.size(); ++i)
+		{
+			if (m_memory[i].watch)
+			{
+				m_memory[i].watch = 0;
+				UpdateDirectAccess(i);
+			}
+		}
+	}
+
+	const BYTE* Memory::GetDirectReadPtr(ADDRESS address, DWORD len) const
+	{
+		address &= m_addressMask;
+		const ADDRESS offset = address & m_slotOffsetMask;
+		const MemorySlot& slot = FindBlock(address);
+		if (!slot.directR || !len || (len > (DWORD)m_blockGranularity - offset))
+		{
+			return nullptr;
+		}
+		return slot.directR + offset;
+	}
+
+	BYTE* Memory::GetDirectWritePtr(ADDRESS address, DWORD len)
+	{
+		address &= m_addressMask;
+		const ADDRESS offset = address & m_slotOffsetMask;
+		const MemorySlot& slot = FindBlock(address);
+		if (!slot.directW || !len || (len > (DWORD)m_blockGranularity - offset))
+		{
+			return nullptr;
+		}
+		return slot.directW + offset;
+	}
+
 	bool Memory::LoadBinary(const char* file, ADDRESS baseAddress)
 	{
 		const MemorySlot& slot = FindBlock(baseAddress);
@@ -329,11 +510,20 @@ namespace emul
 	{
 		address &= m_addressMask;
 		const MemorySlot& slot = FindBlock(address);
-		const MemoryBlockBase* block = slot.blockR;
+		if (slot.directR)
+		{
+			return slot.directR[address & m_slotOffsetMask];
+		}
 
+		const MemoryBlockBase* block = slot.blockR;
 		if (block)
 		{
-			return block->read(address - slot.baseR);
+			const BYTE value = block->read(address - slot.baseR);
+			if ((slot.watch & WATCH_READ) && m_watcher)
+			{
+				m_watcher->OnMemoryRead(address, value);
+			}
+			return value;
 		}
 		else
 		{
@@ -344,6 +534,15 @@ namespace emul
 
 	WORD Memory::Read16(ADDRESS address) const
 	{
+		address &= m_addressMask;
+		const ADDRESS offset = address & m_slotOffsetMask;
+		const MemorySlot& slot = FindBlock(address);
+		if (slot.directR && (offset <= m_slotOffsetMask - 1))
+		{
+			const BYTE* data = slot.directR + offset;
+			return MakeWord(data[1], data[0]);
+		}
+
 		BYTE l = Read8(address);
 		BYTE h = Read8(address + 1);
 		return MakeWord(h, l);
@@ -351,6 +550,15 @@ namespace emul
 
 	WORD Memory::Read16be(ADDRESS address) const
 	{
+		address &= m_addressMask;
+		const ADDRESS offset = address & m_slotOffsetMask;
+		const MemorySlot& slot = FindBlock(address);
+		if (slot.directR && (offset <= m_slotOffsetMask - 1))
+		{
+			const BYTE* data = slot.directR + offset;
+			return MakeWord(data[0], data[1]);
+		}
+
 		BYTE h = Read8(address);
 		BYTE l = Read8(address + 1);
 		return MakeWord(h, l);
@@ -358,6 +566,15 @@ namespace emul
 
 	DWORD Memory::Read32be(ADDRESS address) const
 	{
+		address &= m_addressMask;
+		const ADDRESS offset = address & m_slotOffsetMask;
+		const MemorySlot& slot = FindBlock(address);
+		if (slot.directR && (offset <= m_slotOffsetMask - 3))
+		{
+			const BYTE* data = slot.directR + offset;
+			return MakeDword(MakeWord(data[0], data[1]), MakeWord(data[2], data[3]));
+		}
+
 		WORD h = Read16be(address);
 		WORD l = Read16be(address + 2);
 		return MakeDword(h, l);
@@ -367,11 +584,24 @@ namespace emul
 	{
 		address &= m_addressMask;
 		const MemorySlot& slot = FindBlock(address);
-		MemoryBlockBase* block = slot.blockW;
+		if (slot.directW)
+		{
+			slot.directW[address & m_slotOffsetMask] = value;
+			return;
+		}
 
+		MemoryBlockBase* block = slot.blockW;
 		if (block)
 		{
 			block->write(address - slot.baseW, value);
+			if ((slot.watch & WATCH_WRITE) && m_watcher)
+			{
+				m_watcher->OnMemoryWrite(address, value);
+			}
+			if (slot.clean)
+			{
+				OnWriteClean(address);
+			}
 		}
 		else
 		{
@@ -381,18 +611,53 @@ namespace emul
 
 	void Memory::Write16(ADDRESS address, WORD value)
 	{
+		address &= m_addressMask;
+		const ADDRESS offset = address & m_slotOffsetMask;
+		const MemorySlot& slot = FindBlock(address);
+		if (slot.directW && (offset <= m_slotOffsetMask - 1))
+		{
+			BYTE* data = slot.directW + offset;
+			data[0] = GetLByte(value);
+			data[1] = GetHByte(value);
+			return;
+		}
+
 		Write8(address, GetLByte(value));
 		Write8(address + 1, GetHByte(value));
 	}
 
 	void Memory::Write16be(ADDRESS address, WORD value)
 	{
+		address &= m_addressMask;
+		const ADDRESS offset = address & m_slotOffsetMask;
+		const MemorySlot& slot = FindBlock(address);
+		if (slot.directW && (offset <= m_slotOffsetMask - 1))
+		{
+			BYTE* data = slot.directW + offset;
+			data[0] = GetHByte(value);
+			data[1] = GetLByte(value);
+			return;
+		}
+
 		Write8(address, GetHByte(value));
 		Write8(address + 1, GetLByte(value));
 	}
 
 	void Memory::Write32be(ADDRESS address, DWORD value)
 	{
+		address &= m_addressMask;
+		const ADDRESS offset = address & m_slotOffsetMask;
+		const MemorySlot& slot = FindBlock(address);
+		if (slot.directW && (offset <= m_slotOffsetMask - 3))
+		{
+			BYTE* data = slot.directW + offset;
+			data[0] = GetHByte(GetHWord(value));
+			data[1] = GetLByte(GetHWord(value));
+			data[2] = GetHByte(GetLWord(value));
+			data[3] = GetLByte(GetLWord(value));
+			return;
+		}
+
 		Write16be(address, GetHWord(value));
 		Write16be(address + 2, GetLWord(value));
 	}
@@ -461,7 +726,16 @@ namespace emul
 
 			// Dump only memory blocks, not io blocks
 			MemoryBlock* block = dynamic_cast<MemoryBlock*>(rawBlock);
-			if (block)
+			if (!m_serializeData)
+			{
+				// Block list only
+			}
+			else if (block && GetSnapshotFile())
+			{
+				block->SaveToSnapshot(*GetSnapshotFile(), block->GetId());
+				blockJson["chunk"] = block->GetId();
+			}
+			else if (block)
 			{
 				std::string fileName = "memory_" + block->GetId() + ".bin";
 				fs::path path = GetSerializationDir();
@@ -486,8 +760,6 @@ namespace emul
 			MemoryType type = source["type"];
 			if (type != MemoryType::IO)
 			{
-				std::string fileName = source["file"];
-
 				MemoryBlock* dest = dynamic_cast<MemoryBlock*>(FindBlock(id.c_str()));
 				if (!dest)
 				{
@@ -505,9 +777,26 @@ namespace emul
 					return;
 				}
 
-				fs::path path = GetSerializationDir();
-				path.append(fileName);
-				dest->LoadFromFile(path.string().c_str());
+				if (source.contains("chunk"))
+				{
+					if (!GetSnapshotFile())
+					{
+						throw SerializableException("Memory: No snapshot file");
+					}
+					if (!dest->LoadFromSnapshot(*GetSnapshotFile(), source["chunk"].get<std::string>()))
+					{
+						throw SerializableException("Memory: Error loading block from snapshot");
+					}
+				}
+				else if (source.contains("file"))
+				{
+					// Older snapshots: one file per block
+					std::string fileName = source["file"];
+					fs::path path = GetSerializationDir();
+					path.append(fileName);
+					dest->LoadFromFile(path.string().c_str());
+				}
+				// else: no block data, restored by the caller (see SetSerializeData)
 			}
 		}
 	}
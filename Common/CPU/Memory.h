@@ -14,6 +14,38 @@ namespace emul
 		MemoryBlockBase* blockW = nullptr;
 		ADDRESS baseR = 0;
 		ADDRESS baseW = 0;
+
+		// Direct host pointers to the data at the start of the slot.
+		// Only set for plain MemoryBlock RAM/ROM (directW: RAM only),
+		// nullptr means accesses go through blockR/blockW
+		BYTE* directR = nullptr;
+		BYTE* directW = nullptr;
+
+		// WatchFlags, see Breakpoints. A slot watched for read/write
+		// has no direct pointer so accesses go through the slow path
+		BYTE watch = 0;
+
+		// Maps a clean page of a block with dirty tracking (see RewindBuffer).
+		// No direct write pointer: the first write goes through the slow path,
+		// flags the page dirty and restores the direct pointer
+		bool clean = false;
+	};
+
+	enum WatchFlags : BYTE
+	{
+		WATCH_EXEC = 1,
+		WATCH_READ = 2,
+		WATCH_WRITE = 4,
+	};
+
+	// Notified of accesses to slots watched for read/write
+	class MemoryWatcher
+	{
+	public:
+		virtual ~MemoryWatcher() {}
+
+		virtual void OnMemoryRead(ADDRESS address, BYTE value) = 0;
+		virtual void OnMemoryWrite(ADDRESS address, BYTE value) = 0;
 	};
 
 	enum class AllocateMode
@@ -60,6 +92,30 @@ namespace emul
 		void Write16be(ADDRESS address, WORD value); // big-endian
 		void Write32be(ADDRESS address, DWORD value); // big-endian
 
+		// Direct host pointer to [address, address+len), for bulk transfers.
+		// nullptr if the range is not entirely in one slot with direct access
+		const BYTE* GetDirectReadPtr(ADDRESS address, DWORD len) const;
+		BYTE* GetDirectWritePtr(ADDRESS address, DWORD len);
+
+		WORD GetBlockGranularity() const { return m_blockGranularity; }
+
+		// Breakpoint/watchpoint flags (WatchFlags) of the slot containing address
+		void SetWatch(ADDRESS address, BYTE flags);
+		BYTE GetWatch(ADDRESS address) const { return FindBlock(address & m_addressMask).watch; }
+		void ClearWatch();
+		void SetWatcher(MemoryWatcher* watcher) { m_watcher = watcher; }
+
+		// Dirty page tracking of RAM blocks, for incremental snapshots (see RewindBuffer).
+		// Blocks allocated later are tracked as well
+		void EnableDirtyTracking(bool enable);
+		bool IsDirtyTracking() const { return m_dirtyTracking; }
+		void ClearDirty();
+		std::vector<MemoryBlock*> GetTrackedBlocks() const;
+
+		// When false, Serialize() only saves the block list, block
+		// data is saved and restored by the caller (see RewindBuffer)
+		void SetSerializeData(bool serialize) { m_serializeData = serialize; }
+
 		void Clear(BYTE filler = 0);
 
 		void Dump(ADDRESS start, DWORD len, const char* outFile);
@@ -79,6 +135,13 @@ namespace emul
 	protected:
 		MemoryBlockBase* FindBlock(const char* id) const;
 
+		// Recompute direct host pointers after slot block/base changes
+		void UpdateDirectAccess(size_t slotIndex);
+		void UpdateDirectAccess();
+
+		// First write to a clean slot
+		void OnWriteClean(ADDRESS address);
+
 		using MemoryBlocks = std::vector<std::tuple<ADDRESS, MemoryBlock>>;
 
 	private:
@@ -86,10 +149,16 @@ namespace emul
 		ADDRESS m_addressMask = 0;
 
 		const WORD m_blockGranularity;
+		const ADDRESS m_slotOffsetMask;
 
 		static WORD s_uninitialized;
 
 		std::vector<MemorySlot> m_memory;
 		std::set<MemoryBlockBase*> m_blocks;
+
+		MemoryWatcher* m_watcher = nullptr;
+
+		bool m_dirtyTracking = false;
+		bool m_serializeData = true;
 	};
 }
@@ -2,6 +2,7 @@
 
 #include <CPU/MemoryBlock.h>
 #include <FileUtil.h>
+#include <SnapshotFile.h>
 
 using hscommon::fileUtil::File;
 
@@ -47,13 +48,19 @@ namespace emul
 
 		if (size == 0 || size > m_maxBlockSize)
 		{
-			throw std::exception("Invalid block size");
+			throw std::runtime_error("Invalid block size");
 		}
 
 		m_size = RoundBlockSize(size);
 		m_data = new BYTE[m_size];
 
 		Clear();
+
+		// New storage, all pages are dirty
+		if (IsDirtyTracking())
+		{
+			EnableDirtyTracking(true);
+		}
 	}
 
 	void MemoryBlock::Clear(BYTE filler)
@@ -82,7 +89,7 @@ namespace emul
 
 		if (offset >= m_size)
 		{
-			throw std::exception("LoadBinary: offset out of range");
+			throw std::runtime_error("LoadBinary: offset out of range");
 		}
 
 		File f(file, "rb");
@@ -185,4 +192,58 @@ namespace emul
 
 		return true;
 	}
+
+	void MemoryBlock::SaveToSnapshot(SnapshotFile& to, const std::string& name) const
+	{
+		to.AddChunk(SnapshotFile::ChunkType::MEMORY, name, m_data, m_size);
+	}
+
+	bool MemoryBlock::LoadFromSnapshot(const SnapshotFile& from, const std::string& name)
+	{
+		size_t size;
+		const BYTE* data = from.FindChunk(SnapshotFile::ChunkType::MEMORY, name, size);
+		if (!data)
+		{
+			LogPrintf(LOG_ERROR, "LoadFromSnapshot: chunk not found [%s]", name.c_str());
+			return false;
+		}
+		else if (size != m_size)
+		{
+			LogPrintf(LOG_ERROR, "LoadFromSnapshot: size mismatch [%s]", name.c_str());
+			return false;
+		}
+
+		memcpy(m_data, data, size);
+		return true;
+	}
+
+	void MemoryBlock::EnableDirtyTracking(bool enable)
+	{
+		const DWORD pageCount = enable ? (GetRawSize() + s_blockGranularity - 1) / s_blockGranularity : 0;
+		m_dirty.assign(pageCount, 1);
+		m_dirty.shrink_to_fit();
+		m_dirtyCount = pageCount;
+	}
+
+	void MemoryBlock::SetDirty(ADDRESS rawOffset, DWORD len)
+	{
+		if (m_dirty.empty() || !len)
+		{
+			return;
+		}
+
+		const DWORD first = rawOffset / s_blockGranularity;
+		const DWORD last = std::min((rawOffset + len - 1) / s_blockGranularity, (DWORD)m_dirty.size() - 1);
+		for (DWORD page = first; page <= last; ++page)
+		{
+			m_dirtyCount += !m_dirty[page];
+			m_dirty[page] = 1;
+		}
+	}
+
+	void MemoryBlock::ClearDirty()
+	{
+		std::fill(m_dirty.begin(), m_dirty.end(), 0);
+		m_dirtyCount = 0;
+	}
 }
@@ -6,6 +6,8 @@
 
 namespace emul
 {
+	class SnapshotFile;
+
 	class MemoryBlock : public MemoryBlockBase
 	{
 	public:
@@ -31,12 +33,51 @@ namespace emul
 		virtual bool Dump(const char* outFile) const { return Dump(0, m_size, outFile); }
 		virtual bool Dump(ADDRESS offset, DWORD len, const char* outFile) const;
 
+		// Block data as snapshot file chunk(s), see SnapshotFile
+		virtual void SaveToSnapshot(SnapshotFile& to, const std::string& name) const;
+		virtual bool LoadFromSnapshot(const SnapshotFile& from, const std::string& name);
+
 		virtual BYTE read(ADDRESS offset) const override;
 		virtual void write(ADDRESS offset, BYTE data) override;
 
 		const BYTE* getPtr() const { return m_data; }
+		BYTE* getPtr() { return m_data; }
+
+		// Incremental snapshots (see RewindBuffer)
+		//
+		// Block contents as raw host storage, in pages of GetBlockGranularity() bytes.
+		// Pages written since the last ClearDirty() are flagged dirty: Memory flags
+		// plain blocks on the first write to a page, subclasses with their own
+		// storage (e.g. video planes) flag them in write() with MarkDirty()
+		virtual BYTE* GetRawData() { return m_data; }
+		virtual DWORD GetRawSize() const { return m_size; }
+
+		// All pages start dirty
+		void EnableDirtyTracking(bool enable);
+		bool IsDirtyTracking() const { return !m_dirty.empty(); }
+
+		DWORD GetPageCount() const { return (DWORD)m_dirty.size(); }
+		bool IsDirty(DWORD page) const { return m_dirty[page]; }
+		// Number of dirty pages, 0 if nothing was written since ClearDirty()
+		DWORD GetDirtyCount() const { return m_dirtyCount; }
+
+		void SetDirty(ADDRESS rawOffset, DWORD len);
+		void ClearDirty();
 
 	protected:
+		void MarkDirty(ADDRESS rawOffset)
+		{
+			if (!m_dirty.empty())
+			{
+				BYTE& dirty = m_dirty[rawOffset / s_blockGranularity];
+				m_dirtyCount += !dirty;
+				dirty = 1;
+			}
+		}
+
 		BYTE* m_data = nullptr;
+
+		std::vector<BYTE> m_dirty;
+		DWORD m_dirtyCount = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace emul
+{
+	// Opcode handler for the CPU dispatch tables
+	//
+	// Drop-in replacement for std::function<void()> in the opcode tables.
+	// The handler (typically a lambda capturing 'this' and a few
+	// constants) is stored inline and invoked through a plain function
+	// pointer generated at compile time for each handler type.
+	// No heap allocation and no type-erasure call chain.
+	//
+	// Handlers must be trivially copyable and fit in the inline storage,
+	// this is enforced at compile time.
+	class OpcodeHandler
+	{
+	public:
+		OpcodeHandler() = default;
+
+		template<typename FUNC, typename = std::enable_if_t<!std::is_same<std::decay_t<FUNC>, OpcodeHandler>::value>>
+		OpcodeHandler(FUNC func)
+		{
+			static_assert(sizeof(FUNC) <= sizeof(m_storage), "Opcode handler too large");
+			static_assert(alignof(FUNC) <= alignof(void*), "Opcode handler alignment");
+			static_assert(std::is_trivially_copyable<FUNC>::value, "Opcode handler must be trivially copyable");
+			static_assert(std::is_trivially_destructible<FUNC>::value, "Opcode handler must be trivially destructible");
+
+			new (m_storage) FUNC(func);
+			m_thunk = &Call<FUNC>;
+		}
+
+		void operator()() const { m_thunk(m_storage); }
+
+	protected:
+		using ThunkFunc = void(*)(const void* storage);
+
+		template<typename FUNC>
+		static void Call(const void* storage) { (*static_cast<const FUNC*>(storage))(); }
+
+		static void Unassigned(const void*) { throw std::runtime_error("Unassigned opcode handler"); }
+
+		ThunkFunc m_thunk = &Unassigned;
+
+		// 'this' + member function pointer + one more pointer/value
+		alignas(void*) unsigned char m_storage[4 * sizeof(void*)] = {};
+	};
+
+	static_assert(std::is_trivially_copyable<OpcodeHandler>::value, "OpcodeHandler must be trivially copyable");
+}
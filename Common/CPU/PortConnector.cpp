@@ -1,16 +1,14 @@
 #include "stdafx.h"
 
 #include "PortConnector.h"
+#include "CPUProfiler.h"
+#include "Breakpoints.h"
 #include <Config.h>
 
 namespace emul
 {
-	PortConnector::OutputPortMap PortConnector::m_outputPorts;
-	PortConnector::InputPortMap PortConnector::m_inputPorts;
-	WORD PortConnector::m_currentPort = 0;
-	PortConnectorMode PortConnector::m_portConnectorMode = PortConnectorMode::UNDEFINED;
-
-	GetPortFunc PortConnector::m_getPortFunc = nullptr;
+	PortConnector::Context PortConnector::s_defaultContext;
+	thread_local PortConnector::Context* PortConnector::s_currentContext = &PortConnector::s_defaultContext;
 
 	WORD GetPortByteHi(WORD port) { return port >> 8; }
 	WORD GetPortByteLow(WORD port) { return port & 0xFF; }
@@ -37,7 +35,7 @@ namespace emul
 		handler->chained = new PortHandler(chained);
 	}
 
-	PortConnector::PortConnector() : Logger("PORT")
+	PortConnector::PortConnector() : Logger("PORT"), m_context(s_currentContext)
 	{
 	}
 
@@ -45,41 +43,46 @@ namespace emul
 	{
 	}
 
-	void PortConnector::Init(PortConnectorMode mode)
+	void PortConnector::SetCurrentContext(Context* context)
+	{
+		s_currentContext = context ? context : &s_defaultContext;
+	}
+
+	void PortConnector::Context::Init(PortConnectorMode mode)
 	{
-		m_portConnectorMode = mode;
+		this->mode = mode;
 
 		switch (mode)
 		{
 		case PortConnectorMode::BYTE_HI:
-			m_getPortFunc = GetPortByteHi;
-			m_inputPorts.resize(256);
-			m_outputPorts.resize(256);
+			getPortFunc = GetPortByteHi;
+			inputPorts.resize(256);
+			outputPorts.resize(256);
 			break;
 
 		case PortConnectorMode::BYTE_LOW:
-			m_getPortFunc = GetPortByteLow;
-			m_inputPorts.resize(256);
-			m_outputPorts.resize(256);
+			getPortFunc = GetPortByteLow;
+			inputPorts.resize(256);
+			outputPorts.resize(256);
 			break;
 
 		case PortConnectorMode::WORD:
-			m_getPortFunc = GetPortWord;
-			m_inputPorts.resize(65536);
-			m_outputPorts.resize(65536);
+			getPortFunc = GetPortWord;
+			inputPorts.resize(65536);
+			outputPorts.resize(65536);
 			break;
 
 		default:
-			throw std::exception("PortConnector::Init(): Invalid mode");
+			throw std::runtime_error("PortConnector::Init(): Invalid mode");
 		}
 
 		Clear();
 	}
 
-	void PortConnector::Clear()
+	void PortConnector::Context::Clear()
 	{
-		std::fill(m_inputPorts.begin(), m_inputPorts.end(), PortHandler());
-		std::fill(m_outputPorts.begin(), m_outputPorts.end(), PortHandler());
+		std::fill(inputPorts.begin(), inputPorts.end(), PortHandler());
+		std::fill(outputPorts.begin(), outputPorts.end(), PortHandler());
 	}
 
 	bool PortConnector::Connect(WORD port, INFunction inFunc, bool replace)
@@ -87,7 +90,7 @@ namespace emul
 		if (!IsInit())
 		{
 			LogPrintf(LOG_ERROR, "PortConnector: Not Initialized");
-			throw std::exception("PortConnector: Not Initialized");
+			throw std::runtime_error("PortConnector: Not Initialized");
 		}
 
 		LogPrintf(LOG_INFO, "Connect input port 0x%04X", port);
@@ -110,7 +113,7 @@ namespace emul
 		if (!IsInit())
 		{
 			LogPrintf(LOG_ERROR, "PortConnector: Not Initialized");
-			throw std::exception("PortConnector: Not Initialized");
+			throw std::runtime_error("PortConnector: Not Initialized");
 		}
 
 		LogPrintf(LOG_INFO, "Connect output port 0x%04X", port);
@@ -142,7 +145,7 @@ namespace emul
 		if (!IsInit())
 		{
 			LogPrintf(LOG_ERROR, "PortConnector: Not Initialized");
-			throw std::exception("PortConnector: Not Initialized");
+			throw std::runtime_error("PortConnector: Not Initialized");
 		}
 
 		LogPrintf(LOG_INFO, "Connect input ports, mask=[%s]", portMask.ToString().c_str());
@@ -164,7 +167,7 @@ namespace emul
 		if (!IsInit())
 		{
 			LogPrintf(LOG_ERROR, "PortConnector: Not Initialized");
-			throw std::exception("PortConnector: Not Initialized");
+			throw std::runtime_error("PortConnector: Not Initialized");
 		}
 
 		LogPrintf(LOG_INFO, "Connect output ports, mask=[%s]", portMask.ToString().c_str());
@@ -217,7 +220,11 @@ namespace emul
 
 	bool PortConnector::In(WORD port, BYTE& value)
 	{
-		m_currentPort = port;
+		m_context->currentPort = port;
+		if (m_context->profiler)
+		{
+			m_context->profiler->OnPortIn(port);
+		}
 		PortHandler& inPort = GetInputPort(port);
 
 		if (!inPort.IsSet())
@@ -226,16 +233,32 @@ namespace emul
 			LogPrintf(LOG_WARNING, "PortConnector::In: port 0x%04X not allocated", port);
 #endif
 			value = 0xFF;
+			if (m_context->breakpoints)
+			{
+				m_context->breakpoints->OnPortIn(port, value);
+			}
 			return false;
 		}
 
 		value = inPort.In();
+		if (m_context->breakpoints)
+		{
+			m_context->breakpoints->OnPortIn(port, value);
+		}
 		return true;
 	}
 
 	bool PortConnector::Out(WORD port, BYTE value)
 	{
-		m_currentPort = port;
+		m_context->currentPort = port;
+		if (m_context->profiler)
+		{
+			m_context->profiler->OnPortOut(port);
+		}
+		if (m_context->breakpoints)
+		{
+			m_context->breakpoints->OnPortOut(port, value);
+		}
 		PortHandler& outPort = GetOutputPort(port);
 
 		if (!outPort.IsSet())
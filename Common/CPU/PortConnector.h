@@ -15,6 +15,9 @@ namespace emul
 
 	typedef WORD(*GetPortFunc)(WORD);
 
+	class CPUProfiler;
+	class Breakpoints;
+
 
 	class PortConnector : virtual public Logger
 	{
@@ -22,10 +25,6 @@ namespace emul
 		PortConnector();
 		virtual ~PortConnector();
 
-		static void Init(PortConnectorMode mode);
-
-		static void Clear();
-
 		typedef void (PortConnector::* OUTFunction)(BYTE);
 		typedef BYTE(PortConnector::* INFunction)();
 
@@ -65,6 +64,48 @@ namespace emul
 		using InputPortMap = std::vector<PortHandler>;
 		using OutputPortMap = std::vector<PortHandler>;
 
+		// Port maps for one machine.
+		//
+		// Each ComputerBase owns a context and makes it current for the
+		// calling thread when it is constructed and initialized.
+		// PortConnectors attach to the current context when they are
+		// constructed, so devices of different machines don't share ports.
+		struct Context
+		{
+			Context() = default;
+
+			Context(const Context&) = delete;
+			Context& operator=(const Context&) = delete;
+			Context(Context&&) = delete;
+			Context& operator=(Context&&) = delete;
+
+			void Init(PortConnectorMode mode);
+			void Clear();
+
+			bool IsInit() const { return outputPorts.size() && inputPorts.size() && mode != PortConnectorMode::UNDEFINED; }
+
+			OutputPortMap outputPorts;
+			InputPortMap inputPorts;
+
+			GetPortFunc getPortFunc = nullptr;
+
+			WORD currentPort = 0;
+			PortConnectorMode mode = PortConnectorMode::UNDEFINED;
+
+			// Port access counters, nullptr when profiling is disabled
+			CPUProfiler* profiler = nullptr;
+
+			// Port watchpoints, nullptr if the machine has no breakpoint engine
+			Breakpoints* breakpoints = nullptr;
+		};
+
+		// nullptr restores the default (process-wide) context
+		static void SetCurrentContext(Context* context);
+		static Context& GetCurrentContext() { return *s_currentContext; }
+
+		void Init(PortConnectorMode mode) { m_context->Init(mode); }
+		void Clear() { m_context->Clear(); }
+
 		bool In(WORD port, BYTE& value);
 		bool Out(WORD port, BYTE value);
 
@@ -79,27 +120,27 @@ namespace emul
 		bool DisconnectInput(WORD portNb);
 		bool DisconnectOutput(WORD portNb);
 
-		static WORD GetCurrentPort() { return m_currentPort; }
+		WORD GetCurrentPort() const { return m_context->currentPort; }
+
+		// Bind to a specific context instead of the one that was current at construction
+		void AttachContext(Context& context) { m_context = &context; }
 
 	protected:
-		static bool IsInit() { return m_outputPorts.size() && m_inputPorts.size() && m_portConnectorMode != PortConnectorMode::UNDEFINED; }
-		static PortConnectorMode GetPortConnectorMode() { return m_portConnectorMode; }
+		bool IsInit() const { return m_context->IsInit(); }
+		PortConnectorMode GetPortConnectorMode() const { return m_context->mode; }
 
 		// Connect/Disconnect are called internally and receive proper byte value in byte modes
-		inline PortHandler& GetInputPortDirect(WORD port) const { return m_inputPorts[port]; }
-		inline PortHandler& GetOutputPortDirect(WORD port) const { return m_outputPorts[port]; }
+		inline PortHandler& GetInputPortDirect(WORD port) const { return m_context->inputPorts[port]; }
+		inline PortHandler& GetOutputPortDirect(WORD port) const { return m_context->outputPorts[port]; }
 
 		// In/Out from CPU receives full word that may need to be trimmed for low/hi byte modes
-		inline PortHandler& GetInputPort(WORD port) const { return m_inputPorts[m_getPortFunc(port)]; }
-		inline PortHandler& GetOutputPort(WORD port) const { return m_outputPorts[m_getPortFunc(port)]; }
+		inline PortHandler& GetInputPort(WORD port) const { return m_context->inputPorts[m_context->getPortFunc(port)]; }
+		inline PortHandler& GetOutputPort(WORD port) const { return m_context->outputPorts[m_context->getPortFunc(port)]; }
 
 	private:
-		static OutputPortMap m_outputPorts;
-		static InputPortMap m_inputPorts;
-
-		static GetPortFunc m_getPortFunc;
+		Context* m_context = nullptr;
 
-		static WORD m_currentPort;
-		static PortConnectorMode m_portConnectorMode;
+		static Context s_defaultContext;
+		static thread_local Context* s_currentContext;
 	};
 }
@@ -0,0 +1,324 @@
+#include "stdafx.h"
+
+#include <Computer/BatchRunner.h>
+#include <Config.h>
+#include <FileUtil.h>
+#include <SnapshotFile.h>
+#include <Sound/Sound.h>
+#include <algorithm>
+#include <chrono>
+
+using cfg::CONFIG;
+using hscommon::fileUtil::File;
+
+namespace emul
+{
+	BatchRunner::BatchRunner(ComputerBase& pc) :
+		Logger("BATCH"),
+		m_pc(pc)
+	{
+		AttachContext(pc.GetPortContext());
+	}
+
+	bool BatchRunner::SetBreakPort(WORD port)
+	{
+		LogPrintf(LOG_INFO, "Break on write to port 0x%04X", port);
+		m_portHit = false;
+		return Connect(port, static_cast<PortConnector::OUTFunction>(&BatchRunner::OnBreakPort), true);
+	}
+
+	void BatchRunner::OnBreakPort(BYTE value)
+	{
+		LogPrintf(LOG_INFO, "Break port write: port=0x%04X, value=0x%02X", GetCurrentPort(), value);
+		m_portHit = true;
+	}
+
+	BatchRunner::Result BatchRunner::Run()
+	{
+		CPU* cpu = m_pc.GetCPU();
+		assert(cpu);
+
+		Result result;
+
+		const size_t startTicks = g_ticks;
+		const size_t endTicks = m_maxTicks ? (startTicks + m_maxTicks) : SIZE_MAX;
+		m_portHit = false;
+
+		LogPrintf(LOG_INFO, "Run: start=%zu, max ticks=%zu", startTicks, m_maxTicks);
+
+		const auto start = std::chrono::steady_clock::now();
+
+		while (g_ticks < endTicks)
+		{
+			if (m_breakOnAddress && (cpu->GetCurrentAddress() == m_breakAddress))
+			{
+				result.reason = StopReason::ADDRESS;
+				break;
+			}
+
+			if (!m_pc.Step())
+			{
+				result.reason = StopReason::EXIT;
+				break;
+			}
+			++result.steps;
+
+			if (m_portHit)
+			{
+				result.reason = StopReason::PORT;
+				break;
+			}
+		}
+
+		const auto end = std::chrono::steady_clock::now();
+
+		result.ticks = g_ticks - startTicks;
+		result.wallTime = std::chrono::duration<double>(end - start).count();
+
+		LogPrintf(LOG_INFO, "Run: stop=[%s], ticks=%zu, steps=%zu, time=%.3fs",
+			GetStopReasonStr(result.reason), result.ticks, result.steps, result.wallTime);
+
+		return result;
+	}
+
+	const char* BatchRunner::GetStopReasonStr(StopReason reason)
+	{
+		switch (reason)
+		{
+		case StopReason::TICKS: return "ticks";
+		case StopReason::ADDRESS: return "address";
+		case StopReason::PORT: return "port";
+		case StopReason::EXIT: return "exit";
+		default: return "?";
+		}
+	}
+
+	bool BatchRunner::SaveFrameBuffer(const video::Video& video, const char* fileName)
+	{
+		const std::vector<uint32_t>& fb = video.GetFrameBuffer();
+		const int fbWidth = (int)video.GetFrameBufferWidth();
+		const int fbHeight = (int)video.GetFrameBufferHeight();
+
+		if (fb.empty() || !fbWidth || !fbHeight)
+		{
+			return false;
+		}
+
+		// Clip display rect to framebuffer
+		SDL_Rect rect = video.GetDisplayRect();
+		rect.x = std::clamp(rect.x, 0, fbWidth);
+		rect.y = std::clamp(rect.y, 0, fbHeight);
+		rect.w = std::clamp(rect.w, 0, fbWidth - rect.x);
+		rect.h = std::clamp(rect.h, 0, fbHeight - rect.y);
+		if (!rect.w || !rect.h)
+		{
+			rect = { 0, 0, fbWidth, fbHeight };
+		}
+
+		File file(fileName, "wb");
+		if (!file)
+		{
+			return false;
+		}
+
+		fprintf(file, "P6\n%d %d\n255\n", rect.w, rect.h);
+
+		std::vector<BYTE> line(rect.w * 3);
+		for (int y = rect.y; y < rect.y + rect.h; ++y)
+		{
+			const uint32_t* src = &fb[(size_t)y * fbWidth + rect.x];
+			BYTE* dest = line.data();
+			for (int x = 0; x < rect.w; ++x)
+			{
+				const uint32_t pixel = *src++;
+				*dest++ = BYTE(pixel >> 16);
+				*dest++ = BYTE(pixel >> 8);
+				*dest++ = BYTE(pixel);
+			}
+
+			if (fwrite(line.data(), line.size(), 1, file) != 1)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool BatchRunner::ParseAddress(const std::string& str, ADDRESS& addr)
+	{
+		try
+		{
+			const size_t sep = str.find(':');
+			if (sep == std::string::npos)
+			{
+				addr = (ADDRESS)std::stoul(str, nullptr, 0);
+				return true;
+			}
+
+			const unsigned long segment = std::stoul(str.substr(0, sep), nullptr, 16);
+			const unsigned long offset = std::stoul(str.substr(sep + 1), nullptr, 16);
+			if (segment > 0xFFFF || offset > 0xFFFF)
+			{
+				return false;
+			}
+			addr = S2A((WORD)segment, (WORD)offset);
+			return true;
+		}
+		catch (std::exception&)
+		{
+			return false;
+		}
+	}
+
+	static File s_logFile;
+
+	static void LogCallback(const char* str)
+	{
+		fprintf(s_logFile ? s_logFile : stderr, "%s", str);
+	}
+
+	int BatchRunner::Main(int argc, char* args[], CreateComputerFunc createComputer, InitComputerFunc onInit)
+	{
+		Logger::RegisterLogCallback(LogCallback);
+
+		const char* configFile = (argc > 1) ? args[1] : "config/config.ini";
+		if (!CONFIG().LoadConfigFile(configFile))
+		{
+			fprintf(stderr, "Unable to read config file %s\n", configFile);
+			return 1;
+		}
+
+		std::string logFileName = CONFIG().GetValueStr("debug", "logfile");
+		if (logFileName.size())
+		{
+			Logger::EnableColors(false);
+			if (!s_logFile.Open(logFileName.c_str(), "w"))
+			{
+				fprintf(stderr, "Error opening log file\n");
+			}
+			else if (CONFIG().GetValueBool("debug", "logfile.async"))
+			{
+				Logger::SetTimestampFunc([]() { return g_ticks; });
+				Logger::EnableAsync();
+			}
+		}
+
+		// This thread's sound instance, no audio output: samples
+		// are only streamed to file if requested
+		sound::Sound sound;
+		sound::Sound::SetCurrent(&sound);
+		sound.Init(1024, false);
+		sound.EnableLog(CONFIG().GetLogLevel("sound"));
+
+		std::string audioFile = CONFIG().GetValueStr("batch", "audio");
+		if (audioFile.size())
+		{
+			sound.StreamToFile(true, audioFile.c_str());
+		}
+
+		std::string arch = CONFIG().GetValueStr("core", "arch");
+		ComputerBase* pc = createComputer(arch);
+		if (!pc)
+		{
+			fprintf(stderr, "Unknown architecture: [core].arch=[%s]\n", arch.c_str());
+			Logger::EnableAsync(false);
+			sound::Sound::SetCurrent(nullptr);
+			return 2;
+		}
+
+		int exitCode = 0;
+		try
+		{
+			int32_t baseRAM = CONFIG().GetValueInt32("core", "baseram", 640);
+			pc->Init(baseRAM);
+			pc->EnableLog(CONFIG().GetLogLevel("pc"));
+			pc->Reset();
+			if (onInit)
+			{
+				onInit(*pc);
+			}
+
+			// Start point for an input replay, the config must match the snapshot
+			std::string snapshotDir = CONFIG().GetValueStr("batch", "snapshot");
+			if (snapshotDir.size())
+			{
+				SnapshotFile snapshot;
+				json state;
+
+				std::filesystem::path snapshotPath = snapshotDir;
+				snapshotPath.append(SnapshotFile::FILE_NAME);
+				if (!snapshot.Load(snapshotPath) || !snapshot.GetState(state))
+				{
+					throw std::runtime_error("Unable to read [batch].snapshot");
+				}
+
+				pc->SetSerializationDir(snapshotDir);
+				pc->SetSnapshotFile(&snapshot);
+				pc->Deserialize(state);
+				pc->SetSnapshotFile(nullptr);
+			}
+
+			// Skips the sound output when there is nothing to record
+			pc->SetTurbo(audioFile.empty());
+
+			BatchRunner runner(*pc);
+			runner.EnableLog(CONFIG().GetLogLevel("batch"));
+
+			std::string ticksStr = CONFIG().GetValueStr("batch", "ticks");
+			if (ticksStr.size())
+			{
+				runner.SetMaxTicks((size_t)std::stoull(ticksStr, nullptr, 0));
+			}
+
+			std::string breakpointStr = CONFIG().GetValueStr("batch", "breakpoint");
+			if (breakpointStr.size())
+			{
+				ADDRESS breakpoint;
+				if (!ParseAddress(breakpointStr, breakpoint))
+				{
+					throw std::runtime_error("Unable to decode [batch].breakpoint address");
+				}
+				runner.SetBreakAddress(breakpoint);
+			}
+
+			std::string portStr = CONFIG().GetValueStr("batch", "port");
+			if (portStr.size())
+			{
+				runner.SetBreakPort(CONFIG().GetValueWORD("batch", "port"));
+			}
+
+			Result result = runner.Run();
+
+			std::string frameBufferFile = CONFIG().GetValueStr("batch", "framebuffer");
+			if (frameBufferFile.size() && !SaveFrameBuffer(pc->GetVideo(), frameBufferFile.c_str()))
+			{
+				fprintf(stderr, "Unable to save framebuffer to %s\n", frameBufferFile.c_str());
+				exitCode = 3;
+			}
+
+			fprintf(stdout, "arch=%s stop=%s ticks=%zu steps=%zu wall=%.3fs speed=%.3fMHz\n",
+				arch.c_str(),
+				GetStopReasonStr(result.reason),
+				result.ticks,
+				result.steps,
+				result.wallTime,
+				result.GetTicksMHz());
+		}
+		catch (const std::exception& e)
+		{
+			fprintf(stderr, "Error while running cpu [%s]\n", e.what());
+			exitCode = 4;
+		}
+
+		delete pc;
+		pc = nullptr;
+
+		Logger::EnableAsync(false);
+
+		sound.StreamToFile(false);
+		sound::Sound::SetCurrent(nullptr);
+
+		return exitCode;
+	}
+}
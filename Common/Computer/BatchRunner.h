@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Computer/ComputerBase.h>
+#include <CPU/PortConnector.h>
+#include <functional>
+#include <string>
+
+namespace emul
+{
+	// Runs a computer without any UI (no main window, overlay or console),
+	// for a number of emulated ticks or until a trigger is hit,
+	// and measures the throughput.
+	//
+	// Used by the headless batch executables for throughput measurements
+	// and regression runs, see Main().
+	class BatchRunner : public PortConnector
+	{
+	public:
+		enum class StopReason { TICKS, ADDRESS, PORT, EXIT };
+
+		struct Result
+		{
+			StopReason reason = StopReason::TICKS;
+
+			size_t ticks = 0; // Emulated g_ticks
+			size_t steps = 0; // Computer::Step() calls
+			double wallTime = 0.0; // Seconds
+
+			// Emulated ticks per (wall) second, in MHz
+			double GetTicksMHz() const { return wallTime > 0.0 ? (ticks / wallTime) / 1000000.0 : 0.0; }
+		};
+
+		// pc must be initialized (ports are connected to its context)
+		BatchRunner(ComputerBase& pc);
+
+		BatchRunner() = delete;
+		BatchRunner(const BatchRunner&) = delete;
+		BatchRunner& operator=(const BatchRunner&) = delete;
+		BatchRunner(BatchRunner&&) = delete;
+		BatchRunner& operator=(BatchRunner&&) = delete;
+
+		// 0 = no limit
+		void SetMaxTicks(size_t ticks) { m_maxTicks = ticks; }
+
+		// Stop before the instruction at addr is executed
+		void SetBreakAddress(ADDRESS addr) { m_breakOnAddress = true; m_breakAddress = addr; }
+
+		// Stop after a write to port.
+		// The trigger is chained to the existing output port handler,
+		// so the runner must outlive the computer's last Step()
+		bool SetBreakPort(WORD port);
+
+		Result Run();
+
+		static const char* GetStopReasonStr(StopReason reason);
+
+		// Saves the visible part of the framebuffer as a binary PPM (P6) image
+		static bool SaveFrameBuffer(const video::Video& video, const char* fileName);
+
+		// Decodes a [batch].breakpoint address, "SEGMENT:OFFSET" (hex) or linear
+		static bool ParseAddress(const std::string& str, ADDRESS& addr);
+
+		// Headless entry point for any computer:
+		// Loads the config file (args[1] or config/config.ini), creates the computer
+		// for [core].arch with createComputer, initializes it, calls onInit (optional,
+		// e.g. to set the cpu speed), runs it with the [batch] parameters and prints
+		// a summary line on stdout.
+		//
+		// The run has its own Sound instance, without audio device.
+		// Returns the process exit code
+		using CreateComputerFunc = std::function<ComputerBase*(const std::string& arch)>;
+		using InitComputerFunc = std::function<void(ComputerBase& pc)>;
+		static int Main(int argc, char* args[], CreateComputerFunc createComputer, InitComputerFunc onInit = nullptr);
+
+	protected:
+		void OnBreakPort(BYTE value);
+
+		ComputerBase& m_pc;
+
+		size_t m_maxTicks = 0;
+
+		bool m_breakOnAddress = false;
+		ADDRESS m_breakAddress = 0;
+
+		bool m_portHit = false;
+	};
+}
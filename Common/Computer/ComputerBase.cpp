@@ -1,7 +1,10 @@
 #include "stdafx.h"
 #include <Computer/ComputerBase.h>
+#include <Computer/RewindBuffer.h>
 #include <Config.h>
 #include "IO/InputEvents.h"
+#include <Storage/CartridgeLoader.h>
+#include <Storage/DeviceTape.h>
 
 #include <assert.h>
 #include <fstream>
@@ -14,13 +17,31 @@ namespace emul
 		Logger("Computer"),
 		m_memory(blockGranularity)
 	{
+		// Devices created from here on connect to this machine's ports
+		AttachContext(m_ports);
+		SetCurrentContext(&m_ports);
 	}
 
 	ComputerBase::~ComputerBase()
 	{
+		m_ports.breakpoints = nullptr;
+
+		if (m_profiler)
+		{
+			m_profiler->Dump();
+			m_ports.profiler = nullptr;
+			delete m_profiler;
+		}
+
+		delete m_rewind;
 		delete m_inputs;
 		delete m_cpu;
 		delete m_video;
+
+		if (&GetCurrentContext() == &m_ports)
+		{
+			SetCurrentContext(nullptr);
+		}
 	}
 
 	void ComputerBase::Reboot()
@@ -32,12 +53,14 @@ namespace emul
 
 	void ComputerBase::Init(const char* cpuid, WORD baseram)
 	{
+		SetCurrentContext(&m_ports);
+
 		m_baseRAMSize = baseram;
 
 		InitCPU(cpuid);
 		if (!m_cpu)
 		{
-			throw std::exception("CPU not set");
+			throw std::runtime_error("CPU not set");
 		}
 
 		m_cpu->EnableLog(CONFIG().GetLogLevel("cpu"));
@@ -45,8 +68,74 @@ namespace emul
 
 		PortConnector::Clear();
 
+		m_scheduler.Clear();
+		m_scheduler.EnableLog(CONFIG().GetLogLevel("scheduler"));
+
 		m_memory.Init(m_cpu->GetAddressBits());
 		m_memory.EnableLog(CONFIG().GetLogLevel("memory"));
+
+		InitBreakpoints();
+
+		if (CONFIG().GetValueBool("debug", "profile"))
+		{
+			InitProfiler();
+		}
+
+		if (CONFIG().GetValueInt32("debug", "rewind.interval") > 0)
+		{
+			InitRewind();
+		}
+	}
+
+	void ComputerBase::InitBreakpoints()
+	{
+		m_breakpoints.EnableLog(CONFIG().GetLogLevel("breakpoints"));
+		m_breakpoints.Init(&m_memory);
+
+		m_cpu->SetBreakpoints(&m_breakpoints);
+		m_ports.breakpoints = &m_breakpoints;
+
+		static const std::tuple<const char*, BreakpointType> watchKeys[] = {
+			{ "watch.exec", BreakpointType::EXEC },
+			{ "watch.read", BreakpointType::READ },
+			{ "watch.write", BreakpointType::WRITE },
+			{ "watch.in", BreakpointType::PORT_IN },
+			{ "watch.out", BreakpointType::PORT_OUT },
+		};
+
+		for (const auto& [key, type] : watchKeys)
+		{
+			std::string watch = CONFIG().GetValueStr("monitor", key);
+			if (watch.size())
+			{
+				m_breakpoints.AddFromString(type, watch.c_str());
+			}
+		}
+	}
+
+	void ComputerBase::InitProfiler()
+	{
+		delete m_profiler;
+		m_profiler = new CPUProfiler();
+		m_profiler->EnableLog(CONFIG().GetLogLevel("profiler"));
+		m_profiler->Init(m_cpu->GetID().c_str(), m_cpu->GetOpcodeCount(), m_cpu->GetAddressBits(), m_memory.GetBlockGranularity());
+
+		std::string dumpFile = CONFIG().GetValueStr("debug", "profile.file", "dump/profile.csv");
+		m_profiler->SetDumpFile(dumpFile.c_str());
+
+		m_cpu->SetProfiler(m_profiler);
+		m_ports.profiler = m_profiler;
+	}
+
+	void ComputerBase::InitRewind()
+	{
+		delete m_rewind;
+		m_rewind = new RewindBuffer();
+		m_rewind->EnableLog(CONFIG().GetLogLevel("rewind"));
+		m_rewind->Init(this,
+			CONFIG().GetValueInt32("debug", "rewind.interval"),
+			CONFIG().GetValueInt32("debug", "rewind.count", 10),
+			(size_t)CONFIG().GetValueInt32("debug", "rewind.maxmem", 64) * 1024 * 1024);
 	}
 
 	void ComputerBase::InitInputs(size_t clockSpeedHz, size_t pollInterval)
@@ -59,6 +148,66 @@ namespace emul
 		m_inputs = new events::InputEvents(clockSpeedHz, pollInterval);
 		m_inputs->Init();
 		m_inputs->EnableLog(CONFIG().GetLogLevel("inputs"));
+		m_inputs->SetActionHandler([this](const events::InputRecord& action) { OnInputAction(action); });
+
+		// Recording/replay starts at power on, and restarts when a snapshot is restored
+		events::InputRecorder& recorder = m_inputs->GetRecorder();
+		recorder.EnableLog(CONFIG().GetLogLevel("inputrec"));
+
+		std::string replayFile = CONFIG().GetValueStr("debug", "input.replay");
+		std::string recordFile = CONFIG().GetValueStr("debug", "input.record");
+		if (replayFile.size())
+		{
+			recorder.StartReplay(replayFile.c_str());
+		}
+		else if (recordFile.size())
+		{
+			recorder.StartRecord(recordFile.c_str());
+		}
+	}
+
+	void ComputerBase::OnInputAction(const events::InputRecord& action)
+	{
+		using events::InputAction;
+
+		tape::DeviceTape* tape = GetTape();
+		CartridgeLoader* cart = dynamic_cast<CartridgeLoader*>(this);
+
+		switch ((InputAction)action.code)
+		{
+		case InputAction::TAPE_STATE:
+			if (tape && (action.unit < tape->GetCount()))
+			{
+				tape->GetTape(action.unit).SetState((tape::TapeState)action.value);
+				return;
+			}
+			break;
+		case InputAction::TAPE_LOAD:
+			if (tape && (action.unit < tape->GetCount()))
+			{
+				tape->GetTape(action.unit).LoadRaw(action.data.c_str());
+				return;
+			}
+			break;
+		case InputAction::CART_LOAD:
+			if (cart)
+			{
+				cart->LoadCartridge(action.data);
+				return;
+			}
+			break;
+		case InputAction::CART_UNLOAD:
+			if (cart)
+			{
+				cart->UnloadCartridge();
+				return;
+			}
+			break;
+		default:
+			break;
+		}
+
+		LogPrintf(LOG_WARNING, "OnInputAction: Action %d not supported on unit %d", action.code, action.unit);
 	}
 
 	void ComputerBase::Serialize(json& to)
@@ -90,5 +239,30 @@ namespace emul
 		m_cpu->Deserialize(from["cpu"]);
 		m_memory.Deserialize(from["memory"]);
 		m_video->Deserialize(from["video"]);
+
+		// A rewind stays in the same session and keeps the rewind history.
+		// The input stream can't follow it (the machine goes back in time,
+		// not the stream), so the recording or replay ends here
+		if (m_rewind && m_rewind->IsRestoring())
+		{
+			events::InputRecorder* recorder = m_inputs ? &m_inputs->GetRecorder() : nullptr;
+			if (recorder && (recorder->IsRecording() || recorder->IsReplaying()))
+			{
+				LogPrintf(LOG_WARNING, "Deserialize: Rewind, input %s stopped", recorder->IsRecording() ? "recording" : "replay");
+				recorder->Stop();
+			}
+			return;
+		}
+
+		if (m_inputs)
+		{
+			m_inputs->RestartRecorder();
+		}
+
+		// Restored from elsewhere, older snapshots don't apply
+		if (m_rewind)
+		{
+			m_rewind->Reset();
+		}
 	}
 }
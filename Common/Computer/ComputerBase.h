@@ -2,17 +2,21 @@
 
 #include <CPU/CPU.h>
 #include <CPU/Memory.h>
+#include <CPU/Breakpoints.h>
+#include <Computer/Scheduler.h>
 #include <Serializable.h>
 #include "Video/Video.h"
 #include <set>
 
 using emul::WORD;
 
-namespace events { class InputEvents; }
+namespace events { class InputEvents; struct InputRecord; }
 namespace tape { class DeviceTape; }
 
 namespace emul
 {
+	class RewindBuffer;
+
 	class ComputerBase : public Serializable, public PortConnector
 	{
 	public:
@@ -24,15 +28,28 @@ namespace emul
 
 		virtual void Init(WORD baseRAM) = 0;
 
-		virtual bool Step() { return m_cpu->Step(); }
+		virtual bool Step()
+		{
+			const bool ret = m_cpu->Step();
+			if (m_profiler)
+			{
+				m_profiler->OnInstruction(m_cpu->GetLastOpcode(), m_cpu->GetLastAddress(), m_cpu->GetInstructionTicks());
+			}
+			m_breakpoints.OnStep();
+			return ret;
+		}
 
 		virtual void Reset() { m_cpu->Reset(); }
 
 		CPU* GetCPU() const { return m_cpu; }
 		Memory& GetMemory() { return m_memory; }
+		Breakpoints& GetBreakpoints() { return m_breakpoints; }
 		events::InputEvents& GetInputs() { return *m_inputs; }
 		video::Video& GetVideo() { return *m_video; }
 		const video::Video& GetVideo() const { return *m_video; }
+		Scheduler& GetScheduler() { return m_scheduler; }
+		RewindBuffer* GetRewind() { return m_rewind; }
+		PortConnector::Context& GetPortContext() { return m_ports; }
 
 		virtual tape::DeviceTape* GetTape() { return nullptr; }
 
@@ -49,12 +66,26 @@ namespace emul
 		virtual void Init(const char* cpuid, WORD baseRAM);
 		virtual void InitCPU(const char* cpuID) = 0;
 		virtual void InitInputs(size_t clockSpeedHz, size_t pollInterval = 0);
+		void InitProfiler();
+		void InitBreakpoints();
+		void InitRewind();
+
+		// Media changes and other external actions, from the UI or replayed.
+		// Handles tape and cartridge actions, computers with other media override this
+		virtual void OnInputAction(const events::InputRecord& action);
+
+		// Per-machine port maps, see PortConnector::Context
+		PortConnector::Context m_ports;
 
 		Memory m_memory;
+		Breakpoints m_breakpoints;
+		Scheduler m_scheduler;
 
 		WORD m_baseRAMSize = 0;
 
 		emul::CPU* m_cpu = nullptr;
+		CPUProfiler* m_profiler = nullptr;
+		RewindBuffer* m_rewind = nullptr;
 		events::InputEvents* m_inputs = nullptr;
 		video::Video* m_video = nullptr;
 
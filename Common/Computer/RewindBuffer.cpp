@@ -0,0 +1,275 @@
+#include "stdafx.h"
+
+#include <Computer/RewindBuffer.h>
+#include <Computer/ComputerBase.h>
+
+namespace emul
+{
+	RewindBuffer::RewindBuffer() : Logger("rewind")
+	{
+	}
+
+	RewindBuffer::~RewindBuffer()
+	{
+	}
+
+	void RewindBuffer::Init(ComputerBase* computer, size_t interval, size_t maxCount, size_t maxBytes)
+	{
+		assert(computer);
+		assert(interval);
+
+		m_computer = computer;
+		m_memory = &computer->GetMemory();
+		m_interval = interval;
+		m_maxCount = std::max(maxCount, (size_t)1);
+		m_maxBytes = maxBytes;
+
+		LogPrintf(LOG_INFO, "Init: Snapshot every %zu frames, keep %zu, max %zu KB", m_interval, m_maxCount, m_maxBytes / 1024);
+
+		m_memory->EnableDirtyTracking(true);
+		Reset();
+	}
+
+	void RewindBuffer::Reset()
+	{
+		LogPrintf(LOG_DEBUG, "Reset");
+
+		m_entries.clear();
+		m_blocks.clear();
+		m_usage = 0;
+	}
+
+	void RewindBuffer::Update()
+	{
+		const size_t frame = m_computer->GetVideo().GetFrameCount();
+		if (m_entries.size() && ((frame - m_lastFrame) < m_interval))
+		{
+			return;
+		}
+
+		m_lastFrame = frame;
+		Take();
+	}
+
+	DWORD RewindBuffer::GetPageSize(const MemoryBlock* block, DWORD page) const
+	{
+		const DWORD pageSize = m_memory->GetBlockGranularity();
+		return std::min(pageSize, block->GetRawSize() - (page * pageSize));
+	}
+
+	bool RewindBuffer::CheckBlocks() const
+	{
+		std::vector<MemoryBlock*> tracked = m_memory->GetTrackedBlocks();
+		if (tracked.size() != m_blocks.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < tracked.size(); ++i)
+		{
+			if ((tracked[i] != m_blocks[i].block) ||
+				(tracked[i]->GetRawSize() != m_blocks[i].shadow.size()))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void RewindBuffer::InitShadow()
+	{
+		Reset();
+
+		for (MemoryBlock* block : m_memory->GetTrackedBlocks())
+		{
+			TrackedBlock tracked;
+			tracked.block = block;
+			tracked.shadow.assign(block->GetRawData(), block->GetRawData() + block->GetRawSize());
+
+			LogPrintf(LOG_INFO, "InitShadow: Block [%s], %d KB", block->GetId().c_str(), block->GetRawSize() / 1024);
+
+			m_usage += tracked.shadow.size();
+			m_blocks.push_back(std::move(tracked));
+		}
+	}
+
+	void RewindBuffer::Take()
+	{
+		Entry entry;
+		entry.ticks = g_ticks;
+
+		if (m_entries.empty() || !CheckBlocks())
+		{
+			// First snapshot or memory layout changed (block allocated/freed)
+			InitShadow();
+		}
+		else
+		{
+			// Previous contents of the pages written since the last snapshot
+			const DWORD pageSize = m_memory->GetBlockGranularity();
+			for (size_t i = 0; i < m_blocks.size(); ++i)
+			{
+				TrackedBlock& tracked = m_blocks[i];
+				MemoryBlock* block = tracked.block;
+				if (!block->GetDirtyCount())
+				{
+					continue;
+				}
+
+				for (DWORD page = 0; page < block->GetPageCount(); ++page)
+				{
+					if (!block->IsDirty(page))
+					{
+						continue;
+					}
+
+					const size_t offset = (size_t)page * pageSize;
+					const DWORD size = GetPageSize(block, page);
+					BYTE* shadow = tracked.shadow.data() + offset;
+					const BYTE* current = block->GetRawData() + offset;
+
+					entry.pages.push_back({ i, page, entry.data.size() });
+					entry.data.insert(entry.data.end(), shadow, shadow + size);
+					memcpy(shadow, current, size);
+				}
+			}
+		}
+		m_memory->ClearDirty();
+
+		// Device states, without the memory contents
+		json state;
+		m_snapshot.Clear();
+		m_memory->SetSerializeData(false);
+		Serializable::SetSerializeDiskData(false);
+		Serializable::SetSnapshotFile(&m_snapshot);
+		m_computer->Serialize(state);
+		Serializable::SetSnapshotFile(nullptr);
+		Serializable::SetSerializeDiskData(true);
+		m_memory->SetSerializeData(true);
+		m_snapshot.SetState(state);
+		entry.state = m_snapshot.GetBuffer();
+
+		LogPrintf(LOG_DEBUG, "Take: tick %zu, %zu pages, state %zu bytes", entry.ticks, entry.pages.size(), entry.state.size());
+
+		m_usage += entry.GetSize();
+		m_entries.push_back(std::move(entry));
+
+		Trim();
+	}
+
+	void RewindBuffer::Trim()
+	{
+		while ((m_entries.size() > 1) && ((m_entries.size() > m_maxCount) || (m_usage > m_maxBytes)))
+		{
+			m_usage -= m_entries.front().GetSize();
+			m_entries.pop_front();
+
+			// The new oldest snapshot can't be undone, its undo pages are not needed
+			Entry& oldest = m_entries.front();
+			m_usage -= oldest.GetSize();
+			oldest.pages = std::vector<UndoPage>();
+			oldest.data = std::vector<BYTE>();
+			m_usage += oldest.GetSize();
+		}
+	}
+
+	bool RewindBuffer::Rewind(size_t steps)
+	{
+		if (m_entries.empty())
+		{
+			LogPrintf(LOG_WARNING, "Rewind: No snapshot");
+			return false;
+		}
+
+		if (!CheckBlocks())
+		{
+			LogPrintf(LOG_WARNING, "Rewind: Memory layout changed, snapshots dropped");
+			Reset();
+			return false;
+		}
+
+		steps = std::min(steps, m_entries.size() - 1);
+
+		// Back to the most recent snapshot: pages written since then
+		const DWORD pageSize = m_memory->GetBlockGranularity();
+		for (TrackedBlock& tracked : m_blocks)
+		{
+			MemoryBlock* block = tracked.block;
+			if (!block->GetDirtyCount())
+			{
+				continue;
+			}
+
+			for (DWORD page = 0; page < block->GetPageCount(); ++page)
+			{
+				if (block->IsDirty(page))
+				{
+					const size_t offset = (size_t)page * pageSize;
+					memcpy(block->GetRawData() + offset, tracked.shadow.data() + offset, GetPageSize(block, page));
+				}
+			}
+		}
+
+		// Further back, newest first
+		for (size_t i = 0; i < steps; ++i)
+		{
+			const Entry& entry = m_entries.back();
+			for (const UndoPage& undo : entry.pages)
+			{
+				TrackedBlock& tracked = m_blocks[undo.blockIndex];
+				const size_t offset = (size_t)undo.page * pageSize;
+				const DWORD size = GetPageSize(tracked.block, undo.page);
+				const BYTE* data = entry.data.data() + undo.offset;
+
+				memcpy(tracked.shadow.data() + offset, data, size);
+				memcpy(tracked.block->GetRawData() + offset, data, size);
+			}
+
+			m_usage -= entry.GetSize();
+			m_entries.pop_back();
+		}
+		m_memory->ClearDirty();
+
+		// Device states
+		const Entry& target = m_entries.back();
+		json state;
+		if (!m_snapshot.Load(target.state.data(), target.state.size()) || !m_snapshot.GetState(state))
+		{
+			LogPrintf(LOG_ERROR, "Rewind: Error reading snapshot");
+			Reset();
+			return false;
+		}
+
+		bool ok = true;
+		m_restoring = true;
+		m_memory->SetSerializeData(false);
+		Serializable::SetSerializeDiskData(false);
+		Serializable::SetSnapshotFile(&m_snapshot);
+		try
+		{
+			m_computer->Deserialize(state);
+		}
+		catch (const SerializableException& e)
+		{
+			LogPrintf(LOG_ERROR, "Rewind: Error restoring snapshot: %s", e.what());
+			ok = false;
+		}
+		Serializable::SetSnapshotFile(nullptr);
+		Serializable::SetSerializeDiskData(true);
+		m_memory->SetSerializeData(true);
+		m_restoring = false;
+		m_snapshot.Close();
+
+		if (!ok)
+		{
+			Reset();
+			return false;
+		}
+
+		LogPrintf(LOG_INFO, "Rewind: %zu snapshot(s) back, to tick %zu", steps, target.ticks);
+
+		// Next snapshot one full interval from now
+		m_lastFrame = m_computer->GetVideo().GetFrameCount();
+		return true;
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <CPU/Memory.h>
+#include <SnapshotFile.h>
+#include <deque>
+#include <vector>
+
+namespace emul
+{
+	class ComputerBase;
+
+	// In-memory ring of snapshots, to rewind the emulation a few seconds
+	//
+	// A snapshot is taken every n video frames, between instructions.
+	// Device states are serialized as usual (SnapshotFile, kept in memory)
+	// but without the memory block data, which is tracked per page
+	// (see MemoryBlock dirty pages):
+	//
+	// - A shadow copy of the tracked RAM blocks holds their contents
+	//   at the most recent snapshot
+	// - Each snapshot keeps the previous contents of the pages written
+	//   since the snapshot before it (undo pages)
+	//
+	// Rewinding copies back the pages written since the most recent snapshot
+	// from the shadow copy, then applies the undo pages going back in time.
+	//
+	// Disk image changes are not saved (see SetSerializeDiskData): disks
+	// are not rewound, like images written without copy-on-write.
+	// Both taking a snapshot and rewinding only touch written pages, so
+	// the cost depends on the memory written, not on the RAM size.
+	//
+	// Size is bounded by a snapshot count and a memory budget (shadow copy
+	// included), the oldest snapshots are dropped first.
+	class RewindBuffer : public Logger
+	{
+	public:
+		RewindBuffer();
+		~RewindBuffer();
+
+		RewindBuffer(const RewindBuffer&) = delete;
+		RewindBuffer& operator=(const RewindBuffer&) = delete;
+		RewindBuffer(RewindBuffer&&) = delete;
+		RewindBuffer& operator=(RewindBuffer&&) = delete;
+
+		// Enables memory dirty tracking
+		void Init(ComputerBase* computer, size_t interval, size_t maxCount, size_t maxBytes);
+
+		// Drops all snapshots, e.g. when a snapshot is restored
+		void Reset();
+
+		// Called by the main loop between instructions,
+		// takes a snapshot every [interval] frames
+		void Update();
+
+		// Restores the snapshot taken [steps] snapshots before the most
+		// recent one (0: most recent, clamped to the oldest).
+		// Newer snapshots are dropped, an input recording or replay is stopped
+		bool Rewind(size_t steps);
+
+		// Set while a rewind deserializes the computer
+		bool IsRestoring() const { return m_restoring; }
+
+		size_t GetCount() const { return m_entries.size(); }
+		size_t GetMemoryUsage() const { return m_usage; }
+
+	protected:
+		void Take();
+		void Trim();
+
+		// (Re)creates the shadow copy, drops all snapshots
+		void InitShadow();
+		// True if the tracked blocks are the same as the shadow copy's
+		bool CheckBlocks() const;
+
+		DWORD GetPageSize(const MemoryBlock* block, DWORD page) const;
+
+		ComputerBase* m_computer = nullptr;
+		Memory* m_memory = nullptr;
+
+		size_t m_interval = 0;
+		size_t m_maxCount = 0;
+		size_t m_maxBytes = 0;
+
+		size_t m_lastFrame = 0;
+
+		struct TrackedBlock
+		{
+			MemoryBlock* block = nullptr;
+			std::vector<BYTE> shadow;
+		};
+		std::vector<TrackedBlock> m_blocks;
+
+		struct UndoPage
+		{
+			size_t blockIndex; // in m_blocks
+			DWORD page;
+			size_t offset; // in Entry::data
+		};
+
+		struct Entry
+		{
+			size_t ticks = 0;
+			std::vector<BYTE> state; // SnapshotFile buffer
+			std::vector<UndoPage> pages;
+			std::vector<BYTE> data;
+
+			size_t GetSize() const { return state.size() + (pages.size() * sizeof(UndoPage)) + data.size(); }
+		};
+		std::deque<Entry> m_entries;
+
+		size_t m_usage = 0;
+
+		// Serialization, buffer reused for each snapshot
+		SnapshotFile m_snapshot;
+
+		bool m_restoring = false;
+	};
+}
@@ -0,0 +1,110 @@
+#include "stdafx.h"
+
+#include <Computer/Scheduler.h>
+
+namespace emul
+{
+	Scheduler::Scheduler() : Logger("SCHED")
+	{
+	}
+
+	void Scheduler::Clear()
+	{
+		m_events.clear();
+		m_queue = decltype(m_queue)();
+		m_nextDeadline = NO_DEADLINE;
+	}
+
+	Scheduler::EventID Scheduler::AddEvent(size_t deadline, size_t period, EventFunc func)
+	{
+		assert(func);
+
+		EventID id = m_events.size();
+		Event event;
+		event.func = func;
+		event.period = period;
+		m_events.push_back(event);
+
+		LogPrintf(LOG_DEBUG, "AddEvent: id=%zu, deadline=%zu, period=%zu", id, deadline, period);
+
+		Push(id, deadline);
+		return id;
+	}
+
+	void Scheduler::Push(EventID id, size_t deadline)
+	{
+		Event& event = m_events[id];
+		event.deadline = deadline;
+		event.active = true;
+
+		m_queue.push({ deadline, id });
+		m_nextDeadline = std::min(m_nextDeadline, deadline);
+	}
+
+	void Scheduler::Reschedule(EventID id, size_t deadline)
+	{
+		assert(id < m_events.size());
+
+		Event& event = m_events[id];
+		if (event.active && event.deadline == deadline)
+		{
+			return;
+		}
+
+		Push(id, deadline);
+		UpdateNextDeadline();
+	}
+
+	void Scheduler::Cancel(EventID id)
+	{
+		assert(id < m_events.size());
+		m_events[id].active = false;
+		UpdateNextDeadline();
+	}
+
+	void Scheduler::UpdateNextDeadline()
+	{
+		// Drop stale entries so that the top of the queue is always a live event
+		while (!m_queue.empty())
+		{
+			const QueueEntry& top = m_queue.top();
+			const Event& event = m_events[top.id];
+			if (event.active && event.deadline == top.deadline)
+			{
+				break;
+			}
+			m_queue.pop();
+		}
+
+		m_nextDeadline = m_queue.empty() ? NO_DEADLINE : m_queue.top().deadline;
+	}
+
+	void Scheduler::Run(size_t ticks)
+	{
+		UpdateNextDeadline();
+
+		while (m_nextDeadline <= ticks)
+		{
+			const QueueEntry top = m_queue.top();
+			m_queue.pop();
+
+			Event& event = m_events[top.id];
+			// Keep a copy: handler may add events and reallocate m_events
+			EventFunc func = event.func;
+			if (event.period)
+			{
+				// Re-arm from the deadline, not from 'ticks', to avoid drift
+				Push(top.id, top.deadline + event.period);
+			}
+			else
+			{
+				event.active = false;
+			}
+
+			// Handler can reschedule/cancel any event, including itself
+			func();
+
+			UpdateNextDeadline();
+		}
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <CPU/CPUCommon.h>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace emul
+{
+	// Timestamped event queue keyed on g_ticks.
+	//
+	// Devices that only need attention at known points in time register
+	// a deadline here instead of being ticked on every base clock cycle.
+	// The main loop only has to compare g_ticks with GetNextDeadline()
+	// and call Run() when it's reached.
+	class Scheduler : public Logger
+	{
+	public:
+		using EventFunc = std::function<void()>;
+		using EventID = size_t;
+
+		static constexpr EventID INVALID_EVENT = (EventID)-1;
+		static constexpr size_t NO_DEADLINE = (size_t)-1;
+
+		Scheduler();
+
+		Scheduler(const Scheduler&) = delete;
+		Scheduler& operator=(const Scheduler&) = delete;
+		Scheduler(Scheduler&&) = delete;
+		Scheduler& operator=(Scheduler&&) = delete;
+
+		void Clear();
+
+		// One-shot event, fires once when g_ticks reaches deadline
+		EventID Schedule(size_t deadline, EventFunc func) { return AddEvent(deadline, 0, func); }
+
+		// Periodic event, first fires at g_ticks + period
+		EventID SchedulePeriodic(size_t period, EventFunc func) { assert(period); return AddEvent(g_ticks + period, period, func); }
+
+		// Move the deadline of an existing event (also re-arms a one-shot event that already fired)
+		void Reschedule(EventID id, size_t deadline);
+		void Cancel(EventID id);
+
+		bool IsDue(size_t ticks) const { return ticks >= m_nextDeadline; }
+		size_t GetNextDeadline() const { return m_nextDeadline; }
+
+		// Fires all events with deadline <= ticks, in deadline order
+		void Run(size_t ticks);
+
+	protected:
+		EventID AddEvent(size_t deadline, size_t period, EventFunc func);
+		void Push(EventID id, size_t deadline);
+		void UpdateNextDeadline();
+
+		struct Event
+		{
+			EventFunc func;
+			size_t deadline = NO_DEADLINE;
+			size_t period = 0;
+			bool active = false;
+		};
+		std::vector<Event> m_events;
+
+		// Heap entries are validated against m_events on pop,
+		// stale entries (cancelled/rescheduled events) are simply dropped
+		struct QueueEntry
+		{
+			size_t deadline;
+			EventID id;
+
+			bool operator>(const QueueEntry& other) const
+			{
+				return (deadline == other.deadline) ? (id > other.id) : (deadline > other.deadline);
+			}
+		};
+		std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> m_queue;
+
+		size_t m_nextDeadline = NO_DEADLINE;
+	};
+}
@@ -23,6 +23,11 @@ namespace cfg
 			return false;
 		}
 
+		return LoadConfig(is);
+	}
+
+	bool Config::LoadConfig(std::istream& is)
+	{
 		m_config.clear();
 		m_config.parse(is);
 
@@ -49,6 +54,11 @@ namespace cfg
 			return false;
 		}
 
+		return SaveConfig(os);
+	}
+
+	bool Config::SaveConfig(std::ostream& os)
+	{
 		try
 		{
 			m_config.generate(os);
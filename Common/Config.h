@@ -19,6 +19,9 @@ namespace cfg
 		bool LoadConfigFile(const char* path);
 		bool SaveConfigFile(const char* path);
 
+		bool LoadConfig(std::istream& is);
+		bool SaveConfig(std::ostream& os);
+
 		std::string GetValueStr(const char* section, const char* key, const char* defaultValue = "");
 
 		// Reads an integer in decimal format only.
@@ -247,6 +247,8 @@ namespace via
 
 		TIMER1.Reset();
 		TIMER2.Reset();
+		m_syncTicks = m_ticks;
+		UpdateNextEvent();
 
 		m_portA.Reset();
 		m_portB.Reset();
@@ -257,6 +259,7 @@ namespace via
 	// 4 - T1C-L: T1 Low-Order Counter
 	BYTE Device6522::ReadT1CounterL()
 	{
+		Sync();
 		BYTE value = TIMER1.GetCounterLow();
 
 		// Reading this register resets the Timer1 interrupt flag
@@ -268,6 +271,7 @@ namespace via
 	// 5 - T1C-H: T1 High-Order Counter
 	BYTE Device6522::ReadT1CounterH()
 	{
+		Sync();
 		BYTE value = TIMER1.GetCounterHigh();
 
 		LogPrintf(LOG_DEBUG, "ReadT1CounterH, value=%02X", value);
@@ -280,8 +284,10 @@ namespace via
 		// Writing this register resets the Timer1 interrupt flag
 		m_interrupt.ClearInterrupt(InterruptFlag::TIMER1);
 
+		Sync();
 		TIMER1.SetCounterHighLatch(value);
 		TIMER1.Load();
+		UpdateNextEvent();
 	}
 
 	// 6 - T1L-L: T1 Low-Order Latch
@@ -295,7 +301,9 @@ namespace via
 	void Device6522::WriteT1LatchL(BYTE value)
 	{
 		LogPrintf(LOG_DEBUG, "WriteT1LatchL, value=%02X", value);
+		Sync();
 		TIMER1.SetCounterLowLatch(value);
+		UpdateNextEvent();
 	}
 
 	// 7 - T1L-H: T1 High-Order Latch
@@ -309,12 +317,15 @@ namespace via
 	void Device6522::WriteT1LatchH(BYTE value)
 	{
 		LogPrintf(LOG_DEBUG, "WriteT1LatchH, value=%02X", value);
+		Sync();
 		TIMER1.SetCounterHighLatch(value);
+		UpdateNextEvent();
 	}
 
 	// 8 - T2C-L: T2 Low-Order Counter
 	BYTE Device6522::ReadT2CounterL()
 	{
+		Sync();
 		BYTE value = TIMER2.GetCounterLow();
 
 		// Reading this register resets the Timer2 interrupt flag
@@ -326,12 +337,15 @@ namespace via
 	void Device6522::WriteT2LatchL(BYTE value)
 	{
 		LogPrintf(LOG_DEBUG, "WriteT2LatchL, value=%02X", value);
+		Sync();
 		TIMER2.SetCounterLowLatch(value);
+		UpdateNextEvent();
 	}
 
 	// 9 - T2C-H: T2 High-Order Counter
 	BYTE Device6522::ReadT2CounterH()
 	{
+		Sync();
 		BYTE value = TIMER2.GetCounterHigh();
 		LogPrintf(LOG_DEBUG, "ReadT2CounterH, value=%02X", value);
 		return value;
@@ -343,8 +357,10 @@ namespace via
 		// Writing this register resets the Timer2 interrupt flag
 		m_interrupt.ClearInterrupt(InterruptFlag::TIMER2);
 
+		Sync();
 		TIMER2.SetCounterHighLatch(value);
 		TIMER2.Load();
+		UpdateNextEvent();
 	}
 
 	// A - SR: Shift Register
@@ -370,7 +386,9 @@ namespace via
 		case ShiftRegisterMode::SHIFT_OUT_T2:
 			if (m_interrupt.IsInterruptSet(InterruptFlag::SR))
 			{
+				Sync();
 				TIMER2.Load();
+				UpdateNextEvent();
 			}
 			m_interrupt.ClearInterrupt(InterruptFlag::SR);
 			break;
@@ -559,6 +577,33 @@ namespace via
 		return ret;
 	}
 
+	size_t Device6522::Timer::GetTicksToFire() const
+	{
+		if (!m_latch)
+		{
+			return NO_EVENT;
+		}
+		// Reload tick, then decrements down to 0, then fire
+		return m_load ? ((size_t)m_latch + 2) : ((size_t)m_counter + 1);
+	}
+
+	void Device6522::Timer::Skip(size_t ticks)
+	{
+		if (!ticks)
+		{
+			return;
+		}
+
+		if (m_load)
+		{
+			m_counter = m_latch;
+			m_load = false;
+			--ticks;
+		}
+		// With latch == 0 the counter wraps around and keeps going
+		m_counter -= (WORD)ticks;
+	}
+
 	void Device6522::Timer::Serialize(json& to)
 	{
 		to["latch"] = m_latch;
@@ -600,6 +645,47 @@ namespace via
 			m_interrupt.SetInterrupt(InterruptFlag::CB1);
 		}
 
+		// Timers are only stepped when one of them fires,
+		// in between the counters are reconstructed on access
+		if (++m_ticks >= m_nextEvent)
+		{
+			Sync();
+		}
+	}
+
+	// Equivalent to calling TickTimers() once per tick, but only the
+	// ticks where a timer fires go through it, the rest are skipped in bulk
+	void Device6522::Sync()
+	{
+		while (m_syncTicks < m_ticks)
+		{
+			const size_t ticks = m_ticks - m_syncTicks;
+			const size_t toFire = std::min(TIMER1.GetTicksToFire(), TIMER2.GetTicksToFire());
+			const size_t skip = std::min(ticks, toFire - 1);
+
+			TIMER1.Skip(skip);
+			TIMER2.Skip(skip);
+			m_syncTicks += skip;
+
+			if (m_syncTicks < m_ticks)
+			{
+				TickTimers();
+				++m_syncTicks;
+			}
+		}
+
+		UpdateNextEvent();
+	}
+
+	void Device6522::UpdateNextEvent()
+	{
+		assert(m_syncTicks == m_ticks);
+		const size_t toFire = std::min(TIMER1.GetTicksToFire(), TIMER2.GetTicksToFire());
+		m_nextEvent = (toFire == NO_EVENT) ? NO_EVENT : (m_syncTicks + toFire);
+	}
+
+	void Device6522::TickTimers()
+	{
 		if (TIMER1.Tick())
 		{
 			LogPrintf(LOG_DEBUG, "Timer1 triggered");
@@ -653,6 +739,8 @@ namespace via
 
 	void Device6522::Serialize(json& to)
 	{
+		Sync();
+
 		m_portA.Serialize(to["portA"]);
 		m_portB.Serialize(to["portB"]);
 
@@ -676,6 +764,8 @@ namespace via
 
 		TIMER1.Deserialize(from["timer1"]);
 		TIMER2.Deserialize(from["timer2"]);
+		m_syncTicks = m_ticks;
+		UpdateNextEvent();
 
 		m_interrupt.Deserialize(from["interrupt"]);
 		UpdateIER();
@@ -126,8 +126,15 @@ namespace via
 
 		bool GetIRQ() const { return m_interrupt.IsIRQ(); }
 
+		// Only checks CA1/CB1, the timers are brought up to date
+		// when they fire or when their registers are accessed
 		virtual void Tick();
 
+		// Ticks until the next timer underflow (interrupt or
+		// shift register event), NO_EVENT if no timer can fire
+		size_t GetTicksToNextEvent() const { return (m_nextEvent == NO_EVENT) ? NO_EVENT : (m_nextEvent - m_ticks); }
+		static constexpr size_t NO_EVENT = (size_t)-1;
+
 		virtual void OnReadPort(VIAPort* src) {}
 		virtual void OnWritePort(VIAPort* src) {}
 
@@ -272,6 +279,11 @@ namespace via
 			void Reset();
 			bool Tick(); // Returns true when interrupt should be set. TODO: Ugly
 
+			// Ticks until Tick() returns true, NO_EVENT if never (latch == 0)
+			size_t GetTicksToFire() const;
+			// Equivalent to calling Tick() 'ticks' times, none of them firing
+			void Skip(size_t ticks);
+
 			BYTE GetCounterHigh() const { return emul::GetHByte(m_counter); }
 			BYTE GetCounterLow() const { return emul::GetLByte(m_counter); }
 
@@ -296,6 +308,19 @@ namespace via
 			WORD m_counter = 0;
 		} TIMER1, TIMER2;
 
+		// Ticks TIMER1 and TIMER2 once, handles underflows
+		void TickTimers();
+
+		// Brings the timers up to date with m_ticks
+		void Sync();
+		// Next tick where a timer fires, must be called
+		// after the timers are reloaded or reprogrammed
+		void UpdateNextEvent();
+
+		size_t m_ticks = 0; // Device clock, incremented by Tick()
+		size_t m_syncTicks = 0; // Timers are up to date at this tick
+		size_t m_nextEvent = NO_EVENT;
+
 		void Shift();
 		BYTE m_shiftRegister = 0;
 
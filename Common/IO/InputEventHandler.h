@@ -1,6 +1,10 @@
 #pragma once
 
+#ifdef HSCOMMON_NO_SDL
+union SDL_Event;
+#else
 #include <SDL.h>
+#endif
 
 namespace events
 {
@@ -5,7 +5,6 @@
 #include <IO/DeviceKeyboard.h>
 #include <IO/DeviceJoystick.h>
 #include <IO/DeviceMouse.h>
-#include <SDL.h>
 
 namespace events
 {
@@ -23,15 +22,20 @@ namespace events
 
 	InputEvents::~InputEvents()
 	{
+#ifndef HSCOMMON_NO_SDL
 		if (m_gameController)
 		{
 			SDL_GameControllerClose(m_gameController);
 			m_gameController = nullptr;
 		}
+#endif
 	}
 
 	void InputEvents::Init()
 	{
+#ifdef HSCOMMON_NO_SDL
+		LogPrintf(LOG_INFO, "No host input (built without SDL), replay only");
+#else
 		if (SDL_WasInit(SDL_INIT_EVENTS) == 0)
 		{
 			LogPrintf(LOG_WARNING, "SDL Init Subsystem [Events]");
@@ -40,6 +44,7 @@ namespace events
 				LogPrintf(LOG_ERROR, "Error initializing events subsystem: %s", SDL_GetError());
 			}
 		}
+#endif
 
 		LogPrintf(LOG_INFO, "Clock Frequency: %zi Hz", m_clockSpeedHz);
 		LogPrintf(LOG_INFO, "Poll Interval:   %zi", m_pollInterval);
@@ -67,6 +72,9 @@ namespace events
 			return;
 		}
 
+#ifdef HSCOMMON_NO_SDL
+		LogPrintf(LOG_WARNING, "No Game Controller (built without SDL)");
+#else
 		if (SDL_WasInit(SDL_INIT_GAMECONTROLLER) == 0)
 		{
 			LogPrintf(LOG_WARNING, "SDL Init Subsystem [Game Controller]");
@@ -116,6 +124,7 @@ namespace events
 				m_gameController = nullptr;
 			}
 		}
+#endif
 	}
 
 	void InputEvents::CaptureMouse(bool capture)
@@ -135,7 +144,15 @@ namespace events
 			LogPrintf(LOG_WARNING, "Capture mouse [%s]", m_mouseCaptured ? "ON" : "OFF");
 		}
 
+#ifndef HSCOMMON_NO_SDL
 		SDL_SetRelativeMouseMode(m_mouseCaptured ? SDL_TRUE : SDL_FALSE);
+#endif
+	}
+
+	void InputEvents::RestartRecorder()
+	{
+		m_recorder.Restart();
+		m_cooldown = m_pollInterval;
 	}
 
 	void InputEvents::Tick()
@@ -147,6 +164,18 @@ namespace events
 
 		m_cooldown = m_pollInterval;
 
+		if (m_recorder.IsReplaying())
+		{
+			Replay();
+			return;
+		}
+
+		Poll();
+	}
+
+	void InputEvents::Poll()
+	{
+#ifndef HSCOMMON_NO_SDL
 		SDL_Event e;
 		while (!m_quit && SDL_PollEvent(&e))
 		{
@@ -167,18 +196,18 @@ namespace events
 			switch (e.type)
 			{
 			case SDL_QUIT:
-				m_quit = true;
+				InputQuit();
 				break;
 			case SDL_KEYDOWN:
 			case SDL_KEYUP:
-				InputKey(e.key);
+				InputKey(e.key.keysym.scancode, e.key.state == SDL_PRESSED, e.key.repeat);
 				break;
 			case SDL_CONTROLLERBUTTONDOWN:
 			case SDL_CONTROLLERBUTTONUP:
 				//TODO: Only 2 buttons for now
 				if ((e.cbutton.which == m_controllerID) && (e.cbutton.button <= 1))
 				{
-					InputControllerButton(e.cbutton.button, e.cbutton.state);
+					InputControllerButton(e.cbutton.button, e.cbutton.state == SDL_PRESSED);
 				}
 				break;
 			case SDL_CONTROLLERAXISMOTION:
@@ -190,48 +219,117 @@ namespace events
 				break;
 			case SDL_MOUSEBUTTONDOWN:
 			case SDL_MOUSEBUTTONUP:
-				m_mouse->SetButtonClick(e.button.x, e.button.y, e.button.button, e.type == SDL_MOUSEBUTTONDOWN);
+				InputMouseButton(e.button.x, e.button.y, e.button.button, e.button.state == SDL_PRESSED);
 				break;
 			case SDL_MOUSEMOTION:
-				m_mouse->SetMouseMoveAbs(e.motion.x, e.motion.y);
-				m_mouse->SetMouseMoveRel(e.motion.xrel, e.motion.yrel);
+				InputMouseMotion(e.motion.x, e.motion.y, e.motion.xrel, e.motion.yrel);
+				break;
 			default:
 				break;
 			}
 		}
+#endif
 	}
-	void InputEvents::InputKey(SDL_KeyboardEvent& evt)
+
+	void InputEvents::Replay()
 	{
-		if (evt.repeat)
+		InputRecord record;
+		while (!m_quit && m_recorder.GetNext(record))
 		{
+			switch (record.type)
+			{
+			case InputRecordType::KEY:
+				InputKey((Scancode)record.code, record.value, record.repeat);
+				break;
+			case InputRecordType::CONTROLLER_BUTTON:
+				InputControllerButton((uint8_t)record.code, record.value);
+				break;
+			case InputRecordType::CONTROLLER_AXIS:
+				InputControllerAxis((uint8_t)record.code, (int16_t)record.value);
+				break;
+			case InputRecordType::MOUSE_BUTTON:
+				InputMouseButton(record.x, record.y, (uint8_t)record.code, record.value);
+				break;
+			case InputRecordType::MOUSE_MOTION:
+				InputMouseMotion(record.x, record.y, record.dx, record.dy);
+				break;
+			case InputRecordType::ACTION:
+				if (m_actionHandler)
+				{
+					m_actionHandler(record);
+				}
+				break;
+			case InputRecordType::QUIT:
+				InputQuit();
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	void InputEvents::Action(InputAction action, BYTE unit, int32_t value, const char* data)
+	{
+		// Actions come from the recording during a replay
+		if (m_recorder.IsReplaying())
+		{
+			LogPrintf(LOG_WARNING, "Action [%d] ignored during replay", (int)action);
 			return;
 		}
 
-		LogPrintf(LOG_DEBUG, "InputKey: [%s] key: %d, repeat: %d", evt.state == SDL_PRESSED ? "DOWN" : "UP", evt.keysym.scancode, evt.repeat);
-		KeyMap::iterator it = m_keyMap->find(evt.keysym.scancode);
+		LogPrintf(LOG_INFO, "Action: [%d] unit: %d, value: %d, data: [%s]", (int)action, unit, value, data);
+
+		InputRecord record(InputRecordType::ACTION, (WORD)action, value);
+		record.unit = unit;
+		record.data = data;
+		m_recorder.Record(record);
+
+		if (m_actionHandler)
+		{
+			m_actionHandler(record);
+		}
+	}
+
+	void InputEvents::InputKey(Scancode scancode, bool pressed, bool repeat)
+	{
+		InputRecord record(InputRecordType::KEY, scancode, pressed);
+		record.repeat = repeat;
+		m_recorder.Record(record);
+
+		if (repeat)
+		{
+			return;
+		}
+
+		LogPrintf(LOG_DEBUG, "InputKey: [%s] key: %d, repeat: %d", pressed ? "DOWN" : "UP", scancode, repeat);
+		KeyMap::iterator it = m_keyMap->find(scancode);
 		if (it != m_keyMap->end())
 		{
 			Key& key = it->second;
 
-			m_keyboard->InputKey(key.GetRow(), key.GetCol(), evt.state == SDL_PRESSED);
+			m_keyboard->InputKey(key.GetRow(), key.GetCol(), pressed);
 		}
 		else
 		{
-			LogPrintf(LOG_WARNING, "Unmapped scancode %d", evt.keysym.scancode);
+			LogPrintf(LOG_WARNING, "Unmapped scancode %d", scancode);
 		}
 	}
 
-	void InputEvents::InputControllerButton(uint8_t button, uint8_t state)
+	void InputEvents::InputControllerButton(uint8_t button, bool pressed)
 	{
-		LogPrintf(LOG_DEBUG, "InputControllerButton: button[%d]=[%s]", button, (state == SDL_PRESSED) ? "PRESSED" : "RELEASED");
+		m_recorder.Record(InputRecord(InputRecordType::CONTROLLER_BUTTON, button, pressed));
+
+		LogPrintf(LOG_DEBUG, "InputControllerButton: button[%d]=[%s]", button, pressed ? "PRESSED" : "RELEASED");
 		if (m_joystick)
 		{
 			// TODO: Only 1 joystick for now
-			m_joystick->SetButtonState(0, button, (state == SDL_PRESSED) ? true : false);
+			m_joystick->SetButtonState(0, button, pressed);
 		}
 	}
 	void InputEvents::InputControllerAxis(uint8_t axis, int16_t value)
 	{
+		m_recorder.Record(InputRecord(InputRecordType::CONTROLLER_AXIS, axis, value));
+
 		LogPrintf(LOG_DEBUG, "InputControllerAxis: axis[%d]=[%d]", axis, value);
 		if (m_joystick)
 		{
@@ -240,4 +338,32 @@ namespace events
 		}
 	}
 
+	void InputEvents::InputMouseButton(int32_t x, int32_t y, uint8_t button, bool pressed)
+	{
+		InputRecord record(InputRecordType::MOUSE_BUTTON, button, pressed);
+		record.x = x;
+		record.y = y;
+		m_recorder.Record(record);
+
+		m_mouse->SetButtonClick(x, y, button, pressed);
+	}
+	void InputEvents::InputMouseMotion(int32_t x, int32_t y, int32_t dx, int32_t dy)
+	{
+		InputRecord record(InputRecordType::MOUSE_MOTION);
+		record.x = x;
+		record.y = y;
+		record.dx = dx;
+		record.dy = dy;
+		m_recorder.Record(record);
+
+		m_mouse->SetMouseMoveAbs(x, y);
+		m_mouse->SetMouseMoveRel(dx, dy);
+	}
+
+	void InputEvents::InputQuit()
+	{
+		m_recorder.Record(InputRecord(InputRecordType::QUIT));
+		m_quit = true;
+	}
+
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 
+#ifndef HSCOMMON_NO_SDL
 #include <SDL.h>
+#endif
+#include <functional>
 #include <map>
 #include <vector>
 
 #include <IO/DeviceMouse.h>
+#include <IO/InputRecorder.h>
 
 using emul::BYTE;
 
@@ -32,7 +36,13 @@ namespace events
 		BYTE m_col;
 	};
 
-	typedef std::map<SDL_Scancode, Key> KeyMap;
+#ifdef HSCOMMON_NO_SDL
+	// SDL_Scancode values, without the SDL headers
+	typedef WORD Scancode;
+#else
+	typedef SDL_Scancode Scancode;
+#endif
+	typedef std::map<Scancode, Key> KeyMap;
 
 	class InputEvents : public Logger
 	{
@@ -64,21 +74,47 @@ namespace events
 
 		bool IsQuit() { return m_quit; }
 
+		// Record/replay of all the input events below
+		InputRecorder& GetRecorder() { return m_recorder; }
+		// New time base for record/replay (snapshot restored, etc.),
+		// also restarts the poll interval so polls happen at the same ticks
+		void RestartRecorder();
+
+		// External stimuli that are not SDL events (media changes from the UI, etc.).
+		// They go through the handler so they can be recorded and replayed
+		// Ignored during a replay, where they come from the recording
+		using ActionHandler = std::function<void(const InputRecord& action)>;
+		void SetActionHandler(ActionHandler handler) { m_actionHandler = handler; }
+		void Action(InputAction action, BYTE unit = 0, int32_t value = 0, const char* data = "");
+
 	protected:
 		const size_t m_clockSpeedHz;
 		const size_t m_pollInterval;
 		size_t m_cooldown;
 
-		void InputKey(SDL_KeyboardEvent& evt);
-		void InputControllerButton(uint8_t button, uint8_t state);
+		void InputKey(Scancode scancode, bool pressed, bool repeat);
+		void InputControllerButton(uint8_t button, bool pressed);
 		void InputControllerAxis(uint8_t axis, int16_t value);
+		void InputMouseButton(int32_t x, int32_t y, uint8_t button, bool pressed);
+		void InputMouseMotion(int32_t x, int32_t y, int32_t dx, int32_t dy);
+		void InputQuit();
 		bool m_quit = false;
 
+		// Host events (SDL), not available without SDL
+		void Poll();
+
+		// Feeds the recorded events that are due, without SDL
+		void Replay();
+		InputRecorder m_recorder;
+		ActionHandler m_actionHandler;
+
 		kbd::DeviceKeyboard* m_keyboard = nullptr;
 		KeyMap* m_keyMap = nullptr;
 
+#ifndef HSCOMMON_NO_SDL
 		SDL_GameController* m_gameController = nullptr;
 		SDL_JoystickID m_controllerID = -1;
+#endif
 
 		joy::DeviceJoystick* m_joystick = nullptr;
 
@@ -0,0 +1,340 @@
+#include "stdafx.h"
+
+#include <IO/InputRecorder.h>
+
+using emul::g_ticks;
+
+namespace events
+{
+	InputRecorder::InputRecorder() : Logger("inputrec")
+	{
+	}
+
+	InputRecorder::~InputRecorder()
+	{
+		Stop();
+	}
+
+	bool InputRecorder::StartRecord(const char* path)
+	{
+		Stop();
+
+		if (!m_file.Open(path, "wb"))
+		{
+			LogPrintf(LOG_ERROR, "StartRecord: Error opening output file [%s]", path);
+			return false;
+		}
+
+		LogPrintf(LOG_INFO, "StartRecord: [%s] at tick %zu", path, g_ticks);
+
+		m_path = path;
+		m_mode = Mode::RECORD;
+		m_startTicks = g_ticks;
+		m_lastTicks = 0;
+		m_count = 0;
+
+		m_buffer.assign(MAGIC, MAGIC + sizeof(MAGIC));
+		WriteByte(VERSION);
+		Flush();
+		return true;
+	}
+
+	bool InputRecorder::StartReplay(const char* path)
+	{
+		Stop();
+
+		hscommon::fileUtil::File file;
+		if (!file.Open(path, "rb"))
+		{
+			LogPrintf(LOG_ERROR, "StartReplay: Error opening input file [%s]", path);
+			return false;
+		}
+
+		std::error_code ec;
+		const size_t size = (size_t)std::filesystem::file_size(path, ec);
+		m_data.resize(ec ? 0 : size);
+		if (m_data.empty() || (fread(m_data.data(), size, 1, file) != 1))
+		{
+			LogPrintf(LOG_ERROR, "StartReplay: Error reading input file [%s]", path);
+			m_data.clear();
+			return false;
+		}
+
+		if ((size <= sizeof(MAGIC)) || memcmp(m_data.data(), MAGIC, sizeof(MAGIC)) || (m_data[sizeof(MAGIC)] != VERSION))
+		{
+			LogPrintf(LOG_ERROR, "StartReplay: Invalid input file or version [%s]", path);
+			m_data.clear();
+			return false;
+		}
+
+		LogPrintf(LOG_INFO, "StartReplay: [%s] at tick %zu", path, g_ticks);
+
+		m_path = path;
+		m_mode = Mode::REPLAY;
+		m_startTicks = g_ticks;
+		m_lastTicks = 0;
+		m_count = 0;
+
+		m_pos = sizeof(MAGIC) + 1;
+		m_hasNext = ReadRecord(m_next);
+		return true;
+	}
+
+	void InputRecorder::Restart()
+	{
+		const std::string path = m_path;
+
+		switch (m_mode)
+		{
+		case Mode::RECORD:
+			StartRecord(path.c_str());
+			break;
+		case Mode::REPLAY:
+			StartReplay(path.c_str());
+			break;
+		default:
+			break;
+		}
+	}
+
+	void InputRecorder::Stop()
+	{
+		switch (m_mode)
+		{
+		case Mode::RECORD:
+			LogPrintf(LOG_INFO, "Stop: Recorded %zu events", m_count);
+			m_file.Close();
+			break;
+		case Mode::REPLAY:
+			LogPrintf(LOG_INFO, "Stop: Replayed %zu events", m_count);
+			m_data.clear();
+			m_hasNext = false;
+			break;
+		default:
+			break;
+		}
+
+		m_mode = Mode::NONE;
+	}
+
+	void InputRecorder::Record(const InputRecord& record)
+	{
+		if (!IsRecording())
+		{
+			return;
+		}
+
+		const size_t ticks = g_ticks - m_startTicks;
+		WriteVarUInt(ticks - m_lastTicks);
+		m_lastTicks = ticks;
+
+		WriteByte((BYTE)record.type);
+
+		switch (record.type)
+		{
+		case InputRecordType::KEY:
+			WriteVarUInt(record.code);
+			WriteByte((record.value ? 1 : 0) | (record.repeat ? 2 : 0));
+			break;
+		case InputRecordType::CONTROLLER_BUTTON:
+			WriteByte((BYTE)record.code);
+			WriteByte(record.value ? 1 : 0);
+			break;
+		case InputRecordType::CONTROLLER_AXIS:
+			WriteByte((BYTE)record.code);
+			WriteVarInt(record.value);
+			break;
+		case InputRecordType::MOUSE_BUTTON:
+			WriteByte((BYTE)record.code);
+			WriteByte(record.value ? 1 : 0);
+			WriteVarInt(record.x);
+			WriteVarInt(record.y);
+			break;
+		case InputRecordType::MOUSE_MOTION:
+			WriteVarInt(record.x);
+			WriteVarInt(record.y);
+			WriteVarInt(record.dx);
+			WriteVarInt(record.dy);
+			break;
+		case InputRecordType::ACTION:
+			WriteByte((BYTE)record.code);
+			WriteByte(record.unit);
+			WriteVarInt(record.value);
+			WriteVarUInt(record.data.size());
+			m_buffer.insert(m_buffer.end(), record.data.begin(), record.data.end());
+			break;
+		case InputRecordType::QUIT:
+			break;
+		default:
+			throw std::runtime_error("InputRecorder: Invalid record type");
+		}
+
+		LogPrintf(LOG_DEBUG, "Record: [%zu] type=%d, code=%d, value=%d", ticks, (int)record.type, record.code, record.value);
+
+		++m_count;
+
+		// Events are rare, write them immediately so a
+		// recording is complete even if the emulator crashes
+		Flush();
+	}
+
+	bool InputRecorder::GetNext(InputRecord& record)
+	{
+		if (!IsReplaying())
+		{
+			return false;
+		}
+
+		if (!m_hasNext)
+		{
+			Stop();
+			return false;
+		}
+
+		if (m_next.ticks > (g_ticks - m_startTicks))
+		{
+			return false;
+		}
+
+		record = m_next;
+		++m_count;
+
+		m_hasNext = ReadRecord(m_next);
+		return true;
+	}
+
+	void InputRecorder::WriteVarUInt(uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			WriteByte((BYTE)value | 0x80);
+			value >>= 7;
+		}
+		WriteByte((BYTE)value);
+	}
+
+	void InputRecorder::Flush()
+	{
+		if (m_buffer.size())
+		{
+			fwrite(m_buffer.data(), m_buffer.size(), 1, m_file);
+			fflush(m_file);
+			m_buffer.clear();
+		}
+	}
+
+	bool InputRecorder::ReadByte(BYTE& value)
+	{
+		if (m_pos >= m_data.size())
+		{
+			return false;
+		}
+		value = m_data[m_pos++];
+		return true;
+	}
+
+	bool InputRecorder::ReadVarUInt(uint64_t& value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			BYTE b;
+			if (!ReadByte(b))
+			{
+				return false;
+			}
+			value |= (uint64_t)(b & 0x7F) << shift;
+			if (!(b & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool InputRecorder::ReadVarInt(int64_t& value)
+	{
+		uint64_t raw;
+		if (!ReadVarUInt(raw))
+		{
+			return false;
+		}
+		value = (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+		return true;
+	}
+
+	// Returns false at the end of the stream or if the data is invalid
+	bool InputRecorder::ReadRecord(InputRecord& record)
+	{
+		if (m_pos == m_data.size())
+		{
+			return false;
+		}
+
+		record = InputRecord();
+
+		uint64_t delta;
+		BYTE type;
+		uint64_t code = 0;
+		BYTE flags = 0;
+		int64_t value = 0, x = 0, y = 0, dx = 0, dy = 0;
+		uint64_t size = 0;
+
+		bool ok = ReadVarUInt(delta) && ReadByte(type) && (type < (BYTE)InputRecordType::_COUNT);
+		if (ok)
+		{
+			record.type = (InputRecordType)type;
+
+			switch (record.type)
+			{
+			case InputRecordType::KEY:
+				ok = ReadVarUInt(code) && ReadByte(flags);
+				break;
+			case InputRecordType::CONTROLLER_BUTTON:
+				ok = ReadByte(type) && ReadByte(flags);
+				code = type;
+				break;
+			case InputRecordType::CONTROLLER_AXIS:
+				ok = ReadByte(type) && ReadVarInt(value);
+				code = type;
+				break;
+			case InputRecordType::MOUSE_BUTTON:
+				ok = ReadByte(type) && ReadByte(flags) && ReadVarInt(x) && ReadVarInt(y);
+				code = type;
+				break;
+			case InputRecordType::MOUSE_MOTION:
+				ok = ReadVarInt(x) && ReadVarInt(y) && ReadVarInt(dx) && ReadVarInt(dy);
+				break;
+			case InputRecordType::ACTION:
+				ok = ReadByte(type) && ReadByte(record.unit) && ReadVarInt(value) && ReadVarUInt(size) &&
+					(size <= m_data.size() - m_pos);
+				code = type;
+				if (ok)
+				{
+					record.data.assign((const char*)&m_data[m_pos], (size_t)size);
+					m_pos += (size_t)size;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		if (!ok)
+		{
+			LogPrintf(LOG_ERROR, "ReadRecord: Invalid data at offset %zu", m_pos);
+			return false;
+		}
+
+		m_lastTicks += (size_t)delta;
+		record.ticks = m_lastTicks;
+		record.code = (WORD)code;
+		record.value = (flags & 1) ? 1 : (int32_t)value;
+		record.repeat = (flags & 2);
+		record.x = (int32_t)x;
+		record.y = (int32_t)y;
+		record.dx = (int32_t)dx;
+		record.dy = (int32_t)dy;
+		return true;
+	}
+}
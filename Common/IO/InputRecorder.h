@@ -0,0 +1,135 @@
+#pragma once
+
+#include <CPU/CPUCommon.h>
+#include <string>
+#include <vector>
+
+using emul::BYTE;
+using emul::WORD;
+
+namespace events
+{
+	enum class InputRecordType : BYTE
+	{
+		KEY,               // code: SDL scancode, value: pressed, repeat
+		CONTROLLER_BUTTON, // code: button, value: pressed
+		CONTROLLER_AXIS,   // code: axis, value: raw axis value
+		MOUSE_BUTTON,      // code: SDL button, value: pressed, x/y: position
+		MOUSE_MOTION,      // x/y: position, dx/dy: relative motion
+		ACTION,            // code: InputAction, unit, value, data
+		QUIT,
+
+		_COUNT
+	};
+
+	// External stimuli that are not SDL input events
+	//
+	// Media loads store the host path of the image, not its content:
+	// replaying on another host needs the same files at the same paths
+	enum class InputAction : BYTE
+	{
+		TAPE_STATE,   // unit: drive, value: tape::TapeState
+		TAPE_LOAD,    // unit: drive, data: tape image path
+		FLOPPY_LOAD,  // unit: drive, data: disk image path
+		FLOPPY_EJECT, // unit: drive
+		CART_LOAD,    // data: cartridge image path
+		CART_UNLOAD,
+	};
+
+	struct InputRecord
+	{
+		InputRecord(InputRecordType type = InputRecordType::QUIT, WORD code = 0, int32_t value = 0) :
+			type(type), code(code), value(value)
+		{
+		}
+
+		// Relative to the start of the recording
+		size_t ticks = 0;
+
+		InputRecordType type;
+		WORD code;
+		int32_t value;
+		bool repeat = false;
+		BYTE unit = 0;
+		int32_t x = 0;
+		int32_t y = 0;
+		int32_t dx = 0;
+		int32_t dy = 0;
+		std::string data;
+	};
+
+	// Deterministic record/replay of input events
+	//
+	// Every externally sourced event is stored with its timestamp
+	// (g_ticks, relative to Start*()) in a compact binary stream:
+	//
+	//   "HKIR", version (BYTE)
+	//   Records: delta ticks (varint), type (BYTE), type specific payload
+	//
+	// Integers are LEB128 varints, signed values are zigzag encoded.
+	//
+	// Events are recorded and replayed at the same point (input poll), so
+	// starting from the same state (power on or snapshot), a replay feeds
+	// the exact same events to the devices at the exact same tick.
+	class InputRecorder : public Logger
+	{
+	public:
+		InputRecorder();
+		~InputRecorder();
+
+		InputRecorder(const InputRecorder&) = delete;
+		InputRecorder& operator=(const InputRecorder&) = delete;
+		InputRecorder(InputRecorder&&) = delete;
+		InputRecorder& operator=(InputRecorder&&) = delete;
+
+		bool StartRecord(const char* path);
+		bool StartReplay(const char* path);
+
+		// Restarts the recording (truncated) or the replay (from the beginning)
+		// with a new time base, e.g. after a snapshot is restored
+		void Restart();
+
+		void Stop();
+
+		bool IsRecording() const { return m_mode == Mode::RECORD; }
+		bool IsReplaying() const { return m_mode == Mode::REPLAY; }
+
+		void Record(const InputRecord& record);
+
+		// Next record due at the current tick, false if none.
+		// Replay stops at the end of the stream
+		bool GetNext(InputRecord& record);
+
+	protected:
+		static constexpr char MAGIC[4] = { 'H', 'K', 'I', 'R' };
+		static constexpr BYTE VERSION = 1;
+
+		enum class Mode { NONE, RECORD, REPLAY };
+		Mode m_mode = Mode::NONE;
+
+		std::string m_path;
+		size_t m_startTicks = 0;
+		size_t m_lastTicks = 0;
+		size_t m_count = 0;
+
+		// Record
+		void WriteVarUInt(uint64_t value);
+		void WriteVarInt(int64_t value) { WriteVarUInt(((uint64_t)value << 1) ^ (uint64_t)(value >> 63)); }
+		void WriteByte(BYTE value) { m_buffer.push_back(value); }
+		void Flush();
+
+		hscommon::fileUtil::File m_file;
+		std::vector<BYTE> m_buffer;
+
+		// Replay
+		bool ReadVarUInt(uint64_t& value);
+		bool ReadVarInt(int64_t& value);
+		bool ReadByte(BYTE& value);
+		bool ReadRecord(InputRecord& record);
+
+		std::vector<BYTE> m_data;
+		size_t m_pos = 0;
+		InputRecord m_next;
+		bool m_hasNext = false;
+	};
+}
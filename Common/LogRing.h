@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Lock-free single producer / single consumer ring of variable size records
+//
+// Producer: thread that logs (Logger::_LogPrintf in async mode)
+// Consumer: async log writer thread
+//
+// Each record is stored as a 32 bit size followed by the data, and
+// can wrap around the end of the buffer. Read and write positions are
+// free running counters, only masked when accessing the data.
+class LogRing
+{
+public:
+	LogRing() = default;
+
+	LogRing(const LogRing&) = delete;
+	LogRing& operator=(const LogRing&) = delete;
+	LogRing(LogRing&&) = delete;
+	LogRing& operator=(LogRing&&) = delete;
+
+	// Not thread safe, size must be a power of two
+	void Init(size_t size)
+	{
+		assert(size && ((size & (size - 1)) == 0));
+		m_data.assign(size, 0);
+		m_mask = size - 1;
+		m_read.store(0, std::memory_order_relaxed);
+		m_write.store(0, std::memory_order_relaxed);
+	}
+
+	// Producer side. Returns false if there is not enough room (record is dropped)
+	bool Push(const uint8_t* data, uint32_t size)
+	{
+		const size_t write = m_write.load(std::memory_order_relaxed);
+		const size_t used = write - m_read.load(std::memory_order_acquire);
+		if (used + sizeof(size) + size > m_mask + 1)
+		{
+			return false;
+		}
+
+		Copy(write, (const uint8_t*)&size, sizeof(size));
+		Copy(write + sizeof(size), data, size);
+
+		m_write.store(write + sizeof(size) + size, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer side. Copies the next record to dest, false if the ring is empty
+	bool Pop(std::vector<uint8_t>& dest)
+	{
+		const size_t read = m_read.load(std::memory_order_relaxed);
+		if (read == m_write.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		uint32_t size;
+		Fetch(read, (uint8_t*)&size, sizeof(size));
+		dest.resize(size);
+		Fetch(read + sizeof(size), dest.data(), size);
+
+		m_read.store(read + sizeof(size) + size, std::memory_order_release);
+		return true;
+	}
+
+protected:
+	void Copy(size_t pos, const uint8_t* src, size_t size)
+	{
+		const size_t offset = pos & m_mask;
+		const size_t first = std::min(size, m_data.size() - offset);
+		memcpy(&m_data[offset], src, first);
+		memcpy(&m_data[0], src + first, size - first);
+	}
+
+	void Fetch(size_t pos, uint8_t* dest, size_t size) const
+	{
+		const size_t offset = pos & m_mask;
+		const size_t first = std::min(size, m_data.size() - offset);
+		memcpy(dest, &m_data[offset], first);
+		memcpy(dest + first, &m_data[0], size - first);
+	}
+
+	std::vector<uint8_t> m_data;
+	size_t m_mask = 0;
+
+	// Separate cache lines, written by different threads
+	alignas(64) std::atomic<size_t> m_write{ 0 };
+	alignas(64) std::atomic<size_t> m_read{ 0 };
+};
@@ -1,17 +1,72 @@
 #include "stdafx.h"
 #include "Logger.h"
+#include "LogRing.h"
+
+#include <cctype>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 void(*Logger::m_logCallbackFunc)(const char *str);
 bool Logger::m_enableColors = true;
-char Logger::m_logBuffer[1024];
+thread_local char Logger::m_logBuffer[1024];
 Logger::ModuleList Logger::m_moduleList;
 
+namespace
+{
+	// Module names by index, for async records.
+	// Names are never removed so indices stay valid
+	class ModuleNames
+	{
+	public:
+		uint16_t GetIndex(const std::string& name)
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			auto it = m_indices.find(name);
+			if (it != m_indices.end())
+			{
+				return it->second;
+			}
+
+			const uint16_t index = (uint16_t)std::min(m_names.size(), (size_t)UINT16_MAX);
+			if (index < UINT16_MAX)
+			{
+				m_names.push_back(name);
+			}
+			m_indices[name] = index;
+			return index;
+		}
+
+		std::string GetName(uint16_t index)
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			return (index < m_names.size()) ? m_names[index] : "?";
+		}
+
+	protected:
+		std::mutex m_lock;
+		std::map<std::string, uint16_t> m_indices;
+		std::deque<std::string> m_names;
+	};
+
+	ModuleNames& GetModuleNames()
+	{
+		static ModuleNames names;
+		return names;
+	}
+
+	size_t(*s_timestampFunc)() = nullptr;
+}
+
 
 Logger::Logger(const char* moduleID) :
 	m_moduleID(moduleID),
 	m_minSeverity(SEVERITY::LOG_DEBUG)
 {
 	RegisterModuleID(moduleID);
+	m_moduleIndex = GetModuleNames().GetIndex(m_moduleID);
 }
 
 Logger::~Logger()
@@ -22,7 +77,7 @@ void Logger::RegisterModuleID(const char* moduleID)
 {
 	if (moduleID == nullptr)
 	{
-		throw std::exception("Logger: ModuleID is null");
+		throw std::runtime_error("Logger: ModuleID is null");
 	}
 
 	m_moduleList.insert(std::pair<std::string, Logger*>(moduleID, this));
@@ -85,6 +140,581 @@ static void AddChar(char*& dest, char ch)
 	*(dest++) = ch;
 }
 
+static void AddPrefix(char*& dest, const std::string& moduleID, Logger::SEVERITY sev, bool colors)
+{
+	AddChar(dest, '[');
+	AddStr(dest, moduleID, colors ? HBLK : nullptr);
+	AddChar(dest, ']');
+	AddChar(dest, '[');
+	AddStr(dest, LOG_LEVEL_STRINGS[int(sev)], colors ? LOG_LEVEL_COLORS[int(sev)] : nullptr);
+	AddChar(dest, ']');
+}
+
+namespace
+{
+	// printf conversion spec, only what's needed to know the argument types
+	struct FormatSpec
+	{
+		enum class LENGTH { NONE, HH, H, L, LL, Z, J, T, LD };
+		enum class ARG { NONE, SIGNED, UNSIGNED, DOUBLE, STRING, POINTER, COUNT, INVALID };
+
+		const char* begin = nullptr; // '%'
+		const char* lengthPos = nullptr; // length modifier or conversion
+		const char* end = nullptr; // after conversion
+		int stars = 0; // '*' width/precision, int arguments before the value
+		LENGTH length = LENGTH::NONE;
+		ARG arg = ARG::INVALID;
+	};
+
+	// format points to '%', false if the spec is incomplete
+	bool ParseSpec(const char* format, FormatSpec& spec)
+	{
+		using LENGTH = FormatSpec::LENGTH;
+		using ARG = FormatSpec::ARG;
+
+		spec = FormatSpec();
+		spec.begin = format++;
+
+		while (*format && strchr("-+ #0", *format))
+		{
+			++format;
+		}
+
+		// Width, precision
+		for (int i = 0; i < 2; ++i)
+		{
+			if ((i == 1) && (*format != '.'))
+			{
+				break;
+			}
+			else if (i == 1)
+			{
+				++format;
+			}
+
+			if (*format == '*')
+			{
+				++spec.stars;
+				++format;
+			}
+			else while (isdigit((unsigned char)*format))
+			{
+				++format;
+			}
+		}
+
+		spec.lengthPos = format;
+		switch (*format)
+		{
+		case 'h':
+			spec.length = (format[1] == 'h') ? LENGTH::HH : LENGTH::H;
+			format += (spec.length == LENGTH::HH) ? 2 : 1;
+			break;
+		case 'l':
+			spec.length = (format[1] == 'l') ? LENGTH::LL : LENGTH::L;
+			format += (spec.length == LENGTH::LL) ? 2 : 1;
+			break;
+		case 'z': spec.length = LENGTH::Z; ++format; break;
+		case 'j': spec.length = LENGTH::J; ++format; break;
+		case 't': spec.length = LENGTH::T; ++format; break;
+		case 'L': spec.length = LENGTH::LD; ++format; break;
+		case 'I': // MSVC
+			if (!strncmp(format, "I64", 3))
+			{
+				spec.length = LENGTH::LL;
+				format += 3;
+			}
+			else if (!strncmp(format, "I32", 3))
+			{
+				format += 3;
+			}
+			else
+			{
+				spec.length = LENGTH::Z;
+				++format;
+			}
+			break;
+		default:
+			break;
+		}
+
+		if (!*format)
+		{
+			return false;
+		}
+
+		const bool wide = (spec.length == LENGTH::L);
+		switch (*format)
+		{
+		case '%': spec.arg = ARG::NONE; break;
+		case 'd': case 'i': spec.arg = ARG::SIGNED; break;
+		case 'c': spec.arg = wide ? ARG::INVALID : ARG::SIGNED; break;
+		case 'u': case 'o': case 'x': case 'X': spec.arg = ARG::UNSIGNED; break;
+		case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A': spec.arg = ARG::DOUBLE; break;
+		case 's': spec.arg = wide ? ARG::INVALID : ARG::STRING; break;
+		case 'p': spec.arg = ARG::POINTER; break;
+		case 'n': spec.arg = ARG::COUNT; break;
+		default: spec.arg = ARG::INVALID; break;
+		}
+		spec.end = format + 1;
+		return true;
+	}
+
+	int64_t ReadSigned(va_list& args, FormatSpec::LENGTH length)
+	{
+		using LENGTH = FormatSpec::LENGTH;
+		switch (length)
+		{
+		case LENGTH::HH: return (signed char)va_arg(args, int);
+		case LENGTH::H: return (short)va_arg(args, int);
+		case LENGTH::L: return va_arg(args, long);
+		case LENGTH::LL: return va_arg(args, long long);
+		case LENGTH::Z: return (ptrdiff_t)va_arg(args, size_t);
+		case LENGTH::J: return va_arg(args, intmax_t);
+		case LENGTH::T: return va_arg(args, ptrdiff_t);
+		default: return va_arg(args, int);
+		}
+	}
+
+	uint64_t ReadUnsigned(va_list& args, FormatSpec::LENGTH length)
+	{
+		using LENGTH = FormatSpec::LENGTH;
+		switch (length)
+		{
+		case LENGTH::HH: return (unsigned char)va_arg(args, unsigned int);
+		case LENGTH::H: return (unsigned short)va_arg(args, unsigned int);
+		case LENGTH::L: return va_arg(args, unsigned long);
+		case LENGTH::LL: return va_arg(args, unsigned long long);
+		case LENGTH::Z: return va_arg(args, size_t);
+		case LENGTH::J: return va_arg(args, uintmax_t);
+		case LENGTH::T: return (size_t)va_arg(args, ptrdiff_t);
+		default: return va_arg(args, unsigned int);
+		}
+	}
+
+	// Async record, followed by the arguments in the order they are
+	// consumed: 8 byte values, strings as a 16 bit length + characters.
+	// format == nullptr: message is already formatted, single string argument
+	struct LogRecord
+	{
+		const char* format;
+		size_t timestamp;
+		uint16_t module;
+		uint8_t severity;
+	};
+
+	constexpr size_t MAX_STRING_ARG = 1024;
+
+	template<typename T>
+	void Put(std::vector<uint8_t>& dest, T value)
+	{
+		const uint8_t* src = (const uint8_t*)&value;
+		dest.insert(dest.end(), src, src + sizeof(T));
+	}
+
+	void PutString(std::vector<uint8_t>& dest, const char* str)
+	{
+		if (!str)
+		{
+			str = "(null)";
+		}
+		const uint16_t len = (uint16_t)strnlen(str, MAX_STRING_ARG);
+		Put(dest, len);
+		dest.insert(dest.end(), str, str + len);
+	}
+
+	// Stores the raw arguments, false if the format can't be handled
+	// (or has no arguments, the format string is then stored as is)
+	bool EncodeArgs(const char* format, va_list& args, std::vector<uint8_t>& dest)
+	{
+		using ARG = FormatSpec::ARG;
+
+		bool hasArgs = false;
+		for (const char* pos = strchr(format, '%'); pos; pos = strchr(pos, '%'))
+		{
+			FormatSpec spec;
+			if (!ParseSpec(pos, spec) || (spec.arg == ARG::INVALID))
+			{
+				return false;
+			}
+			pos = spec.end;
+
+			for (int i = 0; i < spec.stars; ++i)
+			{
+				Put<int64_t>(dest, va_arg(args, int));
+				hasArgs = true;
+			}
+
+			switch (spec.arg)
+			{
+			case ARG::NONE: break;
+			case ARG::SIGNED: Put(dest, ReadSigned(args, spec.length)); break;
+			case ARG::UNSIGNED: Put(dest, ReadUnsigned(args, spec.length)); break;
+			case ARG::DOUBLE: Put(dest, (spec.length == FormatSpec::LENGTH::LD) ? (double)va_arg(args, long double) : va_arg(args, double)); break;
+			case ARG::STRING: PutString(dest, va_arg(args, const char*)); break;
+			case ARG::POINTER: Put<uint64_t>(dest, (uintptr_t)va_arg(args, void*)); break;
+			case ARG::COUNT: va_arg(args, void*); break;
+			default: return false;
+			}
+			hasArgs |= (spec.arg != ARG::NONE);
+		}
+		return hasArgs;
+	}
+
+	template<typename T>
+	T Get(const uint8_t*& src, const uint8_t* end)
+	{
+		T value = T();
+		if (src + sizeof(T) <= end)
+		{
+			memcpy(&value, src, sizeof(T));
+			src += sizeof(T);
+		}
+		return value;
+	}
+
+	std::string GetString(const uint8_t*& src, const uint8_t* end)
+	{
+		const uint16_t len = std::min(Get<uint16_t>(src, end), (uint16_t)(end - src));
+		std::string str((const char*)src, len);
+		src += len;
+		return str;
+	}
+
+	template<typename T>
+	void AppendFormat(std::string& dest, const char* spec, T value)
+	{
+		char buf[256];
+		const int len = snprintf(buf, sizeof(buf), spec, value);
+		if (len < 0)
+		{
+			return;
+		}
+		else if (len < (int)sizeof(buf))
+		{
+			dest.append(buf, len);
+		}
+		else
+		{
+			const size_t pos = dest.size();
+			dest.resize(pos + len + 1);
+			snprintf(&dest[pos], len + 1, spec, value);
+			dest.resize(pos + len);
+		}
+	}
+
+	// Formats the message of a record, same output as vsprintf
+	// with the original arguments
+	void FormatRecord(const LogRecord& record, const uint8_t* args, const uint8_t* end, std::string& dest)
+	{
+		using ARG = FormatSpec::ARG;
+
+		if (!record.format)
+		{
+			dest += GetString(args, end);
+			return;
+		}
+
+		const char* pos = record.format;
+		for (const char* next = strchr(pos, '%'); next; next = strchr(pos, '%'))
+		{
+			dest.append(pos, next);
+
+			FormatSpec spec;
+			if (!ParseSpec(next, spec))
+			{
+				pos = next;
+				break;
+			}
+			pos = spec.end;
+
+			// Spec with '*' replaced by the values and normalized length:
+			// integers are stored as 64 bit, floating point as double
+			char specStr[64];
+			char* out = specStr;
+			for (const char* in = spec.begin; in < spec.lengthPos; ++in)
+			{
+				if (*in == '*')
+				{
+					out += sprintf(out, "%d", (int)Get<int64_t>(args, end));
+				}
+				else
+				{
+					*out++ = *in;
+				}
+			}
+			const char conversion = spec.end[-1];
+			if (((spec.arg == ARG::SIGNED) || (spec.arg == ARG::UNSIGNED)) && (conversion != 'c'))
+			{
+				*out++ = 'l';
+				*out++ = 'l';
+			}
+			*out++ = conversion;
+			*out = '\0';
+
+			switch (spec.arg)
+			{
+			case ARG::NONE: dest += '%'; break;
+			case ARG::SIGNED:
+				if (conversion == 'c')
+				{
+					AppendFormat(dest, specStr, (int)Get<int64_t>(args, end));
+				}
+				else
+				{
+					AppendFormat(dest, specStr, (long long)Get<int64_t>(args, end));
+				}
+				break;
+			case ARG::UNSIGNED: AppendFormat(dest, specStr, (unsigned long long)Get<uint64_t>(args, end)); break;
+			case ARG::DOUBLE: AppendFormat(dest, specStr, Get<double>(args, end)); break;
+			case ARG::STRING: AppendFormat(dest, specStr, GetString(args, end).c_str()); break;
+			case ARG::POINTER: AppendFormat(dest, specStr, (void*)(uintptr_t)Get<uint64_t>(args, end)); break;
+			default: break;
+			}
+		}
+		dest += pos;
+	}
+
+	// Background writer for async mode.
+	//
+	// Each logging thread gets its own ring (created on its first log
+	// call), the writer thread polls all rings and outputs the records.
+	class AsyncWriter
+	{
+	public:
+		using OutputFunc = void(*)(uint16_t module, Logger::SEVERITY sev, size_t timestamp, const char* message);
+
+		AsyncWriter(size_t ringSize, OutputFunc output) :
+			m_ringSize(ringSize),
+			m_output(output),
+			m_generation(++s_generation),
+			m_loggerModule(GetModuleNames().GetIndex("logger"))
+		{
+			m_thread = std::thread(&AsyncWriter::Run, this);
+		}
+
+		~AsyncWriter()
+		{
+			m_stop = true;
+			m_thread.join();
+		}
+
+		AsyncWriter(const AsyncWriter&) = delete;
+		AsyncWriter& operator=(const AsyncWriter&) = delete;
+		AsyncWriter(AsyncWriter&&) = delete;
+		AsyncWriter& operator=(AsyncWriter&&) = delete;
+
+		void Log(uint16_t module, Logger::SEVERITY sev, const char* format, va_list args)
+		{
+			static thread_local std::vector<uint8_t> record;
+			record.clear();
+
+			LogRecord header;
+			header.format = format;
+			header.timestamp = s_timestampFunc ? s_timestampFunc() : 0;
+			header.module = module;
+			header.severity = (uint8_t)sev;
+			Put(record, header);
+
+			va_list argsCopy;
+			va_copy(argsCopy, args);
+			if (!EncodeArgs(format, argsCopy, record))
+			{
+				// Unknown conversion, or no arguments (format may not be a literal):
+				// keep the formatted message
+				char buf[1024];
+				vsnprintf(buf, sizeof(buf), format, args);
+
+				record.resize(sizeof(LogRecord));
+				((LogRecord*)record.data())->format = nullptr;
+				PutString(record, buf);
+			}
+			va_end(argsCopy);
+
+			ThreadRing& ring = GetThreadRing();
+			if (!ring.ring.Push(record.data(), (uint32_t)record.size()))
+			{
+				ring.dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		size_t GetDroppedCount()
+		{
+			std::lock_guard<std::mutex> lock(m_ringsLock);
+			size_t dropped = 0;
+			for (auto& ring : m_rings)
+			{
+				dropped += ring->dropped.load(std::memory_order_relaxed);
+			}
+			return dropped;
+		}
+
+	protected:
+		struct ThreadRing
+		{
+			LogRing ring;
+			std::atomic<size_t> dropped{ 0 };
+			size_t reportedDropped = 0; // Writer thread only
+		};
+
+		ThreadRing& GetThreadRing()
+		{
+			static thread_local uint32_t generation = 0;
+			static thread_local ThreadRing* ring = nullptr;
+
+			if (generation != m_generation)
+			{
+				auto newRing = std::make_unique<ThreadRing>();
+				newRing->ring.Init(m_ringSize);
+				ring = newRing.get();
+				generation = m_generation;
+
+				std::lock_guard<std::mutex> lock(m_ringsLock);
+				m_rings.push_back(std::move(newRing));
+			}
+			return *ring;
+		}
+
+		void Run()
+		{
+			while (true)
+			{
+				const bool stop = m_stop;
+				const bool idle = !Drain();
+				if (stop && idle)
+				{
+					break;
+				}
+				else if (idle)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+		}
+
+		// Returns true if anything was output
+		bool Drain()
+		{
+			std::vector<ThreadRing*> rings;
+			{
+				std::lock_guard<std::mutex> lock(m_ringsLock);
+				for (auto& ring : m_rings)
+				{
+					rings.push_back(ring.get());
+				}
+			}
+
+			bool output = false;
+			for (ThreadRing* ring : rings)
+			{
+				while (ring->ring.Pop(m_record))
+				{
+					if (m_record.size() < sizeof(LogRecord))
+					{
+						continue;
+					}
+
+					LogRecord header;
+					memcpy(&header, m_record.data(), sizeof(LogRecord));
+
+					m_message.clear();
+					FormatRecord(header, m_record.data() + sizeof(LogRecord), m_record.data() + m_record.size(), m_message);
+					m_output(header.module, (Logger::SEVERITY)header.severity, header.timestamp, m_message.c_str());
+					m_lastTimestamp = header.timestamp;
+					output = true;
+				}
+
+				const size_t dropped = ring->dropped.load(std::memory_order_relaxed);
+				if (dropped != ring->reportedDropped)
+				{
+					char buf[64];
+					sprintf(buf, "%zu log records dropped, ring full", dropped - ring->reportedDropped);
+					m_output(m_loggerModule, Logger::LOG_WARNING, m_lastTimestamp, buf);
+					ring->reportedDropped = dropped;
+					output = true;
+				}
+			}
+			return output;
+		}
+
+		const size_t m_ringSize;
+		const OutputFunc m_output;
+		const uint32_t m_generation;
+		const uint16_t m_loggerModule;
+
+		std::mutex m_ringsLock;
+		std::vector<std::unique_ptr<ThreadRing>> m_rings;
+
+		std::atomic<bool> m_stop{ false };
+		std::thread m_thread;
+
+		// Writer thread only
+		std::vector<uint8_t> m_record;
+		std::string m_message;
+		size_t m_lastTimestamp = 0;
+
+		static std::atomic<uint32_t> s_generation;
+	};
+	std::atomic<uint32_t> AsyncWriter::s_generation{ 0 };
+
+	AsyncWriter* s_asyncWriter = nullptr;
+}
+
+void Logger::EnableAsync(bool enable, size_t ringSize)
+{
+	delete s_asyncWriter;
+	s_asyncWriter = nullptr;
+
+	if (enable)
+	{
+		size_t size = 4096;
+		while (size < ringSize)
+		{
+			size <<= 1;
+		}
+		s_asyncWriter = new AsyncWriter(size, &Logger::OutputAsync);
+	}
+}
+
+bool Logger::IsAsync()
+{
+	return s_asyncWriter != nullptr;
+}
+
+size_t Logger::GetDroppedCount()
+{
+	return s_asyncWriter ? s_asyncWriter->GetDroppedCount() : 0;
+}
+
+void Logger::SetTimestampFunc(size_t(*timestampFunc)())
+{
+	s_timestampFunc = timestampFunc;
+}
+
+void Logger::OutputAsync(uint16_t module, SEVERITY sev, size_t timestamp, const char* message)
+{
+	std::string line;
+	if (s_timestampFunc)
+	{
+		char ts[32];
+		sprintf(ts, "[%zu]", timestamp);
+		line += ts;
+	}
+
+	const std::string moduleID = GetModuleNames().GetName(module);
+	std::vector<char> prefix(moduleID.size() + 64);
+	char* pos = prefix.data();
+	AddPrefix(pos, moduleID, sev, m_enableColors);
+	line.append(prefix.data(), pos);
+	line += message;
+	line += '\n';
+
+	if (m_logCallbackFunc)
+	{
+		m_logCallbackFunc(line.c_str());
+	}
+}
+
 void Logger::_LogPrintf(SEVERITY sev, const char *msg, ...) const
 {
 	switch (sev)
@@ -96,21 +726,26 @@ void Logger::_LogPrintf(SEVERITY sev, const char *msg, ...) const
 	case LOG_ERROR:
 		break;
 	default:
-		throw std::exception("Invalid log level");
+		throw std::runtime_error("Invalid log level");
 	}
 
 	va_list args;
 	va_start(args, msg);
 
+	if (s_asyncWriter)
+	{
+		s_asyncWriter->Log(m_moduleIndex, sev, msg, args);
+		va_end(args);
+		return;
+	}
+
 	char* pos = m_logBuffer;
-	AddChar(pos, '[');
-	AddStr(pos, m_moduleID, m_enableColors ? HBLK : nullptr);
-	AddChar(pos, ']');
-	AddChar(pos, '[');
-	AddStr(pos, LOG_LEVEL_STRINGS[int(sev)], m_enableColors ? LOG_LEVEL_COLORS[int(sev)] : nullptr);
-	AddChar(pos, ']');
-
-	pos += vsprintf(pos, msg, args);
+	AddPrefix(pos, m_moduleID, sev, m_enableColors);
+
+	// Keep room for '\n' and '\0'
+	const size_t left = sizeof(m_logBuffer) - (pos - m_logBuffer) - 2;
+	const int len = vsnprintf(pos, left, msg, args);
+	pos += std::clamp(len, 0, (int)left - 1);
 
 	va_end(args);
 
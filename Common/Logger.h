@@ -4,7 +4,7 @@
 #include <algorithm>
 
 #define LogPrintf(sev, fmt, ...) \
-	do { if (IsLog(sev)) _LogPrintf(sev, fmt, __VA_ARGS__); } while (0)
+	do { if (IsLog(sev)) _LogPrintf(sev, fmt, ##__VA_ARGS__); } while (0)
 
 #define LogPrintHex(sev, buf, size) \
 	do { if (IsLog(sev)) _LogPrintHex(sev, buf, size); } while (0)
@@ -25,6 +25,21 @@ public:
 
 	static void RegisterLogCallback(void(*)(const char *));
 
+	// Asynchronous logging: log calls only store a binary record (module,
+	// severity, format string pointer, raw arguments, timestamp) in a ring
+	// buffer of the calling thread. A background thread formats the records
+	// and calls the log callback, records are dropped when a ring is full.
+	// The format string must be a literal (only the pointer is kept).
+	// Enable/disable while no other thread is logging.
+	// Disable before exit to flush pending records, while the log callback
+	// and its output are still valid.
+	static void EnableAsync(bool enable = true, size_t ringSize = 1024 * 1024);
+	static bool IsAsync();
+	static size_t GetDroppedCount();
+
+	// Timestamp stored in async records, called on the logging thread
+	static void SetTimestampFunc(size_t(*)());
+
 protected:
 	const char* GetModuleID() const { return m_moduleID.c_str(); }
 
@@ -39,12 +54,16 @@ private:
 
 	void RegisterModuleID(const char* moduleID);
 
+	// Called on the async writer thread
+	static void OutputAsync(uint16_t module, SEVERITY sev, size_t timestamp, const char* message);
+
 	SEVERITY m_minSeverity;
 	std::string m_moduleID;
+	uint16_t m_moduleIndex = 0;
 
 	static ModuleList m_moduleList;
 	static bool m_enableColors;
-	static char m_logBuffer[1024];
+	static thread_local char m_logBuffer[1024];
 
 	static void(*m_logCallbackFunc)(const char *str);
 };
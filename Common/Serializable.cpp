@@ -5,4 +5,6 @@
 namespace emul
 {
 	std::filesystem::path Serializable::m_serializationDir;
+	SnapshotFile* Serializable::m_snapshotFile = nullptr;
+	bool Serializable::m_serializeDiskData = true;
 }
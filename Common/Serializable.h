@@ -6,6 +6,8 @@ using json = nlohmann::json;
 
 namespace emul
 {
+	class SnapshotFile;
+
 	enum class SerializationError
 	{
 		FATAL, // Something we can't recover from
@@ -34,9 +36,21 @@ namespace emul
 
 		static std::filesystem::path GetSerializationDir() { return m_serializationDir; }
 		static void SetSerializationDir(std::filesystem::path dir) { m_serializationDir = dir; }
-		
+
+		// When set, bulk data (memory blocks, etc.) goes in the snapshot
+		// file chunks instead of separate files in the serialization dir
+		static SnapshotFile* GetSnapshotFile() { return m_snapshotFile; }
+		static void SetSnapshotFile(SnapshotFile* file) { m_snapshotFile = file; }
+
+		// When false, disk image changes are neither saved nor restored,
+		// disks keep their current contents (see RewindBuffer)
+		static bool GetSerializeDiskData() { return m_serializeDiskData; }
+		static void SetSerializeDiskData(bool serialize) { m_serializeDiskData = serialize; }
+
 	protected:
 		static std::filesystem::path m_serializationDir;
+		static SnapshotFile* m_snapshotFile;
+		static bool m_serializeDiskData;
 	};
 }
 
@@ -0,0 +1,347 @@
+#include "stdafx.h"
+
+#include <SnapshotFile.h>
+#include <Serializable.h>
+#include <Config.h>
+#include <FileUtil.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using cfg::CONFIG;
+using hscommon::fileUtil::File;
+
+namespace emul
+{
+	static const char MAGIC[8] = { 'H', 'K', 'S', 'N', 'A', 'P', 0x1A, 0 };
+
+	SnapshotFile::SnapshotFile() : Logger("snapshot")
+	{
+		Clear();
+	}
+
+	SnapshotFile::~SnapshotFile()
+	{
+		Close();
+
+		// Don't leave a dangling pointer behind
+		if (Serializable::GetSnapshotFile() == this)
+		{
+			Serializable::SetSnapshotFile(nullptr);
+		}
+	}
+
+	void SnapshotFile::Clear()
+	{
+		m_buffer.clear();
+		m_buffer.resize(sizeof(FileHeader));
+		m_chunkCount = 0;
+
+		FileHeader* header = (FileHeader*)m_buffer.data();
+		memcpy(header->magic, MAGIC, sizeof(MAGIC));
+		header->version = VERSION;
+	}
+
+	void SnapshotFile::AddChunk(ChunkType type, const std::string& name, const void* data, size_t size)
+	{
+		if (name.size() >= MAX_NAME)
+		{
+			throw std::runtime_error("AddChunk: name too long");
+		}
+
+		LogPrintf(LOG_DEBUG, "AddChunk: [%.4s][%s], size=%zu", (const char*)&type, name.c_str(), size);
+
+		const size_t pos = m_buffer.size();
+		m_buffer.resize(pos + sizeof(ChunkHeader) + Align(size));
+
+		ChunkHeader* chunk = (ChunkHeader*)(m_buffer.data() + pos);
+		chunk->type = (uint32_t)type;
+		chunk->compression = (uint32_t)Compression::NONE;
+		chunk->size = size;
+		chunk->rawSize = size;
+		strncpy(chunk->name, name.c_str(), MAX_NAME);
+
+		if (size)
+		{
+			memcpy(m_buffer.data() + pos + sizeof(ChunkHeader), data, size);
+		}
+
+		((FileHeader*)m_buffer.data())->chunkCount = ++m_chunkCount;
+	}
+
+	void SnapshotFile::SetState(const json& state)
+	{
+		std::vector<uint8_t> cbor = json::to_cbor(state);
+		AddChunk(ChunkType::STATE, "computer", cbor.data(), cbor.size());
+	}
+
+	void SnapshotFile::SetConfig()
+	{
+		std::ostringstream os;
+		if (!CONFIG().SaveConfig(os))
+		{
+			throw std::runtime_error("SetConfig: Error saving config");
+		}
+		const std::string config = os.str();
+		AddChunk(ChunkType::CONFIG, "config.ini", config.data(), config.size());
+	}
+
+	bool SnapshotFile::Save(const std::filesystem::path& path) const
+	{
+		LogPrintf(LOG_INFO, "Save: [%s], %d chunks, %zu bytes", path.string().c_str(), m_chunkCount, m_buffer.size());
+
+		File f(path.string().c_str(), "wb");
+		if (!f)
+		{
+			LogPrintf(LOG_ERROR, "Save: error opening file");
+			return false;
+		}
+
+		if (fwrite(m_buffer.data(), m_buffer.size(), 1, f) != 1)
+		{
+			LogPrintf(LOG_ERROR, "Save: error writing file");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SnapshotFile::Load(const std::filesystem::path& path)
+	{
+		Close();
+
+		LogPrintf(LOG_INFO, "Load: [%s]", path.string().c_str());
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.string().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			LogPrintf(LOG_ERROR, "Load: error opening file");
+			return false;
+		}
+		m_fileHandle = file;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(FileHeader))
+		{
+			LogPrintf(LOG_ERROR, "Load: invalid file size");
+			Close();
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!mapping)
+		{
+			LogPrintf(LOG_ERROR, "Load: error mapping file");
+			Close();
+			return false;
+		}
+		m_mapHandle = mapping;
+
+		const BYTE* view = (const BYTE*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view)
+		{
+			LogPrintf(LOG_ERROR, "Load: error mapping file view");
+			Close();
+			return false;
+		}
+
+		m_data = view;
+		m_size = (size_t)size.QuadPart;
+#else
+		const int file = open(path.string().c_str(), O_RDONLY);
+		if (file < 0)
+		{
+			LogPrintf(LOG_ERROR, "Load: error opening file");
+			return false;
+		}
+
+		struct stat fileStat;
+		if ((fstat(file, &fileStat) != 0) || (fileStat.st_size < (off_t)sizeof(FileHeader)))
+		{
+			LogPrintf(LOG_ERROR, "Load: invalid file size");
+			close(file);
+			return false;
+		}
+
+		// The mapping stays valid after the file is closed
+		void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (view == MAP_FAILED)
+		{
+			LogPrintf(LOG_ERROR, "Load: error mapping file");
+			return false;
+		}
+		m_mapHandle = view;
+
+		m_data = (const BYTE*)view;
+		m_size = (size_t)fileStat.st_size;
+#endif
+
+		if (!Index())
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	bool SnapshotFile::Load(const BYTE* data, size_t size)
+	{
+		Close();
+
+		if (!data || size < sizeof(FileHeader))
+		{
+			LogPrintf(LOG_ERROR, "Load: invalid buffer");
+			return false;
+		}
+
+		m_data = data;
+		m_size = size;
+
+		if (!Index())
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void SnapshotFile::Close()
+	{
+#ifdef _WIN32
+		if (m_mapHandle && m_data)
+		{
+			UnmapViewOfFile(m_data);
+		}
+		if (m_mapHandle)
+		{
+			CloseHandle((HANDLE)m_mapHandle);
+			m_mapHandle = nullptr;
+		}
+		if (m_fileHandle)
+		{
+			CloseHandle((HANDLE)m_fileHandle);
+			m_fileHandle = nullptr;
+		}
+#else
+		if (m_mapHandle)
+		{
+			munmap(m_mapHandle, m_size);
+			m_mapHandle = nullptr;
+		}
+#endif
+
+		m_data = nullptr;
+		m_size = 0;
+		m_chunks.clear();
+	}
+
+	bool SnapshotFile::Index()
+	{
+		const FileHeader* header = (const FileHeader*)m_data;
+		if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+		{
+			LogPrintf(LOG_ERROR, "Index: not a snapshot file");
+			return false;
+		}
+		if (header->version != VERSION)
+		{
+			LogPrintf(LOG_ERROR, "Index: unsupported version: %d", header->version);
+			return false;
+		}
+
+		size_t pos = sizeof(FileHeader);
+		for (uint32_t i = 0; i < header->chunkCount; ++i)
+		{
+			if (m_size - pos < sizeof(ChunkHeader))
+			{
+				LogPrintf(LOG_ERROR, "Index: truncated file");
+				return false;
+			}
+
+			const ChunkHeader* chunkHeader = (const ChunkHeader*)(m_data + pos);
+			pos += sizeof(ChunkHeader);
+
+			if (chunkHeader->size > m_size - pos)
+			{
+				LogPrintf(LOG_ERROR, "Index: truncated chunk");
+				return false;
+			}
+			if (chunkHeader->compression != (uint32_t)Compression::NONE)
+			{
+				LogPrintf(LOG_ERROR, "Index: unsupported compression: %d", chunkHeader->compression);
+				return false;
+			}
+
+			Chunk chunk;
+			chunk.type = (ChunkType)chunkHeader->type;
+			chunk.name.assign(chunkHeader->name, strnlen(chunkHeader->name, MAX_NAME));
+			chunk.data = m_data + pos;
+			chunk.size = (size_t)chunkHeader->size;
+			m_chunks.push_back(chunk);
+
+			LogPrintf(LOG_DEBUG, "Index: [%.4s][%s], size=%zu", (const char*)&chunkHeader->type, chunk.name.c_str(), chunk.size);
+
+			pos += std::min(Align(chunk.size), m_size - pos);
+		}
+
+		LogPrintf(LOG_INFO, "Index: %zu chunks", m_chunks.size());
+		return true;
+	}
+
+	const BYTE* SnapshotFile::FindChunk(ChunkType type, const std::string& name, size_t& size) const
+	{
+		for (const Chunk& chunk : m_chunks)
+		{
+			if (chunk.type == type && chunk.name == name)
+			{
+				size = chunk.size;
+				return chunk.data;
+			}
+		}
+
+		size = 0;
+		return nullptr;
+	}
+
+	bool SnapshotFile::GetState(json& state) const
+	{
+		size_t size;
+		const BYTE* data = FindChunk(ChunkType::STATE, "computer", size);
+		if (!data)
+		{
+			LogPrintf(LOG_ERROR, "GetState: state chunk not found");
+			return false;
+		}
+
+		try
+		{
+			state = json::from_cbor(data, data + size);
+		}
+		catch (std::exception e)
+		{
+			LogPrintf(LOG_ERROR, "GetState: error decoding state: %s", e.what());
+			return false;
+		}
+		return true;
+	}
+
+	bool SnapshotFile::LoadConfig() const
+	{
+		size_t size;
+		const BYTE* data = FindChunk(ChunkType::CONFIG, "config.ini", size);
+		if (!data)
+		{
+			LogPrintf(LOG_ERROR, "LoadConfig: config chunk not found");
+			return false;
+		}
+
+		std::istringstream is(std::string((const char*)data, size));
+		return CONFIG().LoadConfig(is);
+	}
+}
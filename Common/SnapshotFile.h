@@ -0,0 +1,137 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace emul
+{
+	constexpr uint32_t MakeFourCC(const char id[5])
+	{
+		return (uint32_t)id[0] | ((uint32_t)id[1] << 8) | ((uint32_t)id[2] << 16) | ((uint32_t)id[3] << 24);
+	}
+
+	// Single file, binary snapshot container
+	//
+	// File layout (little endian):
+	//
+	//   FileHeader
+	//   ChunkHeader + payload, padded to ALIGN
+	//   ChunkHeader + payload, padded to ALIGN
+	//   ...
+	//
+	// Chunks are identified by type + name (e.g. MEMORY + block id).
+	// Payloads are aligned so they can be used in place when
+	// the file is memory mapped (no parsing, one copy to the destination).
+	//
+	// Each chunk has a compression codec field and its uncompressed size,
+	// only NONE is implemented for now.
+	class SnapshotFile : public Logger
+	{
+	public:
+		static constexpr const char* FILE_NAME = "computer.snap";
+
+		static constexpr uint32_t VERSION = 1;
+		static constexpr size_t ALIGN = 64;
+		static constexpr size_t MAX_NAME = 40;
+
+		enum class ChunkType : uint32_t
+		{
+			STATE = MakeFourCC("STAT"),  // Serialized computer (json, CBOR encoded)
+			CONFIG = MakeFourCC("CONF"), // Configuration (config.ini text)
+			MEMORY = MakeFourCC("MEM "), // Raw memory block data
+			DISK = MakeFourCC("DISK"), // Disk image changes (copy-on-write delta)
+		};
+
+		enum class Compression : uint32_t
+		{
+			NONE = 0,
+		};
+
+		SnapshotFile();
+		~SnapshotFile();
+
+		SnapshotFile(const SnapshotFile&) = delete;
+		SnapshotFile& operator=(const SnapshotFile&) = delete;
+		SnapshotFile(SnapshotFile&&) = delete;
+		SnapshotFile& operator=(SnapshotFile&&) = delete;
+
+		// Writing
+
+		// Starts a new empty snapshot. Keeps the allocated buffer,
+		// so it can be reused for frequent (per frame) snapshots
+		void Clear();
+
+		void AddChunk(ChunkType type, const std::string& name, const void* data, size_t size);
+
+		void SetState(const json& state);
+		void SetConfig(); // Current CONFIG()
+
+		bool Save(const std::filesystem::path& path) const;
+
+		// Raw snapshot data, to keep in memory or send elsewhere
+		const std::vector<BYTE>& GetBuffer() const { return m_buffer; }
+
+		// Reading
+
+		// File is memory mapped and stays mapped until Close()
+		bool Load(const std::filesystem::path& path);
+		// Data is not copied, it must stay valid until Close()
+		bool Load(const BYTE* data, size_t size);
+		void Close();
+
+		bool IsLoaded() const { return m_data != nullptr; }
+
+		// Returns nullptr if not found
+		const BYTE* FindChunk(ChunkType type, const std::string& name, size_t& size) const;
+
+		bool GetState(json& state) const;
+		bool LoadConfig() const; // Replaces current CONFIG()
+
+	protected:
+		struct FileHeader
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t chunkCount;
+			BYTE reserved[ALIGN - 16];
+		};
+		static_assert(sizeof(FileHeader) == ALIGN);
+
+		struct ChunkHeader
+		{
+			uint32_t type;
+			uint32_t compression;
+			uint64_t size; // Stored payload size
+			uint64_t rawSize; // Uncompressed payload size
+			char name[MAX_NAME]; // Zero terminated
+		};
+		static_assert(sizeof(ChunkHeader) == ALIGN);
+
+		struct Chunk
+		{
+			ChunkType type;
+			std::string name;
+			const BYTE* data;
+			size_t size;
+		};
+
+		static size_t Align(size_t size) { return (size + ALIGN - 1) & ~(ALIGN - 1); }
+
+		bool Index();
+
+		// Writing
+		std::vector<BYTE> m_buffer;
+		uint32_t m_chunkCount = 0;
+
+		// Reading
+		const BYTE* m_data = nullptr;
+		size_t m_size = 0;
+		std::vector<Chunk> m_chunks;
+
+		// Memory mapped file (POSIX: m_mapHandle is the mapped view)
+		void* m_fileHandle = nullptr;
+		void* m_mapHandle = nullptr;
+	};
+}
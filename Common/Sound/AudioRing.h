@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace sound
+{
+	// Lock-free single producer / single consumer ring of stereo sample frames
+	//
+	// Producer: emulation thread (Sound::Update)
+	// Consumer: SDL audio callback thread
+	//
+	// Read and write positions are free running counters, only
+	// masked when accessing the data, so fill = write - read.
+	class AudioRing
+	{
+	public:
+		AudioRing() = default;
+
+		AudioRing(const AudioRing&) = delete;
+		AudioRing& operator=(const AudioRing&) = delete;
+		AudioRing(AudioRing&&) = delete;
+		AudioRing& operator=(AudioRing&&) = delete;
+
+		// Not thread safe, call before the audio device is started.
+		// frames must be a power of two
+		void Init(size_t frames)
+		{
+			assert(frames && ((frames & (frames - 1)) == 0));
+			m_data.assign(frames * 2, 0);
+			m_mask = frames - 1;
+			m_read.store(0, std::memory_order_relaxed);
+			m_write.store(0, std::memory_order_relaxed);
+		}
+
+		size_t GetCapacity() const { return m_mask + 1; }
+
+		// Approximate when called from the producer or consumer side,
+		// the other side can move concurrently
+		size_t GetFill() const
+		{
+			return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+		}
+
+		// Producer side. Returns false if the ring is full (frame is dropped)
+		bool Push(int16_t left, int16_t right)
+		{
+			const size_t write = m_write.load(std::memory_order_relaxed);
+			if (write - m_read.load(std::memory_order_acquire) > m_mask)
+			{
+				return false;
+			}
+
+			int16_t* dest = &m_data[(write & m_mask) * 2];
+			dest[0] = left;
+			dest[1] = right;
+
+			m_write.store(write + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer side. Copies up to 'frames' sample frames to dest,
+		// returns the number of frames copied
+		size_t Pop(int16_t* dest, size_t frames)
+		{
+			const size_t read = m_read.load(std::memory_order_relaxed);
+			const size_t available = m_write.load(std::memory_order_acquire) - read;
+			if (frames > available)
+			{
+				frames = available;
+			}
+
+			for (size_t i = 0; i < frames; ++i)
+			{
+				const int16_t* src = &m_data[((read + i) & m_mask) * 2];
+				*dest++ = src[0];
+				*dest++ = src[1];
+			}
+
+			m_read.store(read + frames, std::memory_order_release);
+			return frames;
+		}
+
+	protected:
+		std::vector<int16_t> m_data;
+		size_t m_mask = 0;
+
+		// Separate cache lines, written by different threads
+		alignas(64) std::atomic<size_t> m_write{ 0 };
+		alignas(64) std::atomic<size_t> m_read{ 0 };
+	};
+}
@@ -0,0 +1,109 @@
+#include "stdafx.h"
+
+#include <Sound/BlipBuffer.h>
+#include <algorithm>
+#include <cmath>
+
+namespace sound
+{
+	// Lowpass cutoff, relative to the output Nyquist frequency
+	const double CUTOFF = 0.9;
+
+	int32_t BlipBuffer::s_kernel[BlipBuffer::PHASES][BlipBuffer::WIDTH];
+
+	BlipBuffer::BlipBuffer()
+	{
+		// Shared by all buffers, built once (thread safe)
+		static const bool kernelInit = (InitKernel(), true);
+		(void)kernelInit;
+	}
+
+	void BlipBuffer::InitKernel()
+	{
+		const double PI = 3.14159265358979323846;
+
+		for (int phase = 0; phase < PHASES; ++phase)
+		{
+			double taps[WIDTH];
+			double sum = 0.0;
+
+			for (int i = 0; i < WIDTH; ++i)
+			{
+				// Distance from the (delayed) step position, in output samples
+				const double x = (i - HALF_WIDTH) - (double)phase / PHASES + 1.0;
+
+				const double sinc = (x == 0.0) ? 1.0 : sin(PI * CUTOFF * x) / (PI * CUTOFF * x);
+
+				// Blackman window over [-HALF_WIDTH, HALF_WIDTH]
+				const double w = x / HALF_WIDTH;
+				const double window = (fabs(w) >= 1.0) ? 0.0 : (0.42 + 0.5 * cos(PI * w) + 0.08 * cos(2.0 * PI * w));
+
+				taps[i] = sinc * window;
+				sum += taps[i];
+			}
+
+			// Normalize so the taps of each phase add up to exactly 1 << KERNEL_BITS,
+			// otherwise the integrated output would drift
+			int32_t total = 0;
+			int maxTap = 0;
+			for (int i = 0; i < WIDTH; ++i)
+			{
+				s_kernel[phase][i] = (int32_t)lround(taps[i] / sum * (1 << KERNEL_BITS));
+				total += s_kernel[phase][i];
+				if (s_kernel[phase][i] > s_kernel[phase][maxTap])
+				{
+					maxTap = i;
+				}
+			}
+			s_kernel[phase][maxTap] += (1 << KERNEL_BITS) - total;
+		}
+	}
+
+	void BlipBuffer::Init(size_t size)
+	{
+		m_size = size;
+		m_buffer.resize(size + WIDTH);
+		Clear();
+	}
+
+	void BlipBuffer::Clear()
+	{
+		std::fill(m_buffer.begin(), m_buffer.end(), 0);
+		m_offset = 0;
+		m_integrator = 0;
+	}
+
+	uint32_t BlipBuffer::GetMaxFrameClocks() const
+	{
+		// Keep room for what's already buffered
+		const uint64_t room = ((uint64_t)(m_size - GetAvailable()) << FACTOR_BITS) - (m_offset & (FACTOR_ONE - 1));
+		return (uint32_t)std::min(room / std::max(m_factor, (uint64_t)1), (uint64_t)UINT32_MAX);
+	}
+
+	size_t BlipBuffer::Read(int16_t* dest, size_t count, size_t stride)
+	{
+		count = std::min(count, GetAvailable());
+		if (!count)
+		{
+			return 0;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			m_integrator += m_buffer[i];
+
+			const int64_t sample = m_integrator >> KERNEL_BITS;
+			*dest = (int16_t)std::clamp(sample, (int64_t)INT16_MIN, (int64_t)INT16_MAX);
+			dest += stride;
+		}
+
+		// Move the remaining samples (and kernel tails) to the front
+		const size_t remain = GetAvailable() - count + WIDTH;
+		std::copy(m_buffer.begin() + count, m_buffer.begin() + count + remain, m_buffer.begin());
+		std::fill(m_buffer.begin() + remain, m_buffer.begin() + remain + count, 0);
+
+		m_offset -= (uint64_t)count << FACTOR_BITS;
+
+		return count;
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+
+namespace sound
+{
+	// Band-limited step synthesis buffer (one channel)
+	//
+	// Sources don't produce samples, they add amplitude deltas at
+	// timestamps in their own clock. Each delta is added to the output
+	// (at the playback rate) as a band-limited step: a windowed-sinc
+	// impulse that is integrated when the samples are read.
+	//
+	// Time is split in frames: AddDelta() times are relative to the
+	// start of the current frame, EndFrame() closes it and makes the
+	// samples available for Read().
+	class BlipBuffer
+	{
+	public:
+		// Kernel is WIDTH samples wide, output is delayed by HALF_WIDTH samples
+		static constexpr int HALF_WIDTH = 8;
+		static constexpr int WIDTH = HALF_WIDTH * 2;
+
+		// Sub-sample resolution of the step position
+		static constexpr int PHASE_BITS = 5;
+		static constexpr int PHASES = 1 << PHASE_BITS;
+
+		// Kernel taps are fixed point, each phase sums to 1 << KERNEL_BITS
+		static constexpr int KERNEL_BITS = 15;
+
+		BlipBuffer();
+
+		BlipBuffer(const BlipBuffer&) = delete;
+		BlipBuffer& operator=(const BlipBuffer&) = delete;
+		BlipBuffer(BlipBuffer&&) = delete;
+		BlipBuffer& operator=(BlipBuffer&&) = delete;
+
+		// size: Maximum number of output samples in one frame
+		void Init(size_t size);
+		void Clear();
+
+		size_t GetSize() const { return m_size; }
+
+		// Output samples per input clock, 32.32 fixed point (see GetFactor)
+		void SetFactor(uint64_t factor) { m_factor = factor; }
+		uint64_t GetFactor() const { return m_factor; }
+
+		static uint64_t GetFactor(double clockRate, double sampleRate) { return (uint64_t)(sampleRate / clockRate * FACTOR_ONE); }
+
+		// Longest frame (in input clocks) that fits in the buffer
+		uint32_t GetMaxFrameClocks() const;
+
+		void AddDelta(uint32_t time, int32_t delta)
+		{
+			const uint64_t pos = m_offset + time * m_factor;
+			const size_t index = (size_t)(pos >> FACTOR_BITS);
+			const int phase = (int)(pos >> (FACTOR_BITS - PHASE_BITS)) & (PHASES - 1);
+
+			assert(index + WIDTH <= m_buffer.size());
+
+			const int32_t* kernel = s_kernel[phase];
+			int64_t* out = &m_buffer[index];
+			for (int i = 0; i < WIDTH; ++i)
+			{
+				out[i] += (int64_t)delta * kernel[i];
+			}
+		}
+
+		void EndFrame(uint32_t time) { m_offset += time * m_factor; assert(GetAvailable() <= m_size); }
+
+		size_t GetAvailable() const { return (size_t)(m_offset >> FACTOR_BITS); }
+
+		// Reads (and removes) up to count samples, every stride int16_t in dest
+		size_t Read(int16_t* dest, size_t count, size_t stride = 1);
+
+	protected:
+		static constexpr int FACTOR_BITS = 32;
+		static constexpr uint64_t FACTOR_ONE = (uint64_t)1 << FACTOR_BITS;
+
+		static void InitKernel();
+		static int32_t s_kernel[PHASES][WIDTH];
+
+		size_t m_size = 0;
+		std::vector<int64_t> m_buffer;
+
+		uint64_t m_factor = FACTOR_ONE;
+		uint64_t m_offset = 0;
+
+		int64_t m_integrator = 0;
+	};
+}
@@ -1,29 +1,37 @@
 #include "stdafx.h"
 #include "Sound.h"
+#include <Config.h>
 
 #include <thread>
 #include <algorithm>
 
+using cfg::CONFIG;
+
 namespace sound
 {
-	// Called from another thread
-	void AudioCallback(void* userData, Uint8* stream, int length)
-	{
-		const SDL_AudioSpec& spec = SOUND().GetAudioSpec();
+	// Maximum resampling ratio adjustment in rate control mode (+/- 0.5%)
+	const double MAX_RATE_ADJUST = 0.005;
 
-		assert(length == spec.samples * sizeof(int16_t) * 2);
+	// Rate control mode: when the emulation falls behind the host clock by
+	// more than this, give up on catching up (avoids running in bursts)
+	const double MAX_LAG_SECONDS = 0.1;
 
-		const uint8_t* source = (const uint8_t*)SOUND().GetPlayingBuffer();
+	// Band-limited synthesis buffer size, in sample frames (~90ms)
+	const size_t BLIP_SIZE = 4096;
 
-		memset(stream, 0, length);
-		SDL_MixAudioFormat(stream, source, spec.format, length, SOUND().GetMasterVolume());
-		if (SOUND().IsStagingFull())
-		{
-			SOUND().ResetStaging();
-		}
+#ifndef HSCOMMON_NO_SDL
+	static_assert(Sound::MAX_VOLUME == SDL_MIX_MAXVOLUME);
+
+	// Called from another thread
+	void AudioCallback(void* userData, Uint8* stream, int length)
+	{
+		((Sound*)userData)->FillAudioBuffer(stream, length);
 	}
+#endif
+
+	thread_local Sound* Sound::s_current = nullptr;
 
-	Sound& Sound::Get()
+	Sound& Sound::GetDefault()
 	{
 		static Sound sound;
 		return sound;
@@ -40,23 +48,21 @@ namespace sound
 
 	void Sound::Cleanup()
 	{
+#ifndef HSCOMMON_NO_SDL
 		if (m_audioDeviceID)
 		{
 			SDL_CloseAudioDevice(m_audioDeviceID);
 			m_audioDeviceID = 0;
-		}
-
-		delete[] m_bufSilence;
-		m_bufSilence = nullptr;
 
-		delete[] m_bufPlaying;
-		m_bufPlaying = nullptr;
+			LogPrintf(LOG_INFO, "Underruns: %zu, Overruns: %zu", GetUnderruns(), GetOverruns());
+		}
+#endif
 
-		delete[] m_bufStaging;
-		m_bufStaging = nullptr;
+		delete[] m_bufCallback;
+		m_bufCallback = nullptr;
 	}
 
-	bool Sound::Init(WORD bufferSampleFrames)
+	bool Sound::Init(WORD bufferSampleFrames, bool openDevice)
 	{
 		m_bufferSize = bufferSampleFrames;
 
@@ -66,13 +72,46 @@ namespace sound
 			return false;
 		}
 
-		// x2 for stereo
-		m_bufSilence = new int16_t[m_bufferSize * 2];
-		m_bufPlaying = new int16_t[m_bufferSize * 2];
-		m_bufStaging = new int16_t[m_bufferSize * 2];
-
 		LogPrintf(LOG_INFO, "Initialize sound engine - Buffer size: %d sample frames", m_bufferSize);
 
+		m_blipL.Init(BLIP_SIZE);
+		m_blipR.Init(BLIP_SIZE);
+		m_synced = false;
+
+		if (!openDevice)
+		{
+			LogPrintf(LOG_INFO, "No audio device");
+#ifndef HSCOMMON_NO_SDL
+			m_audioSpec = SDL_AudioSpec();
+			m_audioSpec.freq = PLAYBACK_FREQUENCY;
+			m_audioSpec.format = AUDIO_S16;
+			m_audioSpec.channels = 2;
+			m_audioSpec.samples = m_bufferSize;
+#endif
+			return true;
+		}
+
+#ifdef HSCOMMON_NO_SDL
+		LogPrintf(LOG_ERROR, "No audio device support (built without SDL)");
+		return false;
+#else
+
+		// Target latency, at least two device buffers so the callback never waits on the emulation
+		int latencyMs = CONFIG().GetValueInt32("sound", "latency", 50);
+		m_latencyFrames = std::max((size_t)latencyMs * PLAYBACK_FREQUENCY / 1000, (size_t)m_bufferSize * 2);
+
+		size_t ringSize = 1;
+		while (ringSize < m_latencyFrames * 2)
+		{
+			ringSize <<= 1;
+		}
+		m_ring.Init(ringSize);
+
+		m_rateControl = CONFIG().GetValueBool("sound", "ratecontrol");
+
+		LogPrintf(LOG_INFO, "Latency: %d ms (%zu sample frames), Ring size: %zu sample frames", latencyMs, m_latencyFrames, ringSize);
+		LogPrintf(LOG_INFO, "Rate control: %s", m_rateControl ? "ON" : "OFF");
+
 		if (SDL_WasInit(SDL_INIT_AUDIO) == 0)
 		{
 			LogPrintf(LOG_INFO, "SDL Init Subsystem [Audio]");
@@ -85,25 +124,38 @@ namespace sound
 		InitSDLAudio();
 
 		return true;
+#endif
 	}
 
 	void Sound::SetBaseClock(int freq)
 	{
-		// PLAYBACK_FREQUENCY
 		LogPrintf(LOG_INFO, "SetBaseClock: %dHz", freq);
 
-		m_freqDivider = freq / PLAYBACK_FREQUENCY;
-
-		if (m_freqDivider < 1)
+		if (freq <= 0)
 		{
-			LogPrintf(LOG_ERROR, "Invalid clock divider");
-		}
-		else
-		{
-			LogPrintf(LOG_INFO, "Sample Clock Divider: %d", m_freqDivider);
+			LogPrintf(LOG_ERROR, "Invalid base clock");
+			return;
 		}
+
+		m_baseClock = freq;
+		m_baseFactor = BlipBuffer::GetFactor(freq, PLAYBACK_FREQUENCY);
+		m_blipL.SetFactor(m_baseFactor);
+		m_blipR.SetFactor(m_baseFactor);
+
+		LogPrintf(LOG_INFO, "Sample Clock Divider: %.3f", (double)freq / PLAYBACK_FREQUENCY);
+
+		m_blipL.Clear();
+		m_blipR.Clear();
+		m_levelL = 0;
+		m_levelR = 0;
+		m_synced = false;
+
+		// Restart host clock pacing
+		m_inputTicks = 0;
+		m_outputFrames = 0;
 	}
 
+#ifndef HSCOMMON_NO_SDL
 	void Sound::InitSDLAudio()
 	{
 		SDL_AudioSpec want;
@@ -112,43 +164,58 @@ namespace sound
 		want.channels = 2; // Stereo
 		want.samples = m_bufferSize;
 		want.callback = &AudioCallback;
-		want.userdata = nullptr;
+		want.userdata = this;
 
 		m_audioDeviceID = SDL_OpenAudioDevice(0, 0, &want, &m_audioSpec, 0);
 		if (m_audioDeviceID == 0)
 		{
 			LogPrintf(LOG_ERROR, "Unable to open Audio Device: %s", SDL_GetError());
+			return;
 		}
 
-		for (WORD i = 0; i < m_bufferSize * 2; ++i)
-		{
-			m_bufSilence[i] = m_audioSpec.silence;
-			m_bufStaging[i] = m_audioSpec.silence;
-			m_bufPlaying[i] = m_audioSpec.silence;
-		}
+		// Device is opened paused, callback doesn't run until it's unpaused
+		m_bufCallback = new int16_t[m_audioSpec.samples * 2];
 
 		SDL_PauseAudioDevice(m_audioDeviceID, false);
 	}
 
-	void Sound::MoveToPlayingBuffer()
+	void Sound::FillAudioBuffer(Uint8* stream, int length)
 	{
-		SDL_LockAudio();
-		memcpy(m_bufPlaying, m_bufStaging, m_bufferSize * sizeof(uint16_t) * 2);
-		SDL_UnlockAudio();
+		const size_t frames = std::min((size_t)length / (sizeof(int16_t) * 2), (size_t)m_audioSpec.samples);
+		assert(frames * sizeof(int16_t) * 2 == (size_t)length);
+
+		const size_t read = m_ring.Pop(m_bufCallback, frames);
+		if (read < frames)
+		{
+			std::fill(m_bufCallback + read * 2, m_bufCallback + frames * 2, 0);
+
+			// Don't count the initial fill
+			if (m_started)
+			{
+				++m_underruns;
+			}
+		}
+
+		memset(stream, m_audioSpec.silence, length);
+		SDL_MixAudioFormat(stream, (const Uint8*)m_bufCallback, m_audioSpec.format, (Uint32)(frames * sizeof(int16_t) * 2), GetMasterVolume());
 	}
+#endif
 
 	void Sound::SetMasterVolume(int vol)
 	{
-		m_masterVolume = std::clamp(vol, 0, SDL_MIX_MAXVOLUME);
+		m_masterVolume = std::clamp(vol, 0, MAX_VOLUME);
 		LogPrintf(LOG_INFO, "Set Master Volume [%d]", m_masterVolume);
 	}
 
 	void Sound::StreamToFile(bool stream, const char* outFile)
 	{
-		if (!stream && m_outputFile)
+		if (!stream)
 		{
-			LogPrintf(LOG_INFO, "StreamToFile: Stop audio stream dump to file");
-			m_outputFile.Close();
+			if (m_outputFile)
+			{
+				LogPrintf(LOG_INFO, "StreamToFile: Stop audio stream dump to file");
+				m_outputFile.Close();
+			}
 			return;
 		}
 		else
@@ -168,68 +235,155 @@ namespace sound
 		}
 	}
 
-	void Sound::PlayMono(int16_t data)
+	void Sound::WaitAudio()
 	{
-		static int sample = 0;
-		static int32_t avg = 0;
-
-		if (m_outputFile) fputc(data, m_outputFile);
+		if (!m_rateControl)
+		{
+			// Paced by the audio device: only wait when we're ahead of the target latency
+			while (m_ring.GetFill() >= m_latencyFrames) { std::this_thread::yield(); };
+			return;
+		}
 
-		// temp hack, "average" n samples
-		avg += data;
-		++sample;
-		if (sample == m_freqDivider)
+		// Paced by the host clock: don't get ahead of real time by more than the target latency
+		const double latency = (double)m_latencyFrames / PLAYBACK_FREQUENCY;
+		const double emulated = (double)m_inputTicks / m_baseClock;
+		while (true)
 		{
-			if (IsStagingFull())
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+			const double ahead = emulated - elapsed;
+
+			if (ahead < -MAX_LAG_SECONDS)
 			{
-				MoveToPlayingBuffer();
+				// Too far behind, resynchronize
+				m_startTime = std::chrono::steady_clock::now() - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(emulated));
+				break;
+			}
+			else if (ahead <= latency)
+			{
+				break;
 			}
 
-			// Crude synchronization
-			while (IsStagingFull()) { std::this_thread::yield(); };
-
-			avg /= m_freqDivider;
-			AddSample(m_muted ? 0 : avg); // Left
-			AddSample(m_muted ? 0 : avg); // Right
-
-			avg = 0;
-			sample = 0;
+			std::this_thread::yield();
 		}
 	}
 
-	void Sound::PlayStereo(int16_t left, int16_t right)
+	void Sound::UpdateRateControl()
 	{
-		static int sample = 0;
-		static int32_t avgL = 0;
-		static int32_t avgR = 0;
+		// Ring above target: produce fewer frames, and vice versa
+		const double error = std::clamp(((double)m_ring.GetFill() - (double)m_latencyFrames) / m_latencyFrames, -1.0, 1.0);
+		const uint64_t factor = (uint64_t)(m_baseFactor * (1.0 - MAX_RATE_ADJUST * error));
+		m_blipL.SetFactor(factor);
+		m_blipR.SetFactor(factor);
+	}
+
+	void Sound::OutputFrame(int16_t left, int16_t right)
+	{
+		if (m_muted)
+		{
+			left = 0;
+			right = 0;
+		}
 
 		if (m_outputFile)
 		{
-			fputc(left, m_outputFile);
-			fputc(right, m_outputFile);
+			const int16_t frame[2] = { left, right };
+			fwrite(frame, sizeof(frame), 1, m_outputFile);
 		}
 
-		// temp hack, "average" n samples
-		avgL += left;
-		avgR += right;
-		++sample;
-		if (sample == m_freqDivider)
+		if (!m_audioDeviceID)
 		{
-			if (IsStagingFull())
-			{
-				MoveToPlayingBuffer();
-			}
+			return;
+		}
 
-			// Crude synchronization
-			while (IsStagingFull()) { std::this_thread::yield(); };
+		if (m_outputFrames == 0)
+		{
+			m_startTime = std::chrono::steady_clock::now();
+		}
 
-			AddSample(m_muted ? 0 : (avgL / m_freqDivider));
-			AddSample(m_muted ? 0 : (avgR / m_freqDivider));
+		WaitAudio();
 
-			avgL = 0;
-			avgR = 0;
-			sample = 0;
+		if (!m_ring.Push(left, right))
+		{
+			++m_overruns;
+		}
+
+		if (!m_started && m_ring.GetFill() >= m_latencyFrames / 2)
+		{
+			m_started = true;
+		}
+
+		if ((++m_outputFrames & 255) == 0 && m_rateControl)
+		{
+			UpdateRateControl();
 		}
 	}
 
+	void Sound::Resync(size_t ticks)
+	{
+		m_frameStart = ticks;
+		m_synced = true;
+	}
+
+	void Sound::AddDelta(size_t ticks, int16_t left, int16_t right)
+	{
+		if (!m_synced || ticks < m_frameStart)
+		{
+			Resync(ticks);
+		}
+		else if (ticks - m_frameStart >= m_blipL.GetMaxFrameClocks())
+		{
+			// Frame is full, Update() wasn't called in a while
+			Update(ticks);
+		}
+
+		const uint32_t time = (uint32_t)(ticks - m_frameStart);
+
+		if (left != m_levelL)
+		{
+			m_blipL.AddDelta(time, left - m_levelL);
+			m_levelL = left;
+		}
+		if (right != m_levelR)
+		{
+			m_blipR.AddDelta(time, right - m_levelR);
+			m_levelR = right;
+		}
+	}
+
+	void Sound::Update(size_t ticks)
+	{
+		if (!m_synced || ticks < m_frameStart)
+		{
+			Resync(ticks);
+			return;
+		}
+
+		const size_t elapsed = ticks - m_frameStart;
+		if (elapsed > m_blipL.GetMaxFrameClocks())
+		{
+			// Long gap (turbo, pause, ...), don't try to fill it
+			LogPrintf(LOG_DEBUG, "Update: Resync, gap=%zu ticks", elapsed);
+			Resync(ticks);
+			return;
+		}
+
+		m_blipL.EndFrame((uint32_t)elapsed);
+		m_blipR.EndFrame((uint32_t)elapsed);
+		m_frameStart = ticks;
+		m_inputTicks += elapsed;
+
+		int16_t frames[256 * 2];
+		size_t available;
+		while ((available = m_blipL.GetAvailable()) != 0)
+		{
+			const size_t count = std::min(available, (size_t)256);
+			m_blipL.Read(frames, count, 2);
+			m_blipR.Read(frames + 1, count, 2);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				OutputFrame(frames[i * 2], frames[i * 2 + 1]);
+			}
+		}
+	}
 }
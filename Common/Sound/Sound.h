@@ -1,16 +1,25 @@
 #pragma once
 
+#ifndef HSCOMMON_NO_SDL
 #include <SDL.h>
+#endif
 #include <FileUtil.h>
+#include <Sound/AudioRing.h>
+#include <Sound/BlipBuffer.h>
+#include <atomic>
+#include <chrono>
 
 using emul::WORD;
 
 namespace sound
 {
-	// Singleton
+	// SOUND() is the current thread's instance, the process-wide default
+	// one unless the thread selected its own with SetCurrent(). Each
+	// instance has its own ring, so one emulation thread feeds one ring
 	class Sound : public Logger
 	{
 	public:
+		Sound();
 		~Sound();
 
 		Sound(const Sound&) = delete;
@@ -18,57 +27,129 @@ namespace sound
 		Sound(Sound&&) = delete;
 		Sound& operator=(Sound&&) = delete;
 
-		static Sound& Get();
+		static Sound& Get() { return s_current ? *s_current : GetDefault(); }
+
+		// nullptr restores the default (process-wide) instance
+		static void SetCurrent(Sound* sound) { s_current = sound; }
 
 		// A sample frame is a chunk of audio data of the size specified in format multiplied by the number of channels
-		bool Init(WORD bufferSampleFrames = 1024);
+		// openDevice = false: no audio output (headless), samples are only streamed to file (if enabled).
+		// Without SDL (HSCOMMON_NO_SDL) there is no audio device to open
+		bool Init(WORD bufferSampleFrames = 1024, bool openDevice = true);
 		void Cleanup();
 
-		// Used for synchronization, set the interval at which Play() is called
+		// Frequency of the clock used for the SetOutput/Update timestamps
+		// (the computer's g_ticks)
 		void SetBaseClock(int freq);
 
 		void StreamToFile(bool stream, const char* outFile = nullptr);
 
+#ifndef HSCOMMON_NO_SDL
 		const SDL_AudioSpec& GetAudioSpec() const { return m_audioSpec; }
-
-		int16_t* GetPlayingBuffer() const { return m_bufPlaying; }
-		int16_t* GetSilenceBuffer() const { return m_bufSilence; }
-
-		bool IsStagingFull() const { return m_bufStagingPos == m_bufferSize * 2; }
-		void ResetStaging() { m_bufStagingPos = 0; }
+#endif
 
 		void SetMute(bool mute) { m_muted = mute; }
 
 		int GetMasterVolume() const { return m_masterVolume; }
 		void SetMasterVolume(int vol);
 
-		void PlayMono(int16_t data);
-		void PlayStereo(int16_t left, int16_t right);
+		// Sets the output level at time 'ticks' (base clock).
+		// Only changes are recorded, as band-limited steps, so this
+		// can be called on every tick at little cost
+		void SetOutput(size_t ticks, int16_t data) { SetOutput(ticks, data, data); }
+		void SetOutput(size_t ticks, int16_t left, int16_t right)
+		{
+			if (left != m_levelL || right != m_levelR)
+			{
+				AddDelta(ticks, left, right);
+			}
+		}
+
+		// Advances the sound clock to 'ticks' and outputs the sample frames up to that point.
+		// Called once per Step() (not on every tick), this is where the emulation is paced
+		void Update(size_t ticks);
+
+		// Audio callback ran out of data (callbacks padded with silence)
+		size_t GetUnderruns() const { return m_underruns; }
+		// Ring was full, sample frames dropped
+		size_t GetOverruns() const { return m_overruns; }
+
+#ifndef HSCOMMON_NO_SDL
+		// Called from the audio thread
+		void FillAudioBuffer(Uint8* stream, int length);
+#endif
+
+		// Same as SDL_MIX_MAXVOLUME
+		static constexpr int MAX_VOLUME = 128;
 
 	protected:
-		Sound();
-		WORD m_bufferSize;
+		static Sound& GetDefault();
+		static thread_local Sound* s_current;
+
+		WORD m_bufferSize = 0;
 
+#ifndef HSCOMMON_NO_SDL
 		void InitSDLAudio();
+#endif
+
+		void AddDelta(size_t ticks, int16_t left, int16_t right);
+
+		// Start a new frame at 'ticks', drops the time since the last Update
+		void Resync(size_t ticks);
 
-		void AddSample(int16_t s) { m_bufStaging[m_bufStagingPos++] = s; }
-		void MoveToPlayingBuffer();
+		// One output sample frame, after resampling
+		void OutputFrame(int16_t left, int16_t right);
 
+		// Emulation pacing, see OutputFrame
+		void WaitAudio();
+		void UpdateRateControl();
+
+#ifndef HSCOMMON_NO_SDL
 		SDL_AudioSpec m_audioSpec;
-		SDL_AudioDeviceID m_audioDeviceID = 0;
+#endif
+		uint32_t m_audioDeviceID = 0; // SDL_AudioDeviceID, 0: no audio device
+
+		AudioRing m_ring;
 
-		int16_t* m_bufSilence = nullptr;
-		int16_t* m_bufPlaying = nullptr;
-		int16_t* m_bufStaging = nullptr;
-		size_t m_bufStagingPos = 0;
+		// Audio thread only
+		int16_t* m_bufCallback = nullptr;
 
 		hscommon::fileUtil::File m_outputFile;
 
 		const int PLAYBACK_FREQUENCY = 44100;
-		int m_freqDivider = 1;
+
+		// Band-limited synthesis, base clock -> PLAYBACK_FREQUENCY
+		BlipBuffer m_blipL;
+		BlipBuffer m_blipR;
+		uint64_t m_baseFactor = 0;
+
+		int16_t m_levelL = 0;
+		int16_t m_levelR = 0;
+
+		// Start of the current blip frame, in base clock ticks
+		size_t m_frameStart = 0;
+		bool m_synced = false;
+
+		// Target ring fill level, in sample frames
+		size_t m_latencyFrames = 0;
+
+		// Rate control (config [sound].ratecontrol):
+		// false: Emulation is paced by the audio device, waits when
+		//        the ring is above the target latency
+		// true:  Emulation is paced by the host clock and the resampling
+		//        ratio is nudged to keep the ring around the target latency
+		bool m_rateControl = false;
+		int m_baseClock = PLAYBACK_FREQUENCY;
+		size_t m_inputTicks = 0;
+		size_t m_outputFrames = 0;
+		std::chrono::steady_clock::time_point m_startTime;
+
+		std::atomic<size_t> m_underruns{ 0 };
+		std::atomic<size_t> m_overruns{ 0 };
+		std::atomic<bool> m_started{ false };
 
 		bool m_muted = false;
-		int m_masterVolume = SDL_MIX_MAXVOLUME; // 0..128
+		int m_masterVolume = MAX_VOLUME; // 0..128
 	};
 
 	constexpr auto SOUND = &Sound::Get;
@@ -6,10 +6,12 @@
 #include <UI/SnapshotInfo.h>
 #include <UI/SnapshotWidget.h>
 #include <Config.h>
+#include <SnapshotFile.h>
 
 #pragma warning(disable:4251)
 
 #include <CPU/CPUCommon.h>
+#include <IO/InputEvents.h>
 #include <Storage/DeviceTape.h>
 #include <Core/Window.h>
 #include <Core/WindowManager.h>
@@ -33,6 +35,9 @@ using cfg::CONFIG;
 using namespace CoreUI;
 using namespace hscommon::fileUtil;
 using emul::CartridgeLoader;
+using emul::SnapshotFile;
+
+using events::InputAction;
 
 using tape::DeviceTape;
 using tape::TapeDeck;
@@ -115,6 +120,7 @@ namespace ui
 
 		m_mainWnd->SetToolbar(m_toolbar);
 		UpdateTitle();
+		SetRedraw();
 
 		// Toolbar section: Reboot
 		m_rebootButton = m_toolbar->AddToolbarItem("reboot", RES().FindImage("overlay16", 11));
@@ -141,6 +147,7 @@ namespace ui
 		{
 			m_lastSnapshotDir.clear();
 		}
+		m_snapshotName.clear();
 		UpdateSnapshot();
 
 		// Toolbar section: Tape drives
@@ -154,6 +161,7 @@ namespace ui
 			for (int i = 0; i < (int)m_pc->GetTape()->GetCount(); ++i)
 			{
 				char id[32];
+				m_tapeButtons[i].lastState = -1; // New buttons, force update
 
 				sprintf(id, "tape.%d.%s", i, "counter");
 				m_tapeButtons[i].counter = m_toolbar->AddToolbarItem(id, m_tapeStateIcons[(int)TapeStateIcon::PLAY_OFF], "0000");
@@ -249,25 +257,28 @@ namespace ui
 			std::string op(id.cbegin()+ 7, id.end());
 			TapeDeck& tape = m_pc->GetTape()->GetTape(drive);
 
+			// Tape actions go through the inputs so they can be recorded
+			events::InputEvents& inputs = m_pc->GetInputs();
+
 			if (op == "stop")
 			{
-				tape.SetState(TapeState::STOP);
+				inputs.Action(InputAction::TAPE_STATE, drive, (int)TapeState::STOP);
 			}
 			else if (op == "rewind")
 			{
-				tape.SetState(TapeState::REW);
+				inputs.Action(InputAction::TAPE_STATE, drive, (int)TapeState::REW);
 			}
 			else if (op == "forward")
 			{
-				tape.SetState(TapeState::FWD);
+				inputs.Action(InputAction::TAPE_STATE, drive, (int)TapeState::FWD);
 			}
 			else if (op == "play")
 			{
-				tape.SetState(TapeState::PLAY);
+				inputs.Action(InputAction::TAPE_STATE, drive, (int)TapeState::PLAY);
 			}
 			else if (op == "record")
 			{
-				tape.SetState(TapeState::REC);
+				inputs.Action(InputAction::TAPE_STATE, drive, (int)TapeState::REC);
 			}
 			else if (op == "counter") // TODO: Temporary
 			{
@@ -280,7 +291,7 @@ namespace ui
 				}
 				else
 				{
-					LoadTapeImage(tape);
+					LoadTapeImage(drive);
 				}
 			}
 
@@ -337,14 +348,17 @@ namespace ui
 
 	void Overlay::UpdateSnapshot()
 	{
-		if (m_lastSnapshotDir.empty())
+		std::string name;
+		if (!m_lastSnapshotDir.empty())
 		{
-			m_loadSnapshotButton->SetText("");
+			name = GetSnapshotName(m_lastSnapshotDir);
 		}
-		else
+
+		if (name != m_snapshotName)
 		{
-			std::string name = GetSnapshotName(m_lastSnapshotDir);
+			m_snapshotName = name;
 			m_loadSnapshotButton->SetText(name.c_str());
+			SetRedraw();
 		}
 	}
 
@@ -352,6 +366,7 @@ namespace ui
 	{
 		m_turboButton->SetPushed(m_turbo);
 		m_turboButton->SetImage(m_turbo ? m_turboOn : m_turboOff);
+		SetRedraw();
 	}
 
 	void Overlay::UpdateTape()
@@ -367,6 +382,18 @@ namespace ui
 			TapeDeck& deck = tape->GetTape(drive);
 			auto& buttons = m_tapeButtons[drive];
 
+			const size_t counter = deck.GetCounterRaw() / 1000;
+			if (((int)deck.GetState() == buttons.lastState) &&
+				(deck.GetMotor() == buttons.lastMotor) &&
+				(counter == buttons.lastCounter))
+			{
+				continue;
+			}
+			buttons.lastState = (int)deck.GetState();
+			buttons.lastMotor = deck.GetMotor();
+			buttons.lastCounter = counter;
+			SetRedraw();
+
 			buttons.stop->SetPushed(deck.GetState() == TapeState::STOP);
 			buttons.rewind->SetPushed(deck.GetState() == TapeState::REW);
 			buttons.play->SetPushed(deck.GetState() == TapeState::PLAY);
@@ -376,7 +403,7 @@ namespace ui
 			// Counter
 			{
 				static char buf[16];
-				sprintf(buf, "%04zu", deck.GetCounterRaw()/1000);
+				sprintf(buf, "%04zu", counter);
 				buttons.counter->SetText(buf);
 
 				TapeStateIcon state;
@@ -439,23 +466,31 @@ namespace ui
 		}
 
 		m_mainWnd->SetText(os.str().c_str());
+		SetRedraw();
 	}
 
 	// video::Renderer
 	void Overlay::Render()
 	{
+		// Emulated frames, not presented frames: presenting is
+		// skipped when nothing changed on screen
 		const size_t frames = 240;
-		static size_t frameCounter = 0;
 		static auto frameTime = std::chrono::high_resolution_clock::now();
 		float fps = 0.;
 
-		if (++frameCounter == 240)
+		const size_t frameCount = m_pc ? m_pc->GetVideo().GetFrameCount() : 0;
+		if (frameCount < m_fpsFrameCount)
+		{
+			// New computer
+			m_fpsFrameCount = frameCount;
+		}
+		if (frameCount - m_fpsFrameCount >= frames)
 		{
 			auto now = std::chrono::high_resolution_clock::now();
 			auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - frameTime).count();
 			frameTime = now;
-			fps = frames * 1000.f / delta;
-			frameCounter = 0;
+			fps = (frameCount - m_fpsFrameCount) * 1000.f / delta;
+			m_fpsFrameCount = frameCount;
 		}
 
 		if (fps > 0.)
@@ -474,6 +509,7 @@ namespace ui
 		{
 			WINMGR().Draw();
 		}
+		m_redraw = false;
 	}
 
 	void Overlay::ToggleTurbo()
@@ -491,15 +527,26 @@ namespace ui
 			return;
 		}
 
+		// Config, computer state and memory blocks all go in a single file
+		SnapshotFile snapshot;
+		snapshot.SetConfig();
+
 		json j;
 		m_pc->SetSerializationDir(snapshotDir);
+		m_pc->SetSnapshotFile(&snapshot);
 		m_pc->Serialize(j);
+		m_pc->SetSnapshotFile(nullptr);
+
+		snapshot.SetState(j);
 
 		fs::path outFile = snapshotDir;
-		outFile.append("computer.json");
+		outFile.append(SnapshotFile::FILE_NAME);
 
-		std::ofstream outStream(outFile.string());
-		outStream << std::setw(4) << j;
+		if (!snapshot.Save(outFile))
+		{
+			LogPrintf(LOG_ERROR, "SaveComputerData: Error saving state to [%s]", outFile.string().c_str());
+			return;
+		}
 
 		LogPrintf(LOG_INFO, "SaveComputerData: Saved state to [%s]", outFile.string().c_str());
 	}
@@ -518,17 +565,6 @@ namespace ui
 		}
 	}
 
-	void Overlay::SaveConfigFile(const fs::path& snapshotDir)
-	{
-		fs::path outFile = snapshotDir;
-		outFile.append("config.ini");
-
-		if (!CONFIG().SaveConfigFile(outFile.string().c_str()))
-		{
-			LogPrintf(LOG_ERROR, "SaveConfigFile: Error saving config file: %s", outFile.string().c_str());
-		}
-	}
-
 	void Overlay::SaveSnapshot(const fs::path& snapshotDir)
 	{
 		if (!m_pc)
@@ -537,7 +573,6 @@ namespace ui
 		}
 
 		SaveSnapshotInfo(snapshotDir);
-		SaveConfigFile(snapshotDir);
 		SaveComputerData(snapshotDir);
 
 		m_lastSnapshotDir = snapshotDir;
@@ -612,40 +647,60 @@ namespace ui
 			return;
 		}
 
-		// We don't need to read back the config.ini for trivial cases
+		// We don't need to read back the config for trivial cases
 		// (e.g when the configuration is compatible with the current one)
 		// If the deserialization fails with a compatibility error, the
 		// full restore will be done in the main loop, including
 		// reading back the configuration
 
-		fs::path inFile = snapshotDir;
-		inFile.append("computer.json");
-		std::ifstream inStream(inFile);
-
-		LogPrintf(LOG_INFO, "RestoreSnapshot: Read from [%s]", inFile.string().c_str());
+		SnapshotFile snapshot;
+		json j;
 
-		if (!inStream)
+		fs::path inFile = snapshotDir;
+		inFile.append(SnapshotFile::FILE_NAME);
+		if (fs::exists(inFile))
 		{
-			LogPrintf(LOG_ERROR, "RestoreSnapshot: Error opening file\n");
-			return;
-		}
+			LogPrintf(LOG_INFO, "RestoreSnapshot: Read from [%s]", inFile.string().c_str());
 
-		json j;
-		try
-		{
-			inStream >> j;
+			if (!snapshot.Load(inFile) || !snapshot.GetState(j))
+			{
+				LogPrintf(LOG_ERROR, "RestoreSnapshot: Error reading snapshot\n");
+				return;
+			}
 		}
-		catch (std::exception e)
+		else
 		{
-			LogPrintf(LOG_ERROR, "RestoreSnapshot: Error reading snapshot: %s\n", e.what());
-			return;
+			// Older snapshots: json + separate files
+			inFile = snapshotDir;
+			inFile.append("computer.json");
+			std::ifstream inStream(inFile);
+
+			LogPrintf(LOG_INFO, "RestoreSnapshot: Read from [%s]", inFile.string().c_str());
+
+			if (!inStream)
+			{
+				LogPrintf(LOG_ERROR, "RestoreSnapshot: Error opening file\n");
+				return;
+			}
+
+			try
+			{
+				inStream >> j;
+			}
+			catch (std::exception e)
+			{
+				LogPrintf(LOG_ERROR, "RestoreSnapshot: Error reading snapshot: %s\n", e.what());
+				return;
+			}
 		}
 
 		bool compatible = true;
 		try
 		{
 			m_pc->SetSerializationDir(snapshotDir);
+			m_pc->SetSnapshotFile(snapshot.IsLoaded() ? &snapshot : nullptr);
 			m_pc->Deserialize(j);
+			m_pc->SetSnapshotFile(nullptr);
 
 			SetPC(m_pc);
 		}
@@ -846,7 +901,7 @@ namespace ui
 		m_snapshotWnd->AddControl(widget);
 	}
 
-	void Overlay::LoadTapeImage(TapeDeck& deck)
+	void Overlay::LoadTapeImage(BYTE drive)
 	{
 		if (!m_pc || !m_pc->GetTape())
 		{
@@ -858,7 +913,7 @@ namespace ui
 		// TODO: Temp
 		if (SelectFile(diskImage, { {"Raw Tape image (*.raw)", "*.raw"} }))
 		{
-			deck.LoadRaw(diskImage.string().c_str());
+			m_pc->GetInputs().Action(InputAction::TAPE_LOAD, drive, 0, diskImage.string().c_str());
 		}
 		UpdateTape();
 	}
@@ -878,7 +933,7 @@ namespace ui
 
 		if (SelectFile(path, filter))
 		{
-			cartLoader->LoadCartridge(path);
+			m_pc->GetInputs().Action(InputAction::CART_LOAD, 0, 0, path.string().c_str());
 			UpdateCartridgeName();
 		}
 	}
@@ -892,7 +947,7 @@ namespace ui
 			return;
 		}
 
-		cartLoader->UnloadCartridge();
+		m_pc->GetInputs().Action(InputAction::CART_UNLOAD);
 		UpdateCartridgeName();
 	}
 
@@ -905,6 +960,8 @@ namespace ui
 			return;
 		}
 
+		SetRedraw();
+
 		std::string name = cartLoader->GetCartridgeInfo();
 		if (name.empty())
 		{
@@ -930,6 +987,10 @@ namespace ui
 		bool handled = false;
 		bool redraw = false;
 
+		// Hover, clicks, tooltips, window events (exposed, resized) can all
+		// change what is displayed
+		SetRedraw();
+
 		if (e.type == SDL_QUIT)
 		{
 			// Do nothing
@@ -19,7 +19,7 @@ namespace ui
 
 		virtual bool Init();
 		virtual void SetPC(emul::ComputerBase* pc);
-		virtual void Show(bool show = true) { m_show = show; }
+		virtual void Show(bool show = true) { m_redraw |= (show != m_show); m_show = show; }
 		virtual bool Update();
 
 		// When a snapshot is not compatible with the current pc
@@ -31,6 +31,8 @@ namespace ui
 
 		// video::Renderer
 		virtual void Render() override;
+		// Only when the overlay contents changed since it was last drawn
+		virtual bool NeedsRedraw() const override { return m_redraw; }
 
 		// events::EventHandler
 		virtual bool HandleEvent(SDL_Event& e) override;
@@ -41,6 +43,9 @@ namespace ui
 	protected:
 		CoreUI::ToolbarPtr GetToolbar() { return m_toolbar; }
 
+		// To call when something visible changed in the overlay
+		void SetRedraw() { m_redraw |= m_show; }
+
 		virtual void OnClick(CoreUI::WidgetRef widget);
 		virtual void OnClose(CoreUI::WidgetRef widget);
 
@@ -51,7 +56,7 @@ namespace ui
 
 		virtual void ToggleTurbo();
 
-		void LoadTapeImage(tape::TapeDeck& deck);
+		void LoadTapeImage(emul::BYTE drive);
 
 		// TODO: Should be in separate class so it can be used by others
 		bool MakeSnapshotDirectory(std::filesystem::path& dir);
@@ -59,7 +64,6 @@ namespace ui
 		bool GetLastSnapshotDirectory(std::filesystem::path& snapshotDir);
 		void SaveComputerData(const std::filesystem::path& snapshotDir);
 		void SaveSnapshotInfo(const std::filesystem::path& snapshotDir);
-		void SaveConfigFile(const std::filesystem::path& snapshotDir);
 		void SaveSnapshot(const std::filesystem::path& snapshotDir);
 		void RestoreSnapshot(const std::filesystem::path& snapshotDir);
 		void DeleteSnapshot(const std::filesystem::path& snapshotDir);
@@ -73,6 +77,7 @@ namespace ui
 		emul::ComputerBase* m_pc = nullptr;
 		std::filesystem::path m_snapshotBaseDirectory;
 		std::filesystem::path m_lastSnapshotDir;
+		std::string m_snapshotName; // Displayed in m_loadSnapshotButton
 
 		bool m_turbo = false;
 
@@ -95,6 +100,11 @@ namespace ui
 			CoreUI::ToolbarItemPtr record;
 			CoreUI::ToolbarItemPtr counter;
 
+			// Last displayed status
+			int lastState = -1; // tape::TapeState
+			bool lastMotor = false;
+			size_t lastCounter = 0;
+
 		} m_tapeButtons[2];
 
 		enum class TapeStateIcon { PLAY_OFF, PLAY_ON, REC_OFF, REC_ON, _MAX_STATE };
@@ -116,6 +126,9 @@ namespace ui
 
 	private:
 		bool m_show = true;
+		bool m_redraw = true;
+
+		size_t m_fpsFrameCount = 0;
 
 		CoreUI::ToolbarPtr m_toolbar;
 	};
@@ -73,6 +73,8 @@ namespace crtc_6845
 	}
 	void CRTController::WriteCRTCData(BYTE value)
 	{
+		++m_writeCount;
+
 		switch (m_config.currRegister)
 		{
 		case CRT_H_TOTAL_CHAR:
@@ -142,6 +142,10 @@ namespace crtc_6845
 		const CRTCConfig& GetConfig() const { return m_config; }
 		const CRTCData& GetData() const { return m_data; }
 
+		// Incremented on every register write, lets the video card
+		// detect config changes made in the middle of a scanline
+		size_t GetWriteCount() const { return m_writeCount; }
+
 		void SetEventHandler(EventHandler* handler) { m_events = handler; }
 
 		void SetCharWidth(BYTE charWidth);
@@ -170,5 +174,7 @@ namespace crtc_6845
 		EventHandler* m_events = nullptr;
 
 		bool m_configChanged = false;
+
+		size_t m_writeCount = 0;
 	};
 }
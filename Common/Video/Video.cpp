@@ -2,6 +2,8 @@
 
 #include <Video/Video.h>
 #include <Config.h>
+
+#ifndef HSCOMMON_NO_MAINWINDOW
 #include <UI/MainWindow.h>
 #include <UI/Overlay.h>
 
@@ -10,12 +12,14 @@
 #pragma warning(disable:4251)
 #include <Core/WindowManager.h>
 
-#include <assert.h>
-
-using cfg::CONFIG;
 using ui::MAINWND;
 using ui::WindowSize;
 using ui::Overlay;
+#endif
+
+#include <assert.h>
+
+using cfg::CONFIG;
 
 namespace video
 {
@@ -76,8 +80,13 @@ namespace video
 			m_fbHeight = height;
 			m_fb.resize(width * height);
 			std::fill(m_fb.begin(), m_fb.end(), GetBackgroundColor());
+			m_fbPrev.resize(width * height);
+			m_dirtyLines.resize(height);
+			m_forceRedraw = true;
 
+#ifndef HSCOMMON_NO_MAINWINDOW
 			m_sdlTexture = SDL_CreateTexture(MAINWND().GetRenderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+#endif
 		}
 		else
 		{
@@ -95,11 +104,13 @@ namespace video
 		m_fbWidth = 0;
 		m_fbHeight = 0;
 
+#ifndef HSCOMMON_NO_MAINWINDOW
 		if (m_sdlTexture)
 		{
 			SDL_DestroyTexture(m_sdlTexture);
 			m_sdlTexture = nullptr;
 		}
+#endif
 	}
 
 	void Video::InitMonitor(bool forceMono)
@@ -137,16 +148,103 @@ namespace video
 		}
 	}
 
+	void Video::UpdateDirtyLines()
+	{
+		const uint32_t maxX = std::min(m_fbMaxX, m_fbWidth);
+		const uint32_t maxY = std::min(m_fbMaxY, m_fbHeight);
+
+		// Visible area changed, the lines have to be compared/uploaded in full
+		if (maxX != m_prevMaxX || maxY != m_prevMaxY)
+		{
+			m_prevMaxX = maxX;
+			m_prevMaxY = maxY;
+			m_forceRedraw = true;
+		}
+
+		m_frameDirty = m_forceRedraw;
+		for (uint32_t y = 0; y < maxY; ++y)
+		{
+			const uint32_t* line = m_fb.data() + (y * m_fbWidth);
+			uint32_t* prevLine = m_fbPrev.data() + (y * m_fbWidth);
+
+			const bool dirty = m_forceRedraw || (memcmp(line, prevLine, maxX * sizeof(uint32_t)) != 0);
+			if (dirty)
+			{
+				memcpy(prevLine, line, maxX * sizeof(uint32_t));
+				m_frameDirty = true;
+			}
+			m_dirtyLines[y] = dirty;
+		}
+	}
+
+	bool Video::RenderersNeedRedraw() const
+	{
+		for (auto renderer : m_renderers)
+		{
+			if (renderer->NeedsRedraw())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	void Video::RenderFrame()
 	{
-		static size_t frames = 0;
+		if (((m_frameCount + 1) % 60) == 0)
+		{
+			LogPrintf(Logger::LOG_INFO, "60 frames");
+		}
+		++m_frameCount;
+
+		UpdateDirtyLines();
+
+#ifdef HSCOMMON_NO_MAINWINDOW
+		m_forceRedraw = false;
+#else
+		// Headless, nothing to present
+		if (!MAINWND().GetRenderer())
+		{
+			m_forceRedraw = false;
+			return;
+		}
 
-		SDL_Rect fbRect = SDL_Rect{ 0, 0, (int)m_fbMaxX, (int)m_fbMaxY };
 		SDL_Rect srcRect = GetDisplayRect(m_border);
+		if (!SDL_RectEquals(&srcRect, &m_prevSrcRect))
+		{
+			m_prevSrcRect = srcRect;
+			m_forceRedraw = true;
+		}
+
+		// Nothing changed, keep what's on screen
+		if (!m_frameDirty && !m_forceRedraw && !RenderersNeedRedraw())
+		{
+			return;
+		}
+		m_forceRedraw = false;
 
 		if (m_sdlTexture)
 		{
-			SDL_UpdateTexture(m_sdlTexture, &fbRect, &m_fb[0], m_fbWidth * sizeof(uint32_t));
+			// Upload runs of changed lines only
+			uint32_t y = 0;
+			while (y < m_prevMaxY)
+			{
+				if (!m_dirtyLines[y])
+				{
+					++y;
+					continue;
+				}
+
+				uint32_t end = y + 1;
+				while (end < m_prevMaxY && m_dirtyLines[end])
+				{
+					++end;
+				}
+
+				SDL_Rect lines = SDL_Rect{ 0, (int)y, (int)m_prevMaxX, (int)(end - y) };
+				SDL_UpdateTexture(m_sdlTexture, &lines, &m_fb[y * m_fbWidth], m_fbWidth * sizeof(uint32_t));
+				y = end;
+			}
 			SDL_RenderCopy(MAINWND().GetRenderer(), m_sdlTexture, &srcRect, &m_targetRect);
 		}
 
@@ -165,12 +263,7 @@ namespace video
 
 		SDL_SetRenderDrawColor(MAINWND().GetRenderer(), r, g, b, 255);
 		SDL_RenderClear(MAINWND().GetRenderer());
-
-		if (++frames == 60)
-		{
-			LogPrintf(Logger::LOG_INFO, "60 frames");
-			frames = 0;
-		}
+#endif
 	}
 
 	void Video::BeginFrame()
@@ -238,7 +331,7 @@ namespace video
 		if (it == m_modes.end())
 		{
 			LogPrintf(LOG_ERROR, "Unknown mode: %s", id);
-			throw std::exception("Unknown mode");
+			throw std::runtime_error("Unknown mode");
 		}
 
 		m_currMode = &(it->second);
@@ -248,8 +341,13 @@ namespace video
 	{
 		const double targetRatio = 4 / 3.;
 
+#ifdef HSCOMMON_NO_MAINWINDOW
+		// No window, nominal 4:3 client area
+		SDL_Rect rect{ 0, 0, 640, 480 };
+#else
 		const auto& size = MAINWND().GetSize();
 		SDL_Rect rect{ 0, 0, size.w, size.h - Overlay::GetOverlayHeight() };
+#endif
 
 		float windowRatio = rect.w / (float)rect.h;
 
@@ -267,6 +365,7 @@ namespace video
 		}
 
 		m_targetRect = rect;
+		m_forceRedraw = true;
 	}
 
 	SDL_Point Video::ClientToDisplayRect(SDL_Point screenPoint) const
@@ -290,6 +389,7 @@ namespace video
 	// events::EventHandler
 	bool Video::HandleEvent(SDL_Event& e)
 	{
+#ifndef HSCOMMON_NO_MAINWINDOW
 		if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_RESIZED)
 		{
 			LogPrintf(LOG_INFO, "Resize: %d x %d", e.window.data1, e.window.data2);
@@ -297,6 +397,7 @@ namespace video
 			MAINWND().SetSize({ e.window.data1, e.window.data2 });
 			UpdateTargetRect();
 		}
+#endif
 		return false; // Leave it unhandled if others are interested
 	}
 
@@ -11,7 +11,13 @@ using emul::WORD;
 using emul::BYTE;
 using emul::ADDRESS;
 
+#ifdef HSCOMMON_NO_SDL
+// Same layout as the SDL types, without the SDL headers
+struct SDL_Point { int x; int y; };
+struct SDL_Rect { int x; int y; int w; int h; };
+#else
 #include <SDL_rect.h>
+#endif
 
 struct SDL_Window;
 struct SDL_Renderer;
@@ -23,6 +29,10 @@ namespace video
 	{
 	public:
 		virtual void Render() = 0;
+
+		// When the emulated frame is unchanged, presenting is skipped
+		// unless a renderer needs to draw
+		virtual bool NeedsRedraw() const { return true; }
 	};
 
 	class Video : public PortConnector, public emul::Serializable, public events::EventHandler
@@ -73,6 +83,20 @@ namespace video
 		// The client area (in main window coordinates)
 		const SDL_Rect& GetTargetRect() const { return m_targetRect; }
 
+		// Raw framebuffer data (ARGB), GetFrameBufferWidth() pixels per line
+		const std::vector<uint32_t>& GetFrameBuffer() const { return m_fb; }
+		uint32_t GetFrameBufferWidth() const { return m_fbWidth; }
+		uint32_t GetFrameBufferHeight() const { return m_fbHeight; }
+
+		// Lines of the framebuffer that changed since the previous frame,
+		// updated by RenderFrame (also when headless).
+		// If IsFrameDirty() is false the whole frame is unchanged
+		const std::vector<bool>& GetDirtyLines() const { return m_dirtyLines; }
+		bool IsFrameDirty() const { return m_frameDirty; }
+
+		// Number of RenderFrame calls since creation
+		size_t GetFrameCount() const { return m_frameCount; }
+
 		void BeginFrame();
 		void NewLine();
 		void DrawAt(uint32_t x, uint32_t y, uint32_t color) { m_fb[y * m_fbWidth + x] = color; }
@@ -96,6 +120,13 @@ namespace video
 			++m_fbCurrX; m_fb[m_fbCurrPos++] = color;
 		}
 
+		// Same as count DrawPixel() calls with the colors in order
+		void DrawPixels(const uint32_t* colors, BYTE count) {
+			m_lastDot = colors[count - 1];
+			m_fbCurrX += count;
+			for (BYTE i = 0; i < count; ++i) { m_fb[m_fbCurrPos++] = colors[i]; }
+		}
+
 		void MergeLine(uint32_t* pixels, size_t len);
 		void DrawBackground(BYTE width);
 		void DrawBackground(BYTE width, uint32_t color);
@@ -150,6 +181,19 @@ namespace video
 
 		SDL_Texture* m_sdlTexture = nullptr;
 
+		// Dirty line tracking
+		void UpdateDirtyLines();
+		bool RenderersNeedRedraw() const;
+
+		std::vector<uint32_t> m_fbPrev; // Framebuffer content at last RenderFrame
+		std::vector<bool> m_dirtyLines;
+		bool m_frameDirty = true;
+		bool m_forceRedraw = true; // Texture or target changed, upload and present everything
+		uint32_t m_prevMaxX = 0;
+		uint32_t m_prevMaxY = 0;
+		SDL_Rect m_prevSrcRect = { 0, 0, 0, 0 };
+		size_t m_frameCount = 0;
+
 		std::vector<Renderer*> m_renderers;
 
 		// Modes & drawing functions
@@ -4,6 +4,7 @@
 #include <CPU/CPU.h>
 #include <CPU/PortConnector.h>
 #include <CPU/CPUInfo.h>
+#include <CPU/OpcodeTable.h>
 
 #undef IN
 #undef OUT
@@ -55,7 +56,7 @@ namespace emul
 		inline void TICKT3() { CPU::TICK((*m_currTiming)[(int)cpuInfo::OpcodeTimingType::T3]); }
 		inline void TICKMISC(cpuInfo::MiscTiming misc) { CPU::TICK(m_info.GetMiscTiming(misc)[0]); }
 
-		using OpcodeTable = std::vector<std::function<void()>>;
+		using OpcodeTable = std::vector<OpcodeHandler>;
 		OpcodeTable m_opcodes;
 		void UnknownOpcode();
 
@@ -69,6 +69,7 @@ namespace emul
 			pushPC();
 			m_iff1 = false;
 			m_programCounter = 0x0066;
+			ProfileIRQ((BYTE)m_programCounter);
 			REFRESH();
 			TICKMISC(MiscTiming::TRAP);
 			m_state = CPUState::RUN;
@@ -100,6 +101,7 @@ namespace emul
 				throw std::exception("InterruptMode::IM2 not implemented");
 				break;
 			}
+			ProfileIRQ((BYTE)m_programCounter);
 
 			REFRESH();
 			TICKMISC(MiscTiming::IRQ);
@@ -173,13 +175,14 @@ namespace emul
 
 		BYTE* const regs[] = { &m_reg.B, &m_reg.C, &m_reg.D, &m_reg.E, &m_reg.H, &m_reg.L, nullptr, &m_reg.A };
 
-		auto addOpRegs = [&](BYTE base, std::function<void(CPUZ80*, BYTE& dest)> func)
+		auto addOpRegs = [&](BYTE base, RegOpFunc func)
 		{
 			for (size_t i = 0; i < 8; ++i)
 			{
-				if (regs[i])
+				BYTE* reg = regs[i];
+				if (reg)
 				{
-					m_opcodesBITS[base + i] = [=]() { func(this, *regs[i]); };
+					m_opcodesBITS[base + i] = [=]() { (this->*func)(*reg); };
 				}
 				else
 				{
@@ -193,9 +196,10 @@ namespace emul
 		{
 			for (size_t i = 0; i < 8; ++i)
 			{
-				if (regs[i])
+				BYTE* reg = regs[i];
+				if (reg)
 				{
-					m_opcodesBITS[base + i] = [=]() { BITget(bit, *regs[i]); };
+					m_opcodesBITS[base + i] = [=]() { BITget(bit, *reg); };
 				}
 				else
 				{
@@ -209,9 +213,10 @@ namespace emul
 		{
 			for (size_t i = 0; i < 8; ++i)
 			{
-				if (regs[i])
+				BYTE* reg = regs[i];
+				if (reg)
 				{
-					m_opcodesBITS[base + i] = [=]() { BITset(bit, set, *regs[i]); };
+					m_opcodesBITS[base + i] = [=]() { BITset(bit, set, *reg); };
 				}
 				else
 				{
@@ -270,11 +275,12 @@ namespace emul
 
 		BYTE* const regs[] = { &m_reg.B, &m_reg.C, &m_reg.D, &m_reg.E, &m_reg.H, &m_reg.L, &m_regDummy, &m_reg.A };
 
-		auto addOpRegs = [&](BYTE base, std::function<void(CPUZ80*, BYTE& dest)> func)
+		auto addOpRegs = [&](BYTE base, RegOpFunc func)
 		{
 			for (size_t i = 0; i < 8; ++i)
 			{
-				m_opcodesBITSxy[base + i] = [=]() { IDXop(func, *regs[i]); };
+				BYTE* reg = regs[i];
+				m_opcodesBITSxy[base + i] = [=]() { IDXop(func, *reg); };
 				++added;
 			}
 		};
@@ -292,7 +298,8 @@ namespace emul
 		{
 			for (size_t i = 0; i < 8; ++i)
 			{
-				m_opcodesBITSxy[base + i] = [=]() { BITsetIXY(bit, set, *regs[i]); };
+				BYTE* reg = regs[i];
+				m_opcodesBITSxy[base + i] = [=]() { BITsetIXY(bit, set, *reg); };
 				++added;
 			}
 		};
@@ -691,17 +698,17 @@ namespace emul
 		m_memory.Write8(base, value);
 	}
 
-	void CPUZ80::IDXop(std::function<void(CPUZ80*, BYTE& dest)> func, BYTE& reg)
+	void CPUZ80::IDXop(RegOpFunc func, BYTE& reg)
 	{
 		reg = ReadMemIdx(m_currOffset);
-		func(this, reg);
+		(this->*func)(reg);
 		WriteMemIdx(m_currOffset, reg);
 	}
 
-	void CPUZ80::MEMop(std::function<void(CPUZ80*, BYTE& dest)> func)
+	void CPUZ80::MEMop(RegOpFunc func)
 	{
 		BYTE temp = ReadMem();
-		func(this, temp);
+		(this->*func)(temp);
 		WriteMem(temp);
 	}
 
@@ -92,8 +92,9 @@ namespace emul
 		// Helper functions
 		BYTE ReadMemIdx(BYTE offset);
 		void WriteMemIdx(BYTE offset, BYTE value);
-		void IDXop(std::function<void(CPUZ80*, BYTE& dest)> func, BYTE& reg);
-		void MEMop(std::function<void(CPUZ80*, BYTE& dest)> func);
+		using RegOpFunc = void(CPUZ80::*)(BYTE& dest);
+		void IDXop(RegOpFunc func, BYTE& reg);
+		void MEMop(RegOpFunc func);
 
 		void jumpRelIF(bool condition, BYTE offset);
 		void exec(OpcodeTable& table, BYTE opcode);
@@ -350,6 +350,31 @@ namespace emul
 		}
 	}
 
+	void ComputerCPC::OnInputAction(const events::InputRecord& action)
+	{
+		switch ((events::InputAction)action.code)
+		{
+		case events::InputAction::FLOPPY_LOAD:
+			if (m_floppy && (action.unit < 2))
+			{
+				m_floppy->LoadDiskImage(action.unit, action.data.c_str());
+				return;
+			}
+			break;
+		case events::InputAction::FLOPPY_EJECT:
+			if (m_floppy && (action.unit < 2))
+			{
+				m_floppy->ClearDiskImage(action.unit);
+				return;
+			}
+			break;
+		default:
+			break;
+		}
+
+		ComputerBase::OnInputAction(action);
+	}
+
 	void ComputerCPC::OnLowROMChange(bool load)
 	{
 		m_lowROMLoaded = load;
@@ -499,9 +524,9 @@ namespace emul
 
 			if (!m_turbo)
 			{
-				//SOUND().PlayMono(tape.Read() * 8000);
+				//SOUND().SetOutput(g_ticks, tape.Read() * 8000);
 				const auto& out = m_sound.GetOutput();
-				SOUND().PlayStereo(out.A + out.B, out.A + out.C);
+				SOUND().SetOutput(g_ticks, out.A + out.B, out.A + out.C);
 			}
 
 			{
@@ -526,6 +551,11 @@ namespace emul
 		}
 		GetCPU().SetINT(GetVideo().IsInterrupt());
 
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
+		}
+
 		return true;
 	}
 
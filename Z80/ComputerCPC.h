@@ -78,6 +78,8 @@ namespace emul
 		void InitTape();
 		void InitFloppy(fdc::DeviceFloppy* fdd);
 
+		virtual void OnInputAction(const events::InputRecord& action) override;
+
 		static const std::map<std::string, Model> s_modelMap;
 		Model m_model = Model::CPC464;
 
@@ -161,7 +161,7 @@ namespace emul
 
 			if (!m_turbo)
 			{
-				SOUND().PlayMono(m_sound.GetOutput() * 10);
+				SOUND().SetOutput(g_ticks, m_sound.GetOutput() * 10);
 			}
 
 			GetInputs().Tick();
@@ -173,6 +173,11 @@ namespace emul
 			GetCPU().SetNMI(GetVideo().IsInterrupt());
 		}
 
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
+		}
+
 		return true;
 	}
 
@@ -18,7 +18,8 @@ namespace emul
 		Logger("ComputerZ80"),
 		ComputerBase(m_memory),
 		m_baseRAM("RAM", 0x8000, emul::MemoryType::RAM),
-		m_rom("ROM", 0x1000, emul::MemoryType::ROM)
+		m_rom("ROM", 0x1000, emul::MemoryType::ROM),
+		m_bootstrapROM("bootstrap", { 0x31, 0xff, 0xff, 0xc3, 0x00, 0x80 }, emul::MemoryType::ROM)
 	{
 	}
 
@@ -29,10 +30,8 @@ namespace emul
 
 		GetMemory().EnableLog(CONFIG().GetLogLevel("memory"));
 
-		std::vector<BYTE> bootstrap = { 0x31, 0xff, 0xff, 0xc3, 0x00, 0x80 };
-
-		static MemoryBlock bootstrapROM("bootstrap", bootstrap, MemoryType::ROM);
-		m_memory.Allocate(&bootstrapROM, 0);
+		// LD SP, FFFFh; JP 8000h
+		m_memory.Allocate(&m_bootstrapROM, 0);
 
 		m_baseRAM.LoadFromFile("P:/Projects/z80/z80test/src/z80doc.out");
 		m_memory.Allocate(&m_baseRAM, 32768);
@@ -86,9 +85,6 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = 0;
-		cpuTicks += GetCPU().GetInstructionTicks();
-
 		++g_ticks;
 
 		GetInputs().Tick();
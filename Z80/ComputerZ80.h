@@ -36,5 +36,6 @@ namespace emul
 
 		emul::MemoryBlock m_baseRAM;
 		emul::MemoryBlock m_rom;
+		emul::MemoryBlock m_bootstrapROM;
 	};
 }
@@ -75,9 +75,6 @@ namespace emul
 			return false;
 		}
 
-		static uint32_t cpuTicks = 0;
-		cpuTicks += GetCPU().GetInstructionTicks();
-
 		// Interrupt when A6 = 0
 		//
 		// Interrupts are only enabled during Display File processing.
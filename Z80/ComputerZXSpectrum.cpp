@@ -97,19 +97,18 @@ namespace emul
 			GetVideo().Tick();
 
 			// Generate an interrupt every RTC_CLK (50Hz)
-			static size_t rtcDelay = RTC_RATE;
-			GetCPU().SetINT(rtcDelay == RTC_RATE);
-			if (--rtcDelay == 0)
+			GetCPU().SetINT(m_rtcTicks == 0);
+			if (++m_rtcTicks == RTC_RATE)
 			{
 				GetVideo().VSync();
 
 				// Reset Counter
-				rtcDelay = RTC_RATE;
+				m_rtcTicks = 0;
 			}
 
 			if (!m_turbo)
 			{
-				SOUND().PlayMono(m_earOutput << 8);
+				SOUND().SetOutput(g_ticks, m_earOutput << 8);
 			}
 
 			GetInputs().Tick();
@@ -119,6 +118,11 @@ namespace emul
 			}
 		}
 
+		if (!m_turbo)
+		{
+			SOUND().Update(g_ticks);
+		}
+
 		return true;
 	}
 
@@ -41,5 +41,7 @@ namespace emul
 
 		kbd::DeviceKeyboardZX80 m_keyboard;
 
+		// CPU ticks since the last RTC interrupt
+		size_t m_rtcTicks = 0;
 	};
 }
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Monitor8080.h"
 #include "CPU/CPU8080.h"
+#include <CPU/CPUProfiler.h>
 
 using cpuInfo::Opcode;
 using cpuInfo::Coord;
@@ -68,13 +69,26 @@ namespace emul
 				Update();
 				break;
 
+			case 64: // F6: Dump profiler data
+				if (m_cpu->GetProfiler())
+				{
+					m_cpu->GetProfiler()->Dump();
+				}
+				break;
+
 				// Not implemented, ignore
 			case 59: // F1
 			case 60: // F2
 			case 61: // F3
-			case 64: // F6
 			case 65: // F7
+				break;
 			case 67: // F9
+				if (m_cpu->GetBreakpoints())
+				{
+					m_cpu->GetBreakpoints()->ToggleExec(m_cpu->GetCurrentAddress());
+				}
+				UpdateCode();
+				break;
 			case 68: // F10
 			default:
 				break;
@@ -83,8 +97,16 @@ namespace emul
 		return (m_runMode == RUNMode::STEP) ? MonitorState::WAIT : MonitorState::RUN;
 	}
 
+	bool Monitor8080::IsBreakpoint()
+	{
+		return m_cpu->GetBreakpoints() && m_cpu->GetBreakpoints()->IsBreak(m_cpu->GetCurrentAddress());
+	}
+
 	MonitorState Monitor8080::Run()
 	{
+		// Monitor memory reads don't trigger watchpoints
+		Breakpoints::Suspend suspend(m_cpu->GetBreakpoints());
+
 		Update();
 		if (m_runMode == RUNMode::STEP)
 		{
@@ -96,6 +118,8 @@ namespace emul
 
 	void Monitor8080::Show()
 	{
+		Breakpoints::Suspend suspend(m_cpu->GetBreakpoints());
+
 		std::string ansiFile = m_cpu->GetInfo().GetANSIFile();
 
 		if (ansiFile.size())
@@ -324,7 +348,8 @@ namespace emul
 		pos.y = baseY + y;
 
 		pos.x = offsetPos.x;
-		WriteValueHex((WORD)instr.address, pos);
+		bool isBreakpoint = m_cpu->GetBreakpoints() && m_cpu->GetBreakpoints()->IsExec(instr.address);
+		WriteValueHex((WORD)instr.address, pos, isBreakpoint ? (4 << 4) | 15 : 15);
 		pos.x = rawPos.x;
 		m_console.WriteAt(pos.x, pos.y, (const char*)instr.raw, instr.len);
 		for (int i = 0; i < rawPos.w - instr.len; ++i)
@@ -3,6 +3,7 @@
 #include <IO/Console.h>
 
 #include <CPU/Memory.h>
+#include <CPU/Breakpoints.h>
 #include <CPU/CPUInfo.h>
 
 namespace emul
@@ -26,6 +27,8 @@ namespace emul
 		virtual void Init(CPU* cpu, Memory& memory);
 
 		void SetCustomMemoryView(ADDRESS address) { m_customMemView = address; }
+		// Stop at breakpoint/watchpoint, call before each instruction
+		bool IsBreakpoint();
 
 		void Show();
 		MonitorState Run();
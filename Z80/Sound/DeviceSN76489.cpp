@@ -176,7 +176,8 @@ namespace sn76489
 
 	DeviceSN76489::DeviceSN76489(WORD baseAddress, size_t clockSpeedHz) :
 		Logger("SN76489"),
-		m_baseAddress(baseAddress)
+		m_baseAddress(baseAddress),
+		m_clockSpeed(clockSpeedHz)
 	{
 		m_voices[0] = new VoiceSquare("SN76489_V0");
 		m_voices[1] = new VoiceSquare("SN76489_V1");
@@ -184,8 +185,6 @@ namespace sn76489
 		m_voices[3] = new VoiceNoise("SN76489_N", m_voices[2]);
 		m_currDest = m_voices[0];
 
-		s_clockSpeed = clockSpeedHz;
-
 		Reset();
 	}
 
@@ -257,10 +256,9 @@ namespace sn76489
 			--m_ready;
 		}
 
-		static WORD cooldown = m_tickDivider;
-		if (--cooldown != 0)
+		if (--m_cooldown != 0)
 			return;
-		cooldown = m_tickDivider;
+		m_cooldown = m_tickDivider;
 
 		for (int i = 0; i < 4; ++i)
 		{
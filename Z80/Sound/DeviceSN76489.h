@@ -11,8 +11,6 @@ using emul::BYTE;
 
 namespace sn76489
 {
-	static size_t s_clockSpeed = 1000000;
-
 	static const BYTE s_volumeTable[16] = { 255, 203, 161, 128, 102, 81, 64, 51, 41, 32, 25, 20, 16, 13, 10, 0 };
 
 	class Voice : public Logger, public emul::Serializable
@@ -122,17 +120,20 @@ namespace sn76489
 		WORD GetOutput();
 
 		bool IsReady() const { return m_ready == 0; }
+		size_t GetClockSpeed() const { return m_clockSpeed; }
 
 		virtual void Serialize(json& to) override;
 		virtual void Deserialize(const json& from) override;
 
 	protected:
 		const BYTE m_tickDivider = 16;
+		WORD m_cooldown = m_tickDivider;
 
 		size_t m_ready = 0;
 		void WriteData(BYTE value);
 
 		const WORD m_baseAddress;
+		const size_t m_clockSpeed;
 
 		Voice* m_currDest = nullptr;
 		enum class Function { VOL, DATA };
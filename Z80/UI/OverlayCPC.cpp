@@ -124,6 +124,7 @@ namespace ui
 		}
 
 		m_floppyButton[drive]->SetText(os.str().c_str());
+		SetRedraw();
 	}
 
 	bool OverlayCPC::Update()
@@ -137,7 +138,13 @@ namespace ui
 		{
 			for (int i = 0; i < 2; ++i)
 			{
-				m_floppyButton[i]->SetImage(GetPC()->GetFloppy()->IsActive(i) ? m_floppyActive : m_floppyInactive);
+				const bool active = GetPC()->GetFloppy()->IsActive(i);
+				m_floppyButton[i]->SetImage(active ? m_floppyActive : m_floppyInactive);
+				if (active != m_floppyLED[i])
+				{
+					m_floppyLED[i] = active;
+					SetRedraw();
+				}
 			}
 		}
 
@@ -155,11 +162,11 @@ namespace ui
 
 		if (eject)
 		{
-			GetPC()->GetFloppy()->ClearDiskImage(drive);
+			GetPC()->GetInputs().Action(events::InputAction::FLOPPY_EJECT, drive);
 		}
 		else if (SelectFile(diskImage, { {"Floppy disk image (*.dsk)", "*.dsk"} }))
 		{
-			GetPC()->GetFloppy()->LoadDiskImage(drive, diskImage.string().c_str());
+			GetPC()->GetInputs().Action(events::InputAction::FLOPPY_LOAD, drive, 0, diskImage.string().c_str());
 		}
 		UpdateFloppy(drive);
 	}
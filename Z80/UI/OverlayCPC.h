@@ -33,5 +33,8 @@ namespace ui
 
 		CoreUI::ImageRef m_floppyInactive = nullptr;
 		CoreUI::ImageRef m_floppyActive = nullptr;
+
+		// Last displayed activity lights
+		bool m_floppyLED[2] = { false, false };
 	};
 }
@@ -39,9 +39,6 @@ namespace video::vdp
 		}
 	}
 
-	int Sprite::size = 8;
-	BYTE Sprite::nameMask = 0xFF;
-
 	void TMS9918::Status::Reset()
 	{
 		interrupt = false;
@@ -78,8 +75,8 @@ namespace video::vdp
 		m_config.sprites16x16 = false;
 		m_config.sprites2x = false;
 
-		Sprite::SetSize(8);
-		Sprite::SetNameMask(0xFF);
+		m_config.spriteSize = 8;
+		m_config.spriteNameMask = 0xFF;
 
 		m_tables.Reset();
 
@@ -234,8 +231,8 @@ namespace video::vdp
 			m_config.sprites16x16 = GetBit(m_tempData, 1);
 			m_config.sprites2x = GetBit(m_tempData, 0);
 
-			Sprite::SetSize(8 * ((m_config.sprites16x16) ? 2 : 1) * ((m_config.sprites2x ? 2 : 1)));
-			Sprite::SetNameMask(m_config.sprites16x16 ? 0xFC : 0xFF);
+			m_config.spriteSize = 8 * ((m_config.sprites16x16) ? 2 : 1) * ((m_config.sprites2x ? 2 : 1));
+			m_config.spriteNameMask = m_config.sprites16x16 ? 0xFC : 0xFF;
 
 			LogPrintf(LOG_INFO, "R1: 16K[%d] ENABLE[%d], INT_EN[%d], SPR16x16[%d], SPR2X[%d] (SPR_SIZE[%d])",
 				m_config.vram16k,
@@ -243,7 +240,7 @@ namespace video::vdp
 				m_config.interruptEnabled,
 				m_config.sprites16x16,
 				m_config.sprites2x,
-				Sprite::GetSize());
+				m_config.spriteSize);
 
 			UpdateMode();
 			if (!m_config.vram16k)
@@ -478,7 +475,7 @@ namespace video::vdp
 			if (sprite->IsLast())
 				break;
 
-			if (sprite->IsVisible(m_currY))
+			if (sprite->IsVisible(m_currY, m_config.spriteSize))
 			{
 				if (drawn == 4)
 				{
@@ -508,7 +505,7 @@ namespace video::vdp
 		to["cfg.interruptEnabled"] = m_config.interruptEnabled;
 		to["cfg.sprites16x16"] = m_config.sprites16x16;
 		to["cfg.sprites2x"] = m_config.sprites2x;
-		to["cfg.spriteSize"] = Sprite::GetSize();
+		to["cfg.spriteSize"] = m_config.spriteSize;
 
 		to["status.interrupt"] = m_status.interrupt;
 		to["status.coincidence"] = m_status.coincidence;
@@ -528,10 +525,18 @@ namespace video::vdp
 		to["currY"] = m_currY;
 		to["currName"] = m_currName;
 
-		std::string fileName = m_vram.GetId() + ".bin";
-		fs::path path = GetSerializationDir() / fileName;
-		m_vram.Dump(0, m_vram.GetSize(), path.string().c_str());
-		to["vram"] = fileName;
+		if (GetSnapshotFile())
+		{
+			m_vram.SaveToSnapshot(*GetSnapshotFile(), m_vram.GetId());
+			to["vramChunk"] = m_vram.GetId();
+		}
+		else
+		{
+			std::string fileName = m_vram.GetId() + ".bin";
+			fs::path path = GetSerializationDir() / fileName;
+			m_vram.Dump(0, m_vram.GetSize(), path.string().c_str());
+			to["vram"] = fileName;
+		}
 	}
 	void TMS9918::Deserialize(const json& from)
 	{
@@ -550,7 +555,8 @@ namespace video::vdp
 		m_config.interruptEnabled = from["cfg.interruptEnabled"];
 		m_config.sprites16x16 = from["cfg.sprites16x16"];
 		m_config.sprites2x = from["cfg.sprites2x"];
-		Sprite::SetSize(from["cfg.spriteSize"]);
+		m_config.spriteSize = from["cfg.spriteSize"];
+		m_config.spriteNameMask = m_config.sprites16x16 ? 0xFC : 0xFF;
 
 		m_status.interrupt = from["status.interrupt"];
 		m_status.coincidence = from["status.coincidence"];
@@ -570,9 +576,23 @@ namespace video::vdp
 		m_currY = from["currY"];
 		m_currName = from["currName"];
 
-		std::string fileName = from["vram"];
-		fs::path path = GetSerializationDir() / fileName;
-		m_vram.LoadFromFile(path.string().c_str());
+		if (from.contains("vramChunk"))
+		{
+			if (!GetSnapshotFile())
+			{
+				throw emul::SerializableException("TMS9918: No snapshot file");
+			}
+			if (!m_vram.LoadFromSnapshot(*GetSnapshotFile(), from["vramChunk"].get<std::string>()))
+			{
+				throw emul::SerializableException("TMS9918: Error loading vram from snapshot");
+			}
+		}
+		else
+		{
+			std::string fileName = from["vram"];
+			fs::path path = GetSerializationDir() / fileName;
+			m_vram.LoadFromFile(path.string().c_str());
+		}
 
 		UpdateMode();
 		m_tables.Update(m_mode);
@@ -18,27 +18,18 @@ namespace video::vdp
         bool IsLast() const { return yPos == 0xD0; }
         BYTE GetName() const { return name; }
         BYTE GetColor() const { return color & 0x0F; }
-        bool IsVisible(int y) const {
+        bool IsVisible(int y, int size) const {
             const int ymin = GetY();
             const int ymax = ymin + size;
             return (y >= ymin && y < ymax);
         }
 
-        static int GetSize() { return size; }
-        static void SetSize(int s) { size = s; }
-
-        static BYTE GetNameMask() { return nameMask; }
-        static void SetNameMask(BYTE mask) { nameMask = mask; }
-
     protected:
         // Raw data
         BYTE yPos;
         BYTE hPos;
         BYTE name;
         BYTE color;
-
-        static int size;
-        static BYTE nameMask;
     };
 #pragma pack(pop)
 
@@ -117,6 +108,10 @@ namespace video::vdp
             bool interruptEnabled = false;
             bool sprites16x16 = false;
             bool sprites2x = false;
+
+            // Derived from sprites16x16 and sprites2x
+            int spriteSize = 8;
+            BYTE spriteNameMask = 0xFF;
         } m_config;
 
         // Computes m_mode from m1,m2,m3
@@ -170,7 +165,7 @@ namespace video::vdp
         // Sprites
         Sprite* m_sprites = nullptr;
         const Sprite* GetSprite(int index) const { return m_sprites + index; }
-        WORD GetSpritePatternBase(BYTE name) const { return m_tables.spritePattern + (8 * (name & Sprite::GetNameMask())); }
+        WORD GetSpritePatternBase(BYTE name) const { return m_tables.spritePattern + (8 * (name & m_config.spriteNameMask)); }
         void UpdateSpriteData();
 
         // Draw max 4 sprites per line
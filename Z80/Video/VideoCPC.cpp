@@ -183,10 +183,9 @@ namespace video::cpc
 		}
 
 		// Clock at 1/4 Tick rate
-		static int tick4 = 0;
-		if (++tick4 == 4)
+		if (++m_tick4 == 4)
 		{
-			tick4 = 0;
+			m_tick4 = 0;
 		}
 		else
 		{
@@ -252,8 +251,6 @@ namespace video::cpc
 
 	void VideoCPC::UpdateMode()
 	{
-		static int m_lastMode = -1;
-
 		if (m_mode == m_lastMode)
 			return;
 
@@ -71,8 +71,12 @@ namespace video::cpc
             "640x200x2",
             "160x200x4" };
         int m_mode = 0;
+        int m_lastMode = -1;
         void UpdateMode();
 
+        // Clock at 1/4 Tick rate
+        int m_tick4 = 0;
+
         //bool IsCursor() const;
 
         emul::MemoryBlock* m_ram = nullptr;
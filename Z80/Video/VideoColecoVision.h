@@ -17,9 +17,8 @@ namespace video
             m_vdp.Tick();
 
             // VDP clock is 1.5x cpu clk
-            static bool half = false;
-            if (half) m_vdp.Tick();
-            half = !half;
+            if (m_half) m_vdp.Tick();
+            m_half = !m_half;
         }
 
         virtual void EnableLog(SEVERITY severity) override;
@@ -46,5 +45,6 @@ namespace video
         void Write1(BYTE value) { m_vdp.Write(value); }
 
         vdp::TMS9918 m_vdp;
+        bool m_half = false;
     };
 }